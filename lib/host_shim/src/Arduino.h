@@ -0,0 +1,125 @@
+// --------------------------------------------------------
+// Copyright (c) 2025 rapid4mifu 
+//
+// These codes are licensed under GPL v3.0
+// https://opensource.org/license/GPL-3.0
+// --------------------------------------------------------
+
+// Arduino core API of the host shim (ESP32 Arduino 3.x subset)
+//
+// the shim emulates an M5Stack ATOM (-D ESP32 -D ARDUINO_M5Stack_ATOM) so
+// the task modules build unchanged, the pins, the LEDC outputs, the ADC and
+// the hardware timers are driven on the virtual clock of the scheduler and
+// observed through sim.h
+
+#ifndef __SHIM_ARDUINO_H__	/* 二重定義防止 */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+
+#include "freertos/FreeRTOS.h"
+#include "WString.h"
+#include "Print.h"
+#include "IPAddress.h"
+#include "HardwareSerial.h"
+#include "Esp.h"
+
+using std::min;
+using std::max;
+
+#define HIGH 0x1
+#define LOW 0x0
+
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define PULLUP 0x04
+#define INPUT_PULLUP 0x05
+#define PULLDOWN 0x08
+#define INPUT_PULLDOWN 0x09
+#define OPEN_DRAIN 0x10
+#define OUTPUT_OPEN_DRAIN 0x13
+#define ANALOG 0xC0
+
+#define RISING 0x01
+#define FALLING 0x02
+#define CHANGE 0x03
+#define ONLOW 0x04
+#define ONHIGH 0x05
+
+#define IRAM_ATTR
+#define DRAM_ATTR
+#define ARDUINO_ISR_ATTR
+#define PROGMEM
+#define PSTR(s) (s)
+#define pgm_read_byte(addr) (*(const uint8_t *)(addr))
+#define digitalPinToInterrupt(pin) (((pin) < 40) ? (pin) : -1)
+
+#define MALLOC_CAP_8BIT (1 << 2)
+#define MALLOC_CAP_SPIRAM (1 << 10)
+#define MALLOC_CAP_INTERNAL (1 << 11)
+
+typedef struct {
+	uint8_t pin;
+	uint8_t channel;
+	int avg_read_raw;
+	int avg_read_mvolts;
+} adc_continuous_data_t;
+
+typedef struct sim_hw_timer hw_timer_t;
+
+/* time */
+unsigned long millis(void);
+unsigned long micros(void);
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void yield(void);
+
+/* GPIO */
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+void attachInterrupt(uint8_t pin, void (*handler)(void), int mode);
+void attachInterruptArg(uint8_t pin, void (*handler)(void *), void * arg, int mode);
+void detachInterrupt(uint8_t pin);
+
+/* LEDC (PWM) */
+bool ledcAttach(uint8_t pin, uint32_t freq, uint8_t resolution);
+bool ledcWrite(uint8_t pin, uint32_t duty);
+uint32_t ledcRead(uint8_t pin);
+bool ledcDetach(uint8_t pin);
+void rgbLedWrite(uint8_t pin, uint8_t red_val, uint8_t green_val, uint8_t blue_val);
+
+/* ADC */
+uint16_t analogRead(uint8_t pin);
+uint32_t analogReadMilliVolts(uint8_t pin);
+bool analogContinuous(const uint8_t pins[], size_t pins_count, uint32_t conversions_per_pin,
+	uint32_t sampling_freq_hz, void (*userFunc)(void));
+bool analogContinuousRead(adc_continuous_data_t ** buffer, uint32_t timeout_ms);
+bool analogContinuousStart(void);
+bool analogContinuousStop(void);
+bool analogContinuousDeinit(void);
+
+/* hardware timer */
+hw_timer_t * timerBegin(uint32_t frequency);
+void timerEnd(hw_timer_t * timer);
+void timerStart(hw_timer_t * timer);
+void timerStop(hw_timer_t * timer);
+void timerRestart(hw_timer_t * timer);
+void timerAttachInterrupt(hw_timer_t * timer, void (*userFunc)(void));
+void timerDetachInterrupt(hw_timer_t * timer);
+void timerAlarm(hw_timer_t * timer, uint64_t alarm_value, bool autoreload, uint64_t reload_count);
+
+/* chip */
+float temperatureRead(void);
+uint32_t getCpuFrequencyMhz(void);
+bool psramFound(void);
+void * heap_caps_malloc(size_t size, uint32_t caps);
+void heap_caps_free(void * ptr);
+
+#endif /* __SHIM_ARDUINO_H__*/	/* 二重定義防止 */
+#define __SHIM_ARDUINO_H__	/* 二重定義防止 */
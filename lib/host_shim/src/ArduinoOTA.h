@@ -0,0 +1,50 @@
+// --------------------------------------------------------
+// Copyright (c) 2025 rapid4mifu 
+//
+// These codes are licensed under GPL v3.0
+// https://opensource.org/license/GPL-3.0
+// --------------------------------------------------------
+
+// ArduinoOTA of the host shim (no update ever arrives)
+
+#ifndef __SHIM_ARDUINOOTA_H__	/* 二重定義防止 */
+
+#include "Update.h"
+
+#include <functional>
+
+typedef enum {
+	OTA_AUTH_ERROR,
+	OTA_BEGIN_ERROR,
+	OTA_CONNECT_ERROR,
+	OTA_RECEIVE_ERROR,
+	OTA_END_ERROR
+} ota_error_t;
+
+class ArduinoOTAClass {
+public:
+	typedef std::function<void(void)> THandlerFunction;
+	typedef std::function<void(ota_error_t)> THandlerFunction_Error;
+	typedef std::function<void(unsigned int, unsigned int)> THandlerFunction_Progress;
+
+	ArduinoOTAClass & onStart(THandlerFunction fn) { start = fn; return *this; }
+	ArduinoOTAClass & onEnd(THandlerFunction fn) { finish = fn; return *this; }
+	ArduinoOTAClass & onProgress(THandlerFunction_Progress fn) { progress = fn; return *this; }
+	ArduinoOTAClass & onError(THandlerFunction_Error fn) { error = fn; return *this; }
+	ArduinoOTAClass & setHostname(const char * hostname) { (void)hostname; return *this; }
+	void begin(void) {}
+	void end(void) {}
+	void handle(void) {}
+	int getCommand(void) const { return U_FLASH; }
+
+private:
+	THandlerFunction start;
+	THandlerFunction finish;
+	THandlerFunction_Progress progress;
+	THandlerFunction_Error error;
+};
+
+extern ArduinoOTAClass ArduinoOTA;
+
+#endif /* __SHIM_ARDUINOOTA_H__*/	/* 二重定義防止 */
+#define __SHIM_ARDUINOOTA_H__	/* 二重定義防止 */
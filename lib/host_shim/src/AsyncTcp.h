@@ -0,0 +1,10 @@
+// --------------------------------------------------------
+// Copyright (c) 2025 rapid4mifu 
+//
+// These codes are licensed under GPL v3.0
+// https://opensource.org/license/GPL-3.0
+// --------------------------------------------------------
+
+// AsyncTCP of the host shim (the "async_tcp" task lives in sim_net.cpp)
+
+#include "Arduino.h"
@@ -0,0 +1,289 @@
+// --------------------------------------------------------
+// Copyright (c) 2025 rapid4mifu 
+//
+// These codes are licensed under GPL v3.0
+// https://opensource.org/license/GPL-3.0
+// --------------------------------------------------------
+
+// ESPAsyncWebServer of the host shim (ESP32Async 3.x subset)
+//
+// the web socket clients are connected and fed by the test (sim.h), the
+// handlers run in the "async_tcp" task as on the target, every frame sent
+// to a client is recorded with the virtual time
+
+#ifndef __SHIM_ESPASYNCWEBSERVER_H__	/* 二重定義防止 */
+
+#include "Arduino.h"
+#include "FS.h"
+
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <vector>
+
+typedef enum {
+	HTTP_GET = 0b00000001,
+	HTTP_POST = 0b00000010,
+	HTTP_DELETE = 0b00000100,
+	HTTP_PUT = 0b00001000,
+	HTTP_PATCH = 0b00010000,
+	HTTP_HEAD = 0b00100000,
+	HTTP_OPTIONS = 0b01000000,
+	HTTP_ANY = 0b01111111
+} WebRequestMethod;
+typedef uint8_t WebRequestMethodComposite;
+
+typedef enum {
+	WS_EVT_CONNECT,
+	WS_EVT_DISCONNECT,
+	WS_EVT_PING,
+	WS_EVT_PONG,
+	WS_EVT_ERROR,
+	WS_EVT_DATA
+} AwsEventType;
+
+typedef enum {
+	WS_CONTINUATION,
+	WS_TEXT,
+	WS_BINARY,
+	WS_DISCONNECT = 0x08,
+	WS_PING,
+	WS_PONG
+} AwsFrameType;
+
+typedef enum {
+	WS_DISCONNECTED,
+	WS_CONNECTED,
+	WS_DISCONNECTING
+} AwsClientStatus;
+
+typedef struct {
+	uint8_t message_opcode;
+	uint32_t num;
+	uint8_t final;
+	uint8_t masked;
+	uint8_t opcode;
+	uint64_t len;
+	uint8_t mask[4];
+	uint64_t index;
+} AwsFrameInfo;
+
+typedef std::shared_ptr<std::vector<uint8_t>> AsyncWebSocketSharedBuffer;
+typedef std::function<size_t(uint8_t *, size_t, size_t)> AwsResponseFiller;
+typedef std::function<String(const String &)> AwsTemplateProcessor;
+
+class AsyncWebSocket;
+class AsyncWebServerRequest;
+
+class AsyncWebSocketMessageBuffer {
+public:
+	AsyncWebSocketMessageBuffer(const uint8_t * data, size_t size)
+		: buffer(std::make_shared<std::vector<uint8_t>>(data, data + size)) {}
+	uint8_t * get(void) { return buffer->data(); }
+	size_t length(void) const { return buffer->size(); }
+
+private:
+	AsyncWebSocketSharedBuffer buffer;
+	friend class AsyncWebSocket;
+};
+
+class AsyncWebSocketClient {
+public:
+	AsyncWebSocketClient(AsyncWebSocket * server, uint32_t id, size_t queueLimit)
+		: server(server), clientId(id), queueLimit(queueLimit) {}
+
+	uint32_t id(void) const { return clientId; }
+	AwsClientStatus status(void) const { return clientStatus; }
+	IPAddress remoteIP(void) const { return IPAddress(192, 168, 1, (uint8_t)(10 + clientId)); }
+	uint16_t remotePort(void) const { return (uint16_t)(50000 + clientId); }
+	size_t queueLen(void) const { return queued; }
+	bool queueIsFull(void) const { return queued >= queueLimit; }
+	bool canSend(void) const { return !queueIsFull(); }
+
+	bool text(const char * message, size_t len);
+	bool text(const char * message) { return text(message, strlen(message)); }
+	bool text(const String & message) { return text(message.c_str(), message.length()); }
+	bool text(AsyncWebSocketSharedBuffer buffer);
+	bool binary(const uint8_t * message, size_t len);
+	bool binary(AsyncWebSocketSharedBuffer buffer);
+
+	/* host side */
+	void setQueueLen(size_t len) { queued = len; }
+
+private:
+	AsyncWebSocket * server;
+	uint32_t clientId;
+	AwsClientStatus clientStatus = WS_CONNECTED;
+	size_t queueLimit;
+	size_t queued = 0;	// messages the network has not taken yet
+	bool send(bool binary, const uint8_t * data, size_t len);
+	friend class AsyncWebSocket;
+};
+
+typedef std::function<void(AsyncWebSocket *, AsyncWebSocketClient *, AwsEventType, void *, uint8_t *, size_t)> AwsEventHandler;
+
+class AsyncWebHandler {
+public:
+	virtual ~AsyncWebHandler() {}
+};
+
+class AsyncWebSocket : public AsyncWebHandler {
+public:
+	explicit AsyncWebSocket(const char * url);
+	~AsyncWebSocket();
+
+	const char * url(void) const { return wsUrl.c_str(); }
+	void onEvent(AwsEventHandler handler) { eventHandler = handler; }
+	size_t count(void) const;
+	AsyncWebSocketClient * client(uint32_t id);
+	void cleanupClients(uint16_t maxClients = 8) { (void)maxClients; }
+
+	AsyncWebSocketMessageBuffer * makeBuffer(size_t size = 0);
+	AsyncWebSocketMessageBuffer * makeBuffer(const uint8_t * data, size_t size);
+
+	bool text(uint32_t id, const char * message, size_t len);
+	bool text(uint32_t id, const char * message) { return text(id, message, strlen(message)); }
+	bool text(uint32_t id, const String & message) { return text(id, message.c_str(), message.length()); }
+	void textAll(const char * message, size_t len);
+	void textAll(const char * message) { textAll(message, strlen(message)); }
+	void textAll(const String & message) { textAll(message.c_str(), message.length()); }
+	bool binary(uint32_t id, const uint8_t * message, size_t len);
+	bool binary(uint32_t id, AsyncWebSocketMessageBuffer * buffer);
+	bool binary(uint32_t id, AsyncWebSocketSharedBuffer buffer);
+	void binaryAll(const uint8_t * message, size_t len);
+	void binaryAll(AsyncWebSocketMessageBuffer * buffer);
+	void binaryAll(AsyncWebSocketSharedBuffer buffer);
+
+	/* host side (in the async_tcp task) */
+	AsyncWebSocketClient * connect(size_t queueLimit);
+	void disconnect(uint32_t id);
+	void receive(uint32_t id, AwsFrameType opcode, const uint8_t * data, size_t len);
+
+private:
+	std::string wsUrl;
+	AwsEventHandler eventHandler;
+	std::vector<AsyncWebSocketClient *> clients;
+};
+
+class AsyncEventSource : public AsyncWebHandler {
+public:
+	explicit AsyncEventSource(const char * url) : esUrl(url) {}
+	size_t count(void) const { return 0; }
+	void send(const char * message, const char * event = NULL, uint32_t id = 0, uint32_t reconnect = 0)
+		{ (void)message; (void)event; (void)id; (void)reconnect; }
+
+private:
+	std::string esUrl;
+};
+
+class AsyncWebServerResponse {
+public:
+	AsyncWebServerResponse(int code, const String & contentType, size_t length)
+		: responseCode(code), type(contentType), contentLength(length) {}
+	virtual ~AsyncWebServerResponse() {}
+
+	void setCode(int code) { responseCode = code; }
+	int code(void) const { return responseCode; }
+	void addHeader(const char * name, const char * value) { headers.emplace_back(name, value); }
+	void addHeader(const char * name, const String & value) { headers.emplace_back(name, value.c_str()); }
+	void addHeader(const String & name, const String & value) { headers.emplace_back(name.c_str(), value.c_str()); }
+	const std::vector<std::pair<std::string, std::string>> & getHeaders(void) const { return headers; }
+	size_t length(void) const { return contentLength; }
+	virtual std::string body(void) { return std::string(); }
+
+protected:
+	int responseCode;
+	String type;
+	size_t contentLength;
+	std::vector<std::pair<std::string, std::string>> headers;
+};
+
+typedef std::function<void(AsyncWebServerRequest *)> ArRequestHandlerFunction;
+typedef std::function<void(AsyncWebServerRequest *, const String &, size_t, uint8_t *, size_t, bool)> ArUploadHandlerFunction;
+typedef std::function<void(AsyncWebServerRequest *, uint8_t *, size_t, size_t, size_t)> ArBodyHandlerFunction;
+
+class AsyncWebParameter {
+public:
+	AsyncWebParameter(const String & name, const String & value) : paramName(name), paramValue(value) {}
+	const String & name(void) const { return paramName; }
+	const String & value(void) const { return paramValue; }
+	size_t size(void) const { return paramValue.length(); }
+	bool isPost(void) const { return false; }
+	bool isFile(void) const { return false; }
+
+private:
+	String paramName;
+	String paramValue;
+};
+
+class AsyncWebServerRequest {
+public:
+	AsyncWebServerRequest(const String & url, WebRequestMethod method = HTTP_GET) : requestUrl(url), requestMethod(method) {}
+	~AsyncWebServerRequest();
+
+	const String & url(void) const { return requestUrl; }
+	WebRequestMethodComposite method(void) const { return requestMethod; }
+
+	size_t args(void) const { return requestParams.size(); }
+	size_t params(void) const { return requestParams.size(); }
+	const String & arg(size_t i) const { return requestParams[i].value(); }
+	const String & argName(size_t i) const { return requestParams[i].name(); }
+	bool hasArg(const char * name) const;
+	const AsyncWebParameter * getParam(size_t i) const { return &requestParams[i]; }
+	const AsyncWebParameter * getParam(const char * name) const;
+	bool hasHeader(const char * name) const;
+	String header(const char * name) const;
+
+	AsyncWebServerResponse * beginResponse(int code, const char * contentType = "", const char * content = "");
+	AsyncWebServerResponse * beginResponse(int code, const String & contentType, const String & content = String())
+		{ return beginResponse(code, contentType.c_str(), content.c_str()); }
+	AsyncWebServerResponse * beginResponse(int code, const char * contentType, const uint8_t * content, size_t len);
+	AsyncWebServerResponse * beginResponse(const char * contentType, size_t len, AwsResponseFiller callback);
+	AsyncWebServerResponse * beginResponse(const String & contentType, size_t len, AwsResponseFiller callback)
+		{ return beginResponse(contentType.c_str(), len, callback); }
+	AsyncWebServerResponse * beginResponse(File content, const String & path, const char * contentType = "", bool download = false);
+	AsyncWebServerResponse * beginResponse(File content, const String & path, const String & contentType, bool download = false)
+		{ return beginResponse(content, path, contentType.c_str(), download); }
+	void send(AsyncWebServerResponse * response);
+	void send(int code, const char * contentType = "", const char * content = "") { send(beginResponse(code, contentType, content)); }
+	void send(int code, const String & contentType, const String & content = String()) { send(beginResponse(code, contentType, content)); }
+
+	/* host side */
+	void addHeader(const char * name, const char * value) { requestHeaders.emplace_back(name, value); }
+	void addArg(const char * name, const char * value) { requestParams.emplace_back(String(name), String(value)); }
+	AsyncWebServerResponse * getResponse(void) { return response; }
+
+private:
+	String requestUrl;
+	WebRequestMethod requestMethod;
+	std::vector<AsyncWebParameter> requestParams;
+	std::vector<std::pair<std::string, std::string>> requestHeaders;
+	AsyncWebServerResponse * response = NULL;
+};
+
+class AsyncCallbackWebHandler : public AsyncWebHandler {};
+
+class AsyncWebServer {
+public:
+	explicit AsyncWebServer(uint16_t port) : port(port) {}
+
+	void begin(void) {}
+	void end(void) {}
+	AsyncWebHandler & addHandler(AsyncWebHandler * handler) { return *handler; }
+	void onNotFound(ArRequestHandlerFunction fn) { notFound = fn; }
+	AsyncCallbackWebHandler & on(const char * uri, WebRequestMethodComposite method, ArRequestHandlerFunction onRequest,
+		ArUploadHandlerFunction onUpload = nullptr, ArBodyHandlerFunction onBody = nullptr);
+
+	/* host side */
+	void handle(AsyncWebServerRequest * request);
+
+private:
+	uint16_t port;
+	ArRequestHandlerFunction notFound;
+	std::map<std::string, ArRequestHandlerFunction> routes;
+	std::vector<AsyncCallbackWebHandler *> handlers;
+};
+
+#endif /* __SHIM_ESPASYNCWEBSERVER_H__*/	/* 二重定義防止 */
+#define __SHIM_ESPASYNCWEBSERVER_H__	/* 二重定義防止 */
@@ -0,0 +1,24 @@
+// --------------------------------------------------------
+// Copyright (c) 2025 rapid4mifu 
+//
+// These codes are licensed under GPL v3.0
+// https://opensource.org/license/GPL-3.0
+// --------------------------------------------------------
+
+// mDNS responder of the host shim (nothing is announced)
+
+#ifndef __SHIM_ESPMDNS_H__	/* 二重定義防止 */
+
+#include "Arduino.h"
+
+class MDNSResponder {
+public:
+	bool begin(const char * hostName) { return (NULL != hostName) && ('\0' != *hostName); }
+	void end(void) {}
+	bool addService(const char * service, const char * proto, uint16_t port) { (void)service; (void)proto; (void)port; return true; }
+};
+
+extern MDNSResponder MDNS;
+
+#endif /* __SHIM_ESPMDNS_H__*/	/* 二重定義防止 */
+#define __SHIM_ESPMDNS_H__	/* 二重定義防止 */
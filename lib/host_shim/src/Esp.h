@@ -0,0 +1,30 @@
+// --------------------------------------------------------
+// Copyright (c) 2025 rapid4mifu 
+//
+// These codes are licensed under GPL v3.0
+// https://opensource.org/license/GPL-3.0
+// --------------------------------------------------------
+
+// Arduino EspClass of the host shim
+//  (the heap is a fixed size less the bytes allocated by the program)
+
+#ifndef __SHIM_ESP_H__	/* 二重定義防止 */
+
+#include <stdint.h>
+
+class EspClass {
+public:
+	uint32_t getHeapSize(void);
+	uint32_t getFreeHeap(void);
+	uint32_t getMinFreeHeap(void);
+	uint32_t getMaxAllocHeap(void);
+	uint32_t getFreeSketchSpace(void);
+	uint32_t getCpuFreqMHz(void);
+	const char * getSdkVersion(void);
+	void restart(void);
+};
+
+extern EspClass ESP;
+
+#endif /* __SHIM_ESP_H__*/	/* 二重定義防止 */
+#define __SHIM_ESP_H__	/* 二重定義防止 */
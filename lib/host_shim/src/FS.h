@@ -0,0 +1,74 @@
+// --------------------------------------------------------
+// Copyright (c) 2025 rapid4mifu 
+//
+// These codes are licensed under GPL v3.0
+// https://opensource.org/license/GPL-3.0
+// --------------------------------------------------------
+
+// Arduino file system of the host shim (files held in memory)
+
+#ifndef __SHIM_FS_H__	/* 二重定義防止 */
+
+#include "Arduino.h"
+
+#include <map>
+#include <memory>
+#include <string>
+
+#define FILE_READ "r"
+#define FILE_WRITE "w"
+#define FILE_APPEND "a"
+
+namespace fs {
+
+typedef std::shared_ptr<std::string> FileData;
+
+class File : public Stream {
+public:
+	File(void) {}
+	File(const std::string & path, FileData data) : filePath(path), fileData(data) {}
+
+	explicit operator bool(void) const { return (NULL != fileData); }
+	bool isDirectory(void) const { return false; }
+	const char * name(void) const { return filePath.c_str(); }
+	const char * path(void) const { return filePath.c_str(); }
+	size_t size(void) const { return (NULL != fileData) ? fileData->size() : 0; }
+	size_t position(void) const { return pos; }
+	bool seek(uint32_t position) { pos = (position < size()) ? position : size(); return true; }
+	void close(void) { fileData.reset(); }
+
+	int available(void) override { return (int)(size() - pos); }
+	int read(void) override { return (0 < available()) ? (uint8_t)(*fileData)[pos++] : -1; }
+	int peek(void) override { return (0 < available()) ? (uint8_t)(*fileData)[pos] : -1; }
+	size_t read(uint8_t * buf, size_t size);
+	size_t write(uint8_t c) override { return write(&c, 1); }
+	size_t write(const uint8_t * buf, size_t size) override;
+	using Print::write;
+
+private:
+	std::string filePath;
+	FileData fileData;
+	size_t pos = 0;
+};
+
+class FS {
+public:
+	File open(const char * path, const char * mode = FILE_READ, bool create = false);
+	File open(const String & path, const char * mode = FILE_READ, bool create = false) { return open(path.c_str(), mode, create); }
+	bool exists(const char * path);
+	bool exists(const String & path) { return exists(path.c_str()); }
+	bool remove(const char * path);
+	bool remove(const String & path) { return remove(path.c_str()); }
+
+protected:
+	bool mounted = false;
+	std::map<std::string, FileData> files;
+};
+
+}
+
+using fs::FS;
+using fs::File;
+
+#endif /* __SHIM_FS_H__*/	/* 二重定義防止 */
+#define __SHIM_FS_H__	/* 二重定義防止 */
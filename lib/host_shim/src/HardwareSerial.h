@@ -0,0 +1,45 @@
+// --------------------------------------------------------
+// Copyright (c) 2025 rapid4mifu 
+//
+// These codes are licensed under GPL v3.0
+// https://opensource.org/license/GPL-3.0
+// --------------------------------------------------------
+
+// Arduino HardwareSerial of the host shim
+//  (the output is kept for the test, the input is given by SIM_writeSerial)
+
+#ifndef __SHIM_HARDWARESERIAL_H__	/* 二重定義防止 */
+
+#include "Print.h"
+
+#include <deque>
+#include <string>
+
+class HardwareSerial : public Stream {
+public:
+	void begin(unsigned long baud) { (void)baud; }
+	void end(void) {}
+	operator bool(void) const { return true; }
+
+	int available(void) override { return (int)rx.size(); }
+	int read(void) override;
+	int peek(void) override { return rx.empty() ? -1 : (uint8_t)rx.front(); }
+	size_t write(uint8_t c) override;
+	size_t write(const uint8_t * buffer, size_t size) override;
+	using Print::write;
+
+	/* host side */
+	void inject(const char * text);
+	std::string take(void);
+	void setEcho(bool enable) { echo = enable; }
+
+private:
+	std::deque<char> rx;
+	std::string tx;
+	bool echo = false;
+};
+
+extern HardwareSerial Serial;
+
+#endif /* __SHIM_HARDWARESERIAL_H__*/	/* 二重定義防止 */
+#define __SHIM_HARDWARESERIAL_H__	/* 二重定義防止 */
@@ -0,0 +1,53 @@
+// --------------------------------------------------------
+// Copyright (c) 2025 rapid4mifu 
+//
+// These codes are licensed under GPL v3.0
+// https://opensource.org/license/GPL-3.0
+// --------------------------------------------------------
+
+// This software module is related to the Arduino IPAddress of the host shim
+
+#include "IPAddress.h"
+
+#include <stdio.h>
+
+// in the network byte order as lwIP keeps it (the first octet in the lowest byte)
+IPAddress::IPAddress(uint32_t address)
+{
+	for (int i = 0; i < 4; i++) {
+		addr[i] = (uint8_t)(address >> (8 * i));
+	}
+}
+
+IPAddress::operator uint32_t(void) const
+{
+	return (uint32_t)addr[0] | ((uint32_t)addr[1] << 8) | ((uint32_t)addr[2] << 16) | ((uint32_t)addr[3] << 24);
+}
+
+bool IPAddress::fromString(const char * address)
+{
+	unsigned int o[4];
+	char end;
+
+	if ((NULL == address) || (4 != sscanf(address, "%u.%u.%u.%u%c", &o[0], &o[1], &o[2], &o[3], &end))) {
+		return false;
+	}
+	for (int i = 0; i < 4; i++) {
+		if (255 < o[i]) {
+			return false;
+		}
+	}
+	for (int i = 0; i < 4; i++) {
+		addr[i] = (uint8_t)o[i];
+	}
+
+	return true;
+}
+
+String IPAddress::toString(void) const
+{
+	char buf[16];
+
+	snprintf(buf, sizeof(buf), "%u.%u.%u.%u", addr[0], addr[1], addr[2], addr[3]);
+	return String(buf);
+}
@@ -0,0 +1,39 @@
+// --------------------------------------------------------
+// Copyright (c) 2025 rapid4mifu 
+//
+// These codes are licensed under GPL v3.0
+// https://opensource.org/license/GPL-3.0
+// --------------------------------------------------------
+
+// Arduino IPAddress of the host shim (IPv4 only)
+
+#ifndef __SHIM_IPADDRESS_H__	/* 二重定義防止 */
+
+#include "WString.h"
+
+class IPAddress {
+public:
+	IPAddress(void) : addr{0, 0, 0, 0} {}
+	IPAddress(uint8_t o1, uint8_t o2, uint8_t o3, uint8_t o4) : addr{o1, o2, o3, o4} {}
+	IPAddress(uint32_t address);
+	IPAddress(const uint8_t * address) : addr{address[0], address[1], address[2], address[3]} {}
+	IPAddress(const char * address) : IPAddress() { fromString(address); }
+
+	bool fromString(const char * address);
+	bool fromString(const String & address) { return fromString(address.c_str()); }
+	String toString(void) const;
+
+	operator uint32_t(void) const;
+	bool operator==(const IPAddress & rhs) const { return (uint32_t)*this == (uint32_t)rhs; }
+	bool operator!=(const IPAddress & rhs) const { return !(*this == rhs); }
+	uint8_t operator[](int index) const { return addr[index]; }
+	uint8_t & operator[](int index) { return addr[index]; }
+
+private:
+	uint8_t addr[4];
+};
+
+#define INADDR_NONE IPAddress(0, 0, 0, 0)
+
+#endif /* __SHIM_IPADDRESS_H__*/	/* 二重定義防止 */
+#define __SHIM_IPADDRESS_H__	/* 二重定義防止 */
@@ -0,0 +1,36 @@
+// --------------------------------------------------------
+// Copyright (c) 2025 rapid4mifu 
+//
+// These codes are licensed under GPL v3.0
+// https://opensource.org/license/GPL-3.0
+// --------------------------------------------------------
+
+// LittleFS of the host shim (no partition unless the test formats one)
+
+#ifndef __SHIM_LITTLEFS_H__	/* 二重定義防止 */
+
+#include "FS.h"
+
+namespace fs {
+
+class LittleFSFS : public FS {
+public:
+	bool begin(bool formatOnFail = false, const char * basePath = "/littlefs", uint8_t maxOpenFiles = 10, const char * partitionLabel = "spiffs");
+	void end(void) { mounted = false; }
+	bool format(void);
+	size_t totalBytes(void) { return 0x160000; }
+	size_t usedBytes(void);
+
+	/* host side */
+	void addFile(const char * path, const std::string & data);
+
+private:
+	bool formatted = false;
+};
+
+}
+
+extern fs::LittleFSFS LittleFS;
+
+#endif /* __SHIM_LITTLEFS_H__*/	/* 二重定義防止 */
+#define __SHIM_LITTLEFS_H__	/* 二重定義防止 */
@@ -0,0 +1,47 @@
+// --------------------------------------------------------
+// Copyright (c) 2025 rapid4mifu 
+//
+// These codes are licensed under GPL v3.0
+// https://opensource.org/license/GPL-3.0
+// --------------------------------------------------------
+
+// Arduino Preferences of the host shim (the name spaces live in memory)
+
+#ifndef __SHIM_PREFERENCES_H__	/* 二重定義防止 */
+
+#include "Arduino.h"
+
+#include <string>
+
+class Preferences {
+public:
+	bool begin(const char * name, bool readOnly = false, const char * partition_label = NULL);
+	void end(void) { space.clear(); }
+	bool clear(void);
+	bool remove(const char * key);
+	bool isKey(const char * key);
+
+	size_t putBool(const char * key, bool value);
+	size_t putUChar(const char * key, uint8_t value);
+	size_t putUInt(const char * key, uint32_t value);
+	size_t putString(const char * key, const char * value);
+	size_t putString(const char * key, const String & value) { return putString(key, value.c_str()); }
+	size_t putBytes(const char * key, const void * value, size_t len);
+
+	bool getBool(const char * key, bool defaultValue = false);
+	uint8_t getUChar(const char * key, uint8_t defaultValue = 0);
+	uint32_t getUInt(const char * key, uint32_t defaultValue = 0);
+	String getString(const char * key, const String & defaultValue = String());
+	size_t getString(const char * key, char * value, size_t maxLen);
+	size_t getBytesLength(const char * key);
+	size_t getBytes(const char * key, void * buf, size_t maxLen);
+
+private:
+	std::string space;
+	bool readOnly = false;
+	size_t put(const char * key, const void * value, size_t len);
+	const std::string * get(const char * key);
+};
+
+#endif /* __SHIM_PREFERENCES_H__*/	/* 二重定義防止 */
+#define __SHIM_PREFERENCES_H__	/* 二重定義防止 */
@@ -0,0 +1,117 @@
+// --------------------------------------------------------
+// Copyright (c) 2025 rapid4mifu 
+//
+// These codes are licensed under GPL v3.0
+// https://opensource.org/license/GPL-3.0
+// --------------------------------------------------------
+
+// This software module is related to the Arduino Print and Stream of the host shim
+
+#include "Print.h"
+#include "IPAddress.h"
+
+#include <stdio.h>
+#include <vector>
+
+size_t Print::write(const uint8_t * buffer, size_t size)
+{
+	size_t n = 0;
+
+	while (n < size) {
+		if (0 == write(buffer[n])) {
+			break;
+		}
+		n++;
+	}
+
+	return n;
+}
+
+size_t Print::printf(const char * format, ...)
+{
+	va_list args;
+	size_t n;
+
+	va_start(args, format);
+	n = vprintf(format, args);
+	va_end(args);
+
+	return n;
+}
+
+size_t Print::vprintf(const char * format, va_list args)
+{
+	char buf[64];
+	va_list copy;
+	int len;
+
+	va_copy(copy, args);
+	len = vsnprintf(buf, sizeof(buf), format, copy);
+	va_end(copy);
+	if (0 > len) {
+		return 0;
+	}
+	if ((size_t)len < sizeof(buf)) {
+		return write((const uint8_t *)buf, len);
+	}
+
+	std::vector<char> temp(len + 1);
+	vsnprintf(temp.data(), temp.size(), format, args);
+	return write((const uint8_t *)temp.data(), len);
+}
+
+size_t Print::print(const __FlashStringHelper * str) { return print(reinterpret_cast<const char *>(str)); }
+size_t Print::print(const String & str) { return write((const uint8_t *)str.c_str(), str.length()); }
+size_t Print::print(const char * str) { return write(str); }
+size_t Print::print(char c) { return write((uint8_t)c); }
+size_t Print::print(unsigned char value, int base) { return print(String(value, (unsigned char)base)); }
+size_t Print::print(int value, int base) { return print(String(value, (unsigned char)base)); }
+size_t Print::print(unsigned int value, int base) { return print(String(value, (unsigned char)base)); }
+size_t Print::print(long value, int base) { return print(String(value, (unsigned char)base)); }
+size_t Print::print(unsigned long value, int base) { return print(String(value, (unsigned char)base)); }
+size_t Print::print(long long value, int base) { return print(String(value, (unsigned char)base)); }
+size_t Print::print(unsigned long long value, int base) { return print(String(value, (unsigned char)base)); }
+size_t Print::print(double value, int digits) { return print(String(value, (unsigned int)digits)); }
+size_t Print::print(const IPAddress & address) { return print(address.toString()); }
+
+size_t Print::println(void)
+{
+	return write((const uint8_t *)"\r\n", 2);
+}
+
+size_t Stream::readBytes(char * buffer, size_t length)
+{
+	size_t n = 0;
+
+	while ((n < length) && (0 < available())) {
+		buffer[n++] = (char)read();
+	}
+
+	return n;
+}
+
+String Stream::readString(void)
+{
+	String str;
+
+	while (0 < available()) {
+		str += (char)read();
+	}
+
+	return str;
+}
+
+String Stream::readStringUntil(char terminator)
+{
+	String str;
+
+	while (0 < available()) {
+		int c = read();
+		if (terminator == c) {
+			break;
+		}
+		str += (char)c;
+	}
+
+	return str;
+}
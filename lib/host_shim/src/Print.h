@@ -0,0 +1,78 @@
+// --------------------------------------------------------
+// Copyright (c) 2025 rapid4mifu 
+//
+// These codes are licensed under GPL v3.0
+// https://opensource.org/license/GPL-3.0
+// --------------------------------------------------------
+
+// Arduino Print and Stream of the host shim
+
+#ifndef __SHIM_PRINT_H__	/* 二重定義防止 */
+
+#include "WString.h"
+
+#include <string.h>
+
+#include <stdarg.h>
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+class IPAddress;
+
+class Print {
+public:
+	virtual ~Print() {}
+
+	virtual size_t write(uint8_t c) = 0;
+	virtual size_t write(const uint8_t * buffer, size_t size);
+	size_t write(const char * str) { return (NULL != str) ? write((const uint8_t *)str, strlen(str)) : 0; }
+	size_t write(const char * buffer, size_t size) { return write((const uint8_t *)buffer, size); }
+	virtual void flush(void) {}
+
+	size_t printf(const char * format, ...) __attribute__((format(printf, 2, 3)));
+	size_t vprintf(const char * format, va_list args);
+
+	size_t print(const __FlashStringHelper * str);
+	size_t print(const String & str);
+	size_t print(const char * str);
+	size_t print(char c);
+	size_t print(unsigned char value, int base = DEC);
+	size_t print(int value, int base = DEC);
+	size_t print(unsigned int value, int base = DEC);
+	size_t print(long value, int base = DEC);
+	size_t print(unsigned long value, int base = DEC);
+	size_t print(long long value, int base = DEC);
+	size_t print(unsigned long long value, int base = DEC);
+	size_t print(double value, int digits = 2);
+	size_t print(const IPAddress & address);
+
+	size_t println(void);
+	template <typename T>
+	size_t println(const T & value) { size_t n = print(value); return n + println(); }
+	template <typename T>
+	size_t println(const T & value, int format) { size_t n = print(value, format); return n + println(); }
+};
+
+class Stream : public Print {
+public:
+	virtual int available(void) = 0;
+	virtual int read(void) = 0;
+	virtual int peek(void) = 0;
+
+	void setTimeout(unsigned long timeout) { _timeout = timeout; }
+	unsigned long getTimeout(void) { return _timeout; }
+	size_t readBytes(char * buffer, size_t length);
+	size_t readBytes(uint8_t * buffer, size_t length) { return readBytes((char *)buffer, length); }
+	String readString(void);
+	String readStringUntil(char terminator);
+
+protected:
+	// the host streams never wait for more data (the virtual clock would stand still)
+	unsigned long _timeout = 1000;
+};
+
+#endif /* __SHIM_PRINT_H__*/	/* 二重定義防止 */
+#define __SHIM_PRINT_H__	/* 二重定義防止 */
@@ -0,0 +1,42 @@
+// --------------------------------------------------------
+// Copyright (c) 2025 rapid4mifu 
+//
+// These codes are licensed under GPL v3.0
+// https://opensource.org/license/GPL-3.0
+// --------------------------------------------------------
+
+// Arduino Update of the host shim (an image is taken and thrown away)
+
+#ifndef __SHIM_UPDATE_H__	/* 二重定義防止 */
+
+#include "Arduino.h"
+
+#include <functional>
+
+#define U_FLASH 0
+#define U_SPIFFS 100
+#define UPDATE_SIZE_UNKNOWN 0xFFFFFFFF
+
+class UpdateClass {
+public:
+	typedef std::function<void(size_t, size_t)> THandlerFunction_Progress;
+
+	bool setupCrypt(void) { return false; }
+	bool begin(size_t size = UPDATE_SIZE_UNKNOWN, int command = U_FLASH);
+	size_t write(uint8_t * data, size_t len);
+	bool end(bool evenIfRemaining = false);
+	bool hasError(void) const { return false; }
+	void printError(Print & out) { out.println("no error"); }
+	const char * errorString(void) const { return "No Error"; }
+	UpdateClass & onProgress(THandlerFunction_Progress fn) { progress = fn; return *this; }
+
+private:
+	size_t sizeImage = 0;
+	size_t sizeWritten = 0;
+	THandlerFunction_Progress progress;
+};
+
+extern UpdateClass Update;
+
+#endif /* __SHIM_UPDATE_H__*/	/* 二重定義防止 */
+#define __SHIM_UPDATE_H__	/* 二重定義防止 */
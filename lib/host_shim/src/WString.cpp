@@ -0,0 +1,279 @@
+// --------------------------------------------------------
+// Copyright (c) 2025 rapid4mifu 
+//
+// These codes are licensed under GPL v3.0
+// https://opensource.org/license/GPL-3.0
+// --------------------------------------------------------
+
+// This software module is related to the Arduino String of the host shim
+
+#include "WString.h"
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+static std::string sim_formatInteger(unsigned long long value, bool negative, unsigned char base);
+static std::string sim_formatFloat(double value, unsigned int decimalPlaces);
+
+std::string sim_formatInteger(unsigned long long value, bool negative, unsigned char base)
+{
+	char buf[72];
+	size_t pos = sizeof(buf);
+
+	if ((2 > base) || (36 < base)) {
+		base = 10;
+	}
+
+	buf[--pos] = '\0';
+	do {
+		uint8_t digit = value % base;
+		buf[--pos] = (10 > digit) ? ('0' + digit) : ('a' + digit - 10);
+		value /= base;
+	} while (0 != value);
+	if (negative) {
+		buf[--pos] = '-';
+	}
+
+	return std::string(&buf[pos]);
+}
+
+std::string sim_formatFloat(double value, unsigned int decimalPlaces)
+{
+	char buf[64];
+
+	snprintf(buf, sizeof(buf), "%.*f", (int)decimalPlaces, value);
+	return std::string(buf);
+}
+
+String::String(const char * cstr) : buffer((NULL != cstr) ? cstr : "") {}
+String::String(const char * cstr, unsigned int length) : buffer((NULL != cstr) ? cstr : "", (NULL != cstr) ? length : 0) {}
+String::String(const __FlashStringHelper * str) : buffer((NULL != str) ? reinterpret_cast<const char *>(str) : "") {}
+String::String(char c) : buffer(1, c) {}
+String::String(unsigned char value, unsigned char base) : buffer(sim_formatInteger(value, false, base)) {}
+String::String(int value, unsigned char base)
+	: buffer((10 == base) ? sim_formatInteger((value < 0) ? -(long long)value : value, value < 0, base) : sim_formatInteger((unsigned int)value, false, base)) {}
+String::String(unsigned int value, unsigned char base) : buffer(sim_formatInteger(value, false, base)) {}
+String::String(long value, unsigned char base)
+	: buffer((10 == base) ? sim_formatInteger((value < 0) ? -(long long)value : value, value < 0, base) : sim_formatInteger((unsigned long)value, false, base)) {}
+String::String(unsigned long value, unsigned char base) : buffer(sim_formatInteger(value, false, base)) {}
+String::String(long long value, unsigned char base)
+	: buffer((10 == base) ? sim_formatInteger((value < 0) ? -(unsigned long long)value : value, value < 0, base) : sim_formatInteger((unsigned long long)value, false, base)) {}
+String::String(unsigned long long value, unsigned char base) : buffer(sim_formatInteger(value, false, base)) {}
+String::String(float value, unsigned int decimalPlaces) : buffer(sim_formatFloat(value, decimalPlaces)) {}
+String::String(double value, unsigned int decimalPlaces) : buffer(sim_formatFloat(value, decimalPlaces)) {}
+
+String & String::operator=(const char * cstr)
+{
+	buffer = (NULL != cstr) ? cstr : "";
+	return *this;
+}
+
+bool String::reserve(unsigned int size)
+{
+	buffer.reserve(size);
+	return true;
+}
+
+bool String::concat(const String & str) { buffer += str.buffer; return true; }
+bool String::concat(const char * cstr) { if (NULL == cstr) return false; buffer += cstr; return true; }
+bool String::concat(const char * cstr, unsigned int length) { if (NULL == cstr) return false; buffer.append(cstr, length); return true; }
+bool String::concat(char c) { buffer += c; return true; }
+bool String::concat(unsigned char value) { return concat(String(value)); }
+bool String::concat(int value) { return concat(String(value)); }
+bool String::concat(unsigned int value) { return concat(String(value)); }
+bool String::concat(long value) { return concat(String(value)); }
+bool String::concat(unsigned long value) { return concat(String(value)); }
+bool String::concat(float value) { return concat(String(value)); }
+bool String::concat(double value) { return concat(String(value)); }
+
+int String::compareTo(const String & str) const
+{
+	return buffer.compare(str.buffer);
+}
+
+bool String::equalsIgnoreCase(const String & str) const
+{
+	return (buffer.size() == str.buffer.size()) && (0 == strcasecmp(buffer.c_str(), str.buffer.c_str()));
+}
+
+bool String::startsWith(const String & prefix) const
+{
+	return startsWith(prefix, 0);
+}
+
+bool String::startsWith(const String & prefix, unsigned int offset) const
+{
+	return (offset <= buffer.size()) && (0 == buffer.compare(offset, prefix.buffer.size(), prefix.buffer));
+}
+
+bool String::endsWith(const String & suffix) const
+{
+	return (suffix.buffer.size() <= buffer.size())
+		&& (0 == buffer.compare(buffer.size() - suffix.buffer.size(), suffix.buffer.size(), suffix.buffer));
+}
+
+void String::getBytes(unsigned char * buf, unsigned int bufsize, unsigned int index) const
+{
+	size_t len;
+
+	if ((NULL == buf) || (0 == bufsize)) {
+		return;
+	}
+	if (index >= buffer.size()) {
+		buf[0] = '\0';
+		return;
+	}
+
+	len = buffer.size() - index;
+	if (len > bufsize - 1) {
+		len = bufsize - 1;
+	}
+	memcpy(buf, buffer.c_str() + index, len);
+	buf[len] = '\0';
+}
+
+int String::indexOf(char ch, unsigned int fromIndex) const
+{
+	size_t pos = buffer.find(ch, fromIndex);
+	return (std::string::npos != pos) ? (int)pos : -1;
+}
+
+int String::indexOf(const String & str, unsigned int fromIndex) const
+{
+	size_t pos = buffer.find(str.buffer, fromIndex);
+	return (std::string::npos != pos) ? (int)pos : -1;
+}
+
+int String::lastIndexOf(char ch) const
+{
+	size_t pos = buffer.rfind(ch);
+	return (std::string::npos != pos) ? (int)pos : -1;
+}
+
+int String::lastIndexOf(char ch, unsigned int fromIndex) const
+{
+	size_t pos = buffer.rfind(ch, fromIndex);
+	return (std::string::npos != pos) ? (int)pos : -1;
+}
+
+int String::lastIndexOf(const String & str) const
+{
+	size_t pos = buffer.rfind(str.buffer);
+	return (std::string::npos != pos) ? (int)pos : -1;
+}
+
+int String::lastIndexOf(const String & str, unsigned int fromIndex) const
+{
+	size_t pos = buffer.rfind(str.buffer, fromIndex);
+	return (std::string::npos != pos) ? (int)pos : -1;
+}
+
+String String::substring(unsigned int beginIndex) const
+{
+	return substring(beginIndex, (unsigned int)buffer.size());
+}
+
+String String::substring(unsigned int beginIndex, unsigned int endIndex) const
+{
+	if (beginIndex > endIndex) {
+		unsigned int temp = endIndex;
+		endIndex = beginIndex;
+		beginIndex = temp;
+	}
+	if (beginIndex >= buffer.size()) {
+		return String();
+	}
+	if (endIndex > buffer.size()) {
+		endIndex = (unsigned int)buffer.size();
+	}
+
+	return String(buffer.c_str() + beginIndex, endIndex - beginIndex);
+}
+
+void String::replace(char find, char replace)
+{
+	for (char & c : buffer) {
+		if (c == find) {
+			c = replace;
+		}
+	}
+}
+
+void String::replace(const String & find, const String & replace)
+{
+	size_t pos = 0;
+
+	if (find.buffer.empty()) {
+		return;
+	}
+	while (std::string::npos != (pos = buffer.find(find.buffer, pos))) {
+		buffer.replace(pos, find.buffer.size(), replace.buffer);
+		pos += replace.buffer.size();
+	}
+}
+
+void String::remove(unsigned int index)
+{
+	if (index < buffer.size()) {
+		buffer.erase(index);
+	}
+}
+
+void String::remove(unsigned int index, unsigned int count)
+{
+	if (index < buffer.size()) {
+		buffer.erase(index, count);
+	}
+}
+
+void String::toLowerCase(void)
+{
+	for (char & c : buffer) {
+		c = tolower((unsigned char)c);
+	}
+}
+
+void String::toUpperCase(void)
+{
+	for (char & c : buffer) {
+		c = toupper((unsigned char)c);
+	}
+}
+
+void String::trim(void)
+{
+	size_t begin = buffer.find_first_not_of(" \t\r\n\f\v");
+
+	if (std::string::npos == begin) {
+		buffer.clear();
+		return;
+	}
+	buffer = buffer.substr(begin, buffer.find_last_not_of(" \t\r\n\f\v") - begin + 1);
+}
+
+long String::toInt(void) const
+{
+	return atol(buffer.c_str());
+}
+
+float String::toFloat(void) const
+{
+	return (float)atof(buffer.c_str());
+}
+
+double String::toDouble(void) const
+{
+	return atof(buffer.c_str());
+}
+
+String operator+(const String & lhs, const String & rhs) { String s(lhs); s.concat(rhs); return s; }
+String operator+(const String & lhs, const char * rhs) { String s(lhs); s.concat(rhs); return s; }
+String operator+(const char * lhs, const String & rhs) { String s(lhs); s.concat(rhs); return s; }
+String operator+(const String & lhs, char rhs) { String s(lhs); s.concat(rhs); return s; }
+String operator+(const String & lhs, int rhs) { String s(lhs); s.concat(rhs); return s; }
+String operator+(const String & lhs, unsigned int rhs) { String s(lhs); s.concat(rhs); return s; }
+String operator+(const String & lhs, long rhs) { String s(lhs); s.concat(rhs); return s; }
+String operator+(const String & lhs, unsigned long rhs) { String s(lhs); s.concat(rhs); return s; }
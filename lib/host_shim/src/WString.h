@@ -0,0 +1,126 @@
+// --------------------------------------------------------
+// Copyright (c) 2025 rapid4mifu 
+//
+// These codes are licensed under GPL v3.0
+// https://opensource.org/license/GPL-3.0
+// --------------------------------------------------------
+
+// Arduino String of the host shim (on std::string)
+
+#ifndef __SHIM_WSTRING_H__	/* 二重定義防止 */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string>
+
+class __FlashStringHelper;
+#define F(string_literal) (reinterpret_cast<const __FlashStringHelper *>(string_literal))
+
+class String {
+public:
+	String(const char * cstr = "");
+	String(const char * cstr, unsigned int length);
+	String(const String & str) = default;
+	String(String && str) = default;
+	String(const __FlashStringHelper * str);
+	explicit String(char c);
+	explicit String(unsigned char value, unsigned char base = 10);
+	explicit String(int value, unsigned char base = 10);
+	explicit String(unsigned int value, unsigned char base = 10);
+	explicit String(long value, unsigned char base = 10);
+	explicit String(unsigned long value, unsigned char base = 10);
+	explicit String(long long value, unsigned char base = 10);
+	explicit String(unsigned long long value, unsigned char base = 10);
+	explicit String(float value, unsigned int decimalPlaces = 2);
+	explicit String(double value, unsigned int decimalPlaces = 2);
+
+	String & operator=(const String & rhs) = default;
+	String & operator=(String && rhs) = default;
+	String & operator=(const char * cstr);
+
+	bool reserve(unsigned int size);
+	unsigned int length(void) const { return (unsigned int)buffer.size(); }
+	bool isEmpty(void) const { return buffer.empty(); }
+	const char * c_str(void) const { return buffer.c_str(); }
+	char * begin(void) { return &buffer[0]; }
+	char * end(void) { return &buffer[0] + buffer.size(); }
+	const char * begin(void) const { return buffer.c_str(); }
+	const char * end(void) const { return buffer.c_str() + buffer.size(); }
+
+	bool concat(const String & str);
+	bool concat(const char * cstr);
+	bool concat(const char * cstr, unsigned int length);
+	bool concat(char c);
+	bool concat(unsigned char value);
+	bool concat(int value);
+	bool concat(unsigned int value);
+	bool concat(long value);
+	bool concat(unsigned long value);
+	bool concat(float value);
+	bool concat(double value);
+
+	template <typename T>
+	String & operator+=(const T & rhs) { concat(rhs); return *this; }
+
+	int compareTo(const String & str) const;
+	bool equals(const String & str) const { return buffer == str.buffer; }
+	bool equals(const char * cstr) const { return buffer == ((NULL != cstr) ? cstr : ""); }
+	bool equalsIgnoreCase(const String & str) const;
+	bool operator==(const String & rhs) const { return equals(rhs); }
+	bool operator==(const char * cstr) const { return equals(cstr); }
+	bool operator!=(const String & rhs) const { return !equals(rhs); }
+	bool operator!=(const char * cstr) const { return !equals(cstr); }
+	bool operator<(const String & rhs) const { return 0 > compareTo(rhs); }
+	bool operator>(const String & rhs) const { return 0 < compareTo(rhs); }
+	explicit operator bool(void) const { return true; }
+
+	bool startsWith(const String & prefix) const;
+	bool startsWith(const String & prefix, unsigned int offset) const;
+	bool endsWith(const String & suffix) const;
+
+	char charAt(unsigned int index) const { return (index < buffer.size()) ? buffer[index] : '\0'; }
+	void setCharAt(unsigned int index, char c) { if (index < buffer.size()) buffer[index] = c; }
+	char operator[](unsigned int index) const { return charAt(index); }
+	char & operator[](unsigned int index) { return buffer[index]; }
+	void getBytes(unsigned char * buf, unsigned int bufsize, unsigned int index = 0) const;
+	void toCharArray(char * buf, unsigned int bufsize, unsigned int index = 0) const
+		{ getBytes((unsigned char *)buf, bufsize, index); }
+
+	int indexOf(char ch, unsigned int fromIndex = 0) const;
+	int indexOf(const String & str, unsigned int fromIndex = 0) const;
+	int lastIndexOf(char ch) const;
+	int lastIndexOf(char ch, unsigned int fromIndex) const;
+	int lastIndexOf(const String & str) const;
+	int lastIndexOf(const String & str, unsigned int fromIndex) const;
+	String substring(unsigned int beginIndex) const;
+	String substring(unsigned int beginIndex, unsigned int endIndex) const;
+
+	void replace(char find, char replace);
+	void replace(const String & find, const String & replace);
+	void remove(unsigned int index);
+	void remove(unsigned int index, unsigned int count);
+	void toLowerCase(void);
+	void toUpperCase(void);
+	void trim(void);
+
+	long toInt(void) const;
+	float toFloat(void) const;
+	double toDouble(void) const;
+
+private:
+	std::string buffer;
+};
+
+String operator+(const String & lhs, const String & rhs);
+String operator+(const String & lhs, const char * rhs);
+String operator+(const char * lhs, const String & rhs);
+String operator+(const String & lhs, char rhs);
+String operator+(const String & lhs, int rhs);
+String operator+(const String & lhs, unsigned int rhs);
+String operator+(const String & lhs, long rhs);
+String operator+(const String & lhs, unsigned long rhs);
+inline bool operator==(const char * lhs, const String & rhs) { return rhs.equals(lhs); }
+inline bool operator!=(const char * lhs, const String & rhs) { return !rhs.equals(lhs); }
+
+#endif /* __SHIM_WSTRING_H__*/	/* 二重定義防止 */
+#define __SHIM_WSTRING_H__	/* 二重定義防止 */
@@ -0,0 +1,100 @@
+// --------------------------------------------------------
+// Copyright (c) 2025 rapid4mifu 
+//
+// These codes are licensed under GPL v3.0
+// https://opensource.org/license/GPL-3.0
+// --------------------------------------------------------
+
+// Arduino WiFi of the host shim
+//
+// the station connects when the test makes the access point available
+// (SIM_setWiFiStatus), the events are delivered by the "arduino_events"
+// task as on the target
+
+#ifndef __SHIM_WIFI_H__	/* 二重定義防止 */
+
+#include "Arduino.h"
+
+#include <functional>
+
+typedef enum {
+	WIFI_OFF = 0,
+	WIFI_STA,
+	WIFI_AP,
+	WIFI_AP_STA
+} WiFiMode_t;
+
+typedef enum {
+	WL_NO_SHIELD = 255,
+	WL_IDLE_STATUS = 0,
+	WL_NO_SSID_AVAIL,
+	WL_SCAN_COMPLETED,
+	WL_CONNECTED,
+	WL_CONNECT_FAILED,
+	WL_CONNECTION_LOST,
+	WL_DISCONNECTED
+} wl_status_t;
+
+typedef enum {
+	ARDUINO_EVENT_NONE = 0,
+	ARDUINO_EVENT_WIFI_READY,
+	ARDUINO_EVENT_WIFI_SCAN_DONE,
+	ARDUINO_EVENT_WIFI_STA_START,
+	ARDUINO_EVENT_WIFI_STA_STOP,
+	ARDUINO_EVENT_WIFI_STA_CONNECTED,
+	ARDUINO_EVENT_WIFI_STA_DISCONNECTED,
+	ARDUINO_EVENT_WIFI_STA_AUTHMODE_CHANGE,
+	ARDUINO_EVENT_WIFI_STA_GOT_IP,
+	ARDUINO_EVENT_WIFI_STA_GOT_IP6,
+	ARDUINO_EVENT_WIFI_STA_LOST_IP,
+	ARDUINO_EVENT_WIFI_AP_START,
+	ARDUINO_EVENT_WIFI_AP_STOP,
+	ARDUINO_EVENT_WIFI_AP_STACONNECTED,
+	ARDUINO_EVENT_WIFI_AP_STADISCONNECTED,
+	ARDUINO_EVENT_WIFI_AP_STAIPASSIGNED,
+	ARDUINO_EVENT_WIFI_AP_PROBEREQRECVED,
+	ARDUINO_EVENT_WIFI_AP_GOT_IP6,
+	ARDUINO_EVENT_MAX
+} arduino_event_id_t;
+
+typedef arduino_event_id_t WiFiEvent_t;
+typedef void (*WiFiEventCb)(arduino_event_id_t event);
+typedef size_t wifi_event_id_t;
+
+class WiFiClass {
+public:
+	bool mode(WiFiMode_t mode);
+	WiFiMode_t getMode(void) { return wifiMode; }
+	wl_status_t begin(void);
+	wl_status_t begin(const char * ssid, const char * passphrase = NULL);
+	bool config(IPAddress local_ip, IPAddress gateway, IPAddress subnet);
+	bool disconnect(bool wifioff = false);
+	wl_status_t status(void) { return wifiStatus; }
+	String SSID(void) { return String(ssid.c_str()); }
+	int8_t RSSI(void) { return (WL_CONNECTED == wifiStatus) ? -50 : 0; }
+	IPAddress localIP(void) { return (WL_CONNECTED == wifiStatus) ? ipLocal : IPAddress(); }
+	bool softAP(const char * ssid, const char * passphrase = NULL);
+	bool softAPConfig(IPAddress local_ip, IPAddress gateway, IPAddress subnet);
+	IPAddress softAPIP(void) { return ipLocal; }
+	wifi_event_id_t onEvent(WiFiEventCb cbEvent);
+
+	/* host side */
+	void setAccessPoint(bool available);
+	void postEvent(arduino_event_id_t event);
+
+private:
+	WiFiMode_t wifiMode = WIFI_OFF;
+	wl_status_t wifiStatus = WL_DISCONNECTED;
+	bool started = false;
+	bool available = false;
+	std::string ssid;
+	IPAddress ipLocal = IPAddress(192, 168, 1, 100);
+	std::vector<WiFiEventCb> handlers;
+
+	void connect(void);
+};
+
+extern WiFiClass WiFi;
+
+#endif /* __SHIM_WIFI_H__*/	/* 二重定義防止 */
+#define __SHIM_WIFI_H__	/* 二重定義防止 */
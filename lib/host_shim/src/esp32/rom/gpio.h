@@ -0,0 +1,17 @@
+// --------------------------------------------------------
+// Copyright (c) 2025 rapid4mifu 
+//
+// These codes are licensed under GPL v3.0
+// https://opensource.org/license/GPL-3.0
+// --------------------------------------------------------
+
+// GPIO matrix of the host shim (SIG_GPIO_OUT_IDX takes the pin from the LEDC)
+
+#ifndef __SHIM_ROM_GPIO_H__	/* 二重定義防止 */
+
+#include <stdint.h>
+
+void gpio_matrix_out(uint32_t gpio, uint32_t signal_idx, bool out_inv, bool oen_inv);
+
+#endif /* __SHIM_ROM_GPIO_H__*/	/* 二重定義防止 */
+#define __SHIM_ROM_GPIO_H__	/* 二重定義防止 */
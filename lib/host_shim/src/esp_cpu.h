@@ -0,0 +1,19 @@
+// --------------------------------------------------------
+// Copyright (c) 2025 rapid4mifu 
+//
+// These codes are licensed under GPL v3.0
+// https://opensource.org/license/GPL-3.0
+// --------------------------------------------------------
+
+// CPU cycle counter of the host shim (virtual time at 240 MHz)
+
+#ifndef __SHIM_ESP_CPU_H__	/* 二重定義防止 */
+
+#include <stdint.h>
+
+typedef uint32_t esp_cpu_cycle_count_t;
+
+esp_cpu_cycle_count_t esp_cpu_get_cycle_count(void);
+
+#endif /* __SHIM_ESP_CPU_H__*/	/* 二重定義防止 */
+#define __SHIM_ESP_CPU_H__	/* 二重定義防止 */
@@ -0,0 +1,192 @@
+// --------------------------------------------------------
+// Copyright (c) 2025 rapid4mifu 
+//
+// These codes are licensed under GPL v3.0
+// https://opensource.org/license/GPL-3.0
+// --------------------------------------------------------
+
+// FreeRTOS API of the host shim (tasks, notifications, queues, semaphores, timers)
+//
+// every task is a host thread, but only one of them runs at a time: the
+// scheduler hands the CPU to the highest priority ready task (round robin
+// among equal priorities) and a task keeps it until it blocks, yields or
+// readies a task of a higher priority, as on a single core with preemption
+//
+// the tick count follows a virtual clock which only advances while every
+// task is blocked, so the code runs in zero virtual time and a run is
+// reproducible from the same inputs (see sim.h)
+
+#ifndef __SHIM_FREERTOS_H__	/* 二重定義防止 */
+
+#include <stdint.h>
+#include <stddef.h>
+
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint32_t StackType_t;
+// names of the older kernels
+#define portTickType TickType_t
+#define xTaskHandle TaskHandle_t
+
+typedef struct sim_task * TaskHandle_t;
+typedef struct sim_queue * QueueHandle_t;
+typedef struct sim_queue * SemaphoreHandle_t;
+typedef struct sim_timer * TimerHandle_t;
+
+typedef void (*TaskFunction_t)(void *);
+typedef void (*TimerCallbackFunction_t)(TimerHandle_t);
+
+#define pdFALSE (0)
+#define pdTRUE (1)
+#define pdFAIL (0)
+#define pdPASS (1)
+#define errQUEUE_EMPTY (0)
+#define errQUEUE_FULL (0)
+
+#define configTICK_RATE_HZ (1000)
+#define configMAX_PRIORITIES (25)
+#define configMINIMAL_STACK_SIZE (768)
+#define configMAX_TASK_NAME_LEN (16)
+#define configTIMER_TASK_PRIORITY (1)
+#define configGENERATE_RUN_TIME_STATS (1)
+// the tasks share a single (virtual) core
+#define configNUMBER_OF_CORES (1)
+#define portNUM_PROCESSORS (1)
+
+#define portMAX_DELAY ((TickType_t)0xFFFFFFFFUL)
+#define portTICK_PERIOD_MS ((TickType_t)1000 / configTICK_RATE_HZ)
+#define pdMS_TO_TICKS(ms) ((TickType_t)(((uint64_t)(ms) * configTICK_RATE_HZ) / 1000))
+#define pdTICKS_TO_MS(ticks) ((TickType_t)(((uint64_t)(ticks) * 1000) / configTICK_RATE_HZ))
+
+#define tskIDLE_PRIORITY ((UBaseType_t)0)
+#define tskNO_AFFINITY (0x7FFFFFFF)
+
+// interrupts only run between the tasks, a critical section has nothing to exclude
+typedef struct {
+	uint32_t owner;
+	uint32_t count;
+} portMUX_TYPE;
+#define portMUX_INITIALIZER_UNLOCKED {0, 0}
+#define portENTER_CRITICAL(mux) do { (void)(mux); } while (0)
+#define portEXIT_CRITICAL(mux) do { (void)(mux); } while (0)
+#define portENTER_CRITICAL_ISR(mux) do { (void)(mux); } while (0)
+#define portEXIT_CRITICAL_ISR(mux) do { (void)(mux); } while (0)
+#define taskENTER_CRITICAL(mux) portENTER_CRITICAL(mux)
+#define taskEXIT_CRITICAL(mux) portEXIT_CRITICAL(mux)
+// the scheduler picks the next task when the interrupt returns
+#define portYIELD_FROM_ISR(woken) do { (void)(woken); } while (0)
+#define taskYIELD() vPortYield()
+
+typedef enum {
+	eNoAction = 0,
+	eSetBits,
+	eIncrement,
+	eSetValueWithOverwrite,
+	eSetValueWithoutOverwrite
+} eNotifyAction;
+
+typedef enum {
+	eRunning = 0,
+	eReady,
+	eBlocked,
+	eSuspended,
+	eDeleted,
+	eInvalid
+} eTaskState;
+
+typedef struct {
+	TaskHandle_t xHandle;
+	const char * pcTaskName;
+	UBaseType_t xTaskNumber;
+	eTaskState eCurrentState;
+	UBaseType_t uxCurrentPriority;
+	UBaseType_t uxBasePriority;
+	uint32_t ulRunTimeCounter;	// host time spent in the task [us]
+	StackType_t * pxStackBase;
+	uint32_t usStackHighWaterMark;
+	BaseType_t xCoreID;
+} TaskStatus_t;
+
+/* tasks */
+BaseType_t xTaskCreate(TaskFunction_t pxTaskCode, const char * pcName, uint32_t usStackDepth,
+	void * pvParameters, UBaseType_t uxPriority, TaskHandle_t * pxCreatedTask);
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t pxTaskCode, const char * pcName, uint32_t usStackDepth,
+	void * pvParameters, UBaseType_t uxPriority, TaskHandle_t * pxCreatedTask, BaseType_t xCoreID);
+BaseType_t xTaskCreateUniversal(TaskFunction_t pxTaskCode, const char * pcName, uint32_t usStackDepth,
+	void * pvParameters, UBaseType_t uxPriority, TaskHandle_t * pxCreatedTask, BaseType_t xCoreID);
+void vTaskDelete(TaskHandle_t xTask);
+void vTaskDelay(TickType_t xTicksToDelay);
+void vTaskDelayUntil(TickType_t * pxPreviousWakeTime, TickType_t xTimeIncrement);
+BaseType_t xTaskDelayUntil(TickType_t * pxPreviousWakeTime, TickType_t xTimeIncrement);
+void vTaskSuspend(TaskHandle_t xTask);
+void vTaskResume(TaskHandle_t xTask);
+void vTaskPrioritySet(TaskHandle_t xTask, UBaseType_t uxNewPriority);
+UBaseType_t uxTaskPriorityGet(TaskHandle_t xTask);
+TaskHandle_t xTaskGetCurrentTaskHandle(void);
+const char * pcTaskGetName(TaskHandle_t xTask);
+eTaskState eTaskGetState(TaskHandle_t xTask);
+TickType_t xTaskGetTickCount(void);
+TickType_t xTaskGetTickCountFromISR(void);
+UBaseType_t uxTaskGetNumberOfTasks(void);
+UBaseType_t uxTaskGetSystemState(TaskStatus_t * pxTaskStatusArray, UBaseType_t uxArraySize, uint32_t * pulTotalRunTime);
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t xTask);
+void vTaskList(char * pcWriteBuffer);
+void vPortYield(void);
+
+/* task notifications */
+BaseType_t xTaskNotify(TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction);
+BaseType_t xTaskNotifyFromISR(TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction,
+	BaseType_t * pxHigherPriorityTaskWoken);
+BaseType_t xTaskNotifyWait(uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit,
+	uint32_t * pulNotificationValue, TickType_t xTicksToWait);
+BaseType_t xTaskNotifyGive(TaskHandle_t xTaskToNotify);
+void vTaskNotifyGiveFromISR(TaskHandle_t xTaskToNotify, BaseType_t * pxHigherPriorityTaskWoken);
+uint32_t ulTaskNotifyTake(BaseType_t xClearCountOnExit, TickType_t xTicksToWait);
+BaseType_t xTaskNotifyStateClear(TaskHandle_t xTask);
+
+/* queues */
+QueueHandle_t xQueueCreate(UBaseType_t uxQueueLength, UBaseType_t uxItemSize);
+void vQueueDelete(QueueHandle_t xQueue);
+BaseType_t xQueueSend(QueueHandle_t xQueue, const void * pvItemToQueue, TickType_t xTicksToWait);
+BaseType_t xQueueSendToBack(QueueHandle_t xQueue, const void * pvItemToQueue, TickType_t xTicksToWait);
+BaseType_t xQueueSendToFront(QueueHandle_t xQueue, const void * pvItemToQueue, TickType_t xTicksToWait);
+BaseType_t xQueueSendFromISR(QueueHandle_t xQueue, const void * pvItemToQueue, BaseType_t * pxHigherPriorityTaskWoken);
+BaseType_t xQueueSendToBackFromISR(QueueHandle_t xQueue, const void * pvItemToQueue, BaseType_t * pxHigherPriorityTaskWoken);
+BaseType_t xQueueOverwrite(QueueHandle_t xQueue, const void * pvItemToQueue);
+BaseType_t xQueueReceive(QueueHandle_t xQueue, void * pvBuffer, TickType_t xTicksToWait);
+BaseType_t xQueueReceiveFromISR(QueueHandle_t xQueue, void * pvBuffer, BaseType_t * pxHigherPriorityTaskWoken);
+BaseType_t xQueuePeek(QueueHandle_t xQueue, void * pvBuffer, TickType_t xTicksToWait);
+BaseType_t xQueueReset(QueueHandle_t xQueue);
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t xQueue);
+UBaseType_t uxQueueSpacesAvailable(QueueHandle_t xQueue);
+
+/* semaphores (queues without items, no priority inheritance) */
+SemaphoreHandle_t xSemaphoreCreateMutex(void);
+SemaphoreHandle_t xSemaphoreCreateBinary(void);
+SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t uxMaxCount, UBaseType_t uxInitialCount);
+void vSemaphoreDelete(SemaphoreHandle_t xSemaphore);
+BaseType_t xSemaphoreTake(SemaphoreHandle_t xSemaphore, TickType_t xTicksToWait);
+BaseType_t xSemaphoreGive(SemaphoreHandle_t xSemaphore);
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t xSemaphore, BaseType_t * pxHigherPriorityTaskWoken);
+
+/* software timers (callbacks run in the timer service task) */
+TimerHandle_t xTimerCreate(const char * pcTimerName, TickType_t xTimerPeriodInTicks, UBaseType_t uxAutoReload,
+	void * pvTimerID, TimerCallbackFunction_t pxCallbackFunction);
+BaseType_t xTimerStart(TimerHandle_t xTimer, TickType_t xTicksToWait);
+BaseType_t xTimerStop(TimerHandle_t xTimer, TickType_t xTicksToWait);
+BaseType_t xTimerReset(TimerHandle_t xTimer, TickType_t xTicksToWait);
+BaseType_t xTimerChangePeriod(TimerHandle_t xTimer, TickType_t xNewPeriod, TickType_t xTicksToWait);
+BaseType_t xTimerDelete(TimerHandle_t xTimer, TickType_t xTicksToWait);
+BaseType_t xTimerStartFromISR(TimerHandle_t xTimer, BaseType_t * pxHigherPriorityTaskWoken);
+BaseType_t xTimerStopFromISR(TimerHandle_t xTimer, BaseType_t * pxHigherPriorityTaskWoken);
+BaseType_t xTimerResetFromISR(TimerHandle_t xTimer, BaseType_t * pxHigherPriorityTaskWoken);
+BaseType_t xTimerIsTimerActive(TimerHandle_t xTimer);
+TickType_t xTimerGetPeriod(TimerHandle_t xTimer);
+TickType_t xTimerGetExpiryTime(TimerHandle_t xTimer);
+void * pvTimerGetTimerID(TimerHandle_t xTimer);
+void vTimerSetTimerID(TimerHandle_t xTimer, void * pvNewID);
+const char * pcTimerGetName(TimerHandle_t xTimer);
+
+#endif /* __SHIM_FREERTOS_H__*/	/* 二重定義防止 */
+#define __SHIM_FREERTOS_H__	/* 二重定義防止 */
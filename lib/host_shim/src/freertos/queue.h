@@ -0,0 +1,10 @@
+// --------------------------------------------------------
+// Copyright (c) 2025 rapid4mifu 
+//
+// These codes are licensed under GPL v3.0
+// https://opensource.org/license/GPL-3.0
+// --------------------------------------------------------
+
+// FreeRTOS queue API of the host shim (see FreeRTOS.h)
+
+#include "freertos/FreeRTOS.h"
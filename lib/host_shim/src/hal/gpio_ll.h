@@ -0,0 +1,25 @@
+// --------------------------------------------------------
+// Copyright (c) 2025 rapid4mifu 
+//
+// These codes are licensed under GPL v3.0
+// https://opensource.org/license/GPL-3.0
+// --------------------------------------------------------
+
+// GPIO low level access of the host shim
+
+#ifndef __SHIM_GPIO_LL_H__	/* 二重定義防止 */
+
+#include <stdint.h>
+
+typedef int gpio_num_t;
+
+typedef struct {
+	uint32_t out;
+} gpio_dev_t;
+
+extern gpio_dev_t GPIO;
+
+void gpio_ll_set_level(gpio_dev_t * hw, gpio_num_t gpio_num, uint32_t level);
+
+#endif /* __SHIM_GPIO_LL_H__*/	/* 二重定義防止 */
+#define __SHIM_GPIO_LL_H__	/* 二重定義防止 */
@@ -0,0 +1,107 @@
+// --------------------------------------------------------
+// Copyright (c) 2025 rapid4mifu 
+//
+// These codes are licensed under GPL v3.0
+// https://opensource.org/license/GPL-3.0
+// --------------------------------------------------------
+
+// This header file is related to the control of the host shim
+//
+// the caller of these functions is the "loopTask" task (the test main), the
+// virtual clock only advances while it blocks, in SIM_runFor/SIM_runUntil
+// or any blocking FreeRTOS call, so a test is a sequence of inputs and runs
+//
+// the pins, the analog inputs, the serial port and the web socket clients
+// are driven from here as the hardware and the browser would, at once or
+// by a script of steps at their virtual time, and the outputs of the
+// firmware are recorded on a timeline
+
+#ifndef __SIM_H__	/* 二重定義防止 */
+
+#include <Arduino.h>
+#include <WiFi.h>
+
+#include <functional>
+#include <string>
+#include <vector>
+
+typedef struct {
+	UBaseType_t priority;
+	uint64_t run_ns;		// host time spent in the task [ns]
+	uint32_t wakeups;		// blocked -> ready
+	uint32_t switches;		// switched in
+} sim_task_stats_t;
+
+typedef enum {
+	SIM_TL_PIN = 0,			// function of a pin changed (source : pin, value : sim_pin_func_t)
+	SIM_TL_DUTY,			// duty of a pin changed (source : pin, value : duty, see SIM_getPinDuty)
+	SIM_TL_RGB,				// colour of the RGB LED changed (source : pin, value : 0xRRGGBB)
+	SIM_TL_WS_TX			// frame sent to a client (source : client id, value : 1 -> binary, data : payload)
+} sim_tl_kind_t;
+
+typedef enum {
+	SIM_PIN_INPUT = 0,		// input (an output is Hi-Z)
+	SIM_PIN_GPIO,			// GPIO output register
+	SIM_PIN_LEDC			// LEDC (PWM)
+} sim_pin_func_t;
+
+typedef struct {
+	uint64_t time;			// virtual time [us]
+	sim_tl_kind_t kind;
+	uint32_t source;
+	uint32_t value;
+	std::string data;
+} sim_tl_event_t;
+
+/* clock */
+void SIM_runFor(uint64_t us);
+void SIM_runUntil(uint64_t time);
+uint64_t SIM_getTime(void);
+void SIM_setTickCount(TickType_t ticks);
+uint32_t SIM_addEvent(uint64_t time, uint64_t period, std::function<void()> isr);
+void SIM_removeEvent(uint32_t id);
+
+/* script (a step runs at its time as an interrupt, before the tasks it wakes) */
+void SIM_at(uint64_t time, std::function<void()> step);
+void SIM_pressPin(uint64_t time, uint8_t pin, uint8_t active, uint64_t duration, uint32_t bounces = 0);
+
+/* timeline */
+void SIM_recordTimeline(bool record);
+std::vector<sim_tl_event_t> SIM_takeTimeline(void);
+
+/* tasks */
+bool SIM_getTaskStats(const char * name, sim_task_stats_t * stats);
+void SIM_clearTaskStats(void);
+uint64_t SIM_getIsrTime(void);
+
+/* pins */
+void SIM_setPin(uint8_t pin, uint8_t level);
+uint8_t SIM_getPin(uint8_t pin);
+uint32_t SIM_getPinDuty(uint8_t pin);
+void SIM_setAnalog(uint8_t pin, uint16_t mv);
+uint32_t SIM_getRgb(uint8_t pin);
+void SIM_setTemperature(float celsius);
+
+/* serial port */
+void SIM_writeSerial(const char * text);
+std::string SIM_readSerial(void);
+void SIM_echoSerial(bool echo);
+
+/* heap */
+uint64_t SIM_getAllocCount(void);
+size_t SIM_getAllocBytes(void);
+
+/* network */
+void SIM_setWiFiStatus(bool connected);
+void SIM_postWiFiEvent(arduino_event_id_t event);
+uint32_t SIM_connectWs(size_t queueLimit = 8);
+void SIM_disconnectWs(uint32_t id);
+void SIM_setWsQueueLen(uint32_t id, size_t len);
+void SIM_receiveWsText(uint32_t id, const std::string & text);
+void SIM_receiveWsBinary(uint32_t id, const uint8_t * data, size_t len);
+
+/* system */
+bool SIM_isRestarted(void);
+
+#endif /* __SIM_H__*/	/* 二重定義防止 */
+#define __SIM_H__	/* 二重定義防止 */
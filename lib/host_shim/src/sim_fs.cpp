@@ -0,0 +1,256 @@
+// --------------------------------------------------------
+// Copyright (c) 2025 rapid4mifu 
+//
+// These codes are licensed under GPL v3.0
+// https://opensource.org/license/GPL-3.0
+// --------------------------------------------------------
+
+// This software module is related to the storage of the host shim
+//  (LittleFS, Preferences, Update and ArduinoOTA)
+
+#include "ArduinoOTA.h"
+#include "LittleFS.h"
+#include "Preferences.h"
+#include "Update.h"
+
+#include <map>
+
+static std::map<std::string, std::map<std::string, std::string>> nvs;
+
+fs::LittleFSFS LittleFS;
+UpdateClass Update;
+ArduinoOTAClass ArduinoOTA;
+
+/* file system */
+
+size_t fs::File::read(uint8_t * buf, size_t size)
+{
+	size_t len = (size_t)available();
+
+	if (len > size) {
+		len = size;
+	}
+	if (0 < len) {
+		memcpy(buf, fileData->data() + pos, len);
+		pos += len;
+	}
+	return len;
+}
+
+size_t fs::File::write(const uint8_t * buf, size_t size)
+{
+	if (NULL == fileData) {
+		return 0;
+	}
+	fileData->replace(pos, size, (const char *)buf, size);
+	pos += size;
+	return size;
+}
+
+fs::File fs::FS::open(const char * path, const char * mode, bool create)
+{
+	auto it = files.find(path);
+
+	if (!mounted) {
+		return File();
+	}
+	if ('r' == mode[0]) {
+		return (files.end() != it) ? File(path, it->second) : File();
+	}
+
+	(void)create;
+	if ((files.end() == it) || ('w' == mode[0])) {
+		files[path] = std::make_shared<std::string>();
+	}
+	File file(path, files[path]);
+	file.seek((uint32_t)file.size());
+	return file;
+}
+
+bool fs::FS::exists(const char * path)
+{
+	return mounted && (files.end() != files.find(path));
+}
+
+bool fs::FS::remove(const char * path)
+{
+	return mounted && (0 < files.erase(path));
+}
+
+// a partition exists once the test has put a file in it
+bool fs::LittleFSFS::begin(bool formatOnFail, const char * basePath, uint8_t maxOpenFiles, const char * partitionLabel)
+{
+	(void)basePath;
+	(void)maxOpenFiles;
+	(void)partitionLabel;
+	if (!formatted && formatOnFail) {
+		formatted = true;
+	}
+	mounted = formatted;
+	return mounted;
+}
+
+bool fs::LittleFSFS::format(void)
+{
+	files.clear();
+	formatted = true;
+	return true;
+}
+
+size_t fs::LittleFSFS::usedBytes(void)
+{
+	size_t used = 0;
+
+	for (const auto & file : files) {
+		used += file.second->size();
+	}
+	return used;
+}
+
+void fs::LittleFSFS::addFile(const char * path, const std::string & data)
+{
+	formatted = true;
+	files[path] = std::make_shared<std::string>(data);
+}
+
+/* preferences */
+
+bool Preferences::begin(const char * name, bool readOnly, const char * partition_label)
+{
+	(void)partition_label;
+	if ((NULL == name) || ('\0' == *name)) {
+		return false;
+	}
+	space = name;
+	this->readOnly = readOnly;
+	return true;
+}
+
+bool Preferences::clear(void)
+{
+	if (space.empty() || readOnly) {
+		return false;
+	}
+	nvs[space].clear();
+	return true;
+}
+
+bool Preferences::remove(const char * key)
+{
+	if (space.empty() || readOnly) {
+		return false;
+	}
+	return (0 < nvs[space].erase(key));
+}
+
+bool Preferences::isKey(const char * key)
+{
+	return (NULL != get(key));
+}
+
+size_t Preferences::put(const char * key, const void * value, size_t len)
+{
+	if (space.empty() || readOnly) {
+		return 0;
+	}
+	nvs[space][key] = std::string((const char *)value, len);
+	return len;
+}
+
+const std::string * Preferences::get(const char * key)
+{
+	if (space.empty()) {
+		return NULL;
+	}
+
+	auto & entries = nvs[space];
+	auto it = entries.find(key);
+	return (entries.end() != it) ? &it->second : NULL;
+}
+
+size_t Preferences::putBool(const char * key, bool value) { uint8_t v = value ? 1 : 0; return put(key, &v, sizeof(v)); }
+size_t Preferences::putUChar(const char * key, uint8_t value) { return put(key, &value, sizeof(value)); }
+size_t Preferences::putUInt(const char * key, uint32_t value) { return put(key, &value, sizeof(value)); }
+size_t Preferences::putString(const char * key, const char * value) { return put(key, value, strlen(value)); }
+size_t Preferences::putBytes(const char * key, const void * value, size_t len) { return put(key, value, len); }
+
+bool Preferences::getBool(const char * key, bool defaultValue)
+{
+	return (0 != getUChar(key, defaultValue ? 1 : 0));
+}
+
+uint8_t Preferences::getUChar(const char * key, uint8_t defaultValue)
+{
+	const std::string * value = get(key);
+	return ((NULL != value) && (sizeof(uint8_t) == value->size())) ? (uint8_t)(*value)[0] : defaultValue;
+}
+
+uint32_t Preferences::getUInt(const char * key, uint32_t defaultValue)
+{
+	const std::string * value = get(key);
+	uint32_t v = defaultValue;
+
+	if ((NULL != value) && (sizeof(v) == value->size())) {
+		memcpy(&v, value->data(), sizeof(v));
+	}
+	return v;
+}
+
+String Preferences::getString(const char * key, const String & defaultValue)
+{
+	const std::string * value = get(key);
+	return (NULL != value) ? String(value->c_str(), (unsigned int)value->size()) : defaultValue;
+}
+
+size_t Preferences::getString(const char * key, char * value, size_t maxLen)
+{
+	const std::string * stored = get(key);
+
+	if ((NULL == stored) || (stored->size() >= maxLen)) {
+		return 0;
+	}
+	memcpy(value, stored->c_str(), stored->size() + 1);
+	return stored->size() + 1;
+}
+
+size_t Preferences::getBytesLength(const char * key)
+{
+	const std::string * value = get(key);
+	return (NULL != value) ? value->size() : 0;
+}
+
+size_t Preferences::getBytes(const char * key, void * buf, size_t maxLen)
+{
+	const std::string * value = get(key);
+
+	if ((NULL == value) || (value->size() > maxLen)) {
+		return 0;
+	}
+	memcpy(buf, value->data(), value->size());
+	return value->size();
+}
+
+/* update */
+
+bool UpdateClass::begin(size_t size, int command)
+{
+	(void)command;
+	sizeImage = size;
+	sizeWritten = 0;
+	return true;
+}
+
+size_t UpdateClass::write(uint8_t * data, size_t len)
+{
+	(void)data;
+	sizeWritten += len;
+	if (progress) {
+		progress(sizeWritten, sizeImage);
+	}
+	return len;
+}
+
+bool UpdateClass::end(bool evenIfRemaining)
+{
+	return evenIfRemaining || (sizeWritten == sizeImage);
+}
@@ -0,0 +1,707 @@
+// --------------------------------------------------------
+// Copyright (c) 2025 rapid4mifu 
+//
+// These codes are licensed under GPL v3.0
+// https://opensource.org/license/GPL-3.0
+// --------------------------------------------------------
+
+// This software module is related to the hardware of the host shim
+//  (GPIO, LEDC, ADC, hardware timers, serial port, heap, chip)
+
+#include "Arduino.h"
+#include "esp_cpu.h"
+#include "hal/gpio_ll.h"
+#include "esp32/rom/gpio.h"
+#include "soc/gpio_sig_map.h"
+#include "sim.h"
+#include "sim_kernel.h"
+
+#include <atomic>
+#include <new>
+
+#define SIM_NUM_PINS (40)
+#define SIM_HEAP_SIZE (320 * 1024)
+#define SIM_CPU_FREQ_MHZ (240)
+#define SIM_ADC_MAX_MV (3300)
+#define SIM_ADC_RESOLUTION (4095)
+// the allocation header keeps the size (and the alignment of new)
+#define SIM_HEAP_HEADER (16)
+
+typedef struct {
+	uint8_t mode;
+	uint8_t outLevel;		// GPIO output register
+	bool driven;			// the input is driven by the test
+	uint8_t inLevel;
+	bool ledc;				// attached to the LEDC
+	bool matrixGpio;		// routed to the GPIO output register (SIG_GPIO_OUT_IDX)
+	uint8_t resolution;
+	uint32_t duty;
+	uint32_t rgb;
+	uint16_t mv;			// analog input [mV]
+	uint8_t tracedFunc;		// last recorded on the timeline
+	uint32_t tracedDuty;
+	int isrMode;
+	void (*isr)(void *);
+	void * isrArg;
+} sim_pin_t;
+
+struct sim_hw_timer {
+	uint32_t frequency;
+	uint64_t alarm;
+	bool autoReload;
+	void (*isr)(void);
+	uint32_t event;			// 0 -> stopped
+};
+
+typedef struct {
+	std::vector<uint8_t> pins;
+	uint32_t conversions;
+	uint32_t frequency;
+	void (*isr)(void);
+	uint32_t event;
+	std::vector<adc_continuous_data_t> result;
+} sim_adc_t;
+
+static sim_pin_t pins[SIM_NUM_PINS];
+static sim_adc_t adc;
+static float temperature = 40.0f;
+static bool restarted = false;
+static std::atomic<uint64_t> cntAlloc(0);
+static std::atomic<size_t> bytesInUse(0);
+static std::atomic<size_t> bytesPeak(0);
+
+HardwareSerial Serial;
+EspClass ESP;
+gpio_dev_t GPIO;
+
+static sim_pin_t * sim_getPin(uint8_t pin);
+static uint8_t sim_readPin(const sim_pin_t * p);
+static uint8_t sim_getPinFunc(const sim_pin_t * p);
+static void sim_tracePin(uint8_t pin);
+static void sim_convertAdc(void);
+static void sim_interruptPin(sim_pin_t * p, uint8_t previous);
+
+sim_pin_t * sim_getPin(uint8_t pin)
+{
+	if (SIM_NUM_PINS <= pin) {
+		sim_fatal("GPIO%u does not exist", pin);
+	}
+	return &pins[pin];
+}
+
+// undriven inputs read the pull of the pin mode, the board pulls the rest up
+uint8_t sim_readPin(const sim_pin_t * p)
+{
+	if ((OUTPUT & p->mode) == OUTPUT) {
+		return p->outLevel;
+	}
+	if (p->driven) {
+		return p->inLevel;
+	}
+	return (INPUT_PULLDOWN == p->mode) ? LOW : HIGH;
+}
+
+uint8_t sim_getPinFunc(const sim_pin_t * p)
+{
+	if (p->ledc && !p->matrixGpio) {
+		return SIM_PIN_LEDC;
+	}
+	if ((OUTPUT & p->mode) == OUTPUT) {
+		return SIM_PIN_GPIO;
+	}
+	return SIM_PIN_INPUT;
+}
+
+// a change of the function or the duty of an output goes on the timeline
+void sim_tracePin(uint8_t pin)
+{
+	sim_pin_t * p = sim_getPin(pin);
+	uint8_t func = sim_getPinFunc(p);
+	uint32_t duty = SIM_getPinDuty(pin);
+
+	if (func != p->tracedFunc) {
+		p->tracedFunc = func;
+		sim_record(SIM_TL_PIN, pin, func, NULL, 0);
+	}
+	if (duty != p->tracedDuty) {
+		p->tracedDuty = duty;
+		sim_record(SIM_TL_DUTY, pin, duty, NULL, 0);
+	}
+}
+
+void sim_interruptPin(sim_pin_t * p, uint8_t previous)
+{
+	uint8_t level = sim_readPin(p);
+	bool fire = false;
+
+	if (NULL == p->isr) {
+		return;
+	}
+	switch (p->isrMode) {
+	case RISING:
+		fire = (LOW == previous) && (HIGH == level);
+		break;
+	case FALLING:
+		fire = (HIGH == previous) && (LOW == level);
+		break;
+	case CHANGE:
+		fire = (previous != level);
+		break;
+	case ONLOW:
+		fire = (LOW == level);
+		break;
+	case ONHIGH:
+		fire = (HIGH == level);
+		break;
+	default:
+		break;
+	}
+
+	if (fire) {
+		sim_runIsr([p] { p->isr(p->isrArg); });
+	}
+}
+
+/* time */
+
+unsigned long millis(void)
+{
+	return (unsigned long)(sim_getNow() / 1000);
+}
+
+unsigned long micros(void)
+{
+	return (unsigned long)sim_getNow();
+}
+
+void delay(uint32_t ms)
+{
+	vTaskDelay(pdMS_TO_TICKS(ms));
+}
+
+// the code takes no virtual time, a busy wait has nothing to wait for
+void delayMicroseconds(uint32_t us)
+{
+	(void)us;
+}
+
+void yield(void)
+{
+	vPortYield();
+}
+
+/* GPIO */
+
+void pinMode(uint8_t pin, uint8_t mode)
+{
+	sim_pin_t * p = sim_getPin(pin);
+
+	p->mode = mode;
+	p->ledc = false;
+	p->matrixGpio = ((OUTPUT & mode) == OUTPUT);
+	sim_tracePin(pin);
+}
+
+void digitalWrite(uint8_t pin, uint8_t val)
+{
+	sim_getPin(pin)->outLevel = (LOW != val) ? HIGH : LOW;
+	sim_tracePin(pin);
+}
+
+int digitalRead(uint8_t pin)
+{
+	return sim_readPin(sim_getPin(pin));
+}
+
+void attachInterrupt(uint8_t pin, void (*handler)(void), int mode)
+{
+	attachInterruptArg(pin, (void (*)(void *))handler, NULL, mode);
+}
+
+void attachInterruptArg(uint8_t pin, void (*handler)(void *), void * arg, int mode)
+{
+	sim_pin_t * p = sim_getPin(pin);
+
+	p->isr = handler;
+	p->isrArg = arg;
+	p->isrMode = mode;
+}
+
+void detachInterrupt(uint8_t pin)
+{
+	sim_getPin(pin)->isr = NULL;
+}
+
+void gpio_ll_set_level(gpio_dev_t * hw, gpio_num_t gpio_num, uint32_t level)
+{
+	(void)hw;
+	sim_getPin((uint8_t)gpio_num)->outLevel = level ? HIGH : LOW;
+	sim_tracePin((uint8_t)gpio_num);
+}
+
+void gpio_matrix_out(uint32_t gpio, uint32_t signal_idx, bool out_inv, bool oen_inv)
+{
+	(void)out_inv;
+	(void)oen_inv;
+	if (SIG_GPIO_OUT_IDX == signal_idx) {
+		sim_getPin((uint8_t)gpio)->matrixGpio = true;
+		sim_tracePin((uint8_t)gpio);
+	}
+}
+
+/* LEDC */
+
+bool ledcAttach(uint8_t pin, uint32_t freq, uint8_t resolution)
+{
+	sim_pin_t * p = sim_getPin(pin);
+
+	(void)freq;
+	p->mode = OUTPUT;
+	p->ledc = true;
+	p->matrixGpio = false;
+	p->resolution = resolution;
+	p->duty = 0;
+	sim_tracePin(pin);
+
+	return true;
+}
+
+bool ledcWrite(uint8_t pin, uint32_t duty)
+{
+	sim_pin_t * p = sim_getPin(pin);
+
+	if (!p->ledc) {
+		return false;
+	}
+	p->duty = duty;
+	sim_tracePin(pin);
+	return true;
+}
+
+uint32_t ledcRead(uint8_t pin)
+{
+	return sim_getPin(pin)->duty;
+}
+
+bool ledcDetach(uint8_t pin)
+{
+	sim_pin_t * p = sim_getPin(pin);
+
+	if (!p->ledc) {
+		return false;
+	}
+	p->ledc = false;
+	sim_tracePin(pin);
+	return true;
+}
+
+void rgbLedWrite(uint8_t pin, uint8_t red_val, uint8_t green_val, uint8_t blue_val)
+{
+	sim_pin_t * p = sim_getPin(pin);
+	uint32_t rgb = ((uint32_t)red_val << 16) | ((uint32_t)green_val << 8) | blue_val;
+
+	if (rgb != p->rgb) {
+		p->rgb = rgb;
+		sim_record(SIM_TL_RGB, pin, rgb, NULL, 0);
+	}
+}
+
+/* ADC */
+
+uint16_t analogRead(uint8_t pin)
+{
+	return (uint16_t)((uint32_t)sim_getPin(pin)->mv * SIM_ADC_RESOLUTION / SIM_ADC_MAX_MV);
+}
+
+uint32_t analogReadMilliVolts(uint8_t pin)
+{
+	return sim_getPin(pin)->mv;
+}
+
+bool analogContinuous(const uint8_t pins_[], size_t pins_count, uint32_t conversions_per_pin,
+	uint32_t sampling_freq_hz, void (*userFunc)(void))
+{
+	if ((0 == pins_count) || (0 == conversions_per_pin) || (0 == sampling_freq_hz)) {
+		return false;
+	}
+
+	adc.pins.assign(pins_, pins_ + pins_count);
+	adc.conversions = conversions_per_pin;
+	adc.frequency = sampling_freq_hz;
+	adc.isr = userFunc;
+	adc.result.assign(pins_count, adc_continuous_data_t());
+	for (size_t i = 0; i < pins_count; i++) {
+		adc.result[i].pin = pins_[i];
+		adc.result[i].channel = (uint8_t)i;
+	}
+
+	return true;
+}
+
+// a frame of conversions is complete
+void sim_convertAdc(void)
+{
+	for (adc_continuous_data_t & result : adc.result) {
+		result.avg_read_mvolts = sim_getPin(result.pin)->mv;
+		result.avg_read_raw = (int)((uint32_t)result.avg_read_mvolts * SIM_ADC_RESOLUTION / SIM_ADC_MAX_MV);
+	}
+	if (NULL != adc.isr) {
+		adc.isr();
+	}
+}
+
+bool analogContinuousRead(adc_continuous_data_t ** buffer, uint32_t timeout_ms)
+{
+	(void)timeout_ms;
+	if (adc.result.empty()) {
+		return false;
+	}
+	*buffer = adc.result.data();
+	return true;
+}
+
+bool analogContinuousStart(void)
+{
+	uint64_t period;
+
+	if (adc.pins.empty()) {
+		return false;
+	}
+	if (0 != adc.event) {
+		return true;
+	}
+
+	period = (uint64_t)adc.conversions * adc.pins.size() * 1000000 / adc.frequency;
+	adc.event = sim_addEvent(sim_getNow() + period, period, sim_convertAdc);
+	return true;
+}
+
+bool analogContinuousStop(void)
+{
+	if (0 != adc.event) {
+		sim_removeEvent(adc.event);
+		adc.event = 0;
+	}
+	return true;
+}
+
+bool analogContinuousDeinit(void)
+{
+	analogContinuousStop();
+	adc.pins.clear();
+	adc.result.clear();
+	return true;
+}
+
+/* hardware timer */
+
+hw_timer_t * timerBegin(uint32_t frequency)
+{
+	hw_timer_t * timer = new hw_timer_t();
+
+	timer->frequency = frequency;
+	return timer;
+}
+
+void timerEnd(hw_timer_t * timer)
+{
+	timerStop(timer);
+	delete timer;
+}
+
+void timerStart(hw_timer_t * timer)
+{
+	uint64_t period;
+
+	if ((0 != timer->event) || (0 == timer->alarm) || (NULL == timer->isr)) {
+		return;
+	}
+
+	period = timer->alarm * 1000000 / timer->frequency;
+	timer->event = sim_addEvent(sim_getNow() + period, timer->autoReload ? period : 0, [timer] {
+		if (!timer->autoReload) {
+			timer->event = 0;
+		}
+		timer->isr();
+	});
+}
+
+void timerStop(hw_timer_t * timer)
+{
+	if (0 != timer->event) {
+		sim_removeEvent(timer->event);
+		timer->event = 0;
+	}
+}
+
+void timerRestart(hw_timer_t * timer)
+{
+	timerStop(timer);
+	timerStart(timer);
+}
+
+void timerAttachInterrupt(hw_timer_t * timer, void (*userFunc)(void))
+{
+	timer->isr = userFunc;
+}
+
+void timerDetachInterrupt(hw_timer_t * timer)
+{
+	timerStop(timer);
+	timer->isr = NULL;
+}
+
+void timerAlarm(hw_timer_t * timer, uint64_t alarm_value, bool autoreload, uint64_t reload_count)
+{
+	(void)reload_count;
+	timer->alarm = alarm_value;
+	timer->autoReload = autoreload;
+}
+
+/* chip */
+
+float temperatureRead(void)
+{
+	return temperature;
+}
+
+uint32_t getCpuFrequencyMhz(void)
+{
+	return SIM_CPU_FREQ_MHZ;
+}
+
+bool psramFound(void)
+{
+	return false;
+}
+
+void * heap_caps_malloc(size_t size, uint32_t caps)
+{
+	(void)caps;
+	return malloc(size);
+}
+
+void heap_caps_free(void * ptr)
+{
+	free(ptr);
+}
+
+esp_cpu_cycle_count_t esp_cpu_get_cycle_count(void)
+{
+	return (esp_cpu_cycle_count_t)(sim_getNow() * SIM_CPU_FREQ_MHZ);
+}
+
+uint32_t EspClass::getHeapSize(void) { return SIM_HEAP_SIZE; }
+uint32_t EspClass::getFreeHeap(void) { return SIM_HEAP_SIZE - (uint32_t)bytesInUse.load(); }
+uint32_t EspClass::getMinFreeHeap(void) { return SIM_HEAP_SIZE - (uint32_t)bytesPeak.load(); }
+uint32_t EspClass::getMaxAllocHeap(void) { return getFreeHeap(); }
+uint32_t EspClass::getFreeSketchSpace(void) { return 0x1E0000; }
+uint32_t EspClass::getCpuFreqMHz(void) { return SIM_CPU_FREQ_MHZ; }
+const char * EspClass::getSdkVersion(void) { return "host"; }
+
+// the task that restarts the chip stops, the test sees SIM_isRestarted
+void EspClass::restart(void)
+{
+	restarted = true;
+	vTaskSuspend(NULL);
+}
+
+/* serial port */
+
+int HardwareSerial::read(void)
+{
+	int c;
+
+	if (rx.empty()) {
+		return -1;
+	}
+	c = (uint8_t)rx.front();
+	rx.pop_front();
+	return c;
+}
+
+size_t HardwareSerial::write(uint8_t c)
+{
+	return write(&c, 1);
+}
+
+size_t HardwareSerial::write(const uint8_t * buffer, size_t size)
+{
+	tx.append((const char *)buffer, size);
+	if (echo) {
+		fwrite(buffer, 1, size, stdout);
+	}
+	return size;
+}
+
+void HardwareSerial::inject(const char * text)
+{
+	while ('\0' != *text) {
+		rx.push_back(*text++);
+	}
+}
+
+std::string HardwareSerial::take(void)
+{
+	std::string text;
+
+	text.swap(tx);
+	return text;
+}
+
+/* heap (every new and delete of the program) */
+
+void * operator new(size_t size)
+{
+	uint8_t * block = (uint8_t *)malloc(size + SIM_HEAP_HEADER);
+	size_t used;
+
+	if (NULL == block) {
+		throw std::bad_alloc();
+	}
+	*(size_t *)block = size;
+	cntAlloc++;
+	used = (bytesInUse += size);
+	if (bytesPeak.load() < used) {
+		bytesPeak = used;
+	}
+
+	return block + SIM_HEAP_HEADER;
+}
+
+void * operator new[](size_t size)
+{
+	return operator new(size);
+}
+
+void * operator new(size_t size, const std::nothrow_t &) noexcept
+{
+	try {
+		return operator new(size);
+	} catch (...) {
+		return NULL;
+	}
+}
+
+void * operator new[](size_t size, const std::nothrow_t &) noexcept
+{
+	return operator new(size, std::nothrow);
+}
+
+void operator delete(void * ptr) noexcept
+{
+	uint8_t * block;
+
+	if (NULL == ptr) {
+		return;
+	}
+	block = (uint8_t *)ptr - SIM_HEAP_HEADER;
+	bytesInUse -= *(size_t *)block;
+	free(block);
+}
+
+void operator delete[](void * ptr) noexcept
+{
+	operator delete(ptr);
+}
+
+void operator delete(void * ptr, size_t size) noexcept
+{
+	(void)size;
+	operator delete(ptr);
+}
+
+void operator delete[](void * ptr, size_t size) noexcept
+{
+	(void)size;
+	operator delete(ptr);
+}
+
+/* control of the simulation (sim.h) */
+
+uint32_t SIM_addEvent(uint64_t time, uint64_t period, std::function<void()> isr)
+{
+	return sim_addEvent(time, period, isr);
+}
+
+void SIM_removeEvent(uint32_t id)
+{
+	sim_removeEvent(id);
+}
+
+// an edge runs the pin interrupt at once, the tasks it readies run after it
+void SIM_setPin(uint8_t pin, uint8_t level)
+{
+	sim_pin_t * p = sim_getPin(pin);
+	uint8_t previous = sim_readPin(p);
+
+	p->driven = true;
+	p->inLevel = (LOW != level) ? HIGH : LOW;
+	sim_interruptPin(p, previous);
+	sim_preempt();
+}
+
+uint8_t SIM_getPin(uint8_t pin)
+{
+	return sim_readPin(sim_getPin(pin));
+}
+
+// duty at the resolution of the LEDC (a GPIO level is 0 or full scale,
+// an input is 0)
+uint32_t SIM_getPinDuty(uint8_t pin)
+{
+	sim_pin_t * p = sim_getPin(pin);
+
+	if (p->ledc && !p->matrixGpio) {
+		return p->duty;
+	}
+	if (p->matrixGpio && (HIGH == p->outLevel)) {
+		return (1UL << p->resolution);
+	}
+	return 0;
+}
+
+uint32_t SIM_getRgb(uint8_t pin)
+{
+	return sim_getPin(pin)->rgb;
+}
+
+void SIM_setAnalog(uint8_t pin, uint16_t mv)
+{
+	sim_getPin(pin)->mv = mv;
+}
+
+void SIM_setTemperature(float celsius)
+{
+	temperature = celsius;
+}
+
+void SIM_writeSerial(const char * text)
+{
+	Serial.inject(text);
+}
+
+std::string SIM_readSerial(void)
+{
+	return Serial.take();
+}
+
+void SIM_echoSerial(bool echo)
+{
+	Serial.setEcho(echo);
+}
+
+uint64_t SIM_getAllocCount(void)
+{
+	return cntAlloc.load();
+}
+
+size_t SIM_getAllocBytes(void)
+{
+	return bytesInUse.load();
+}
+
+bool SIM_isRestarted(void)
+{
+	return restarted;
+}
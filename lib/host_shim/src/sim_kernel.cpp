@@ -0,0 +1,814 @@
+// --------------------------------------------------------
+// Copyright (c) 2025 rapid4mifu 
+//
+// These codes are licensed under GPL v3.0
+// https://opensource.org/license/GPL-3.0
+// --------------------------------------------------------
+
+// This software module is related to the scheduler of the host shim
+//  (tasks, task notifications, tick and interrupts on the virtual clock)
+
+#include "sim_kernel.h"
+#include "sim.h"
+
+#include <chrono>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <thread>
+
+// the thread that first calls the shim stands for the Arduino loop task
+#define SIM_LOOP_TASK_NAME "loopTask"
+#define SIM_LOOP_TASK_PRIORITY (1)
+#define SIM_LOOP_TASK_STACK (8192)
+
+typedef struct {
+	uint32_t id;
+	uint64_t time;		// next interrupt [us]
+	uint64_t period;	// 0 -> once
+	std::function<void()> isr;
+} sim_irq_t;
+
+typedef struct {
+	std::mutex mutex;				// held by the thread that runs
+	std::vector<sim_task *> tasks;	// creation order (deleted tasks stay)
+	std::vector<sim_irq_t> irqs;	// interrupt sources
+	sim_task * current;
+	uint64_t now;					// virtual time [us]
+	uint64_t tickOffset;			// tick count at time 0
+	uint64_t order;
+	uint32_t nextIrq;
+	UBaseType_t nextNumber;
+	int isr;						// interrupt nesting
+	bool scheduling;				// the scheduler runs (no task time)
+	uint64_t isrNs;					// host time spent in the interrupts [ns]
+} sim_kernel_t;
+
+static sim_kernel_t * kernel = NULL;
+
+static sim_task * sim_createTask(TaskFunction_t code, const char * name, uint32_t stackDepth, void * param, UBaseType_t priority);
+static void sim_runTask(sim_task * task);
+static sim_task * sim_pickTask(void);
+static void sim_schedule(void);
+static void sim_advance(void);
+static void sim_runIrqs(void);
+static BaseType_t sim_notify(sim_task * task, uint32_t value, eNotifyAction action);
+static uint64_t sim_getHostNs(void);
+
+/* kernel */
+
+void sim_initKernel(void)
+{
+	if (NULL != kernel) {
+		return;
+	}
+
+	// never freed: the task threads are still blocked when the program exits
+	kernel = new sim_kernel_t();
+	kernel->nextIrq = 1;
+	kernel->nextNumber = 1;
+
+	sim_task * task = sim_createTask(NULL, SIM_LOOP_TASK_NAME, SIM_LOOP_TASK_STACK, NULL, SIM_LOOP_TASK_PRIORITY);
+	task->lock = new std::unique_lock<std::mutex>(kernel->mutex);
+	task->switches = 1;
+	task->resumeNs = sim_getHostNs();
+	kernel->current = task;
+
+	sim_startTimerTask();
+}
+
+sim_task * sim_getCurrent(void)
+{
+	sim_initKernel();
+	return kernel->current;
+}
+
+uint64_t sim_getNow(void)
+{
+	sim_initKernel();
+	return kernel->now;
+}
+
+uint64_t sim_getTick(void)
+{
+	return sim_getNow() / SIM_US_PER_TICK;
+}
+
+bool sim_isInIsr(void)
+{
+	sim_initKernel();
+	return (0 < kernel->isr);
+}
+
+// end of a block of the given ticks (counted from the current tick as FreeRTOS does)
+uint64_t sim_getDeadline(TickType_t ticks)
+{
+	if (portMAX_DELAY == ticks) {
+		return SIM_TIME_FOREVER;
+	}
+	return (sim_getTick() + ticks) * SIM_US_PER_TICK;
+}
+
+// blocks the current task until it is readied or the deadline has passed
+// (true -> readied), the task waits in the list if one is given
+bool sim_block(sim_wait_list_t * list, uint64_t deadline)
+{
+	sim_task * self = sim_getCurrent();
+
+	if (0 < kernel->isr) {
+		sim_fatal("blocking call of task %s in an interrupt", self->name.c_str());
+	}
+	if (deadline <= kernel->now) {
+		return false;
+	}
+
+	self->state = SIM_TASK_BLOCKED;
+	self->wake = deadline;
+	self->timedOut = false;
+	self->waitList = list;
+	if (NULL != list) {
+		list->push_back(self);
+	}
+
+	sim_schedule();
+	return !self->timedOut;
+}
+
+void sim_ready(sim_task * task)
+{
+	if (SIM_TASK_BLOCKED != task->state) {
+		return;
+	}
+
+	if (NULL != task->waitList) {
+		for (auto it = task->waitList->begin(); it != task->waitList->end(); ++it) {
+			if (*it == task) {
+				task->waitList->erase(it);
+				break;
+			}
+		}
+		task->waitList = NULL;
+	}
+	task->state = SIM_TASK_READY;
+	task->wakeups++;
+}
+
+// readies the waiting task of the highest priority (the first one among equals)
+bool sim_readyFirst(sim_wait_list_t * list)
+{
+	sim_task * best = NULL;
+
+	for (sim_task * task : *list) {
+		if ((NULL == best) || (best->priority < task->priority)) {
+			best = task;
+		}
+	}
+	if (NULL == best) {
+		return false;
+	}
+
+	sim_ready(best);
+	return (kernel->current->priority < best->priority);
+}
+
+// a task readied above the current one runs first (not in an interrupt)
+void sim_preempt(void)
+{
+	sim_task * self = sim_getCurrent();
+
+	if (0 < kernel->isr) {
+		return;
+	}
+	for (sim_task * task : kernel->tasks) {
+		if ((SIM_TASK_READY == task->state) && (self->priority < task->priority)) {
+			sim_schedule();
+			return;
+		}
+	}
+}
+
+// brings the end of a block forward
+void sim_setWake(sim_task * task, uint64_t wake)
+{
+	if ((SIM_TASK_BLOCKED == task->state) && (wake < task->wake)) {
+		task->wake = wake;
+	}
+}
+
+void sim_runIsr(const std::function<void()> & isr)
+{
+	uint64_t start = sim_getHostNs();
+
+	sim_initKernel();
+	kernel->isr++;
+	isr();
+	kernel->isr--;
+
+	uint64_t spent = sim_getHostNs() - start;
+	kernel->isrNs += spent;
+	if (!kernel->scheduling) {
+		// not counted as the time of the interrupted task
+		kernel->current->resumeNs += spent;
+	}
+}
+
+uint32_t sim_addEvent(uint64_t time, uint64_t period, std::function<void()> isr)
+{
+	sim_irq_t irq;
+
+	sim_initKernel();
+	irq.id = kernel->nextIrq++;
+	irq.time = (time > kernel->now) ? time : kernel->now;
+	irq.period = period;
+	irq.isr = isr;
+	kernel->irqs.push_back(irq);
+
+	return irq.id;
+}
+
+void sim_removeEvent(uint32_t id)
+{
+	sim_initKernel();
+	for (auto it = kernel->irqs.begin(); it != kernel->irqs.end(); ++it) {
+		if (id == it->id) {
+			kernel->irqs.erase(it);
+			return;
+		}
+	}
+}
+
+void sim_fatal(const char * format, ...)
+{
+	va_list args;
+
+	fprintf(stderr, "[sim] ");
+	va_start(args, format);
+	vfprintf(stderr, format, args);
+	va_end(args);
+	fprintf(stderr, " (at %llu us)\n", (unsigned long long)((NULL != kernel) ? kernel->now : 0));
+
+	if (NULL != kernel) {
+		for (sim_task * task : kernel->tasks) {
+			fprintf(stderr, "[sim]  %-16s state %d, priority %u, wake %lld\n", task->name.c_str(), task->state,
+				task->priority, (SIM_TIME_FOREVER == task->wake) ? -1LL : (long long)task->wake);
+		}
+	}
+	fflush(stderr);
+	abort();
+}
+
+sim_task * sim_createTask(TaskFunction_t code, const char * name, uint32_t stackDepth, void * param, UBaseType_t priority)
+{
+	sim_task * task = new sim_task();
+
+	task->name = (NULL != name) ? std::string(name).substr(0, configMAX_TASK_NAME_LEN - 1) : "";
+	task->code = code;
+	task->param = param;
+	task->priority = (configMAX_PRIORITIES > priority) ? priority : (configMAX_PRIORITIES - 1);
+	task->number = kernel->nextNumber++;
+	task->stackDepth = stackDepth;
+	task->state = SIM_TASK_READY;
+	task->wake = SIM_TIME_FOREVER;
+	task->order = ++kernel->order;
+	kernel->tasks.push_back(task);
+
+	return task;
+}
+
+void sim_runTask(sim_task * task)
+{
+	std::unique_lock<std::mutex> lock(kernel->mutex);
+
+	task->lock = &lock;
+	task->cv.wait(lock, [task] { return kernel->current == task; });
+	task->switches++;
+	task->resumeNs = sim_getHostNs();
+
+	task->code(task->param);
+
+	// a task must not return
+	vTaskDelete(NULL);
+}
+
+sim_task * sim_pickTask(void)
+{
+	sim_task * best = NULL;
+
+	for (sim_task * task : kernel->tasks) {
+		if (SIM_TASK_READY != task->state) {
+			continue;
+		}
+		if ((NULL == best) || (best->priority < task->priority)
+		 || ((best->priority == task->priority) && (task->order < best->order))) {
+			best = task;
+		}
+	}
+
+	return best;
+}
+
+// hands the CPU to the next task, the time advances while no task is ready
+void sim_schedule(void)
+{
+	sim_task * self = kernel->current;
+	sim_task * next;
+
+	self->runNs += sim_getHostNs() - self->resumeNs;
+	kernel->scheduling = true;
+
+	while (NULL == (next = sim_pickTask())) {
+		sim_advance();
+	}
+	next->order = ++kernel->order;
+
+	if (next != self) {
+		kernel->current = next;
+		next->cv.notify_one();
+		self->cv.wait(*self->lock, [self] { return kernel->current == self; });
+		self->switches++;
+	}
+
+	kernel->scheduling = false;
+	self->resumeNs = sim_getHostNs();
+}
+
+// moves the clock to the next timeout or interrupt
+void sim_advance(void)
+{
+	uint64_t next = SIM_TIME_FOREVER;
+
+	for (sim_task * task : kernel->tasks) {
+		if ((SIM_TASK_BLOCKED == task->state) && (task->wake < next)) {
+			next = task->wake;
+		}
+	}
+	for (const sim_irq_t & irq : kernel->irqs) {
+		if (irq.time < next) {
+			next = irq.time;
+		}
+	}
+	if (SIM_TIME_FOREVER == next) {
+		sim_fatal("every task is blocked without a timeout");
+	}
+
+	if (kernel->now < next) {
+		kernel->now = next;
+	}
+
+	sim_runIrqs();
+
+	for (sim_task * task : kernel->tasks) {
+		if ((SIM_TASK_BLOCKED == task->state) && (task->wake <= kernel->now)) {
+			sim_ready(task);
+			task->timedOut = true;
+		}
+	}
+}
+
+// the interrupts due by now, in the order of their time
+void sim_runIrqs(void)
+{
+	for (;;) {
+		sim_irq_t * due = NULL;
+
+		for (sim_irq_t & irq : kernel->irqs) {
+			if ((irq.time <= kernel->now) && ((NULL == due) || (irq.time < due->time))) {
+				due = &irq;
+			}
+		}
+		if (NULL == due) {
+			return;
+		}
+
+		// the handler may add or remove sources
+		std::function<void()> isr = due->isr;
+		if (0 < due->period) {
+			due->time += due->period;
+		} else {
+			sim_removeEvent(due->id);
+		}
+		sim_runIsr(isr);
+	}
+}
+
+BaseType_t sim_notify(sim_task * task, uint32_t value, eNotifyAction action)
+{
+	switch (action) {
+	case eSetBits:
+		task->notifyValue |= value;
+		break;
+	case eIncrement:
+		task->notifyValue++;
+		break;
+	case eSetValueWithOverwrite:
+		task->notifyValue = value;
+		break;
+	case eSetValueWithoutOverwrite:
+		if (task->notifyPending) {
+			return pdFAIL;
+		}
+		task->notifyValue = value;
+		break;
+	default:
+		break;
+	}
+
+	task->notifyPending = true;
+	if (task->notifyWaiting) {
+		task->notifyWaiting = false;
+		sim_ready(task);
+	}
+
+	return pdPASS;
+}
+
+uint64_t sim_getHostNs(void)
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/* tasks */
+
+BaseType_t xTaskCreate(TaskFunction_t pxTaskCode, const char * pcName, uint32_t usStackDepth,
+	void * pvParameters, UBaseType_t uxPriority, TaskHandle_t * pxCreatedTask)
+{
+	sim_initKernel();
+
+	sim_task * task = sim_createTask(pxTaskCode, pcName, usStackDepth, pvParameters, uxPriority);
+	std::thread(sim_runTask, task).detach();
+
+	if (NULL != pxCreatedTask) {
+		*pxCreatedTask = task;
+	}
+	sim_preempt();
+
+	return pdPASS;
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t pxTaskCode, const char * pcName, uint32_t usStackDepth,
+	void * pvParameters, UBaseType_t uxPriority, TaskHandle_t * pxCreatedTask, BaseType_t xCoreID)
+{
+	(void)xCoreID;
+	return xTaskCreate(pxTaskCode, pcName, usStackDepth, pvParameters, uxPriority, pxCreatedTask);
+}
+
+BaseType_t xTaskCreateUniversal(TaskFunction_t pxTaskCode, const char * pcName, uint32_t usStackDepth,
+	void * pvParameters, UBaseType_t uxPriority, TaskHandle_t * pxCreatedTask, BaseType_t xCoreID)
+{
+	(void)xCoreID;
+	return xTaskCreate(pxTaskCode, pcName, usStackDepth, pvParameters, uxPriority, pxCreatedTask);
+}
+
+void vTaskDelete(TaskHandle_t xTask)
+{
+	sim_task * task = (NULL != xTask) ? xTask : sim_getCurrent();
+
+	if (SIM_TASK_BLOCKED == task->state) {
+		sim_ready(task);
+	}
+	task->state = SIM_TASK_DELETED;
+
+	// the thread of a deleted task waits for good
+	if (task == kernel->current) {
+		sim_schedule();
+	}
+}
+
+void vTaskDelay(TickType_t xTicksToDelay)
+{
+	if (0 == xTicksToDelay) {
+		vPortYield();
+		return;
+	}
+	sim_block(NULL, sim_getDeadline(xTicksToDelay));
+}
+
+BaseType_t xTaskDelayUntil(TickType_t * pxPreviousWakeTime, TickType_t xTimeIncrement)
+{
+	TickType_t wake = *pxPreviousWakeTime + xTimeIncrement;
+	int32_t ahead = (int32_t)(wake - xTaskGetTickCount());
+
+	*pxPreviousWakeTime = wake;
+	if (0 >= ahead) {
+		// already late
+		vPortYield();
+		return pdFALSE;
+	}
+
+	sim_block(NULL, sim_getDeadline((TickType_t)ahead));
+	return pdTRUE;
+}
+
+void vTaskDelayUntil(TickType_t * pxPreviousWakeTime, TickType_t xTimeIncrement)
+{
+	xTaskDelayUntil(pxPreviousWakeTime, xTimeIncrement);
+}
+
+void vTaskSuspend(TaskHandle_t xTask)
+{
+	sim_task * task = (NULL != xTask) ? xTask : sim_getCurrent();
+
+	if (SIM_TASK_BLOCKED == task->state) {
+		sim_ready(task);
+	}
+	task->state = SIM_TASK_SUSPENDED;
+	if (task == kernel->current) {
+		sim_schedule();
+	}
+}
+
+void vTaskResume(TaskHandle_t xTask)
+{
+	sim_initKernel();
+	if ((NULL != xTask) && (SIM_TASK_SUSPENDED == xTask->state)) {
+		xTask->state = SIM_TASK_READY;
+		sim_preempt();
+	}
+}
+
+void vTaskPrioritySet(TaskHandle_t xTask, UBaseType_t uxNewPriority)
+{
+	sim_task * task = (NULL != xTask) ? xTask : sim_getCurrent();
+
+	task->priority = (configMAX_PRIORITIES > uxNewPriority) ? uxNewPriority : (configMAX_PRIORITIES - 1);
+	sim_preempt();
+}
+
+UBaseType_t uxTaskPriorityGet(TaskHandle_t xTask)
+{
+	return ((NULL != xTask) ? xTask : sim_getCurrent())->priority;
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void)
+{
+	return sim_getCurrent();
+}
+
+const char * pcTaskGetName(TaskHandle_t xTask)
+{
+	return ((NULL != xTask) ? xTask : sim_getCurrent())->name.c_str();
+}
+
+eTaskState eTaskGetState(TaskHandle_t xTask)
+{
+	if (xTask == sim_getCurrent()) {
+		return eRunning;
+	}
+
+	switch (xTask->state) {
+	case SIM_TASK_READY:
+		return eReady;
+	case SIM_TASK_BLOCKED:
+		return eBlocked;
+	case SIM_TASK_SUSPENDED:
+		return eSuspended;
+	default:
+		return eDeleted;
+	}
+}
+
+TickType_t xTaskGetTickCount(void)
+{
+	sim_initKernel();
+	return (TickType_t)(kernel->now / SIM_US_PER_TICK + kernel->tickOffset);
+}
+
+TickType_t xTaskGetTickCountFromISR(void)
+{
+	return xTaskGetTickCount();
+}
+
+UBaseType_t uxTaskGetNumberOfTasks(void)
+{
+	UBaseType_t count = 1;	// idle task
+
+	sim_initKernel();
+	for (sim_task * task : kernel->tasks) {
+		count += (SIM_TASK_DELETED != task->state) ? 1 : 0;
+	}
+
+	return count;
+}
+
+// the run time counters are the host time spent in the tasks [us], the total
+// is the virtual time, the idle task gets the rest (the load the code would
+// put on a CPU as fast as the host)
+UBaseType_t uxTaskGetSystemState(TaskStatus_t * pxTaskStatusArray, UBaseType_t uxArraySize, uint32_t * pulTotalRunTime)
+{
+	UBaseType_t count = 0;
+	uint64_t busy = 0;
+
+	if (uxArraySize < uxTaskGetNumberOfTasks()) {
+		return 0;
+	}
+
+	kernel->current->runNs += sim_getHostNs() - kernel->current->resumeNs;
+	kernel->current->resumeNs = sim_getHostNs();
+
+	for (sim_task * task : kernel->tasks) {
+		TaskStatus_t * status = &pxTaskStatusArray[count];
+
+		if (SIM_TASK_DELETED == task->state) {
+			continue;
+		}
+		status->xHandle = task;
+		status->pcTaskName = task->name.c_str();
+		status->xTaskNumber = task->number;
+		status->eCurrentState = eTaskGetState(task);
+		status->uxCurrentPriority = task->priority;
+		status->uxBasePriority = task->priority;
+		status->ulRunTimeCounter = (uint32_t)(task->runNs / 1000);
+		status->pxStackBase = NULL;
+		status->usStackHighWaterMark = task->stackDepth;	// not measured on the host
+		status->xCoreID = 0;
+		busy += task->runNs / 1000;
+		count++;
+	}
+
+	TaskStatus_t * idle = &pxTaskStatusArray[count++];
+	idle->xHandle = NULL;
+	idle->pcTaskName = "IDLE";
+	idle->xTaskNumber = 0;
+	idle->eCurrentState = eReady;
+	idle->uxCurrentPriority = tskIDLE_PRIORITY;
+	idle->uxBasePriority = tskIDLE_PRIORITY;
+	idle->ulRunTimeCounter = (uint32_t)((busy < kernel->now) ? (kernel->now - busy) : 0);
+	idle->pxStackBase = NULL;
+	idle->usStackHighWaterMark = configMINIMAL_STACK_SIZE;
+	idle->xCoreID = 0;
+
+	if (NULL != pulTotalRunTime) {
+		*pulTotalRunTime = (uint32_t)kernel->now;
+	}
+
+	return count;
+}
+
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t xTask)
+{
+	return ((NULL != xTask) ? xTask : sim_getCurrent())->stackDepth;
+}
+
+void vTaskList(char * pcWriteBuffer)
+{
+	static const char stateChar[] = {'R', 'B', 'S', 'D'};
+	size_t len = 0;
+
+	sim_initKernel();
+	pcWriteBuffer[0] = '\0';
+	for (sim_task * task : kernel->tasks) {
+		if (SIM_TASK_DELETED == task->state) {
+			continue;
+		}
+		len += sprintf(&pcWriteBuffer[len], "%-16s\t%c\t%u\t%u\t%u\r\n", task->name.c_str(),
+			(task == kernel->current) ? 'X' : stateChar[task->state], task->priority, task->stackDepth, task->number);
+	}
+}
+
+void vPortYield(void)
+{
+	sim_getCurrent();
+	sim_schedule();
+}
+
+/* task notifications */
+
+BaseType_t xTaskNotify(TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction)
+{
+	sim_initKernel();
+	BaseType_t result = sim_notify(xTaskToNotify, ulValue, eAction);
+	sim_preempt();
+	return result;
+}
+
+BaseType_t xTaskNotifyFromISR(TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction,
+	BaseType_t * pxHigherPriorityTaskWoken)
+{
+	sim_initKernel();
+	BaseType_t result = sim_notify(xTaskToNotify, ulValue, eAction);
+	if ((NULL != pxHigherPriorityTaskWoken) && (kernel->current->priority < xTaskToNotify->priority)) {
+		*pxHigherPriorityTaskWoken = pdTRUE;
+	}
+	return result;
+}
+
+BaseType_t xTaskNotifyWait(uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit,
+	uint32_t * pulNotificationValue, TickType_t xTicksToWait)
+{
+	sim_task * self = sim_getCurrent();
+
+	if (!self->notifyPending) {
+		self->notifyValue &= ~ulBitsToClearOnEntry;
+		self->notifyWaiting = true;
+		sim_block(NULL, sim_getDeadline(xTicksToWait));
+		self->notifyWaiting = false;
+	}
+
+	if (NULL != pulNotificationValue) {
+		*pulNotificationValue = self->notifyValue;
+	}
+	if (!self->notifyPending) {
+		return pdFALSE;
+	}
+	self->notifyValue &= ~ulBitsToClearOnExit;
+	self->notifyPending = false;
+
+	return pdTRUE;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t xTaskToNotify)
+{
+	return xTaskNotify(xTaskToNotify, 0, eIncrement);
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t xTaskToNotify, BaseType_t * pxHigherPriorityTaskWoken)
+{
+	xTaskNotifyFromISR(xTaskToNotify, 0, eIncrement, pxHigherPriorityTaskWoken);
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t xClearCountOnExit, TickType_t xTicksToWait)
+{
+	sim_task * self = sim_getCurrent();
+	uint32_t value;
+
+	if (0 == self->notifyValue) {
+		self->notifyWaiting = true;
+		sim_block(NULL, sim_getDeadline(xTicksToWait));
+		self->notifyWaiting = false;
+	}
+
+	value = self->notifyValue;
+	if (0 != value) {
+		self->notifyValue = xClearCountOnExit ? 0 : (value - 1);
+	}
+	self->notifyPending = false;
+
+	return value;
+}
+
+BaseType_t xTaskNotifyStateClear(TaskHandle_t xTask)
+{
+	sim_task * task = (NULL != xTask) ? xTask : sim_getCurrent();
+	BaseType_t pending = task->notifyPending ? pdTRUE : pdFALSE;
+
+	task->notifyPending = false;
+	return pending;
+}
+
+/* control of the simulation (sim.h) */
+
+void SIM_runFor(uint64_t us)
+{
+	SIM_runUntil(sim_getNow() + us);
+}
+
+void SIM_runUntil(uint64_t time)
+{
+	sim_block(NULL, time);
+}
+
+uint64_t SIM_getTime(void)
+{
+	return sim_getNow();
+}
+
+void SIM_setTickCount(TickType_t ticks)
+{
+	sim_initKernel();
+	kernel->tickOffset = (uint64_t)ticks - kernel->now / SIM_US_PER_TICK;
+}
+
+bool SIM_getTaskStats(const char * name, sim_task_stats_t * stats)
+{
+	sim_initKernel();
+	for (sim_task * task : kernel->tasks) {
+		if (task->name == name) {
+			stats->priority = task->priority;
+			stats->run_ns = task->runNs;
+			stats->wakeups = task->wakeups;
+			stats->switches = task->switches;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void SIM_clearTaskStats(void)
+{
+	sim_initKernel();
+	for (sim_task * task : kernel->tasks) {
+		task->runNs = 0;
+		task->wakeups = 0;
+		task->switches = 0;
+	}
+	kernel->current->resumeNs = sim_getHostNs();
+	kernel->isrNs = 0;
+}
+
+uint64_t SIM_getIsrTime(void)
+{
+	sim_initKernel();
+	return kernel->isrNs;
+}
@@ -0,0 +1,85 @@
+// --------------------------------------------------------
+// Copyright (c) 2025 rapid4mifu 
+//
+// These codes are licensed under GPL v3.0
+// https://opensource.org/license/GPL-3.0
+// --------------------------------------------------------
+
+// This header file is related to the scheduler of the host shim (internal)
+//
+// a big lock is held by the one thread that runs: the current task, or
+// the interrupts and the tick which the scheduler runs in the thread of
+// the task that gave up the CPU, so the shim needs no other locking
+
+#ifndef __SIM_KERNEL_H__	/* 二重定義防止 */
+
+#include "freertos/FreeRTOS.h"
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#define SIM_TIME_FOREVER (UINT64_MAX)
+#define SIM_US_PER_TICK (1000000 / configTICK_RATE_HZ)
+
+typedef enum {
+	SIM_TASK_READY = 0,
+	SIM_TASK_BLOCKED,
+	SIM_TASK_SUSPENDED,
+	SIM_TASK_DELETED
+} sim_task_state_t;
+
+typedef std::vector<struct sim_task *> sim_wait_list_t;
+
+struct sim_task {
+	std::string name;
+	TaskFunction_t code;
+	void * param;
+	UBaseType_t priority;
+	UBaseType_t number;
+	uint32_t stackDepth;
+	sim_task_state_t state;
+	uint64_t wake;					// end of the block [us] (SIM_TIME_FOREVER -> no timeout)
+	bool timedOut;					// the block ended by the timeout
+	uint64_t order;					// round robin among the same priority
+	sim_wait_list_t * waitList;		// object the task is blocked on
+	std::condition_variable cv;
+	std::unique_lock<std::mutex> * lock;
+	/* notification */
+	uint32_t notifyValue;
+	bool notifyPending;
+	bool notifyWaiting;
+	/* statistics */
+	uint64_t runNs;					// host time spent in the task [ns]
+	uint64_t resumeNs;
+	uint32_t wakeups;				// blocked -> ready
+	uint32_t switches;				// switched in
+};
+
+void sim_initKernel(void);
+sim_task * sim_getCurrent(void);
+uint64_t sim_getNow(void);
+uint64_t sim_getTick(void);
+bool sim_isInIsr(void);
+
+uint64_t sim_getDeadline(TickType_t ticks);
+bool sim_block(sim_wait_list_t * list, uint64_t deadline);
+void sim_ready(sim_task * task);
+bool sim_readyFirst(sim_wait_list_t * list);
+void sim_preempt(void);
+void sim_setWake(sim_task * task, uint64_t wake);
+void sim_runIsr(const std::function<void()> & isr);
+
+uint32_t sim_addEvent(uint64_t time, uint64_t period, std::function<void()> isr);
+void sim_removeEvent(uint32_t id);
+
+void sim_fatal(const char * format, ...);
+
+/* provided by the other modules of the shim */
+void sim_startTimerTask(void);
+void sim_record(int kind, uint32_t source, uint32_t value, const void * data, size_t len);
+
+#endif /* __SIM_KERNEL_H__*/	/* 二重定義防止 */
+#define __SIM_KERNEL_H__	/* 二重定義防止 */
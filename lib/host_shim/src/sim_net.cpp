@@ -0,0 +1,552 @@
+// --------------------------------------------------------
+// Copyright (c) 2025 rapid4mifu 
+//
+// These codes are licensed under GPL v3.0
+// https://opensource.org/license/GPL-3.0
+// --------------------------------------------------------
+
+// This software module is related to the network of the host shim
+//  (Wi-Fi, web socket clients and the web server)
+
+#include "AsyncTcp.h"
+#include "ESPAsyncWebServer.h"
+#include "ESPmDNS.h"
+#include "WiFi.h"
+#include "sim.h"
+#include "sim_kernel.h"
+
+#include <deque>
+
+// tasks of the network stack (as in arduino-esp32 and AsyncTCP)
+#define SIM_EVENT_TASK_NAME "arduino_events"
+#define SIM_EVENT_TASK_PRIORITY (19)
+#define SIM_TCP_TASK_NAME "async_tcp"
+#define SIM_TCP_TASK_PRIORITY (10)
+#define SIM_NET_TASK_STACK (8192)
+
+typedef struct {
+	const char * name;
+	UBaseType_t priority;
+	TaskHandle_t handle;
+	std::deque<std::function<void()>> jobs;
+} sim_worker_t;
+
+static sim_worker_t workerEvent = { SIM_EVENT_TASK_NAME, SIM_EVENT_TASK_PRIORITY, NULL, {} };
+static sim_worker_t workerTcp = { SIM_TCP_TASK_NAME, SIM_TCP_TASK_PRIORITY, NULL, {} };
+static uint32_t nextClientId = 1;
+
+WiFiClass WiFi;
+MDNSResponder MDNS;
+
+static void sim_processWorker(void * pvParameters);
+static void sim_post(sim_worker_t * worker, std::function<void()> job);
+static std::vector<AsyncWebSocket *> & sim_getSockets(void);
+static AsyncWebSocket * sim_getSocket(void);
+
+void sim_processWorker(void * pvParameters)
+{
+	sim_worker_t * worker = (sim_worker_t *)pvParameters;
+
+	while (true) {
+		ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+		while (!worker->jobs.empty()) {
+			std::function<void()> job = worker->jobs.front();
+			worker->jobs.pop_front();
+			job();
+		}
+	}
+}
+
+// the job runs in the task of the worker (at once when it is above the caller)
+void sim_post(sim_worker_t * worker, std::function<void()> job)
+{
+	if (NULL == worker->handle) {
+		xTaskCreate(sim_processWorker, worker->name, SIM_NET_TASK_STACK, worker, worker->priority, &worker->handle);
+	}
+	worker->jobs.push_back(job);
+	if (sim_isInIsr()) {
+		vTaskNotifyGiveFromISR(worker->handle, NULL);
+	} else {
+		xTaskNotifyGive(worker->handle);
+	}
+}
+
+std::vector<AsyncWebSocket *> & sim_getSockets(void)
+{
+	static std::vector<AsyncWebSocket *> sockets;
+	return sockets;
+}
+
+AsyncWebSocket * sim_getSocket(void)
+{
+	if (sim_getSockets().empty()) {
+		sim_fatal("no web socket is created");
+	}
+	return sim_getSockets().front();
+}
+
+/* Wi-Fi */
+
+bool WiFiClass::mode(WiFiMode_t mode)
+{
+	wifiMode = mode;
+	return true;
+}
+
+wl_status_t WiFiClass::begin(void)
+{
+	if (!started) {
+		started = true;
+		postEvent(ARDUINO_EVENT_WIFI_STA_START);
+	}
+	connect();
+	return wifiStatus;
+}
+
+wl_status_t WiFiClass::begin(const char * ssid, const char * passphrase)
+{
+	(void)passphrase;
+	this->ssid = (NULL != ssid) ? ssid : "";
+	return begin();
+}
+
+bool WiFiClass::config(IPAddress local_ip, IPAddress gateway, IPAddress subnet)
+{
+	(void)gateway;
+	(void)subnet;
+	if (IPAddress() != local_ip) {
+		ipLocal = local_ip;
+	}
+	return true;
+}
+
+bool WiFiClass::disconnect(bool wifioff)
+{
+	if (WL_CONNECTED == wifiStatus) {
+		wifiStatus = WL_DISCONNECTED;
+		postEvent(ARDUINO_EVENT_WIFI_STA_DISCONNECTED);
+	}
+	if (wifioff && started) {
+		started = false;
+		postEvent(ARDUINO_EVENT_WIFI_STA_STOP);
+	}
+	return true;
+}
+
+bool WiFiClass::softAP(const char * ssid, const char * passphrase)
+{
+	(void)passphrase;
+	this->ssid = (NULL != ssid) ? ssid : "";
+	postEvent(ARDUINO_EVENT_WIFI_AP_START);
+	return true;
+}
+
+bool WiFiClass::softAPConfig(IPAddress local_ip, IPAddress gateway, IPAddress subnet)
+{
+	return config(local_ip, gateway, subnet);
+}
+
+wifi_event_id_t WiFiClass::onEvent(WiFiEventCb cbEvent)
+{
+	handlers.push_back(cbEvent);
+	return handlers.size();
+}
+
+void WiFiClass::connect(void)
+{
+	if (started && available && (WL_CONNECTED != wifiStatus)) {
+		wifiStatus = WL_CONNECTED;
+		postEvent(ARDUINO_EVENT_WIFI_STA_CONNECTED);
+		postEvent(ARDUINO_EVENT_WIFI_STA_GOT_IP);
+	}
+}
+
+void WiFiClass::setAccessPoint(bool available)
+{
+	this->available = available;
+	if (available) {
+		connect();
+	} else if (WL_CONNECTED == wifiStatus) {
+		wifiStatus = WL_CONNECTION_LOST;
+		postEvent(ARDUINO_EVENT_WIFI_STA_DISCONNECTED);
+	}
+}
+
+void WiFiClass::postEvent(arduino_event_id_t event)
+{
+	sim_post(&workerEvent, [this, event] {
+		for (WiFiEventCb handler : handlers) {
+			handler(event);
+		}
+	});
+}
+
+/* web socket */
+
+bool AsyncWebSocketClient::send(bool binary, const uint8_t * data, size_t len)
+{
+	if ((WS_CONNECTED != clientStatus) || queueIsFull()) {
+		return false;
+	}
+
+	sim_record(SIM_TL_WS_TX, clientId, binary ? 1 : 0, data, len);
+	return true;
+}
+
+// a message from a pointer is copied into a message of the client as the
+// library does (an allocation per client), a shared buffer is not
+bool AsyncWebSocketClient::text(const char * message, size_t len)
+{
+	return text(std::make_shared<std::vector<uint8_t>>((const uint8_t *)message, (const uint8_t *)message + len));
+}
+
+bool AsyncWebSocketClient::text(AsyncWebSocketSharedBuffer buffer)
+{
+	return send(false, buffer->data(), buffer->size());
+}
+
+bool AsyncWebSocketClient::binary(const uint8_t * message, size_t len)
+{
+	return binary(std::make_shared<std::vector<uint8_t>>(message, message + len));
+}
+
+bool AsyncWebSocketClient::binary(AsyncWebSocketSharedBuffer buffer)
+{
+	return send(true, buffer->data(), buffer->size());
+}
+
+AsyncWebSocket::AsyncWebSocket(const char * url) : wsUrl(url)
+{
+	sim_getSockets().push_back(this);
+}
+
+AsyncWebSocket::~AsyncWebSocket()
+{
+	std::vector<AsyncWebSocket *> & sockets = sim_getSockets();
+
+	for (auto it = sockets.begin(); it != sockets.end(); ++it) {
+		if (*it == this) {
+			sockets.erase(it);
+			break;
+		}
+	}
+	for (AsyncWebSocketClient * c : clients) {
+		delete c;
+	}
+}
+
+size_t AsyncWebSocket::count(void) const
+{
+	size_t n = 0;
+
+	for (const AsyncWebSocketClient * c : clients) {
+		n += (WS_CONNECTED == c->status()) ? 1 : 0;
+	}
+	return n;
+}
+
+AsyncWebSocketClient * AsyncWebSocket::client(uint32_t id)
+{
+	for (AsyncWebSocketClient * c : clients) {
+		if ((id == c->id()) && (WS_CONNECTED == c->status())) {
+			return c;
+		}
+	}
+	return NULL;
+}
+
+AsyncWebSocketMessageBuffer * AsyncWebSocket::makeBuffer(size_t size)
+{
+	std::vector<uint8_t> zero(size);
+	return new AsyncWebSocketMessageBuffer(zero.data(), size);
+}
+
+AsyncWebSocketMessageBuffer * AsyncWebSocket::makeBuffer(const uint8_t * data, size_t size)
+{
+	return new AsyncWebSocketMessageBuffer(data, size);
+}
+
+bool AsyncWebSocket::text(uint32_t id, const char * message, size_t len)
+{
+	AsyncWebSocketClient * c = client(id);
+	return (NULL != c) && c->text(message, len);
+}
+
+void AsyncWebSocket::textAll(const char * message, size_t len)
+{
+	for (AsyncWebSocketClient * c : clients) {
+		c->text(message, len);
+	}
+}
+
+bool AsyncWebSocket::binary(uint32_t id, const uint8_t * message, size_t len)
+{
+	AsyncWebSocketClient * c = client(id);
+	return (NULL != c) && c->binary(message, len);
+}
+
+// the buffer is owned by the socket from here on
+bool AsyncWebSocket::binary(uint32_t id, AsyncWebSocketMessageBuffer * buffer)
+{
+	bool sent = binary(id, buffer->buffer);
+	delete buffer;
+	return sent;
+}
+
+bool AsyncWebSocket::binary(uint32_t id, AsyncWebSocketSharedBuffer buffer)
+{
+	AsyncWebSocketClient * c = client(id);
+	return (NULL != c) && c->binary(buffer);
+}
+
+void AsyncWebSocket::binaryAll(const uint8_t * message, size_t len)
+{
+	for (AsyncWebSocketClient * c : clients) {
+		c->binary(message, len);
+	}
+}
+
+void AsyncWebSocket::binaryAll(AsyncWebSocketMessageBuffer * buffer)
+{
+	binaryAll(buffer->buffer);
+	delete buffer;
+}
+
+void AsyncWebSocket::binaryAll(AsyncWebSocketSharedBuffer buffer)
+{
+	for (AsyncWebSocketClient * c : clients) {
+		c->binary(buffer);
+	}
+}
+
+AsyncWebSocketClient * AsyncWebSocket::connect(size_t queueLimit)
+{
+	AsyncWebSocketClient * c = new AsyncWebSocketClient(this, nextClientId++, queueLimit);
+
+	clients.push_back(c);
+	if (eventHandler) {
+		eventHandler(this, c, WS_EVT_CONNECT, NULL, NULL, 0);
+	}
+	return c;
+}
+
+void AsyncWebSocket::disconnect(uint32_t id)
+{
+	for (auto it = clients.begin(); it != clients.end(); ++it) {
+		AsyncWebSocketClient * c = *it;
+
+		if (id != c->id()) {
+			continue;
+		}
+		// no longer counted while the handler runs
+		c->clientStatus = WS_DISCONNECTED;
+		if (eventHandler) {
+			eventHandler(this, c, WS_EVT_DISCONNECT, NULL, NULL, 0);
+		}
+		clients.erase(it);
+		delete c;
+		return;
+	}
+}
+
+void AsyncWebSocket::receive(uint32_t id, AwsFrameType opcode, const uint8_t * data, size_t len)
+{
+	AsyncWebSocketClient * c = client(id);
+	AwsFrameInfo info = {};
+	std::vector<uint8_t> payload(data, data + len);
+
+	if ((NULL == c) || !eventHandler) {
+		return;
+	}
+
+	// the whole message in a single frame
+	info.message_opcode = opcode;
+	info.opcode = opcode;
+	info.final = 1;
+	info.index = 0;
+	info.len = len;
+	payload.push_back(0);
+	eventHandler(this, c, WS_EVT_DATA, &info, payload.data(), len);
+}
+
+/* web server */
+
+AsyncWebServerRequest::~AsyncWebServerRequest()
+{
+	delete response;
+}
+
+bool AsyncWebServerRequest::hasArg(const char * name) const
+{
+	return (NULL != getParam(name));
+}
+
+const AsyncWebParameter * AsyncWebServerRequest::getParam(const char * name) const
+{
+	for (const AsyncWebParameter & param : requestParams) {
+		if (param.name() == name) {
+			return &param;
+		}
+	}
+	return NULL;
+}
+
+bool AsyncWebServerRequest::hasHeader(const char * name) const
+{
+	for (const auto & header : requestHeaders) {
+		if (String(header.first.c_str()).equalsIgnoreCase(name)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+String AsyncWebServerRequest::header(const char * name) const
+{
+	for (const auto & header : requestHeaders) {
+		if (String(header.first.c_str()).equalsIgnoreCase(name)) {
+			return String(header.second.c_str());
+		}
+	}
+	return String();
+}
+
+namespace {
+
+class sim_response : public AsyncWebServerResponse {
+public:
+	sim_response(int code, const String & contentType, std::string content)
+		: AsyncWebServerResponse(code, contentType, content.size()), content(content) {}
+	std::string body(void) override { return content; }
+
+private:
+	std::string content;
+};
+
+class sim_filler_response : public AsyncWebServerResponse {
+public:
+	sim_filler_response(const String & contentType, size_t len, AwsResponseFiller filler)
+		: AsyncWebServerResponse(200, contentType, len), filler(filler) {}
+	std::string body(void) override
+	{
+		std::string content;
+		uint8_t chunk[512];
+		size_t len;
+
+		while ((content.size() < contentLength) && (0 < (len = filler(chunk, sizeof(chunk), content.size())))) {
+			content.append((const char *)chunk, len);
+		}
+		return content;
+	}
+
+private:
+	AwsResponseFiller filler;
+};
+
+}
+
+AsyncWebServerResponse * AsyncWebServerRequest::beginResponse(int code, const char * contentType, const char * content)
+{
+	return new sim_response(code, contentType, content);
+}
+
+AsyncWebServerResponse * AsyncWebServerRequest::beginResponse(int code, const char * contentType, const uint8_t * content, size_t len)
+{
+	return new sim_response(code, contentType, std::string((const char *)content, len));
+}
+
+AsyncWebServerResponse * AsyncWebServerRequest::beginResponse(const char * contentType, size_t len, AwsResponseFiller callback)
+{
+	return new sim_filler_response(contentType, len, callback);
+}
+
+AsyncWebServerResponse * AsyncWebServerRequest::beginResponse(File content, const String & path, const char * contentType, bool download)
+{
+	std::string data;
+	int c;
+
+	(void)path;
+	(void)download;
+	while (0 <= (c = content.read())) {
+		data += (char)c;
+	}
+	content.close();
+	return new sim_response(200, contentType, data);
+}
+
+void AsyncWebServerRequest::send(AsyncWebServerResponse * response)
+{
+	if (this->response != response) {
+		delete this->response;
+	}
+	this->response = response;
+}
+
+AsyncCallbackWebHandler & AsyncWebServer::on(const char * uri, WebRequestMethodComposite method, ArRequestHandlerFunction onRequest,
+	ArUploadHandlerFunction onUpload, ArBodyHandlerFunction onBody)
+{
+	(void)method;
+	(void)onUpload;
+	(void)onBody;
+	routes[uri] = onRequest;
+	handlers.push_back(new AsyncCallbackWebHandler());
+	return *handlers.back();
+}
+
+void AsyncWebServer::handle(AsyncWebServerRequest * request)
+{
+	auto route = routes.find(request->url().c_str());
+
+	if (routes.end() != route) {
+		route->second(request);
+	} else if (notFound) {
+		notFound(request);
+	}
+}
+
+/* control of the simulation (sim.h) */
+
+void SIM_setWiFiStatus(bool connected)
+{
+	WiFi.setAccessPoint(connected);
+}
+
+void SIM_postWiFiEvent(arduino_event_id_t event)
+{
+	WiFi.postEvent(event);
+}
+
+// the client is connected in the async_tcp task (the connect handler has run on return)
+uint32_t SIM_connectWs(size_t queueLimit)
+{
+	uint32_t id = nextClientId;
+
+	sim_post(&workerTcp, [queueLimit] { sim_getSocket()->connect(queueLimit); });
+	return id;
+}
+
+void SIM_disconnectWs(uint32_t id)
+{
+	sim_post(&workerTcp, [id] { sim_getSocket()->disconnect(id); });
+}
+
+void SIM_setWsQueueLen(uint32_t id, size_t len)
+{
+	AsyncWebSocketClient * c = sim_getSocket()->client(id);
+
+	if (NULL != c) {
+		c->setQueueLen(len);
+	}
+}
+
+void SIM_receiveWsText(uint32_t id, const std::string & text)
+{
+	sim_post(&workerTcp, [id, text] { sim_getSocket()->receive(id, WS_TEXT, (const uint8_t *)text.data(), text.size()); });
+}
+
+void SIM_receiveWsBinary(uint32_t id, const uint8_t * data, size_t len)
+{
+	std::string frame((const char *)data, len);
+
+	sim_post(&workerTcp, [id, frame] { sim_getSocket()->receive(id, WS_BINARY, (const uint8_t *)frame.data(), frame.size()); });
+}
@@ -0,0 +1,242 @@
+// --------------------------------------------------------
+// Copyright (c) 2025 rapid4mifu 
+//
+// These codes are licensed under GPL v3.0
+// https://opensource.org/license/GPL-3.0
+// --------------------------------------------------------
+
+// This software module is related to the queues and semaphores of the host shim
+
+#include "sim_kernel.h"
+
+#include <string.h>
+
+struct sim_queue {
+	UBaseType_t length;				// number of items
+	UBaseType_t itemSize;			// 0 -> semaphore
+	std::vector<uint8_t> storage;
+	UBaseType_t head;				// oldest item
+	UBaseType_t count;
+	sim_wait_list_t waitSend;
+	sim_wait_list_t waitReceive;
+};
+
+static QueueHandle_t sim_createQueue(UBaseType_t length, UBaseType_t itemSize, UBaseType_t count);
+static BaseType_t sim_sendQueue(QueueHandle_t queue, const void * item, TickType_t ticks, bool front, bool overwrite, BaseType_t * woken);
+static BaseType_t sim_receiveQueue(QueueHandle_t queue, void * buffer, TickType_t ticks, bool peek, BaseType_t * woken);
+
+QueueHandle_t sim_createQueue(UBaseType_t length, UBaseType_t itemSize, UBaseType_t count)
+{
+	sim_queue * queue = new sim_queue();
+
+	sim_initKernel();
+	queue->length = length;
+	queue->itemSize = itemSize;
+	queue->storage.resize((size_t)length * itemSize);
+	queue->head = 0;
+	queue->count = count;
+
+	return queue;
+}
+
+BaseType_t sim_sendQueue(QueueHandle_t queue, const void * item, TickType_t ticks, bool front, bool overwrite, BaseType_t * woken)
+{
+	uint64_t deadline = sim_getDeadline(ticks);
+
+	while ((queue->count >= queue->length) && !overwrite) {
+		if ((NULL != woken) || !sim_block(&queue->waitSend, deadline)) {
+			return errQUEUE_FULL;
+		}
+	}
+
+	if (0 < queue->itemSize) {
+		UBaseType_t slot;
+
+		if (overwrite && (queue->count >= queue->length)) {
+			// a queue of one item is overwritten in place
+			slot = (queue->head + queue->count - 1) % queue->length;
+		} else if (front) {
+			queue->head = (queue->head + queue->length - 1) % queue->length;
+			slot = queue->head;
+			queue->count++;
+		} else {
+			slot = (queue->head + queue->count) % queue->length;
+			queue->count++;
+		}
+		memcpy(&queue->storage[(size_t)slot * queue->itemSize], item, queue->itemSize);
+	} else if (queue->count < queue->length) {
+		queue->count++;
+	}
+
+	if (sim_readyFirst(&queue->waitReceive) && (NULL != woken)) {
+		*woken = pdTRUE;
+	}
+	if (NULL == woken) {
+		sim_preempt();
+	}
+
+	return pdPASS;
+}
+
+BaseType_t sim_receiveQueue(QueueHandle_t queue, void * buffer, TickType_t ticks, bool peek, BaseType_t * woken)
+{
+	uint64_t deadline = sim_getDeadline(ticks);
+
+	while (0 == queue->count) {
+		if ((NULL != woken) || !sim_block(&queue->waitReceive, deadline)) {
+			return pdFALSE;
+		}
+	}
+
+	if (0 < queue->itemSize) {
+		memcpy(buffer, &queue->storage[(size_t)queue->head * queue->itemSize], queue->itemSize);
+	}
+	if (peek) {
+		return pdPASS;
+	}
+	queue->head = (queue->head + 1) % queue->length;
+	queue->count--;
+
+	if (sim_readyFirst(&queue->waitSend) && (NULL != woken)) {
+		*woken = pdTRUE;
+	}
+	if (NULL == woken) {
+		sim_preempt();
+	}
+
+	return pdPASS;
+}
+
+/* queues */
+
+QueueHandle_t xQueueCreate(UBaseType_t uxQueueLength, UBaseType_t uxItemSize)
+{
+	return sim_createQueue(uxQueueLength, uxItemSize, 0);
+}
+
+void vQueueDelete(QueueHandle_t xQueue)
+{
+	if ((NULL != xQueue) && xQueue->waitSend.empty() && xQueue->waitReceive.empty()) {
+		delete xQueue;
+	}
+}
+
+BaseType_t xQueueSend(QueueHandle_t xQueue, const void * pvItemToQueue, TickType_t xTicksToWait)
+{
+	return sim_sendQueue(xQueue, pvItemToQueue, xTicksToWait, false, false, NULL);
+}
+
+BaseType_t xQueueSendToBack(QueueHandle_t xQueue, const void * pvItemToQueue, TickType_t xTicksToWait)
+{
+	return sim_sendQueue(xQueue, pvItemToQueue, xTicksToWait, false, false, NULL);
+}
+
+BaseType_t xQueueSendToFront(QueueHandle_t xQueue, const void * pvItemToQueue, TickType_t xTicksToWait)
+{
+	return sim_sendQueue(xQueue, pvItemToQueue, xTicksToWait, true, false, NULL);
+}
+
+BaseType_t xQueueSendFromISR(QueueHandle_t xQueue, const void * pvItemToQueue, BaseType_t * pxHigherPriorityTaskWoken)
+{
+	BaseType_t woken = pdFALSE;
+	BaseType_t result = sim_sendQueue(xQueue, pvItemToQueue, 0, false, false, &woken);
+
+	if (NULL != pxHigherPriorityTaskWoken) {
+		*pxHigherPriorityTaskWoken |= woken;
+	}
+	return result;
+}
+
+BaseType_t xQueueSendToBackFromISR(QueueHandle_t xQueue, const void * pvItemToQueue, BaseType_t * pxHigherPriorityTaskWoken)
+{
+	return xQueueSendFromISR(xQueue, pvItemToQueue, pxHigherPriorityTaskWoken);
+}
+
+BaseType_t xQueueOverwrite(QueueHandle_t xQueue, const void * pvItemToQueue)
+{
+	return sim_sendQueue(xQueue, pvItemToQueue, 0, false, true, NULL);
+}
+
+BaseType_t xQueueReceive(QueueHandle_t xQueue, void * pvBuffer, TickType_t xTicksToWait)
+{
+	return sim_receiveQueue(xQueue, pvBuffer, xTicksToWait, false, NULL);
+}
+
+BaseType_t xQueueReceiveFromISR(QueueHandle_t xQueue, void * pvBuffer, BaseType_t * pxHigherPriorityTaskWoken)
+{
+	BaseType_t woken = pdFALSE;
+	BaseType_t result = sim_receiveQueue(xQueue, pvBuffer, 0, false, &woken);
+
+	if (NULL != pxHigherPriorityTaskWoken) {
+		*pxHigherPriorityTaskWoken |= woken;
+	}
+	return result;
+}
+
+BaseType_t xQueuePeek(QueueHandle_t xQueue, void * pvBuffer, TickType_t xTicksToWait)
+{
+	return sim_receiveQueue(xQueue, pvBuffer, xTicksToWait, true, NULL);
+}
+
+BaseType_t xQueueReset(QueueHandle_t xQueue)
+{
+	xQueue->head = 0;
+	xQueue->count = 0;
+	while (!xQueue->waitSend.empty()) {
+		sim_readyFirst(&xQueue->waitSend);
+	}
+	sim_preempt();
+
+	return pdPASS;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t xQueue)
+{
+	return xQueue->count;
+}
+
+UBaseType_t uxQueueSpacesAvailable(QueueHandle_t xQueue)
+{
+	return xQueue->length - xQueue->count;
+}
+
+/* semaphores */
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void)
+{
+	return sim_createQueue(1, 0, 1);
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary(void)
+{
+	return sim_createQueue(1, 0, 0);
+}
+
+SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t uxMaxCount, UBaseType_t uxInitialCount)
+{
+	return sim_createQueue(uxMaxCount, 0, uxInitialCount);
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t xSemaphore)
+{
+	vQueueDelete(xSemaphore);
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t xSemaphore, TickType_t xTicksToWait)
+{
+	return sim_receiveQueue(xSemaphore, NULL, xTicksToWait, false, NULL);
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t xSemaphore)
+{
+	// a semaphore that is given already fails as in FreeRTOS
+	if (xSemaphore->count >= xSemaphore->length) {
+		return pdFAIL;
+	}
+	return sim_sendQueue(xSemaphore, NULL, 0, false, false, NULL);
+}
+
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t xSemaphore, BaseType_t * pxHigherPriorityTaskWoken)
+{
+	return xQueueSendFromISR(xSemaphore, NULL, pxHigherPriorityTaskWoken);
+}
@@ -0,0 +1,73 @@
+// --------------------------------------------------------
+// Copyright (c) 2025 rapid4mifu 
+//
+// These codes are licensed under GPL v3.0
+// https://opensource.org/license/GPL-3.0
+// --------------------------------------------------------
+
+// This software module is related to the scripts and the timeline of the host shim
+//  (the steps are interrupts at their virtual time, the same script gives
+//   the same timeline on every run)
+
+#include "sim.h"
+#include "sim_kernel.h"
+
+// interval of the contact bounces [us]
+#define SIM_BOUNCE_PERIOD (1000)
+
+static bool recordTimeline = false;
+static std::vector<sim_tl_event_t> timeline;
+
+static void sim_scriptLevel(uint64_t time, uint8_t pin, uint8_t level, uint32_t bounces);
+
+// the level settles after the contact bounced the given number of times
+void sim_scriptLevel(uint64_t time, uint8_t pin, uint8_t level, uint32_t bounces)
+{
+	uint8_t other = (LOW != level) ? LOW : HIGH;
+
+	for (uint32_t i = 0; i < bounces; i++) {
+		SIM_at(time, [pin, level] { SIM_setPin(pin, level); });
+		time += SIM_BOUNCE_PERIOD;
+		SIM_at(time, [pin, other] { SIM_setPin(pin, other); });
+		time += SIM_BOUNCE_PERIOD;
+	}
+	SIM_at(time, [pin, level] { SIM_setPin(pin, level); });
+}
+
+void sim_record(int kind, uint32_t source, uint32_t value, const void * data, size_t len)
+{
+	if (!recordTimeline) {
+		return;
+	}
+	timeline.push_back({ sim_getNow(), (sim_tl_kind_t)kind, source, value,
+		(NULL != data) ? std::string((const char *)data, len) : std::string() });
+}
+
+/* control of the simulation (sim.h) */
+
+void SIM_at(uint64_t time, std::function<void()> step)
+{
+	sim_addEvent(time, 0, step);
+}
+
+// a press of the given duration (from the settled press to the first release edge)
+void SIM_pressPin(uint64_t time, uint8_t pin, uint8_t active, uint64_t duration, uint32_t bounces)
+{
+	uint8_t release = (LOW != active) ? LOW : HIGH;
+
+	sim_scriptLevel(time, pin, active, bounces);
+	sim_scriptLevel(time + (uint64_t)bounces * 2 * SIM_BOUNCE_PERIOD + duration, pin, release, bounces);
+}
+
+void SIM_recordTimeline(bool record)
+{
+	recordTimeline = record;
+}
+
+std::vector<sim_tl_event_t> SIM_takeTimeline(void)
+{
+	std::vector<sim_tl_event_t> events;
+
+	events.swap(timeline);
+	return events;
+}
@@ -0,0 +1,216 @@
+// --------------------------------------------------------
+// Copyright (c) 2025 rapid4mifu 
+//
+// These codes are licensed under GPL v3.0
+// https://opensource.org/license/GPL-3.0
+// --------------------------------------------------------
+
+// This software module is related to the software timers of the host shim
+//  (the callbacks run in the timer service task, the commands apply at once)
+
+#include "sim_kernel.h"
+
+#define SIM_TIMER_TASK_NAME "Tmr Svc"
+#define SIM_TIMER_TASK_STACK (2048)
+
+struct sim_timer {
+	std::string name;
+	TickType_t period;
+	bool autoReload;
+	void * id;
+	TimerCallbackFunction_t callback;
+	bool active;
+	uint64_t expiry;	// tick of the next expiry
+};
+
+static std::vector<sim_timer *> timers;
+static TaskHandle_t hTaskTimer = NULL;
+
+static void sim_processTimers(void * pvParameters);
+static sim_timer * sim_findDueTimer(uint64_t tick);
+static uint64_t sim_getNextExpiry(void);
+static BaseType_t sim_startTimer(TimerHandle_t timer);
+
+void sim_startTimerTask(void)
+{
+	xTaskCreate(sim_processTimers, SIM_TIMER_TASK_NAME, SIM_TIMER_TASK_STACK, NULL, configTIMER_TASK_PRIORITY, &hTaskTimer);
+}
+
+void sim_processTimers(void * pvParameters)
+{
+	while (true) {
+		sim_timer * timer;
+
+		while (NULL != (timer = sim_findDueTimer(sim_getTick()))) {
+			if (timer->autoReload) {
+				// the period counts from the expected expiry
+				timer->expiry += timer->period;
+			} else {
+				timer->active = false;
+			}
+			timer->callback(timer);
+		}
+
+		uint64_t next = sim_getNextExpiry();
+		sim_block(NULL, (SIM_TIME_FOREVER != next) ? (next * SIM_US_PER_TICK) : SIM_TIME_FOREVER);
+	}
+}
+
+sim_timer * sim_findDueTimer(uint64_t tick)
+{
+	sim_timer * due = NULL;
+
+	for (sim_timer * timer : timers) {
+		if (timer->active && (timer->expiry <= tick) && ((NULL == due) || (timer->expiry < due->expiry))) {
+			due = timer;
+		}
+	}
+
+	return due;
+}
+
+uint64_t sim_getNextExpiry(void)
+{
+	uint64_t next = SIM_TIME_FOREVER;
+
+	for (sim_timer * timer : timers) {
+		if (timer->active && (timer->expiry < next)) {
+			next = timer->expiry;
+		}
+	}
+
+	return next;
+}
+
+BaseType_t sim_startTimer(TimerHandle_t timer)
+{
+	if (NULL == timer) {
+		return pdFAIL;
+	}
+
+	timer->expiry = sim_getTick() + timer->period;
+	timer->active = true;
+	sim_setWake(hTaskTimer, timer->expiry * SIM_US_PER_TICK);
+
+	return pdPASS;
+}
+
+TimerHandle_t xTimerCreate(const char * pcTimerName, TickType_t xTimerPeriodInTicks, UBaseType_t uxAutoReload,
+	void * pvTimerID, TimerCallbackFunction_t pxCallbackFunction)
+{
+	sim_timer * timer;
+
+	sim_initKernel();
+	if (0 == xTimerPeriodInTicks) {
+		return NULL;
+	}
+
+	timer = new sim_timer();
+	timer->name = (NULL != pcTimerName) ? pcTimerName : "";
+	timer->period = xTimerPeriodInTicks;
+	timer->autoReload = (pdFALSE != uxAutoReload);
+	timer->id = pvTimerID;
+	timer->callback = pxCallbackFunction;
+	timer->active = false;
+	timer->expiry = 0;
+	timers.push_back(timer);
+
+	return timer;
+}
+
+BaseType_t xTimerStart(TimerHandle_t xTimer, TickType_t xTicksToWait)
+{
+	(void)xTicksToWait;
+	return sim_startTimer(xTimer);
+}
+
+BaseType_t xTimerStop(TimerHandle_t xTimer, TickType_t xTicksToWait)
+{
+	(void)xTicksToWait;
+	if (NULL == xTimer) {
+		return pdFAIL;
+	}
+
+	xTimer->active = false;
+	return pdPASS;
+}
+
+BaseType_t xTimerReset(TimerHandle_t xTimer, TickType_t xTicksToWait)
+{
+	(void)xTicksToWait;
+	return sim_startTimer(xTimer);
+}
+
+BaseType_t xTimerChangePeriod(TimerHandle_t xTimer, TickType_t xNewPeriod, TickType_t xTicksToWait)
+{
+	(void)xTicksToWait;
+	if ((NULL == xTimer) || (0 == xNewPeriod)) {
+		return pdFAIL;
+	}
+
+	xTimer->period = xNewPeriod;
+	return sim_startTimer(xTimer);
+}
+
+BaseType_t xTimerDelete(TimerHandle_t xTimer, TickType_t xTicksToWait)
+{
+	(void)xTicksToWait;
+	for (auto it = timers.begin(); it != timers.end(); ++it) {
+		if (*it == xTimer) {
+			timers.erase(it);
+			delete xTimer;
+			return pdPASS;
+		}
+	}
+
+	return pdFAIL;
+}
+
+BaseType_t xTimerStartFromISR(TimerHandle_t xTimer, BaseType_t * pxHigherPriorityTaskWoken)
+{
+	(void)pxHigherPriorityTaskWoken;
+	return sim_startTimer(xTimer);
+}
+
+BaseType_t xTimerStopFromISR(TimerHandle_t xTimer, BaseType_t * pxHigherPriorityTaskWoken)
+{
+	(void)pxHigherPriorityTaskWoken;
+	return xTimerStop(xTimer, 0);
+}
+
+BaseType_t xTimerResetFromISR(TimerHandle_t xTimer, BaseType_t * pxHigherPriorityTaskWoken)
+{
+	(void)pxHigherPriorityTaskWoken;
+	return sim_startTimer(xTimer);
+}
+
+BaseType_t xTimerIsTimerActive(TimerHandle_t xTimer)
+{
+	return ((NULL != xTimer) && xTimer->active) ? pdTRUE : pdFALSE;
+}
+
+TickType_t xTimerGetPeriod(TimerHandle_t xTimer)
+{
+	return xTimer->period;
+}
+
+TickType_t xTimerGetExpiryTime(TimerHandle_t xTimer)
+{
+	// in the ticks of xTaskGetTickCount
+	return (TickType_t)(xTimer->expiry - sim_getTick()) + xTaskGetTickCount();
+}
+
+void * pvTimerGetTimerID(TimerHandle_t xTimer)
+{
+	return xTimer->id;
+}
+
+void vTimerSetTimerID(TimerHandle_t xTimer, void * pvNewID)
+{
+	xTimer->id = pvNewID;
+}
+
+const char * pcTimerGetName(TimerHandle_t xTimer)
+{
+	return xTimer->name.c_str();
+}
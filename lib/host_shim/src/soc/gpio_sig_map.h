@@ -0,0 +1,15 @@
+// --------------------------------------------------------
+// Copyright (c) 2025 rapid4mifu 
+//
+// These codes are licensed under GPL v3.0
+// https://opensource.org/license/GPL-3.0
+// --------------------------------------------------------
+
+// GPIO matrix signals of the host shim
+
+#ifndef __SHIM_GPIO_SIG_MAP_H__	/* 二重定義防止 */
+
+#define SIG_GPIO_OUT_IDX 256
+
+#endif /* __SHIM_GPIO_SIG_MAP_H__*/	/* 二重定義防止 */
+#define __SHIM_GPIO_SIG_MAP_H__	/* 二重定義防止 */
@@ -15,114 +15,362 @@ noUiSlider.create(duty_slider, {
 });
 
 var bytes_pre = new Uint8Array(4);
+var status = new Uint8Array(5);
+var duty_out = 0;
+var channel = parseInt(new URLSearchParams(location.search).get('ch')) || 0;	// output channel (index.html?ch=N)
 var mode;
 var dir = 0;
 var xctrl = false;
 var aliveTimer = null;
 
-const parseSokeck = (bytes) => {
-	if (0x04 == bytes[0]) {
-		resetAliveTimer();
-
-		// byte index : 1
-		if (bytes_pre[1] != bytes[1]) {
-			// モード
-			mode = bytes[1] & 0x0F;
-			//console.info('mode : ' + mode);
-
-			// 進行方向
-			dir = (bytes[1] & 0x30) >> 4;
-			//console.info('dir : ' + dir);
-			switch (dir) {
-				case 1:
-					document.getElementById("out-fwd").style.fill = 'green';
-					document.getElementById("out-rvs").style.fill = 'currentColor';
-					break;
-				case 2:
-					document.getElementById("out-fwd").style.fill = 'currentColor';
-					document.getElementById("out-rvs").style.fill = 'green';
-					break;
-				default:
-					document.getElementById("out-fwd").style.fill = 'currentColor';
-					document.getElementById("out-rvs").style.fill = 'currentColor';
-			}
+// スコープ（1kHz のテレメトリ）
+const SCOPE_LEN = 2000;	// samples on the chart (2 s)
+var scopeDuty = new Uint16Array(SCOPE_LEN);
+var scopeVin = new Uint16Array(SCOPE_LEN);
+var scopeCurr = new Uint16Array(SCOPE_LEN);
+var scopePos = 0;
+var scopeDropped = 0;
+var scopeDrawing = false;
+
+// タスクプロファイル（スロット毎）
+var perfTasks = [];
+
+// チェックサムを付加してCOBSエンコードする
+const encodePacket = (cmd) => {
+	const packet = new Uint8Array(cmd.length + 3);
+	var sum = 0;
+	var code = 0;
+
+	packet.set(cmd, 1);
+	for (var i = 0; i < cmd.length; i++) {
+		sum += cmd[i];
+	}
+	// checksum (the sum of all bytes including checksum is zero)
+	packet[cmd.length + 1] = (0x100 - (sum & 0xFF)) & 0xFF;
+
+	for (var i = 1; i <= cmd.length + 1; i++) {
+		if (0 == packet[i]) {
+			packet[code] = i - code;
+			code = i;
 		}
-		bytes_pre[1] = bytes[1];
-
-		// 外部通信制御
-		if (bytes[2] & 0x01) {
-			// 外部通信制御：有効
-			if (false == xctrl) {
-				xctrl = true;
-				console.info("external control is enable.");
-
-				// 外部通信制御 定期処理
-				const xctrlTImer = setInterval(() => {
-					if (xctrl) {
-						console.count("update_speed");
-						update_speed();
-					} else {
-						console.countReset("update_speed");
-						clearInterval(xctrlTImer);
-					}
-				}, 200);
-			}
+	}
+	packet[code] = cmd.length + 2 - code;
+	// delimiter
+	packet[cmd.length + 2] = 0;
+
+	return packet;
+};
+
+// COBSデコードしてチェックサムを検証する
+const decodePacket = (packet) => {
+	var len = packet.length;
+	var next = 0;
+	var sum = 0;
+
+	if (len && 0 == packet[len - 1]) {
+		len--;
+	}
+	if (len < 3) {
+		return null;
+	}
+
+	const bytes = new Uint8Array(len);
+	for (var i = 0; i < len; i++) {
+		if (0 == packet[i]) {
+			return null;
+		}
+		if (i == next) {
+			next = i + packet[i];
+			bytes[i] = 0;
 		} else {
-			// 外部通信制御：無効
-			if (xctrl) {
-				xctrl = false;
-				console.info("external control is disable.");
-			}
+			bytes[i] = packet[i];
 		}
+		sum += bytes[i];
+	}
+	if (next != len || 0 != (sum & 0xFF)) {
+		return null;
+	}
 
-		// 状態・システム
-		if (bytes[2] & 0x80) {
-			// 異常
-			document.getElementById("state-mcu").style.color = 'red';
-		} else {
-			// 正常
-			document.getElementById("state-mcu").style.color = 'green';
+	// command id and data (without checksum)
+	return bytes.subarray(1, len - 1);
+};
+
+const parseSokeck = (packet) => {
+	const raw = new Uint8Array(packet);
+	if ((2 < raw.length) && (0 == raw[0]) && (0x53 == raw[1])) {
+		// ストリームのブロック（COBSではない）
+		parseStream(raw);
+		return;
+	}
+
+	// 1つのフレームに複数のパケット（区切りは 0x00）
+	var start = 0;
+	for (var i = 0; i < raw.length; i++) {
+		if (0 == raw[i]) {
+			parsePacket(raw.subarray(start, i + 1));
+			start = i + 1;
 		}
+	}
+	if (start < raw.length) {
+		parsePacket(raw.subarray(start));
+	}
+};
 
-		// 状態・出力
-		if (bytes[2] & 0x20) {
-			document.getElementById("state-out").style.color = 'red';
-		} else if (2 == mode) {
-			document.getElementById("state-out").style.color = 'green';
-		} else {
-			document.getElementById("state-out").style.color = 'currentColor';
-		}
-		
-		// 入力電圧
-		var volInput = bytes[3]*0.1;
-		//console.info('volOut : ' + volOut);
-		if (10 > volInput) {
-			document.getElementById("volt-in").textContent = '!' + volInput.toFixed(1);
-		} else {
-			document.getElementById("volt-in").textContent = volInput.toFixed(1);
-		}
-
-		// 入力電圧
-		var tempCpu = bytes[4] - 128;
-		//console.info('volOut : ' + volOut);
-		if (-10 >= tempCpu) {
-			document.getElementById("temp-cpu").textContent = '-' + tempCpu;
-		} else if (0 > tempCpu) {
-			document.getElementById("temp-cpu").textContent = '!-' + tempCpu;
-		} else if (10 > tempCpu) {
-			document.getElementById("temp-cpu").textContent = '!!' + tempCpu;
-		} else if (100 > tempCpu) {
-			document.getElementById("temp-cpu").textContent = '!' + tempCpu;
+const parsePacket = (raw) => {
+	const bytes = decodePacket(raw);
+	if (null == bytes) {
+		console.warn("invalid packet ... ", raw);
+	} else if (0x04 == bytes[0]) {
+		// 全体の状態（出力状態はチャネル0）
+		if (0 == channel) {
+			status.set(bytes.subarray(0, 5));
 		} else {
-			document.getElementById("temp-cpu").textContent = tempCpu;
+			status.set(bytes.subarray(3, 5), 3);
 		}
-
+		updateStatus(status);
+	} else if (0x20 == (bytes[0] & 0xF0)) {
+		// 差分の状態（マスクの上位4ビットはチャネル）
+		var mask = bytes[1];
+		var idx = 2;
+		if (channel != (mask >> 4)) {
+			return;
+		}
+		if (mask & 0x01) {
+			status[1] = bytes[idx++];
+		}
+		if (mask & 0x02) {
+			status[2] = bytes[idx++];
+		}
+		if (mask & 0x04) {
+			duty_out = bytes[idx] + (bytes[idx + 1] << 8);
+			idx += 2;
+		}
+		updateStatus(status);
+	} else if (0x40 == (bytes[0] & 0xF0)) {
+		// 電流・電力（チャネル指定）
+		if (channel == bytes[1]) {
+			var currAvg = (bytes[4] + (bytes[5] << 8)) * 0.001;
+			document.getElementById("curr-out").textContent = currAvg.toFixed(2);
+		}
+	} else if (0x60 == (bytes[0] & 0xF0)) {
+		// タスクプロファイル（全体）
+		parsePerf(bytes);
+	} else if (0x70 == (bytes[0] & 0xF0)) {
+		// タスクプロファイル（タスク毎）
+		parsePerfTask(bytes);
 	} else {
 		console.warn("unknown data ... ", bytes);
 	}
 };
 setCallbackMessage(parseSokeck);
 
+// [id][tasks][cpu load 0.1% (2)][free heap 64B (2)][minimum free heap 64B (2)][sampling us (2)]
+const parsePerf = (bytes) => {
+	const view = new DataView(bytes.buffer, bytes.byteOffset, bytes.byteLength);
+	const load = view.getUint16(2, true);
+
+	if (perfTasks.length > bytes[1]) {
+		perfTasks.length = bytes[1];
+	}
+	document.getElementById("perf-info").textContent = 'CPU load ' + ((0xFFFF == load) ? '---' : (load * 0.1).toFixed(1)) + ' %, heap free '
+		+ view.getUint16(4, true) * 64 + ' bytes (minimum ' + view.getUint16(6, true) * 64 + ' bytes), sampling ' + view.getUint16(8, true) + ' us';
+	drawPerf();
+};
+
+// [id][slot][cpu 0.1% (2)][free stack (2)][priority][name]
+const parsePerfTask = (bytes) => {
+	const view = new DataView(bytes.buffer, bytes.byteOffset, bytes.byteLength);
+
+	perfTasks[bytes[1]] = {
+		name: String.fromCharCode(...bytes.subarray(7)),
+		cpu: view.getUint16(2, true),
+		stack: view.getUint16(4, true),
+		priority: bytes[6],
+	};
+	drawPerf();
+};
+
+const drawPerf = () => {
+	const tbody = document.getElementById("perf-tasks");
+
+	if (false == document.getElementById("perf").open) {
+		return;
+	}
+	tbody.textContent = '';
+	perfTasks.forEach((task) => {
+		const row = tbody.insertRow();
+		row.insertCell().textContent = task.name;
+		row.insertCell().textContent = (0xFFFF == task.cpu) ? '---' : (task.cpu * 0.1).toFixed(1);
+		row.insertCell().textContent = task.stack;
+		row.insertCell().textContent = task.priority;
+	});
+};
+
+// [0x00][0x53][ch][count][seq (4)][time (4)][dropped (2)]
+// count x [time delta (2)][duty (2)][input voltage 10mV (2)][current mA (2)]
+const parseStream = (bytes) => {
+	const view = new DataView(bytes.buffer, bytes.byteOffset, bytes.byteLength);
+	const count = bytes[3];
+
+	if ((channel != bytes[2]) || (bytes.length < 14 + count * 8)) {
+		return;
+	}
+	scopeDropped += view.getUint16(12, true);
+
+	for (var i = 0; i < count; i++) {
+		const pos = 14 + i * 8;
+		scopeDuty[scopePos] = view.getUint16(pos + 2, true);
+		scopeVin[scopePos] = view.getUint16(pos + 4, true);
+		scopeCurr[scopePos] = view.getUint16(pos + 6, true);
+		scopePos = (scopePos + 1) % SCOPE_LEN;
+	}
+
+	if (false == scopeDrawing) {
+		scopeDrawing = true;
+		requestAnimationFrame(drawScope);
+	}
+};
+
+const drawScope = () => {
+	const canvas = document.getElementById("scope-chart");
+	const ctx = canvas.getContext("2d");
+	const traces = [
+		{ data: scopeDuty, full: 4096, color: 'green' },
+		{ data: scopeVin, full: 3600, color: 'orange' },
+		{ data: scopeCurr, full: 3000, color: 'red' },
+	];
+
+	scopeDrawing = false;
+	ctx.clearRect(0, 0, canvas.width, canvas.height);
+	traces.forEach((trace) => {
+		ctx.strokeStyle = trace.color;
+		ctx.beginPath();
+		for (var i = 0; i < SCOPE_LEN; i++) {
+			const value = trace.data[(scopePos + i) % SCOPE_LEN];
+			const x = i * canvas.width / SCOPE_LEN;
+			const y = canvas.height * (1 - Math.min(value / trace.full, 1));
+			if (0 == i) {
+				ctx.moveTo(x, y);
+			} else {
+				ctx.lineTo(x, y);
+			}
+		}
+		ctx.stroke();
+	});
+
+	const last = (scopePos + SCOPE_LEN - 1) % SCOPE_LEN;
+	document.getElementById("scope-info").textContent = 'duty ' + scopeDuty[last] + ', ' + (scopeVin[last] * 0.01).toFixed(2) + ' V, '
+		+ scopeCurr[last] + ' mA (dropped ' + scopeDropped + ' samples)';
+};
+
+// スコープを開いている間だけ購読する
+document.getElementById("scope").addEventListener('toggle', (event) => {
+	const ar_cmd = new Uint8Array(3);
+	ar_cmd[0] = parseInt('52',16);
+	ar_cmd[1] = channel;
+	ar_cmd[2] = event.target.open ? 1 : 0;
+	scopeDropped = 0;
+
+	sendWebSocketData(encodePacket(ar_cmd));
+});
+
+const updateStatus = (bytes) => {
+	resetAliveTimer();
+
+	// byte index : 1
+	if (bytes_pre[1] != bytes[1]) {
+		// モード
+		mode = bytes[1] & 0x0F;
+		//console.info('mode : ' + mode);
+
+		// 進行方向
+		dir = (bytes[1] & 0x30) >> 4;
+		//console.info('dir : ' + dir);
+		switch (dir) {
+			case 1:
+				document.getElementById("out-fwd").style.fill = 'green';
+				document.getElementById("out-rvs").style.fill = 'currentColor';
+				break;
+			case 2:
+				document.getElementById("out-fwd").style.fill = 'currentColor';
+				document.getElementById("out-rvs").style.fill = 'green';
+				break;
+			default:
+				document.getElementById("out-fwd").style.fill = 'currentColor';
+				document.getElementById("out-rvs").style.fill = 'currentColor';
+		}
+	}
+	bytes_pre[1] = bytes[1];
+
+	// 外部通信制御
+	if (bytes[2] & 0x01) {
+		// 外部通信制御：有効
+		if (false == xctrl) {
+			xctrl = true;
+			console.info("external control is enable.");
+
+			// 外部通信制御 定期処理
+			const xctrlTImer = setInterval(() => {
+				if (xctrl) {
+					console.count("update_speed");
+					update_speed();
+				} else {
+					console.countReset("update_speed");
+					clearInterval(xctrlTImer);
+				}
+			}, 200);
+		}
+	} else {
+		// 外部通信制御：無効
+		if (xctrl) {
+			xctrl = false;
+			console.info("external control is disable.");
+		}
+	}
+
+	// 状態・システム
+	if (bytes[2] & 0x80) {
+		// 異常
+		document.getElementById("state-mcu").style.color = 'red';
+	} else {
+		// 正常
+		document.getElementById("state-mcu").style.color = 'green';
+	}
+
+	// 状態・出力
+	if (bytes[2] & 0x20) {
+		document.getElementById("state-out").style.color = 'red';
+	} else if (2 == mode) {
+		document.getElementById("state-out").style.color = 'green';
+	} else {
+		document.getElementById("state-out").style.color = 'currentColor';
+	}
+	
+	// 入力電圧
+	var volInput = bytes[3]*0.1;
+	//console.info('volOut : ' + volOut);
+	if (10 > volInput) {
+		document.getElementById("volt-in").textContent = '!' + volInput.toFixed(1);
+	} else {
+		document.getElementById("volt-in").textContent = volInput.toFixed(1);
+	}
+
+	// 入力電圧
+	var tempCpu = bytes[4] - 128;
+	//console.info('volOut : ' + volOut);
+	if (-10 >= tempCpu) {
+		document.getElementById("temp-cpu").textContent = '-' + tempCpu;
+	} else if (0 > tempCpu) {
+		document.getElementById("temp-cpu").textContent = '!-' + tempCpu;
+	} else if (10 > tempCpu) {
+		document.getElementById("temp-cpu").textContent = '!!' + tempCpu;
+	} else if (100 > tempCpu) {
+		document.getElementById("temp-cpu").textContent = '!' + tempCpu;
+	} else {
+		document.getElementById("temp-cpu").textContent = tempCpu;
+	}
+};
+
 const resetAliveTimer = () => {
 	clearTimeout(aliveTimer);
 	aliveTimer = setTimeout(() => {
@@ -132,6 +380,7 @@ const resetAliveTimer = () => {
 		document.getElementById("state-out").style.color = 'currentColor';
 		document.getElementById("volt-in").textContent = '--.-';
 		document.getElementById("temp-cpu").textContent = '---';
+		document.getElementById("curr-out").textContent = '-.--';
 		duty_slider.noUiSlider.set(0);
 		dir = 0;
 	}, 1000);
@@ -154,12 +403,13 @@ function sendOutputCmd(duty) {
 			duty1 = duty1 + 128;
 		}
 
-		const ar_cmd = new Uint8Array(3);
-		ar_cmd[0] = parseInt('12',16);
-		ar_cmd[1] = duty0;
-		ar_cmd[2] = duty1;
+		const ar_cmd = new Uint8Array(4);
+		ar_cmd[0] = parseInt('33',16);
+		ar_cmd[1] = channel;
+		ar_cmd[2] = duty0;
+		ar_cmd[3] = duty1;
 
-		sendWebSocketData(ar_cmd);
+		sendWebSocketData(encodePacket(ar_cmd));
 	}
 }
 
@@ -187,10 +437,11 @@ export const OutputOff = () => {
 	dir = 0;
 	duty_slider.noUiSlider.set(0);
 
-	const ar_cmd = new Uint8Array(3);
-	ar_cmd[0] = parseInt('12',16);
-	ar_cmd[1] = parseInt('00',16);
+	const ar_cmd = new Uint8Array(4);
+	ar_cmd[0] = parseInt('33',16);
+	ar_cmd[1] = channel;
 	ar_cmd[2] = parseInt('00',16);
+	ar_cmd[3] = parseInt('00',16);
 
-	sendWebSocketData(ar_cmd);
+	sendWebSocketData(encodePacket(ar_cmd));
 };
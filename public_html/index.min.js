@@ -1 +1,30 @@
-var uri="ws://"+location.hostname+"/ws";var ws_opened=!1;var pingPongTimer=null;var callbackMessage=null;const webSocket=new ReconnectingWebSocket(uri,null,{debug:!0,binaryType:"arraybuffer"});const checkConnection=()=>{setTimeout(()=>{if(null!=webSocket&&ws_opened){webSocket.send("ping")} pingPongTimer=setTimeout(()=>{console.warn('try to reconnect...');pingPongTimer=null;webSocket.refresh()},1000)},4000)};webSocket.onopen=()=>{console.info('socket is opened : ',new Date());ws_opened=!0;checkConnection()};webSocket.onmessage=(event)=>{if('pong'===event.data){clearTimeout(pingPongTimer);return checkConnection()}else if(event.data.constructor===ArrayBuffer){var arr=new Uint8Array(event.data);if(callbackMessage){callbackMessage(arr)}}else{console.warn(event)}};export const setCallbackMessage=(newCallback)=>{callbackMessage=newCallback};export const sendWebSocketDataHex=(hexStrings)=>{if(null!=webSocket&&ws_opened){const hexNumbers=hexStrings.map((hex)=>Number('0x'+hex));const u8=new Uint8Array(hexNumbers);sendWebSocketData(u8)}};export const sendWebSocketData=(data)=>{if(null!=webSocket&&ws_opened){webSocket.send(data)}};var duty_slider=document.getElementById('out-duty');noUiSlider.create(duty_slider,{start:[0],connect:!0,direction:'rtl',orientation:'vertical',behaviour:'tap',range:{'min':0,'max':100},pips:{mode:'count',values:6,density:5}});var bytes_pre=new Uint8Array(4);var mode;var dir=0;var xctrl=!1;var aliveTimer=null;const parseSokeck=(bytes)=>{if(0x04==bytes[0]){resetAliveTimer();if(bytes_pre[1]!=bytes[1]){mode=bytes[1]&0x0F;dir=(bytes[1]&0x30)>>4;switch(dir){case 1:document.getElementById("out-fwd").style.fill='green';document.getElementById("out-rvs").style.fill='currentColor';break;case 2:document.getElementById("out-fwd").style.fill='currentColor';document.getElementById("out-rvs").style.fill='green';break;default:document.getElementById("out-fwd").style.fill='currentColor';document.getElementById("out-rvs").style.fill='currentColor'}} bytes_pre[1]=bytes[1];if(bytes[2]&0x01){if(!1==xctrl){xctrl=!0;console.info("external control is enable.");const xctrlTImer=setInterval(()=>{if(xctrl){console.count("update_speed");update_speed()}else{console.countReset("update_speed");clearInterval(xctrlTImer)}},200)}}else{if(xctrl){xctrl=!1;console.info("external control is disable.")}} if(bytes[2]&0x80){document.getElementById("state-mcu").style.color='red'}else{document.getElementById("state-mcu").style.color='green'} if(bytes[2]&0x20){document.getElementById("state-out").style.color='red'}else if(2==mode){document.getElementById("state-out").style.color='green'}else{document.getElementById("state-out").style.color='currentColor'} var volInput=bytes[3]*0.1;if(10>volInput){document.getElementById("volt-in").textContent='!'+volInput.toFixed(1)}else{document.getElementById("volt-in").textContent=volInput.toFixed(1)} var tempCpu=bytes[4]-128;if(-10>=tempCpu){document.getElementById("temp-cpu").textContent='-'+tempCpu}else if(0>tempCpu){document.getElementById("temp-cpu").textContent='!-'+tempCpu}else if(10>tempCpu){document.getElementById("temp-cpu").textContent='!!'+tempCpu}else if(100>tempCpu){document.getElementById("temp-cpu").textContent='!'+tempCpu}else{document.getElementById("temp-cpu").textContent=tempCpu}}else{console.warn("unknown data ... ",bytes)}};setCallbackMessage(parseSokeck);const resetAliveTimer=()=>{clearTimeout(aliveTimer);aliveTimer=setTimeout(()=>{document.getElementById("out-fwd").style.fill='currentColor';document.getElementById("out-rvs").style.fill='currentColor';document.getElementById("state-mcu").style.color='currentColor';document.getElementById("state-out").style.color='currentColor';document.getElementById("volt-in").textContent='--.-';document.getElementById("temp-cpu").textContent='---';duty_slider.noUiSlider.set(0);dir=0},1000)};function sendOutputCmd(duty){var duty0,duty1;if(dir){if(duty>4095){duty=4095} duty0=duty&0x00FF;duty1=(duty&0x3F00)>>8;if(1==dir){duty1=duty1+64}else if(2==dir){duty1=duty1+128} const ar_cmd=new Uint8Array(3);ar_cmd[0]=parseInt('12',16);ar_cmd[1]=duty0;ar_cmd[2]=duty1;sendWebSocketData(ar_cmd)}} function update_speed(){if(dir){var duty=Math.floor(duty_slider.noUiSlider.get()*4096/100);sendOutputCmd(duty)}} export const OutputOn=(direction)=>{if(direction>2){dir=0}else{dir=direction;sendOutputCmd(0)}};export const OutputStop=()=>{duty_slider.noUiSlider.set(0)};export const OutputOff=()=>{dir=0;duty_slider.noUiSlider.set(0);const ar_cmd=new Uint8Array(3);ar_cmd[0]=parseInt('12',16);ar_cmd[1]=parseInt('00',16);ar_cmd[2]=parseInt('00',16);sendWebSocketData(ar_cmd)}
\ No newline at end of file
+var uri="ws://"+location.hostname+"/ws";var ws_opened=!1;var pingPongTimer=null;var callbackMessage=null;const webSocket=new ReconnectingWebSocket(uri,null,{debug:!0,binaryType:"arraybuffer"});const checkConnection=()=>{setTimeout(()=>{if(null!=webSocket&&ws_opened){webSocket.send("ping")} pingPongTimer=setTimeout(()=>{console.warn('try to reconnect...');pingPongTimer=null;webSocket.refresh()},1000)},4000)};webSocket.onopen=()=>{console.info('socket is opened : ',new Date());ws_opened=!0;checkConnection()};webSocket.onmessage=(event)=>{if('pong'===event.data){clearTimeout(pingPongTimer);return checkConnection()}else if(event.data.constructor===ArrayBuffer){var arr=new Uint8Array(event.data);if(callbackMessage){callbackMessage(arr)}}else{console.warn(event)}};export const setCallbackMessage=(newCallback)=>{callbackMessage=newCallback};export const sendWebSocketDataHex=(hexStrings)=>{if(null!=webSocket&&ws_opened){const hexNumbers=hexStrings.map((hex)=>Number('0x'+hex));const u8=new Uint8Array(hexNumbers);sendWebSocketData(u8)}};export const sendWebSocketData=(data)=>{if(null!=webSocket&&ws_opened){webSocket.send(data)}};var duty_slider=document.getElementById('out-duty');noUiSlider.create(duty_slider,{start:[0],connect:true,direction:'rtl',orientation:'vertical',behaviour:'tap',range:{'min':0,'max':100},pips:{mode:'count',values:6,density:5}});var bytes_pre=new Uint8Array(4);var status=new Uint8Array(5);var duty_out=0;var channel=parseInt(new URLSearchParams(location.search).get('ch'))||0;var mode;var dir=0;var xctrl=false;var aliveTimer=null;const SCOPE_LEN=2000;var scopeDuty=new Uint16Array(SCOPE_LEN);var scopeVin=new Uint16Array(SCOPE_LEN);var scopeCurr=new Uint16Array(SCOPE_LEN);var scopePos=0;var scopeDropped=0;var scopeDrawing=false;var perfTasks=[];const encodePacket=(cmd)=>{const packet=new Uint8Array(cmd.length+3);var sum=0;var code=0;packet.set(cmd,1);for(var i=0;i<cmd.length;i++){sum+=cmd[i];}
+packet[cmd.length+1]=(0x100-(sum&0xFF))&0xFF;for(var i=1;i<=cmd.length+1;i++){if(0==packet[i]){packet[code]=i-code;code=i;}}
+packet[code]=cmd.length+2-code;packet[cmd.length+2]=0;return packet;};const decodePacket=(packet)=>{var len=packet.length;var next=0;var sum=0;if(len&&0==packet[len-1]){len--;}
+if(len<3){return null;}
+const bytes=new Uint8Array(len);for(var i=0;i<len;i++){if(0==packet[i]){return null;}
+if(i==next){next=i+packet[i];bytes[i]=0;}else{bytes[i]=packet[i];}
+sum+=bytes[i];}
+if(next!=len||0!=(sum&0xFF)){return null;}
+return bytes.subarray(1,len-1);};const parseSokeck=(packet)=>{const raw=new Uint8Array(packet);if((2<raw.length)&&(0==raw[0])&&(0x53==raw[1])){parseStream(raw);return;}
+var start=0;for(var i=0;i<raw.length;i++){if(0==raw[i]){parsePacket(raw.subarray(start,i+1));start=i+1;}}
+if(start<raw.length){parsePacket(raw.subarray(start));}};const parsePacket=(raw)=>{const bytes=decodePacket(raw);if(null==bytes){console.warn("invalid packet ... ",raw);}else if(0x04==bytes[0]){if(0==channel){status.set(bytes.subarray(0,5));}else{status.set(bytes.subarray(3,5),3);}
+updateStatus(status);}else if(0x20==(bytes[0]&0xF0)){var mask=bytes[1];var idx=2;if(channel!=(mask>>4)){return;}
+if(mask&0x01){status[1]=bytes[idx++];}
+if(mask&0x02){status[2]=bytes[idx++];}
+if(mask&0x04){duty_out=bytes[idx]+(bytes[idx+1]<<8);idx+=2;}
+updateStatus(status);}else if(0x40==(bytes[0]&0xF0)){if(channel==bytes[1]){var currAvg=(bytes[4]+(bytes[5]<<8))*0.001;document.getElementById("curr-out").textContent=currAvg.toFixed(2);}}else if(0x60==(bytes[0]&0xF0)){parsePerf(bytes);}else if(0x70==(bytes[0]&0xF0)){parsePerfTask(bytes);}else{console.warn("unknown data ... ",bytes);}};setCallbackMessage(parseSokeck);const parsePerf=(bytes)=>{const view=new DataView(bytes.buffer,bytes.byteOffset,bytes.byteLength);const load=view.getUint16(2,true);if(perfTasks.length>bytes[1]){perfTasks.length=bytes[1];}
+document.getElementById("perf-info").textContent='CPU load '+((0xFFFF==load)?'---':(load*0.1).toFixed(1))+' %, heap free '+view.getUint16(4,true)*64+' bytes (minimum '+view.getUint16(6,true)*64+' bytes), sampling '+view.getUint16(8,true)+' us';drawPerf();};const parsePerfTask=(bytes)=>{const view=new DataView(bytes.buffer,bytes.byteOffset,bytes.byteLength);perfTasks[bytes[1]]={name:String.fromCharCode(...bytes.subarray(7)),cpu:view.getUint16(2,true),stack:view.getUint16(4,true),priority:bytes[6],};drawPerf();};const drawPerf=()=>{const tbody=document.getElementById("perf-tasks");if(false==document.getElementById("perf").open){return;}
+tbody.textContent='';perfTasks.forEach((task)=>{const row=tbody.insertRow();row.insertCell().textContent=task.name;row.insertCell().textContent=(0xFFFF==task.cpu)?'---':(task.cpu*0.1).toFixed(1);row.insertCell().textContent=task.stack;row.insertCell().textContent=task.priority;});};const parseStream=(bytes)=>{const view=new DataView(bytes.buffer,bytes.byteOffset,bytes.byteLength);const count=bytes[3];if((channel!=bytes[2])||(bytes.length<14+count*8)){return;}
+scopeDropped+=view.getUint16(12,true);for(var i=0;i<count;i++){const pos=14+i*8;scopeDuty[scopePos]=view.getUint16(pos+2,true);scopeVin[scopePos]=view.getUint16(pos+4,true);scopeCurr[scopePos]=view.getUint16(pos+6,true);scopePos=(scopePos+1)%SCOPE_LEN;}
+if(false==scopeDrawing){scopeDrawing=true;requestAnimationFrame(drawScope);}};const drawScope=()=>{const canvas=document.getElementById("scope-chart");const ctx=canvas.getContext("2d");const traces=[{data:scopeDuty,full:4096,color:'green'},{data:scopeVin,full:3600,color:'orange'},{data:scopeCurr,full:3000,color:'red'},];scopeDrawing=false;ctx.clearRect(0,0,canvas.width,canvas.height);traces.forEach((trace)=>{ctx.strokeStyle=trace.color;ctx.beginPath();for(var i=0;i<SCOPE_LEN;i++){const value=trace.data[(scopePos+i)%SCOPE_LEN];const x=i*canvas.width/SCOPE_LEN;const y=canvas.height*(1-Math.min(value/trace.full,1));if(0==i){ctx.moveTo(x,y);}else{ctx.lineTo(x,y);}}
+ctx.stroke();});const last=(scopePos+SCOPE_LEN-1)%SCOPE_LEN;document.getElementById("scope-info").textContent='duty '+scopeDuty[last]+', '+(scopeVin[last]*0.01).toFixed(2)+' V, '+scopeCurr[last]+' mA (dropped '+scopeDropped+' samples)';};document.getElementById("scope").addEventListener('toggle',(event)=>{const ar_cmd=new Uint8Array(3);ar_cmd[0]=parseInt('52',16);ar_cmd[1]=channel;ar_cmd[2]=event.target.open?1:0;scopeDropped=0;sendWebSocketData(encodePacket(ar_cmd));});const updateStatus=(bytes)=>{resetAliveTimer();if(bytes_pre[1]!=bytes[1]){mode=bytes[1]&0x0F;dir=(bytes[1]&0x30)>>4;switch(dir){case 1:document.getElementById("out-fwd").style.fill='green';document.getElementById("out-rvs").style.fill='currentColor';break;case 2:document.getElementById("out-fwd").style.fill='currentColor';document.getElementById("out-rvs").style.fill='green';break;default:document.getElementById("out-fwd").style.fill='currentColor';document.getElementById("out-rvs").style.fill='currentColor';}}
+bytes_pre[1]=bytes[1];if(bytes[2]&0x01){if(false==xctrl){xctrl=true;console.info("external control is enable.");const xctrlTImer=setInterval(()=>{if(xctrl){console.count("update_speed");update_speed();}else{console.countReset("update_speed");clearInterval(xctrlTImer);}},200);}}else{if(xctrl){xctrl=false;console.info("external control is disable.");}}
+if(bytes[2]&0x80){document.getElementById("state-mcu").style.color='red';}else{document.getElementById("state-mcu").style.color='green';}
+if(bytes[2]&0x20){document.getElementById("state-out").style.color='red';}else if(2==mode){document.getElementById("state-out").style.color='green';}else{document.getElementById("state-out").style.color='currentColor';}
+var volInput=bytes[3]*0.1;if(10>volInput){document.getElementById("volt-in").textContent='!'+volInput.toFixed(1);}else{document.getElementById("volt-in").textContent=volInput.toFixed(1);}
+var tempCpu=bytes[4]-128;if(-10>=tempCpu){document.getElementById("temp-cpu").textContent='-'+tempCpu;}else if(0>tempCpu){document.getElementById("temp-cpu").textContent='!-'+tempCpu;}else if(10>tempCpu){document.getElementById("temp-cpu").textContent='!!'+tempCpu;}else if(100>tempCpu){document.getElementById("temp-cpu").textContent='!'+tempCpu;}else{document.getElementById("temp-cpu").textContent=tempCpu;}};const resetAliveTimer=()=>{clearTimeout(aliveTimer);aliveTimer=setTimeout(()=>{document.getElementById("out-fwd").style.fill='currentColor';document.getElementById("out-rvs").style.fill='currentColor';document.getElementById("state-mcu").style.color='currentColor';document.getElementById("state-out").style.color='currentColor';document.getElementById("volt-in").textContent='--.-';document.getElementById("temp-cpu").textContent='---';document.getElementById("curr-out").textContent='-.--';duty_slider.noUiSlider.set(0);dir=0;},1000);};function sendOutputCmd(duty){var duty0,duty1;if(dir){if(duty>4095){duty=4095;}
+duty0=duty&0x00FF;duty1=(duty&0x3F00)>>8;if(1==dir){duty1=duty1+64;}else if(2==dir){duty1=duty1+128;}
+const ar_cmd=new Uint8Array(4);ar_cmd[0]=parseInt('33',16);ar_cmd[1]=channel;ar_cmd[2]=duty0;ar_cmd[3]=duty1;sendWebSocketData(encodePacket(ar_cmd));}}
+function update_speed(){if(dir){var duty=Math.floor(duty_slider.noUiSlider.get()*4096/100);sendOutputCmd(duty);}}
+export const OutputOn=(direction)=>{if(direction>2){dir=0;}else{dir=direction;sendOutputCmd(0);}};export const OutputStop=()=>{duty_slider.noUiSlider.set(0);};export const OutputOff=()=>{dir=0;duty_slider.noUiSlider.set(0);const ar_cmd=new Uint8Array(4);ar_cmd[0]=parseInt('33',16);ar_cmd[1]=channel;ar_cmd[2]=parseInt('00',16);ar_cmd[3]=parseInt('00',16);sendWebSocketData(encodePacket(ar_cmd));};
\ No newline at end of file
@@ -0,0 +1,91 @@
+# --------------------------------------------------------
+# Copyright (c) 2025 rapid4mifu
+#
+# These codes are licensed under GPL v3.0
+# https://opensource.org/license/GPL-3.0
+# --------------------------------------------------------
+
+# PlatformIO extra script
+#  stages data_dir (public_html) into the build directory and replaces the
+#  text assets by their gzip compressed variant (<file>.gz) before the
+#  LittleFS image is built, the web server sends them with
+#  "Content-Encoding: gzip" (see src/srv_asset.cpp)
+#
+# usage
+#  PlatformIO extra script : runs for buildfs, uploadfs and uploadfsota
+#  standalone              : python scripts/compress_data.py [data_dir] [staged_dir]
+#                            (prints the size of each staged file, the largest
+#                             first, to check them against ASSET_CACHE_BUDGET,
+#                             the staged copy is kept)
+
+import gzip
+import os
+import shutil
+import sys
+import tempfile
+
+# extensions worth compressing (fonts in woff/woff2 are already compressed)
+COMPRESS_EXT = (".html", ".htm", ".css", ".js", ".json", ".svg", ".ttf", ".txt", ".xml", ".ico")
+# keep the original file when the compressed one is not smaller than this ratio
+COMPRESS_RATIO = 0.9
+# targets building the file system image
+FS_TARGETS = ("buildfs", "uploadfs", "uploadfsota")
+
+
+def stage_data(src_dir, dst_dir):
+    if os.path.isdir(dst_dir):
+        shutil.rmtree(dst_dir)
+
+    size_src = 0
+    size_dst = 0
+    for root, _, files in os.walk(src_dir):
+        out = os.path.join(dst_dir, os.path.relpath(root, src_dir))
+        os.makedirs(out, exist_ok=True)
+        for name in files:
+            path = os.path.join(root, name)
+            with open(path, "rb") as f:
+                data = f.read()
+            size_src += len(data)
+
+            if name.lower().endswith(COMPRESS_EXT):
+                # mtime=0 keeps the image reproducible
+                packed = gzip.compress(data, compresslevel=9, mtime=0)
+                if len(packed) < len(data) * COMPRESS_RATIO:
+                    with open(os.path.join(out, name + ".gz"), "wb") as f:
+                        f.write(packed)
+                    size_dst += len(packed)
+                    continue
+
+            shutil.copy2(path, os.path.join(out, name))
+            size_dst += len(data)
+
+    print("Compressed data : %d -> %d bytes (%s)" % (size_src, size_dst, dst_dir))
+
+
+def list_staged(dst_dir):
+    sizes = []
+    for root, _, files in os.walk(dst_dir):
+        for name in files:
+            path = os.path.join(root, name)
+            sizes.append((os.path.getsize(path), "/" + os.path.relpath(path, dst_dir).replace(os.sep, "/")))
+
+    for size, path in sorted(sizes, reverse=True):
+        print("%8d %s" % (size, path))
+
+
+try:
+    Import("env")
+except NameError:
+    env = None
+
+if env is not None:
+    if any(target in FS_TARGETS for target in COMMAND_LINE_TARGETS):
+        data_dir = env.subst("$PROJECT_DATA_DIR")
+        staged_dir = os.path.join(env.subst("$BUILD_DIR"), "data")
+        stage_data(data_dir, staged_dir)
+        env.Replace(PROJECT_DATA_DIR=staged_dir)
+elif __name__ == "__main__":
+    root = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..")
+    staged_dir = sys.argv[2] if len(sys.argv) > 2 else os.path.join(tempfile.gettempdir(), "rmpp_data")
+    stage_data(sys.argv[1] if len(sys.argv) > 1 else os.path.join(root, "public_html"), staged_dir)
+    list_staged(staged_dir)
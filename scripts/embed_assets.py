@@ -0,0 +1,159 @@
+# --------------------------------------------------------
+# Copyright (c) 2025 rapid4mifu
+#
+# These codes are licensed under GPL v3.0
+# https://opensource.org/license/GPL-3.0
+# --------------------------------------------------------
+
+# Asset table generator
+#  turns public_html into src/assets_embedded.h, a constexpr table linked
+#  into the firmware's rodata (see src/srv_embedded.cpp)
+#
+#  - text assets are stored gzip compressed when it pays off
+#  - the ETag is derived from the stored contents
+#  - the table is indexed by the folded FNV-1a(seed, path) & (size - 1),
+#    the seed is searched until every path has its own slot (perfect hash)
+#
+# usage
+#  PlatformIO extra script : runs when build_flags defines SRV_EMBEDDED_ASSETS
+#  standalone              : python scripts/embed_assets.py [data_dir] [output]
+
+import gzip
+import hashlib
+import os
+import sys
+
+# keep these in sync with scripts/compress_data.py
+COMPRESS_EXT = (".html", ".htm", ".css", ".js", ".json", ".svg", ".ttf", ".txt", ".xml", ".ico")
+COMPRESS_RATIO = 0.9
+# files never requested by the web UI
+SKIP_EXT = (".md",)
+
+MIME_TYPES = {
+    "css": "text/css", "gif": "image/gif", "htm": "text/html", "html": "text/html",
+    "ico": "image/x-icon", "jpeg": "image/jpeg", "jpg": "image/jpeg", "js": "text/javascript",
+    "json": "application/json", "pdf": "application/pdf", "png": "image/png",
+    "svg": "image/svg+xml", "ttf": "font/ttf", "txt": "text/plain", "woff": "font/woff",
+    "woff2": "font/woff2", "xml": "text/xml", "zip": "application/zip",
+}
+
+FNV_PRIME = 16777619
+SEED_MAX = 1 << 20
+
+
+def fnv1a(seed, text):
+    h = seed
+    for c in text.encode("utf-8"):
+        h = ((h ^ c) * FNV_PRIME) & 0xFFFFFFFF
+    # fold the upper bits in, the lower bits of FNV-1a hardly depend on the seed
+    return h ^ (h >> 16)
+
+
+def collect_assets(data_dir):
+    assets = []
+    for root, _, files in os.walk(data_dir):
+        for name in sorted(files):
+            if name.lower().endswith(SKIP_EXT):
+                continue
+            path = os.path.join(root, name)
+            url = "/" + os.path.relpath(path, data_dir).replace(os.sep, "/")
+            with open(path, "rb") as f:
+                data = f.read()
+
+            gzipped = False
+            if name.lower().endswith(COMPRESS_EXT):
+                packed = gzip.compress(data, compresslevel=9, mtime=0)
+                if len(packed) < len(data) * COMPRESS_RATIO:
+                    data = packed
+                    gzipped = True
+
+            ext = name.rsplit(".", 1)[-1].lower() if "." in name else ""
+            assets.append({
+                "url": url,
+                "data": data,
+                "gzip": gzipped,
+                "mime": MIME_TYPES.get(ext, "text/plain"),
+                "etag": '"' + hashlib.sha1(data).hexdigest()[:16] + '"',
+            })
+    return sorted(assets, key=lambda a: a["url"])
+
+
+def find_seed(assets):
+    size = 1
+    while size < len(assets) * 2:
+        size <<= 1
+
+    while True:
+        for seed in range(2166136261, 2166136261 + SEED_MAX):
+            slots = set(fnv1a(seed, a["url"]) & (size - 1) for a in assets)
+            if len(slots) == len(assets):
+                return seed, size
+        size <<= 1
+
+
+def write_header(assets, output):
+    seed, size = find_seed(assets)
+    table = [None] * size
+    for i, a in enumerate(assets):
+        table[fnv1a(seed, a["url"]) & (size - 1)] = i
+
+    lines = [
+        "// This file is generated by scripts/embed_assets.py, do not edit.",
+        "",
+        "#ifndef __ASSETS_EMBEDDED_H",
+        "#define __ASSETS_EMBEDDED_H",
+        "",
+        "#define ASSET_EMBEDDED_SEED (%uUL)" % seed,
+        "#define ASSET_EMBEDDED_SIZE (%u)" % size,
+        "",
+    ]
+    for i, a in enumerate(assets):
+        lines.append("// %s (%u bytes%s)" % (a["url"], len(a["data"]), ", gzip" if a["gzip"] else ""))
+        lines.append("static constexpr uint8_t assetData%u[] = {" % i)
+        data = a["data"]
+        for pos in range(0, len(data), 16):
+            lines.append("\t" + ", ".join("0x%02x" % b for b in data[pos:pos + 16]) + ",")
+        lines.append("};")
+    lines.append("")
+    lines.append("static constexpr asset_embedded_t assetEmbedded[ASSET_EMBEDDED_SIZE] = {")
+    for slot in table:
+        if slot is None:
+            lines.append("\t{NULL, NULL, 0, NULL, NULL, false},")
+        else:
+            a = assets[slot]
+            etag = a["etag"].replace('"', '\\"')
+            lines.append('\t{"%s", assetData%u, sizeof(assetData%u), "%s", "%s", %s},'
+                         % (a["url"], slot, slot, a["mime"], etag, "true" if a["gzip"] else "false"))
+    lines.append("};")
+    lines.append("")
+    lines.append("#endif")
+    lines.append("")
+
+    text = "\n".join(lines)
+    # keep the timestamp (and the build) when nothing changed
+    if os.path.exists(output):
+        with open(output, "r") as f:
+            if f.read() == text:
+                return
+    with open(output, "w") as f:
+        f.write(text)
+    print("Embedded assets : %u files, %u bytes, %u slots (%s)"
+          % (len(assets), sum(len(a["data"]) for a in assets), size, output))
+
+
+def embed(data_dir, output):
+    write_header(collect_assets(data_dir), output)
+
+
+try:
+    Import("env")
+except NameError:
+    env = None
+
+if env is not None:
+    if "SRV_EMBEDDED_ASSETS" in str(env.GetProjectOption("build_flags", "")):
+        embed(env.subst("$PROJECT_DATA_DIR"), os.path.join(env.subst("$PROJECT_SRC_DIR"), "assets_embedded.h"))
+elif __name__ == "__main__":
+    root = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..")
+    embed(sys.argv[1] if len(sys.argv) > 1 else os.path.join(root, "public_html"),
+          sys.argv[2] if len(sys.argv) > 2 else os.path.join(root, "src", "assets_embedded.h"))
@@ -0,0 +1,70 @@
+// --------------------------------------------------------
+// Copyright (c) 2025 rapid4mifu 
+//
+// These codes are licensed under GPL v3.0
+// https://opensource.org/license/GPL-3.0
+// --------------------------------------------------------
+
+// This software module is related to the filter and the scaling of the analog inputs
+
+#include "adc_filter.h"
+
+/******************************************************************************
+* Function Name: ADC_averageRaw
+* Description  : 変換値（生値）の合計から平均の電圧を求める（オーバーサンプリング）
+* Arguments    : sum - sum of the raw counts, count - number of conversions
+* Return Value : average voltage [mV]
+******************************************************************************/
+uint16_t ADC_averageRaw(uint32_t sum, uint32_t count)
+{
+	if (0 == count) {
+		return 0;
+	}
+	return (uint16_t)((uint64_t)sum * ADC_RAW_FULL_MV / ((uint64_t)ADC_RAW_FULL * count));
+}
+
+/******************************************************************************
+* Function Name: ADC_startFilter
+* Description  : 最初のフレームの電圧でフィルタを開始する
+* Arguments    : mv - voltage of the frame [mV]
+* Return Value : filter (ADC_FILTER_SHIFT fractional bits)
+******************************************************************************/
+uint32_t ADC_startFilter(uint16_t mv)
+{
+	return (uint32_t)mv << ADC_FILTER_SHIFT;
+}
+
+/******************************************************************************
+* Function Name: ADC_updateFilter
+* Description  : フレームの電圧を指数移動平均に加える
+* Arguments    : filter - filter (ADC_FILTER_SHIFT fractional bits),
+                 mv - voltage of the frame [mV]
+* Return Value : updated filter
+******************************************************************************/
+uint32_t ADC_updateFilter(uint32_t filter, uint16_t mv)
+{
+	return filter + mv - (filter >> ADC_FILTER_SHIFT);
+}
+
+/******************************************************************************
+* Function Name: ADC_getFilterOutput
+* Description  : フィルタ後の電圧を取得する
+* Arguments    : filter - filter (ADC_FILTER_SHIFT fractional bits)
+* Return Value : voltage [mV]
+******************************************************************************/
+uint16_t ADC_getFilterOutput(uint32_t filter)
+{
+	return (uint16_t)(filter >> ADC_FILTER_SHIFT);
+}
+
+/******************************************************************************
+* Function Name: ADC_scaleDivider
+* Description  : 分圧回路の前の電圧を求める
+* Arguments    : mv - voltage at the pin [mV], div - ratio of the divider (1/div),
+                 unit - unit of the result [mV]
+* Return Value : voltage before the divider [unit]
+******************************************************************************/
+uint32_t ADC_scaleDivider(uint16_t mv, uint32_t div, uint32_t unit)
+{
+	return (uint32_t)mv * div / unit;
+}
@@ -0,0 +1,39 @@
+// --------------------------------------------------------
+// Copyright (c) 2025 rapid4mifu 
+//
+// These codes are licensed under GPL v3.0
+// https://opensource.org/license/GPL-3.0
+// --------------------------------------------------------
+
+// This header file is related to the filter and the scaling of the analog
+//  inputs (see task_adc.h)
+//
+// the conversions of an input are averaged per frame (oversampling, by the
+// driver on ESP32, here from the raw counts on the other targets) and the
+// frames are folded into an exponential moving average, the filter holds
+// the average scaled by 2^ADC_FILTER_SHIFT so that no fraction is lost,
+// a voltage behind a divider is scaled from the voltage at the pin
+
+#ifndef __ADC_FILTER_H
+#define __ADC_FILTER_H
+
+// hardware independent (built on the host as well, see board.h)
+#include <stdint.h>
+#include <stddef.h>
+
+// raw count of the full scale and its voltage [mV] (12 bit, 11 dB attenuation)
+#define ADC_RAW_FULL (4095)
+#define ADC_RAW_FULL_MV (3300)
+
+// time constant of the low-pass filter (2^n frames)
+#ifndef ADC_FILTER_SHIFT
+#define ADC_FILTER_SHIFT (4)
+#endif
+
+uint16_t ADC_averageRaw(uint32_t sum, uint32_t count);
+uint32_t ADC_startFilter(uint16_t mv);
+uint32_t ADC_updateFilter(uint32_t filter, uint16_t mv);
+uint16_t ADC_getFilterOutput(uint32_t filter);
+uint32_t ADC_scaleDivider(uint16_t mv, uint32_t div, uint32_t unit);
+
+#endif /* __ADC_FILTER_H */
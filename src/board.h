@@ -5,7 +5,7 @@
 // https://opensource.org/license/GPL-3.0
 // --------------------------------------------------------
 
-#ifndef __BOARD_H__	/* d`h~ */
+#ifndef __BOARD_H__	/* 二重定義防止 */
 
 #ifndef APP_CPU_NUM
 #define APP_CPU_NUM (1)
@@ -14,12 +14,15 @@
 #define PWM_FRQ 19000
 #define PWM_RES 12
 
+#define RMPP_PIN_NONE 0xFF
+
 #ifdef ARDUINO_M5Stack_ATOM
-// board : M5Stack ATOM Lite
+// board : M5Stack ATOM Lite (the host shim of the native build emulates it)
 #include <esp32/rom/gpio.h>
 #define PIN_PWM1 19
 #define PIN_PWM2 23
 #define PIN_VIN 33
+#define VIN_DIV 11
 
 #define PIN_SW 39
 #define SW_PRESS LOW
@@ -30,9 +33,32 @@
 #define FAULT_CLEAR HIGH
 
 #define PIN_LED 27
+
+// back-EMF sense input (track voltage through the 1/11 divider)
+#ifndef PIN_BEMF
+#define PIN_BEMF 32
+#endif
+#define BEMF_DIV 11
+
+// current sense input (shunt amplifier output, 0.1 ohm x 20 -> 2 V/A)
+//  G32 and G33 are the only ADC1 pins on the headers, so the current sense
+//  takes the place of the back-EMF sense (-D PIN_ISENSE=32 -D PIN_BEMF=0xFF)
+#ifndef PIN_ISENSE
+#define PIN_ISENSE RMPP_PIN_NONE
+#endif
+#define ISENSE_MV_PER_A 2000
+#define ISENSE_OFFSET_MV 0
+
+// output channels (one H-bridge per power district)
+//  { PWM1, PWM2, FAULT, BEMF, ISENSE } per channel, add a line for each extra H-bridge
+//  (BEMF = RMPP_PIN_NONE -> the channel has no back-EMF sense, open loop only,
+//   ISENSE = RMPP_PIN_NONE -> the channel has no current sense, no telemetry)
+#define RMPP_CH_PINS { \
+	{ PIN_PWM1, PIN_PWM2, PIN_FAULT, PIN_BEMF, PIN_ISENSE }, \
+}
 #else
 #error "pin define is not found"
 #endif
 
-#endif /* __BOARD_H__*/	/* d`h~ */
-#define __BOARD_H__	/* d`h~ */
\ No newline at end of file
+#endif /* __BOARD_H__*/	/* 二重定義防止 */
+#define __BOARD_H__	/* 二重定義防止 */
\ No newline at end of file
@@ -5,12 +5,12 @@
 // https://opensource.org/license/GPL-3.0
 // --------------------------------------------------------
 
-#ifndef __CONFIG_H__	/* d`h~ */
+#ifndef __CONFIG_H__	/* 二重定義防止 */
 
 #define CFG_NAMESPACE	"RmppSvw"
 #define HOST_DEFAULT	"rmpp-svw"
 #define AP_SSID_DEFAULT	"RmppSvw-softAP"
 #define AP_PASS_DEFAULT	"p@ss1234"
 
-#endif /* __CONFIG_H__*/	/* d`h~ */
-#define __CONFIG_H__	/* d`h~ */
+#endif /* __CONFIG_H__*/	/* 二重定義防止 */
+#define __CONFIG_H__	/* 二重定義防止 */
@@ -9,6 +9,9 @@
 #include <WiFi.h>
 
 #include "board.h"
+#include "sys_latency.h"
+#include "sys_perf.h"
+#include "task_adc.h"
 #include "task_cfg.h"
 #include "task_cli.h"
 #include "task_input.h"
@@ -19,7 +22,7 @@
 
 void reboot(void) {
 	Serial.println("will be restarted soon ...");
-	vTaskDelay(5000);
+	vTaskDelay(pdMS_TO_TICKS(5000));
 	ESP.restart();
 }
 
@@ -29,17 +32,33 @@ void setup() {
 
 	// ----- UART initialize -----
 	Serial.begin(115200);
-	vTaskDelay(2000);
+	vTaskDelay(pdMS_TO_TICKS(2000));
 
 	// ----- CLI (Command Line Interface) task initialize -----
 	if (false == CLI_initTask()) {
 		reboot();
 	}
+
+	// ----- task profile initialize -----
+	if (false == SYS_initPerf()) {
+		reboot();
+	}
+#ifdef SYS_LATENCY_ENABLE
+	if (false == SYS_initLatency()) {
+		reboot();
+	}
+#endif
 		
 	// ----- RMPP (Railway Model Power Pack) task initialize -----
 	if (false == RMPP_initTask()) {
 		reboot();
 	}
+
+	// ----- ADC task initialize -----
+	// (after the tasks that attach analog inputs)
+	if (false == ADC_initTask()) {
+		reboot();
+	}
 	
 	// ----- Button task initialize -----
 	if (false == INP_initTask()) {
@@ -102,5 +121,5 @@ void setup() {
 
 void loop()
 {
-	vTaskDelay(1000);
+	vTaskDelay(pdMS_TO_TICKS(1000));
 }
@@ -0,0 +1,35 @@
+// --------------------------------------------------------
+// Copyright (c) 2025 rapid4mifu 
+//
+// These codes are licensed under GPL v3.0
+// https://opensource.org/license/GPL-3.0
+// --------------------------------------------------------
+
+// This software module is related to the alive monitoring of the controlling
+//  client of the Railway Model Power Pack (RMPP)
+
+#include "rmpp_alive.h"
+
+/******************************************************************************
+* Function Name: RMPP_feedAlive
+* Description  : コマンドの受信時刻を記録する
+* Arguments    : alive - alive monitoring, tick - current tick
+* Return Value : none
+******************************************************************************/
+void RMPP_feedAlive(rmpp_alive_t * alive, uint32_t tick)
+{
+	alive->tickLast = tick;
+}
+
+/******************************************************************************
+* Function Name: RMPP_isAliveExpired
+* Description  : 最後のコマンドからタイムアウト時間が経過したかを判定する
+*                (ティックカウントの桁あふれを含む)
+* Arguments    : alive - alive monitoring, tick - current tick,
+                 timeout - timeout [tick]
+* Return Value : true -> no command within the timeout
+******************************************************************************/
+bool RMPP_isAliveExpired(const rmpp_alive_t * alive, uint32_t tick, uint32_t timeout)
+{
+	return timeout <= (uint32_t)(tick - alive->tickLast);
+}
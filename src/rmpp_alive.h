@@ -0,0 +1,30 @@
+// --------------------------------------------------------
+// Copyright (c) 2025 rapid4mifu 
+//
+// These codes are licensed under GPL v3.0
+// https://opensource.org/license/GPL-3.0
+// --------------------------------------------------------
+
+// This header file is related to the alive monitoring of the controlling
+//  client of the Railway Model Power Pack (RMPP)
+//
+// every accepted command only stores its tick (no timer is restarted per
+// command), the deadline is checked at the status period, so the output
+// stops between the timeout and the timeout plus one status period after
+// the last command, the tick count may wrap around in between
+
+#ifndef __RMPP_ALIVE_H
+#define __RMPP_ALIVE_H
+
+// hardware independent (built on the host as well, see board.h)
+#include <stdint.h>
+#include <stddef.h>
+
+typedef struct {
+	uint32_t tickLast;	// tick of the last command
+} rmpp_alive_t;
+
+void RMPP_feedAlive(rmpp_alive_t * alive, uint32_t tick);
+bool RMPP_isAliveExpired(const rmpp_alive_t * alive, uint32_t tick, uint32_t timeout);
+
+#endif /* __RMPP_ALIVE_H */
@@ -0,0 +1,160 @@
+// --------------------------------------------------------
+// Copyright (c) 2025 rapid4mifu 
+//
+// These codes are licensed under GPL v3.0
+// https://opensource.org/license/GPL-3.0
+// --------------------------------------------------------
+
+// This software module is related to communication commands
+//  for the Railway Model Power Pack (RMPP)
+
+#include "rmpp_cmd.h"
+
+#include <string.h>
+
+/******************************************************************************
+* Function Name: RMPP_calcChecksum
+* Description  : チェックサムを計算する
+* Arguments    : cmd - command data (command id and data bytes),
+                 len - command length (without checksum)
+* Return Value : checksum (the sum of all bytes including checksum is zero)
+******************************************************************************/
+uint8_t RMPP_calcChecksum(const uint8_t * cmd, uint8_t len)
+{
+	uint8_t sum = 0;
+
+	for (uint8_t i = 0; i < len; i++) {
+		sum += cmd[i];
+	}
+
+	return (uint8_t)(0 - sum);
+}
+
+/******************************************************************************
+* Function Name: RMPP_encodePacket
+* Description  : コマンドにチェックサムを付加してCOBSエンコードする（インプレース）
+* Arguments    : buf - packet buffer (RMPP_PACKET_LEN_MAX bytes),
+                       the command is placed at RMPP_PACKET_CMD(buf)
+                 len - command length (with checksum)
+* Return Value : packet length (with delimiter), 0 -> invalid command length
+******************************************************************************/
+uint8_t RMPP_encodePacket(uint8_t * buf, uint8_t len)
+{
+	uint8_t * cmd = RMPP_PACKET_CMD(buf);
+	uint8_t code = 0;
+
+	if ((RMPP_CMD_LEN_MIN > len) || (RMPP_CMD_LEN_MAX < len)) {
+		return 0;
+	}
+
+	// checksum
+	cmd[len - RMPP_BYTES_CHECKSUM] = RMPP_calcChecksum(cmd, len - RMPP_BYTES_CHECKSUM);
+
+	// each zero byte is replaced by the distance to the next zero byte,
+	// the overhead byte holds the distance to the first one
+	for (uint8_t i = RMPP_BYTES_OVERHEAD; i <= len; i++) {
+		if (0 == buf[i]) {
+			buf[code] = i - code;
+			code = i;
+		}
+	}
+	buf[code] = len + RMPP_BYTES_OVERHEAD - code;
+
+	// delimiter
+	buf[len + RMPP_BYTES_OVERHEAD] = 0;
+
+	return len + RMPP_BYTES_COBS;
+}
+
+/******************************************************************************
+* Function Name: RMPP_decodePacket
+* Description  : COBSパケットをデコードしてチェックサムを検証する（インプレース）
+* Arguments    : buf - packet data, the decoded command is placed at RMPP_PACKET_CMD(buf)
+                 len - packet length (the delimiter may be omitted)
+* Return Value : command length (with checksum), 0 -> malformed packet
+******************************************************************************/
+uint8_t RMPP_decodePacket(uint8_t * buf, size_t len)
+{
+	uint16_t next = 0;
+	uint8_t sum = 0;
+
+	if (len && (0 == buf[len - 1])) {
+		len -= RMPP_BYTES_DELIMITER;
+	}
+
+	// reject by length before touching the data
+	if ((RMPP_CMD_LEN_MIN + RMPP_BYTES_OVERHEAD > len) || (RMPP_CMD_LEN_MAX + RMPP_BYTES_OVERHEAD < len)) {
+		return 0;
+	}
+
+	for (uint8_t i = 0; i < len; i++) {
+		if (0 == buf[i]) {
+			// delimiter inside the packet
+			return 0;
+		}
+
+		if (i == next) {
+			// code byte : restore the zero byte
+			next = i + buf[i];
+			buf[i] = 0;
+		}
+		sum += buf[i];
+	}
+
+	// the code chain must end exactly at the end of the packet
+	if (next != len) {
+		return 0;
+	}
+
+	// checksum
+	if (0 != sum) {
+		return 0;
+	}
+
+	// the command id must match the command length
+	len -= RMPP_BYTES_OVERHEAD;
+	if ((size_t)RMPP_GET_CMD_LEN(buf[RMPP_BYTES_OVERHEAD]) != len) {
+		return 0;
+	}
+
+	return (uint8_t)len;
+}
+
+/******************************************************************************
+* Function Name: RMPP_walkFrame
+* Description  : 受信フレームをパケットに分割し、デコードしたコマンドを順に処理する
+* Arguments    : data - received frame (one or more cobs encoded packets, decoded in place),
+                 len - frame length, id - websocket client id,
+                 handler - handler of each decoded command
+* Return Value : number of commands handed to the handler
+******************************************************************************/
+size_t RMPP_walkFrame(uint8_t * data, size_t len, uint32_t id, rmpp_cmd_handler_t handler)
+{
+	uint8_t * end = data + len;
+	uint8_t * delim;
+	size_t len_packet;
+	uint8_t len_cmd;
+	size_t count = 0;
+
+	// each packet in the frame is terminated by the cobs delimiter,
+	// commands are processed in the order they were packed
+	while (data < end) {
+		delim = (uint8_t *)memchr(data, 0, end - data);
+		if (NULL != delim) {
+			len_packet = delim - data + RMPP_BYTES_DELIMITER;
+		} else {
+			len_packet = end - data;
+		}
+
+		// malformed packets are rejected before parsing the command
+		len_cmd = RMPP_decodePacket(data, len_packet);
+		if (len_cmd) {
+			handler(RMPP_PACKET_CMD(data), len_cmd, id);
+			count++;
+		}
+
+		data += len_packet;
+	}
+
+	return count;
+}
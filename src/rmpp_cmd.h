@@ -7,10 +7,19 @@
 
 // This header file is related to communication commands
 //  for the Railway Model Power Pack (RMPP)
+//
+// packet format (COBS encoded)
+//  [overhead][command id][data ...][checksum][delimiter (0x00)]
+//  the number of data bytes is given by the lower 4 bits of the command id,
+//  and a single WebSocket frame may carry several packets back to back.
 
 #ifndef __RMPP_CMD_H
 #define __RMPP_CMD_H
 
+// hardware independent (built on the host as well, see board.h)
+#include <stdint.h>
+#include <stddef.h>
+
 // number of command id bytes
 #define RMPP_BYTES_CMDID		(1) 
 // number of data bytes
@@ -37,20 +46,82 @@
 #define RMPP_BYTES_DAT_RD_STATUS	(4)
 // number of data bytes for WR_OUTPUT command
 #define RMPP_BYTES_DAT_WR_OUTPUT	(2)
+// number of data bytes for WR_OUTPUT_CH command
+#define RMPP_BYTES_DAT_WR_OUTPUT_CH	(3)
+// number of data bytes for RD_TELEMETRY command
+#define RMPP_BYTES_DAT_RD_TELEMETRY	(11)
+// number of data bytes for WR_STREAM command
+#define RMPP_BYTES_DAT_WR_STREAM	(2)
+// number of data bytes for RD_PERF command
+#define RMPP_BYTES_DAT_RD_PERF		(9)
+// maximum number of data bytes for RD_PERF_TASK command
+#define RMPP_BYTES_DAT_RD_PERF_TASK	(RMPP_BYTES_DAT_MAX)
 
 // number of commad length for RD_STATUS command
 #define RMPP_CMD_LEN_RD_STATUS		(RMPP_CMD_LEN_MIN + RMPP_BYTES_DAT_RD_STATUS)
 // number of commad length for WR_OUTPUT command
 #define RMPP_CMD_LEN_WR_OUTPUT		(RMPP_CMD_LEN_MIN + RMPP_BYTES_DAT_WR_OUTPUT)
+// number of commad length for WR_OUTPUT_CH command
+#define RMPP_CMD_LEN_WR_OUTPUT_CH	(RMPP_CMD_LEN_MIN + RMPP_BYTES_DAT_WR_OUTPUT_CH)
+// number of commad length for RD_TELEMETRY command
+#define RMPP_CMD_LEN_RD_TELEMETRY	(RMPP_CMD_LEN_MIN + RMPP_BYTES_DAT_RD_TELEMETRY)
+// number of commad length for RD_PERF command
+#define RMPP_CMD_LEN_RD_PERF		(RMPP_CMD_LEN_MIN + RMPP_BYTES_DAT_RD_PERF)
 
 // command id for RD_STATUS command
 #define RMPP_CMDID_RD_STATUS		(0x00 | RMPP_BYTES_DAT_RD_STATUS)
-// command id for WR_OUTPUT command
+// command id for WR_OUTPUT command (channel 0)
+//  data : [duty low][direction | duty high]
 #define RMPP_CMDID_WR_OUTPUT		(0x10 | RMPP_BYTES_DAT_WR_OUTPUT)
+// command id for RD_STATUS_DIFF command (variable length)
+//  data : [mask][changed fields in the order of the mask bits]
+#define RMPP_CMDID_RD_STATUS_DIFF(bytes)	(0x20 | (bytes))
+// command id for WR_OUTPUT_CH command
+//  data : [channel][duty low][direction | duty high]
+#define RMPP_CMDID_WR_OUTPUT_CH		(0x30 | RMPP_BYTES_DAT_WR_OUTPUT_CH)
+// command id for RD_TELEMETRY command (channels with a current sense)
+//  data : [channel][current now][current average][current peak][power][input voltage]
+//         current [mA], power [10mW], input voltage [10mV] (2 bytes each, little endian)
+#define RMPP_CMDID_RD_TELEMETRY		(0x40 | RMPP_BYTES_DAT_RD_TELEMETRY)
+// command id for WR_STREAM command (subscribe to the telemetry stream, see rmpp_stream.h)
+//  data : [channel][0 -> unsubscribe, 1 -> subscribe]
+#define RMPP_CMDID_WR_STREAM		(0x50 | RMPP_BYTES_DAT_WR_STREAM)
+// command id for RD_PERF command (system profile, see sys_perf.h)
+//  data : [tasks][cpu load [0.1%] (2)][free heap [64B] (2)][minimum free heap [64B] (2)]
+//         [sampling time [us] (2)] (little endian)
+#define RMPP_CMDID_RD_PERF			(0x60 | RMPP_BYTES_DAT_RD_PERF)
+// command id for RD_PERF_TASK command (one task of the profile, variable length)
+//  data : [slot][cpu [0.1%] (2)][free stack (2)][priority][task name (not terminated)]
+#define RMPP_CMDID_RD_PERF_TASK(bytes)	(0x70 | (bytes))
+
+// mask bits for RD_STATUS_DIFF command
+#define RMPP_STATUS_DIFF_OUTPUT		(0x01)	// output flags (1 byte)
+#define RMPP_STATUS_DIFF_STATUS		(0x02)	// status flags (1 byte)
+#define RMPP_STATUS_DIFF_DUTY		(0x04)	// output duty (2 bytes, little endian)
+// channel of RD_STATUS_DIFF command (upper 4 bits of the mask),
+// RD_STATUS always reports channel 0
+#define RMPP_STATUS_DIFF_CH(ch)		(((ch) & 0x0F) << 4)
+#define RMPP_GET_STATUS_DIFF_CH(mask)	(((mask) >> 4) & 0x0F)
+// maximum number of output channels
+#define RMPP_NUM_CH_MAX				(16)
 
 // get number of data bytes from command id
 #define RMPP_GET_BYTES_DAT(byte)	((byte) & 0x0F)
 // get number of command length from command id
 #define RMPP_GET_CMD_LEN(byte)		(RMPP_GET_BYTES_DAT(byte) + RMPP_CMD_LEN_MIN)
+// get command kind from command id
+#define RMPP_GET_CMD_KIND(byte)		(((byte) >> 4) & 0x0F)
+// number of command kinds
+#define RMPP_NUM_CMD_KIND			(16)
+// get command position in the packet buffer
+#define RMPP_PACKET_CMD(buf)		((buf) + RMPP_BYTES_OVERHEAD)
+
+// handler of a decoded command (cmd - command id and data, len - command length with checksum)
+typedef void (*rmpp_cmd_handler_t)(uint8_t * cmd, uint8_t len, uint32_t id);
+
+uint8_t RMPP_calcChecksum(const uint8_t * cmd, uint8_t len);
+uint8_t RMPP_encodePacket(uint8_t * buf, uint8_t len);
+uint8_t RMPP_decodePacket(uint8_t * buf, size_t len);
+size_t RMPP_walkFrame(uint8_t * data, size_t len, uint32_t id, rmpp_cmd_handler_t handler);
 
 #endif /* __RMPP_CMD_H */
@@ -0,0 +1,169 @@
+// --------------------------------------------------------
+// Copyright (c) 2025 rapid4mifu 
+//
+// These codes are licensed under GPL v3.0
+// https://opensource.org/license/GPL-3.0
+// --------------------------------------------------------
+
+// This software module is related to the acceleration / deceleration ramp
+//  of the output duty for the Railway Model Power Pack (RMPP)
+
+#include "rmpp_ramp.h"
+#include "board.h"
+
+// full duty 4096 in 1.6 s at the top of the table, faster through the dead band
+const uint32_t RMPP_RAMP_TABLE_DEFAULT[RMPP_RAMP_TABLE_LEN] = {
+	3000, 3000, 2400, 1800, 1400, 1200, 1000, 900,
+	800, 750, 700, 650, 650, 650, 650, 650,
+};
+
+/******************************************************************************
+* Function Name: RMPP_resetRamp
+* Description  : ランプを指定のデューティで停止状態にする
+* Arguments    : ramp - ramp state, duty - output duty
+* Return Value : none
+******************************************************************************/
+void RMPP_resetRamp(rmpp_ramp_t * ramp, uint16_t duty)
+{
+	ramp->duty = (uint32_t)duty << RMPP_RAMP_FRAC;
+	ramp->target = ramp->duty;
+	ramp->step = 0;
+	ramp->dist = 0;
+	ramp->rising = false;
+}
+
+/******************************************************************************
+* Function Name: RMPP_setRampTarget
+* Description  : ランプの目標デューティを設定する
+* Arguments    : ramp - ramp state, duty - target duty
+* Return Value : none
+******************************************************************************/
+void RMPP_setRampTarget(rmpp_ramp_t * ramp, uint16_t duty)
+{
+	ramp->target = (uint32_t)duty << RMPP_RAMP_FRAC;
+}
+
+/******************************************************************************
+* Function Name: RMPP_updateRamp
+* Description  : デューティを目標に向けて1周期分変化させる
+* Arguments    : ramp - ramp state,
+                 accel - profile while rising, brake - profile while falling
+* Return Value : true -> the duty has changed, false -> the target is reached
+******************************************************************************/
+bool RMPP_updateRamp(rmpp_ramp_t * ramp, const rmpp_ramp_profile_t * accel, const rmpp_ramp_profile_t * brake)
+{
+	uint32_t duty = ramp->duty;
+	uint32_t target = ramp->target;
+	uint32_t remain;
+	uint32_t step;
+	uint32_t index;
+	bool rising = (target > duty);
+	const rmpp_ramp_profile_t * profile = rising ? accel : brake;
+
+	if (duty == target) {
+		ramp->step = 0;
+		ramp->dist = 0;
+		return false;
+	}
+
+	// the S-curve starts again from zero when the direction turns
+	if (rising != ramp->rising) {
+		ramp->rising = rising;
+		ramp->step = 0;
+		ramp->dist = 0;
+	}
+	remain = rising ? (target - duty) : (duty - target);
+
+	switch (profile->curve) {
+	case RMPP_RAMP_LINEAR:
+		step = profile->step;
+		break;
+	case RMPP_RAMP_SCURVE:
+		// the step grows by the jerk up to the maximum, and shrinks again
+		// once the remaining distance is what it took to grow it
+		// (down to 1/16 of the maximum, so that the rounding of the distance
+		//  does not leave a long crawl at the end)
+		step = ramp->step;
+		if (remain <= ramp->dist) {
+			uint32_t creep = (profile->step >> 4) + profile->jerk;
+			step = (step > creep + profile->jerk) ? (step - profile->jerk) : creep;
+			ramp->dist = (ramp->dist > step) ? (ramp->dist - step) : 0;
+		} else if (step < profile->step) {
+			step += profile->jerk;
+			if (step > profile->step) {
+				step = profile->step;
+			}
+			ramp->dist += step;
+		}
+		ramp->step = step;
+		break;
+	case RMPP_RAMP_TABLE:
+		// the full duty (braking from 100%) is beyond the last segment,
+		// it stays on the last entry instead of wrapping around to the first
+		index = duty >> (RMPP_RAMP_FRAC + PWM_RES - 4);
+		step = profile->table[(RMPP_RAMP_TABLE_LEN > index) ? index : (RMPP_RAMP_TABLE_LEN - 1)];
+		break;
+	default:
+		step = remain;
+		break;
+	}
+
+	if (step >= remain) {
+		ramp->duty = target;
+		ramp->step = 0;
+		ramp->dist = 0;
+		return true;
+	}
+
+	ramp->duty = rising ? (duty + step) : (duty - step);
+
+	return true;
+}
+
+/******************************************************************************
+* Function Name: RMPP_getRampDuty
+* Description  : 現在のデューティを取得する
+* Arguments    : ramp - ramp state
+* Return Value : output duty (integer part)
+******************************************************************************/
+uint16_t RMPP_getRampDuty(const rmpp_ramp_t * ramp)
+{
+	return (uint16_t)(ramp->duty >> RMPP_RAMP_FRAC);
+}
+
+/******************************************************************************
+* Function Name: RMPP_makeRampProfile
+* Description  : 全範囲の変化時間からランプのプロファイルを作成する
+* Arguments    : profile - ramp profile (output), curve - rmpp_ramp_curve_t,
+                 time - time from 0 to the full duty [ms],
+                 duty_full - full duty
+* Return Value : true -> made, false -> curve or time out of range (not changed)
+******************************************************************************/
+bool RMPP_makeRampProfile(rmpp_ramp_profile_t * profile, uint8_t curve, uint32_t time, uint16_t duty_full)
+{
+	uint32_t updates;
+
+	if ((RMPP_RAMP_TABLE < curve) || (RMPP_RAMP_TIME_MAX < time)) {
+		return false;
+	}
+	updates = time * RMPP_RAMP_RATE / 1000;
+
+	profile->curve = curve;
+	profile->table = RMPP_RAMP_TABLE_DEFAULT;
+
+	if (0 == updates) {
+		updates = 1;
+	}
+	profile->step = ((uint32_t)duty_full << RMPP_RAMP_FRAC) / updates;
+	if (0 == profile->step) {
+		profile->step = 1;
+	}
+
+	// the S-curve spends a fifth of the time on each bend
+	profile->jerk = profile->step * 5 / updates;
+	if (0 == profile->jerk) {
+		profile->jerk = 1;
+	}
+
+	return true;
+}
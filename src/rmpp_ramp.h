@@ -0,0 +1,67 @@
+// --------------------------------------------------------
+// Copyright (c) 2025 rapid4mifu 
+//
+// These codes are licensed under GPL v3.0
+// https://opensource.org/license/GPL-3.0
+// --------------------------------------------------------
+
+// This header file is related to the acceleration / deceleration ramp
+//  of the output duty for the Railway Model Power Pack (RMPP)
+//
+// the duty is held in fixed point (RMPP_RAMP_FRAC fractional bits) and
+// moved towards the target once per control period,
+// the acceleration profile is used while the duty rises and
+// the braking profile while it falls
+
+#ifndef __RMPP_RAMP_H
+#define __RMPP_RAMP_H
+
+// hardware independent (built on the host as well, see board.h)
+#include <stdint.h>
+#include <stddef.h>
+
+// control rate of the ramp [Hz]
+#ifndef RMPP_RAMP_RATE
+#define RMPP_RAMP_RATE (1000)
+#endif
+
+// number of fractional bits of the ramp duty
+#define RMPP_RAMP_FRAC (8)
+// number of entries of the step table (one per 1/16 of the full duty)
+#define RMPP_RAMP_TABLE_LEN (16)
+// longest time of a profile from 0 to the full duty [ms]
+//  (the step stays above 1/256 of the duty per update and the time fits in 16 bits)
+#define RMPP_RAMP_TIME_MAX (60000)
+
+typedef enum {
+	RMPP_RAMP_NONE = 0,	/* 即時反映 */
+	RMPP_RAMP_LINEAR,	/* 一定の傾き */
+	RMPP_RAMP_SCURVE,	/* S字（傾きを徐々に変化） */
+	RMPP_RAMP_TABLE		/* デューティ毎の傾きをテーブルで指定 */
+} rmpp_ramp_curve_t;
+
+typedef struct {
+	uint8_t curve;					// rmpp_ramp_curve_t
+	uint32_t step;					// LINEAR, SCURVE : maximum step per update (fixed point)
+	uint32_t jerk;					// SCURVE : step increment per update (fixed point)
+	const uint32_t * table;			// TABLE : step per update for each 1/16 of the full duty
+} rmpp_ramp_profile_t;
+
+typedef struct {
+	uint32_t duty;		// current duty (fixed point)
+	uint32_t target;	// target duty (fixed point)
+	uint32_t step;		// current step (SCURVE)
+	uint32_t dist;		// distance covered while the step was rising (SCURVE)
+	bool rising;		// direction of the current ramp
+} rmpp_ramp_t;
+
+// default step table (momentum curve, quick through the dead band at low duty)
+extern const uint32_t RMPP_RAMP_TABLE_DEFAULT[RMPP_RAMP_TABLE_LEN];
+
+void RMPP_resetRamp(rmpp_ramp_t * ramp, uint16_t duty);
+void RMPP_setRampTarget(rmpp_ramp_t * ramp, uint16_t duty);
+bool RMPP_updateRamp(rmpp_ramp_t * ramp, const rmpp_ramp_profile_t * accel, const rmpp_ramp_profile_t * brake);
+uint16_t RMPP_getRampDuty(const rmpp_ramp_t * ramp);
+bool RMPP_makeRampProfile(rmpp_ramp_profile_t * profile, uint8_t curve, uint32_t time, uint16_t duty_full);
+
+#endif /* __RMPP_RAMP_H */
@@ -0,0 +1,83 @@
+// --------------------------------------------------------
+// Copyright (c) 2025 rapid4mifu 
+//
+// These codes are licensed under GPL v3.0
+// https://opensource.org/license/GPL-3.0
+// --------------------------------------------------------
+
+// This software module is related to the closed-loop speed control
+//  of the Railway Model Power Pack (RMPP)
+
+#include "rmpp_speed.h"
+
+/******************************************************************************
+* Function Name: RMPP_setSpeedGain
+* Description  : 範囲を確認してPI制御のゲインを設定する
+* Arguments    : gain - gains (output),
+                 kp - proportional gain, ki - integral gain (0 to RMPP_SPEED_GAIN_MAX)
+* Return Value : true -> set, false -> out of range (not changed)
+******************************************************************************/
+bool RMPP_setSpeedGain(rmpp_speed_gain_t * gain, int32_t kp, int32_t ki)
+{
+	if ((0 > kp) || (RMPP_SPEED_GAIN_MAX < kp) || (0 > ki) || (RMPP_SPEED_GAIN_MAX < ki)) {
+		return false;
+	}
+	gain->kp = kp;
+	gain->ki = ki;
+
+	return true;
+}
+
+/******************************************************************************
+* Function Name: RMPP_resetSpeedPi
+* Description  : 速度制御の積分項をクリアする
+* Arguments    : pi - controller state
+* Return Value : none
+******************************************************************************/
+void RMPP_resetSpeedPi(rmpp_speed_pi_t * pi)
+{
+	pi->integ = 0;
+}
+
+/******************************************************************************
+* Function Name: RMPP_updateSpeedPi
+* Description  : 逆起電力と目標から出力デューティを1周期分計算する
+* Arguments    : pi - controller state, gain - controller gains,
+                 target - target back-EMF [mV], bemf - measured back-EMF [mV],
+                 feed - feed forward duty, duty_full - full duty
+* Return Value : output duty (0 to duty_full)
+******************************************************************************/
+uint16_t RMPP_updateSpeedPi(rmpp_speed_pi_t * pi, const rmpp_speed_gain_t * gain,
+	int32_t target, int32_t bemf, int32_t feed, uint16_t duty_full)
+{
+	const int32_t limit = (int32_t)duty_full << RMPP_SPEED_GAIN_FRAC;
+	int32_t err = target - bemf;
+	int32_t integ = pi->integ + err * gain->ki;
+	int32_t duty;
+
+	if (integ > limit) {
+		integ = limit;
+	} else if (integ < -limit) {
+		integ = -limit;
+	}
+
+	duty = feed + ((err * gain->kp + integ) >> RMPP_SPEED_GAIN_FRAC);
+
+	// anti-windup : the integral is held while the output is saturated
+	//  in the direction the error is pushing it
+	if (duty > duty_full) {
+		duty = duty_full;
+		if (err < 0) {
+			pi->integ = integ;
+		}
+	} else if (duty < 0) {
+		duty = 0;
+		if (err > 0) {
+			pi->integ = integ;
+		}
+	} else {
+		pi->integ = integ;
+	}
+
+	return (uint16_t)duty;
+}
@@ -0,0 +1,56 @@
+// --------------------------------------------------------
+// Copyright (c) 2025 rapid4mifu 
+//
+// These codes are licensed under GPL v3.0
+// https://opensource.org/license/GPL-3.0
+// --------------------------------------------------------
+
+// This header file is related to the closed-loop speed control
+//  of the Railway Model Power Pack (RMPP)
+//
+// the speed of the motor is measured as its back-EMF while the output is
+// gated off, and a PI controller (integer gains with RMPP_SPEED_GAIN_FRAC
+// fractional bits) corrects the duty on top of the open-loop feed forward
+
+#ifndef __RMPP_SPEED_H
+#define __RMPP_SPEED_H
+
+// hardware independent (built on the host as well, see board.h)
+#include <stdint.h>
+#include <stddef.h>
+
+// control rate of the speed loop [Hz]
+#ifndef RMPP_SPEED_RATE
+#define RMPP_SPEED_RATE (100)
+#endif
+
+// number of fractional bits of the gains and the integral
+#define RMPP_SPEED_GAIN_FRAC (8)
+
+// default gains
+#ifndef RMPP_SPEED_KP
+#define RMPP_SPEED_KP 256 // [1/256 duty / mV]
+#endif
+#ifndef RMPP_SPEED_KI
+#define RMPP_SPEED_KI 48 // [1/256 duty / mV] per update
+#endif
+
+// largest gain [1/256 duty / mV]
+//  (an error within 16 bits keeps the products and the integral within 32 bits)
+#define RMPP_SPEED_GAIN_MAX (1 << 14)
+
+typedef struct {
+	int32_t kp;		// proportional gain [duty / mV] (fixed point)
+	int32_t ki;		// integral gain per update [duty / mV] (fixed point)
+} rmpp_speed_gain_t;
+
+typedef struct {
+	int32_t integ;	// integral term [duty] (fixed point)
+} rmpp_speed_pi_t;
+
+bool RMPP_setSpeedGain(rmpp_speed_gain_t * gain, int32_t kp, int32_t ki);
+void RMPP_resetSpeedPi(rmpp_speed_pi_t * pi);
+uint16_t RMPP_updateSpeedPi(rmpp_speed_pi_t * pi, const rmpp_speed_gain_t * gain,
+	int32_t target, int32_t bemf, int32_t feed, uint16_t duty_full);
+
+#endif /* __RMPP_SPEED_H */
@@ -0,0 +1,180 @@
+// --------------------------------------------------------
+// Copyright (c) 2025 rapid4mifu 
+//
+// These codes are licensed under GPL v3.0
+// https://opensource.org/license/GPL-3.0
+// --------------------------------------------------------
+
+// This software module is related to the telemetry streaming
+//  of the Railway Model Power Pack (RMPP)
+
+#include "rmpp_stream.h"
+
+#include <atomic>
+
+static_assert(0 == (RMPP_STREAM_RING_LEN & (RMPP_STREAM_RING_LEN - 1)), "RMPP_STREAM_RING_LEN must be a power of 2");
+static_assert(RMPP_STREAM_BLOCK <= RMPP_STREAM_RING_LEN, "RMPP_STREAM_RING_LEN must hold a block");
+static_assert(RMPP_STREAM_BLOCK <= 0xFF, "the sample count of a block is a single byte");
+
+/* sample ring (single producer : ADC task, single consumer : server task) */
+static rmpp_stream_sample_t ringSample[RMPP_STREAM_RING_LEN];
+static std::atomic<uint32_t> ringHead(0);	// write position (producer)
+static std::atomic<uint32_t> ringTail(0);	// read position (consumer)
+static std::atomic<bool> resetRequired(false);
+
+static std::atomic<uint8_t> streamCh(0);
+static std::atomic<uint32_t> cntPushed(0);
+static std::atomic<uint32_t> cntDropped(0);
+static uint32_t cntDroppedReported = 0;
+static uint32_t cntBlocks = 0;
+
+static uint8_t * rmpp_putUint16(uint8_t * buf, uint16_t value);
+static uint8_t * rmpp_putUint32(uint8_t * buf, uint32_t value);
+
+/******************************************************************************
+* Function Name: RMPP_setStreamChannel
+* Description  : ストリーミングするチャネルを設定する
+* Arguments    : index - channel id
+* Return Value : none
+******************************************************************************/
+void RMPP_setStreamChannel(uint8_t index)
+{
+	streamCh.store(index);
+}
+
+/******************************************************************************
+* Function Name: RMPP_getStreamChannel
+* Description  : ストリーミングするチャネルを取得する
+* Arguments    : none
+* Return Value : channel id
+******************************************************************************/
+uint8_t RMPP_getStreamChannel(void)
+{
+	return streamCh.load(std::memory_order_relaxed);
+}
+
+/******************************************************************************
+* Function Name: RMPP_pushStreamSample
+* Description  : サンプルをリングに追加する（ADCタスクから呼び出す）
+* Arguments    : sample - sample to push
+* Return Value : true  -> a whole block has been pushed since the last one,
+                 false -> no block yet or the sample was dropped (ring full)
+******************************************************************************/
+bool RMPP_pushStreamSample(const rmpp_stream_sample_t * sample)
+{
+	uint32_t head = ringHead.load(std::memory_order_relaxed);
+
+	if (RMPP_STREAM_RING_LEN <= (head - ringTail.load(std::memory_order_acquire))) {
+		cntDropped.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+
+	ringSample[head & (RMPP_STREAM_RING_LEN - 1)] = *sample;
+	ringHead.store(head + 1, std::memory_order_release);
+
+	return (0 == (cntPushed.fetch_add(1, std::memory_order_relaxed) + 1) % RMPP_STREAM_BLOCK);
+}
+
+/******************************************************************************
+* Function Name: RMPP_packStreamBlock
+* Description  : リングからサンプルを1ブロック分取り出して送信データを作成する
+*                (サーバタスクから呼び出す)
+* Arguments    : buf - block buffer, size - buffer size
+* Return Value : block length (0 -> a whole block is not ready)
+******************************************************************************/
+size_t RMPP_packStreamBlock(uint8_t * buf, size_t size)
+{
+	uint32_t tail = ringTail.load(std::memory_order_relaxed);
+	uint32_t head = ringHead.load(std::memory_order_acquire);
+	uint32_t dropped;
+	uint32_t timePrev;
+	uint8_t * pos = buf;
+
+	// the samples queued before the subscription are discarded
+	if (resetRequired.exchange(false)) {
+		tail = head;
+		ringTail.store(tail, std::memory_order_release);
+	}
+
+	if ((RMPP_STREAM_BLOCK > (head - tail)) || (RMPP_STREAM_BLOCK_LEN > size)) {
+		return 0;
+	}
+
+	dropped = cntDropped.load(std::memory_order_relaxed);
+	timePrev = ringSample[tail & (RMPP_STREAM_RING_LEN - 1)].time;
+
+	*pos++ = 0x00;
+	*pos++ = RMPP_STREAM_MARKER;
+	*pos++ = RMPP_getStreamChannel();
+	*pos++ = RMPP_STREAM_BLOCK;
+	pos = rmpp_putUint32(pos, tail);
+	pos = rmpp_putUint32(pos, timePrev);
+	pos = rmpp_putUint16(pos, (uint16_t)((0xFFFF > (dropped - cntDroppedReported)) ? (dropped - cntDroppedReported) : 0xFFFF));
+	cntDroppedReported = dropped;
+
+	// the time is sent as the difference from the previous sample
+	for (uint8_t i = 0; i < RMPP_STREAM_BLOCK; i++) {
+		const rmpp_stream_sample_t * sample = &ringSample[(tail + i) & (RMPP_STREAM_RING_LEN - 1)];
+		uint32_t delta = sample->time - timePrev;
+
+		pos = rmpp_putUint16(pos, (uint16_t)((0xFFFF > delta) ? delta : 0xFFFF));
+		pos = rmpp_putUint16(pos, sample->duty);
+		pos = rmpp_putUint16(pos, sample->vin);
+		pos = rmpp_putUint16(pos, sample->current);
+		timePrev = sample->time;
+	}
+
+	ringTail.store(tail + RMPP_STREAM_BLOCK, std::memory_order_release);
+	cntBlocks++;
+
+	return pos - buf;
+}
+
+/******************************************************************************
+* Function Name: RMPP_resetStream
+* Description  : リングに残っているサンプルを次のブロック作成時に破棄する
+* Arguments    : none
+* Return Value : none
+******************************************************************************/
+void RMPP_resetStream(void)
+{
+	resetRequired.store(true);
+}
+
+/******************************************************************************
+* Function Name: RMPP_getStreamStats
+* Description  : ストリーミングの統計情報を取得する
+* Arguments    : stats - statistics (output)
+* Return Value : none
+******************************************************************************/
+void RMPP_getStreamStats(rmpp_stream_stats_t * stats)
+{
+	stats->pushed = cntPushed.load(std::memory_order_relaxed);
+	stats->dropped = cntDropped.load(std::memory_order_relaxed);
+	stats->blocks = cntBlocks;
+}
+
+/******************************************************************************
+* Function Name: rmpp_putUint16
+* Description  : 16ビット値をリトルエンディアンで書き込む
+* Arguments    : buf - write position, value - value to write
+* Return Value : next write position
+******************************************************************************/
+uint8_t * rmpp_putUint16(uint8_t * buf, uint16_t value)
+{
+	buf[0] = value & 0xFF;
+	buf[1] = value >> 8;
+	return buf + 2;
+}
+
+/******************************************************************************
+* Function Name: rmpp_putUint32
+* Description  : 32ビット値をリトルエンディアンで書き込む
+* Arguments    : buf - write position, value - value to write
+* Return Value : next write position
+******************************************************************************/
+uint8_t * rmpp_putUint32(uint8_t * buf, uint32_t value)
+{
+	buf = rmpp_putUint16(buf, value & 0xFFFF);
+	return rmpp_putUint16(buf, value >> 16);
+}
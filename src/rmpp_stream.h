@@ -0,0 +1,62 @@
+// --------------------------------------------------------
+// Copyright (c) 2025 rapid4mifu 
+//
+// These codes are licensed under GPL v3.0
+// https://opensource.org/license/GPL-3.0
+// --------------------------------------------------------
+
+// This header file is related to the telemetry streaming
+//  of the Railway Model Power Pack (RMPP)
+//
+// samples are pushed by the ADC task and packed into blocks by the server
+// task through a single producer / single consumer ring
+//
+// block format (a WebSocket frame of its own, not COBS encoded)
+//  [0x00][RMPP_STREAM_MARKER][channel][count]
+//  [sequence of the first sample (4)][time of the first sample [us] (4)]
+//  [samples dropped since the previous block (2)]
+//  count x [time delta [us] (2)][duty (2)][input voltage [10mV] (2)][current [mA] (2)]
+//  (little endian, the leading 0x00 never starts a COBS packet)
+
+#ifndef __RMPP_STREAM_H
+#define __RMPP_STREAM_H
+
+// hardware independent (built on the host as well, see board.h)
+#include <stdint.h>
+#include <stddef.h>
+
+// sample rate [Hz]
+#ifndef RMPP_STREAM_RATE
+#define RMPP_STREAM_RATE (1000)
+#endif
+// samples per block
+#define RMPP_STREAM_BLOCK (64)
+// samples kept in the ring (power of 2)
+#define RMPP_STREAM_RING_LEN (256)
+
+#define RMPP_STREAM_MARKER (0x53)
+#define RMPP_STREAM_HEADER_LEN (14)
+#define RMPP_STREAM_SAMPLE_LEN (8)
+#define RMPP_STREAM_BLOCK_LEN (RMPP_STREAM_HEADER_LEN + RMPP_STREAM_BLOCK * RMPP_STREAM_SAMPLE_LEN)
+
+typedef struct {
+	uint32_t time;		// sampling time [us]
+	uint16_t duty;		// output duty
+	uint16_t vin;		// input voltage [10mV]
+	uint16_t current;	// output current [mA]
+} rmpp_stream_sample_t;
+
+typedef struct {
+	uint32_t pushed;	// samples pushed by the producer
+	uint32_t dropped;	// samples dropped (ring full)
+	uint32_t blocks;	// blocks packed
+} rmpp_stream_stats_t;
+
+void RMPP_setStreamChannel(uint8_t index);
+uint8_t RMPP_getStreamChannel(void);
+bool RMPP_pushStreamSample(const rmpp_stream_sample_t * sample);
+size_t RMPP_packStreamBlock(uint8_t * buf, size_t size);
+void RMPP_resetStream(void);
+void RMPP_getStreamStats(rmpp_stream_stats_t * stats);
+
+#endif /* __RMPP_STREAM_H */
@@ -0,0 +1,679 @@
+// --------------------------------------------------------
+// Copyright (c) 2025 rapid4mifu 
+//
+// These codes are licensed under GPL v3.0
+// https://opensource.org/license/GPL-3.0
+// --------------------------------------------------------
+
+// This software module is related to the static assets
+//  served by the web server from LittleFS
+
+#include "srv_asset.h"
+#include "srv_embedded.h"
+#include "task_cli.h"
+
+#include <LittleFS.h>
+#include <memory>
+#include <stdlib.h>
+#include <string.h>
+
+#define ASSET_SUFFIX_GZIP ".gz"
+#define ASSET_SUFFIX_SOURCE ".src"
+#define ASSET_LEN_ETAG 24
+#define ASSET_HASH_CHUNK 256
+
+// FNV-1a (64 bit) of the contents gives the ETag
+#define ASSET_FNV_OFFSET 14695981039346656037ULL
+#define ASSET_FNV_PRIME 1099511628211ULL
+
+typedef struct {
+	const char * ext;	// file extension (without dot)
+	const char * type;	// MIME type
+} asset_mime_t;
+
+// sorted by extension (strcmp order) for binary search
+static const asset_mime_t mimeList[] = {
+	{"css",		"text/css"},
+	{"gif",		"image/gif"},
+	{"gz",		"application/gzip"},
+	{"htm",		"text/html"},
+	{"html",	"text/html"},
+	{"ico",		"image/x-icon"},
+	{"jpeg",	"image/jpeg"},
+	{"jpg",		"image/jpeg"},
+	{"js",		"text/javascript"},
+	{"json",	"application/json"},
+	{"pdf",		"application/pdf"},
+	{"png",		"image/png"},
+	{"svg",		"image/svg+xml"},
+	{"ttf",		"font/ttf"},
+	{"txt",		"text/plain"},
+	{"woff",	"font/woff"},
+	{"woff2",	"font/woff2"},
+	{"xml",		"text/xml"},
+	{"zip",		"application/zip"},
+};
+
+// directories of the third party libraries and fonts,
+// rename the file when it is updated, the browser will not ask again
+static const char * const cacheLongDirs[] = {
+	"/css/",
+	"/font/",
+	"/js/",
+};
+
+// asset held in RAM
+typedef struct {
+	String path;				// requested path
+	bool acceptGzip;			// the request accepted gzip
+	bool gzipped;				// data is gzip compressed
+	bool variant;				// compressed variant exists
+	const char * contentType;	// MIME type (static string)
+	char etag[ASSET_LEN_ETAG];	// entity tag
+	uint8_t * data;				// file contents
+	size_t len;					// file size
+	uint32_t lastUse;			// LRU tick
+} asset_cache_t;
+
+// entity tag of a file (hashed at the first read)
+typedef struct {
+	String path;				// file path in the file system
+	char etag[ASSET_LEN_ETAG];	// entity tag
+} asset_etag_t;
+
+// the responses in flight keep the entry alive after it was evicted
+typedef std::shared_ptr<asset_cache_t> asset_cache_ptr_t;
+
+static asset_cache_ptr_t cacheList[ASSET_CACHE_ENTRIES];
+static asset_etag_t etagList[ASSET_ETAG_ENTRIES];
+static uint8_t etagNext = 0;		// slot replaced next (round robin)
+static SemaphoreHandle_t xMutexCache = NULL;
+static size_t cacheBudget = 0;		// RAM budget [bytes]
+static size_t cacheUsed = 0;		// RAM in use [bytes]
+static uint32_t cacheTick = 0;		// LRU tick
+static bool cachePsram = false;		// entries are allocated in PSRAM
+static asset_stats_t stStats = {};
+
+static int asset_compareMime(const void * key, const void * entry);
+static bool asset_isCacheLong(const String & path);
+static bool asset_acceptsGzip(AsyncWebServerRequest * request);
+static uint64_t asset_hashData(uint64_t hash, const uint8_t * data, size_t len);
+static void asset_makeEtag(char * etag, uint64_t hash);
+static void asset_getEtag(File & file, const String & pathFile, char * etag);
+static void asset_addCacheHeaders(AsyncWebServerResponse * response, const String & path, const char * etag, bool variant);
+static asset_cache_ptr_t asset_findCache(const String & path, bool acceptGzip);
+static asset_cache_ptr_t asset_loadCache(File & file, const String & path, bool acceptGzip);
+static void asset_insertCache(asset_cache_ptr_t entry);
+static void asset_freeCache(asset_cache_t * entry);
+static void asset_sendCache(AsyncWebServerRequest * request, asset_cache_ptr_t entry);
+static void asset_printCache(cli_cmd_t command);
+#ifdef SRV_EMBEDDED_ASSETS
+static void asset_sendEmbedded(AsyncWebServerRequest * request, const asset_embedded_t * asset);
+#endif
+
+/******************************************************************************
+* Function Name: ASSET_initCache
+* Description  : 静的ファイルのRAMキャッシュを初期化する
+* Arguments    : none
+* Return Value : true  -> initialization succeeded,
+                 false -> initialization failed
+******************************************************************************/
+bool ASSET_initCache(void)
+{
+	xMutexCache = xSemaphoreCreateMutex();
+	if (NULL == xMutexCache) {
+		Serial.println(" [failure] Failed to create asset cache mutex.");
+		return false;
+	}
+
+#if defined(ESP32)
+	cachePsram = psramFound();
+#endif
+	cacheBudget = cachePsram ? ASSET_CACHE_BUDGET_PSRAM : ASSET_CACHE_BUDGET;
+	Serial.printf(" Asset cache : %u bytes (%s)\n", cacheBudget, cachePsram ? "PSRAM" : "heap");
+
+	CLI_addCommand("CACHE", asset_printCache);
+
+	return true;
+}
+
+/******************************************************************************
+* Function Name: ASSET_clearCache
+* Description  : 静的ファイルのRAMキャッシュを破棄する（ファイルシステム更新時）
+* Arguments    : none
+* Return Value : none
+******************************************************************************/
+void ASSET_clearCache(void)
+{
+	if (NULL == xMutexCache) {
+		return;
+	}
+
+	xSemaphoreTake(xMutexCache, portMAX_DELAY);
+	for (uint8_t i = 0; i < ASSET_CACHE_ENTRIES; i++) {
+		cacheList[i].reset();
+	}
+	for (uint8_t i = 0; i < ASSET_ETAG_ENTRIES; i++) {
+		etagList[i].path = "";
+	}
+	cacheUsed = 0;
+	stStats.invalidations++;
+	xSemaphoreGive(xMutexCache);
+}
+
+/******************************************************************************
+* Function Name: ASSET_getStats
+* Description  : 静的ファイルのRAMキャッシュの統計情報を取得する
+* Arguments    : stats - statistics (output)
+* Return Value : none
+******************************************************************************/
+void ASSET_getStats(asset_stats_t * stats)
+{
+	*stats = stStats;
+}
+
+/******************************************************************************
+* Function Name: ASSET_getMimeType
+* Description  : ファイルの拡張子からMIMEタイプを取得する
+* Arguments    : path - file path
+* Return Value : MIME type ("text/plain" -> unknown extension)
+******************************************************************************/
+const char * ASSET_getMimeType(const String & path)
+{
+	int dot = path.lastIndexOf('.');
+	int slash = path.lastIndexOf('/');
+
+	if ((0 > dot) || (dot < slash)) {
+		return "text/plain";
+	}
+
+	const char * ext = path.c_str() + dot + 1;
+	const asset_mime_t * mime = (const asset_mime_t *)bsearch(ext, mimeList,
+		sizeof(mimeList) / sizeof(mimeList[0]), sizeof(mimeList[0]), asset_compareMime);
+
+	return (NULL != mime) ? mime->type : "text/plain";
+}
+
+/******************************************************************************
+* Function Name: ASSET_sendFile
+* Description  : LittleFSのファイルを応答する（圧縮済みファイル・キャッシュ対応）
+* Arguments    : request - HTTP request,
+                 path - file path ("<path>.src" -> source of <path> as plain text)
+* Return Value : true -> responded, false -> file not found
+******************************************************************************/
+bool ASSET_sendFile(AsyncWebServerRequest * request, const String & path)
+{
+	uint32_t start = micros();
+	String pathFile = path;
+	const char * contentType;
+	bool download = request->hasArg("download");
+	bool acceptGzip = asset_acceptsGzip(request);
+	bool gzipped = false;
+	bool variant = false;
+
+#ifdef SRV_EMBEDDED_ASSETS
+	if (!download) {
+		// served from the firmware image
+		const asset_embedded_t * asset = ASSET_findEmbedded(path.c_str());
+		if (NULL != asset) {
+			asset_sendEmbedded(request, asset);
+			stStats.embedded++;
+			return true;
+		}
+	}
+#endif
+
+	if (!download) {
+		// served from RAM without touching the file system
+		asset_cache_ptr_t entry = asset_findCache(path, acceptGzip);
+		if (entry) {
+			asset_sendCache(request, entry);
+			stStats.hits++;
+			stStats.hit_us += micros() - start;
+			return true;
+		}
+	}
+
+	if (path.endsWith(ASSET_SUFFIX_SOURCE)) {
+		pathFile = path.substring(0, path.lastIndexOf('.'));
+		contentType = "text/plain";
+	} else {
+		contentType = ASSET_getMimeType(path);
+	}
+
+	if (download) {
+		contentType = "application/octet-stream";
+	} else {
+		// the build step keeps only the compressed file of the text assets
+		String pathGzip = pathFile + ASSET_SUFFIX_GZIP;
+		if (LittleFS.exists(pathGzip)) {
+			variant = true;
+			if (acceptGzip || !LittleFS.exists(pathFile)) {
+				pathFile = pathGzip;
+				gzipped = true;
+			}
+		}
+	}
+
+	File file = LittleFS.open(pathFile, "r");
+	if (!file || file.isDirectory()) {
+		return false;
+	}
+
+	// the tag follows the contents (the build step does not keep the
+	// modification time, so neither size nor time tell a new image apart)
+	char etag[ASSET_LEN_ETAG] = "";
+
+	if (!download) {
+		stStats.misses++;
+
+		// the next request is served from RAM (asset_sendCache also answers 304)
+		asset_cache_ptr_t entry = asset_loadCache(file, path, acceptGzip);
+		if (entry) {
+			file.close();
+			entry->gzipped = gzipped;
+			entry->variant = variant;
+			entry->contentType = contentType;
+			asset_makeEtag(entry->etag, asset_hashData(ASSET_FNV_OFFSET, entry->data, entry->len));
+			asset_insertCache(entry);
+			asset_sendCache(request, entry);
+			stStats.miss_us += micros() - start;
+			return true;
+		}
+	}
+
+	if (!download) {
+		asset_getEtag(file, pathFile, etag);
+	}
+
+	if (!download && request->hasHeader("If-None-Match") && (request->header("If-None-Match") == etag)) {
+		file.close();
+		AsyncWebServerResponse * response = request->beginResponse(304);
+		asset_addCacheHeaders(response, path, etag, variant);
+		request->send(response);
+		stStats.miss_us += micros() - start;
+		return true;
+	}
+
+#if defined(TARGET_RP2040) || defined(TARGET_RP2350)
+	AsyncWebServerResponse * response = request->beginChunkedResponse(
+		contentType,
+		[file](uint8_t *buffer, size_t maxLen, size_t index) -> size_t {
+			maxLen = 1024;
+			auto localHandle = file;
+			size_t len = localHandle.read(buffer, maxLen);
+			if (len == 0) {
+				localHandle.close();
+			}
+			return len;
+		}
+	);
+#else
+	AsyncWebServerResponse * response = request->beginResponse(file, pathFile, contentType, download);
+#endif
+
+	if (gzipped) {
+		response->addHeader("Content-Encoding", "gzip");
+	}
+	if (!download) {
+		asset_addCacheHeaders(response, path, etag, variant);
+	}
+	request->send(response);
+
+	if (!download) {
+		stStats.uncached++;
+		stStats.miss_us += micros() - start;
+	}
+
+	return true;
+}
+
+/******************************************************************************
+* Function Name: asset_compareMime
+* Description  : MIMEテーブル検索用の比較関数
+* Arguments    : key - file extension, entry - table entry
+* Return Value : comparison result (strcmp)
+******************************************************************************/
+int asset_compareMime(const void * key, const void * entry)
+{
+	return strcmp((const char *)key, ((const asset_mime_t *)entry)->ext);
+}
+
+/******************************************************************************
+* Function Name: asset_isCacheLong
+* Description  : 長期キャッシュの対象か判定する
+* Arguments    : path - file path
+* Return Value : true -> versioned asset, false -> revalidate every time
+******************************************************************************/
+bool asset_isCacheLong(const String & path)
+{
+	for (size_t i = 0; i < sizeof(cacheLongDirs) / sizeof(cacheLongDirs[0]); i++) {
+		if (path.startsWith(cacheLongDirs[i])) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/******************************************************************************
+* Function Name: asset_acceptsGzip
+* Description  : クライアントがgzip圧縮を受け付けるか判定する
+* Arguments    : request - HTTP request
+* Return Value : true -> accepts gzip
+******************************************************************************/
+bool asset_acceptsGzip(AsyncWebServerRequest * request)
+{
+	if (!request->hasHeader("Accept-Encoding")) {
+		return false;
+	}
+
+	return (0 <= request->header("Accept-Encoding").indexOf("gzip"));
+}
+
+/******************************************************************************
+* Function Name: asset_hashData
+* Description  : ファイルの内容のハッシュ値を計算する（FNV-1a 64bit）
+* Arguments    : hash - hash of the preceding data (ASSET_FNV_OFFSET -> start),
+                 data - contents, len - length
+* Return Value : hash value
+******************************************************************************/
+uint64_t asset_hashData(uint64_t hash, const uint8_t * data, size_t len)
+{
+	for (size_t i = 0; i < len; i++) {
+		hash = (hash ^ data[i]) * ASSET_FNV_PRIME;
+	}
+
+	return hash;
+}
+
+/******************************************************************************
+* Function Name: asset_makeEtag
+* Description  : ハッシュ値からETagを生成する
+* Arguments    : etag - entity tag (output, ASSET_LEN_ETAG bytes), hash - hash value
+* Return Value : none
+******************************************************************************/
+void asset_makeEtag(char * etag, uint64_t hash)
+{
+	snprintf(etag, ASSET_LEN_ETAG, "\"%08lx%08lx\"", (unsigned long)(hash >> 32), (unsigned long)(hash & 0xFFFFFFFF));
+}
+
+/******************************************************************************
+* Function Name: asset_getEtag
+* Description  : ファイルのETagを取得する（初回はファイルを読んでハッシュ値を求める）
+* Arguments    : file - opened file (rewound after hashing), pathFile - file path,
+                 etag - entity tag (output, ASSET_LEN_ETAG bytes)
+* Return Value : none
+******************************************************************************/
+void asset_getEtag(File & file, const String & pathFile, char * etag)
+{
+	uint8_t buf[ASSET_HASH_CHUNK];
+	uint64_t hash = ASSET_FNV_OFFSET;
+	size_t len;
+
+	if (NULL != xMutexCache) {
+		xSemaphoreTake(xMutexCache, portMAX_DELAY);
+		for (uint8_t i = 0; i < ASSET_ETAG_ENTRIES; i++) {
+			if (etagList[i].path == pathFile) {
+				strcpy(etag, etagList[i].etag);
+				xSemaphoreGive(xMutexCache);
+				return;
+			}
+		}
+		xSemaphoreGive(xMutexCache);
+	}
+
+	// read once, the tag is kept until the file system is updated
+	while (0 < (len = file.read(buf, sizeof(buf)))) {
+		hash = asset_hashData(hash, buf, len);
+	}
+	file.seek(0);
+	asset_makeEtag(etag, hash);
+
+	if (NULL != xMutexCache) {
+		xSemaphoreTake(xMutexCache, portMAX_DELAY);
+		etagList[etagNext].path = pathFile;
+		strcpy(etagList[etagNext].etag, etag);
+		etagNext = (etagNext + 1) % ASSET_ETAG_ENTRIES;
+		xSemaphoreGive(xMutexCache);
+	}
+}
+
+/******************************************************************************
+* Function Name: asset_addCacheHeaders
+* Description  : キャッシュ制御のヘッダを付加する
+* Arguments    : response - HTTP response, path - requested path,
+                 etag - entity tag, variant - compressed variant exists
+* Return Value : none
+******************************************************************************/
+void asset_addCacheHeaders(AsyncWebServerResponse * response, const String & path, const char * etag, bool variant)
+{
+	response->addHeader("ETag", etag);
+
+	if (asset_isCacheLong(path)) {
+		response->addHeader("Cache-Control", "public, max-age=" + String(ASSET_CACHE_LONG_AGE) + ", immutable");
+	} else {
+		response->addHeader("Cache-Control", "no-cache");
+	}
+
+	if (variant) {
+		response->addHeader("Vary", "Accept-Encoding");
+	}
+}
+
+/******************************************************************************
+* Function Name: asset_findCache
+* Description  : RAMキャッシュからファイルを検索する
+* Arguments    : path - requested path, acceptGzip - the request accepts gzip
+* Return Value : cache entry (empty -> not cached)
+******************************************************************************/
+asset_cache_ptr_t asset_findCache(const String & path, bool acceptGzip)
+{
+	asset_cache_ptr_t entry;
+
+	if (NULL == xMutexCache) {
+		return entry;
+	}
+
+	xSemaphoreTake(xMutexCache, portMAX_DELAY);
+	for (uint8_t i = 0; i < ASSET_CACHE_ENTRIES; i++) {
+		if (cacheList[i] && (cacheList[i]->acceptGzip == acceptGzip) && (cacheList[i]->path == path)) {
+			entry = cacheList[i];
+			entry->lastUse = ++cacheTick;
+			break;
+		}
+	}
+	xSemaphoreGive(xMutexCache);
+
+	return entry;
+}
+
+/******************************************************************************
+* Function Name: asset_loadCache
+* Description  : ファイルをRAMに読み込む
+* Arguments    : file - opened file, path - requested path,
+                 acceptGzip - the request accepts gzip
+* Return Value : cache entry (empty -> too large or out of memory)
+******************************************************************************/
+asset_cache_ptr_t asset_loadCache(File & file, const String & path, bool acceptGzip)
+{
+	asset_cache_ptr_t entry;
+	size_t len = file.size();
+
+	// a single asset must not flush the whole cache
+	if ((NULL == xMutexCache) || (0 == len) || ((cacheBudget / 2) < len)) {
+		return entry;
+	}
+
+#if defined(ESP32)
+	uint8_t * data = (uint8_t *)heap_caps_malloc(len, cachePsram ? MALLOC_CAP_SPIRAM : MALLOC_CAP_8BIT);
+#else
+	uint8_t * data = (uint8_t *)malloc(len);
+#endif
+	if (NULL == data) {
+		return entry;
+	}
+
+	if (len != file.read(data, len)) {
+		// the caller falls back to streaming the file
+		file.seek(0);
+		free(data);
+		return entry;
+	}
+
+	entry = asset_cache_ptr_t(new asset_cache_t(), asset_freeCache);
+	entry->path = path;
+	entry->acceptGzip = acceptGzip;
+	entry->data = data;
+	entry->len = len;
+
+	return entry;
+}
+
+/******************************************************************************
+* Function Name: asset_insertCache
+* Description  : RAMキャッシュに登録する（予算を超える分は古いものから破棄）
+* Arguments    : entry - cache entry
+* Return Value : none
+******************************************************************************/
+void asset_insertCache(asset_cache_ptr_t entry)
+{
+	xSemaphoreTake(xMutexCache, portMAX_DELAY);
+
+	entry->lastUse = ++cacheTick;
+	for (;;) {
+		int8_t slotFree = -1;
+		int8_t slotOld = -1;
+
+		for (uint8_t i = 0; i < ASSET_CACHE_ENTRIES; i++) {
+			if (!cacheList[i]) {
+				slotFree = i;
+			} else if ((cacheList[i]->acceptGzip == entry->acceptGzip) && (cacheList[i]->path == entry->path)) {
+				// loaded twice by concurrent requests
+				cacheUsed -= cacheList[i]->len;
+				cacheList[i].reset();
+				slotFree = i;
+			} else if ((0 > slotOld) || (cacheList[i]->lastUse < cacheList[slotOld]->lastUse)) {
+				slotOld = i;
+			}
+		}
+
+		if ((0 <= slotFree) && (cacheBudget >= cacheUsed + entry->len)) {
+			cacheList[slotFree] = entry;
+			cacheUsed += entry->len;
+			break;
+		}
+		if (0 > slotOld) {
+			break;
+		}
+
+		// evict the least recently used asset
+		cacheUsed -= cacheList[slotOld]->len;
+		cacheList[slotOld].reset();
+		stStats.evictions++;
+	}
+
+	xSemaphoreGive(xMutexCache);
+}
+
+/******************************************************************************
+* Function Name: asset_freeCache
+* Description  : キャッシュエントリを解放する（最後の参照が外れた時）
+* Arguments    : entry - cache entry
+* Return Value : none
+******************************************************************************/
+void asset_freeCache(asset_cache_t * entry)
+{
+	free(entry->data);
+	delete entry;
+}
+
+/******************************************************************************
+* Function Name: asset_sendCache
+* Description  : RAMキャッシュのファイルを応答する
+* Arguments    : request - HTTP request, entry - cache entry
+* Return Value : none
+******************************************************************************/
+void asset_sendCache(AsyncWebServerRequest * request, asset_cache_ptr_t entry)
+{
+	AsyncWebServerResponse * response;
+
+	if (request->hasHeader("If-None-Match") && (request->header("If-None-Match") == entry->etag)) {
+		response = request->beginResponse(304);
+	} else {
+		response = request->beginResponse(entry->contentType, entry->len,
+			[entry](uint8_t *buffer, size_t maxLen, size_t index) -> size_t {
+				size_t len = entry->len - index;
+				if (len > maxLen) {
+					len = maxLen;
+				}
+				memcpy(buffer, entry->data + index, len);
+				return len;
+			}
+		);
+		if (entry->gzipped) {
+			response->addHeader("Content-Encoding", "gzip");
+		}
+		stStats.bytes += entry->len;
+	}
+
+	asset_addCacheHeaders(response, entry->path, entry->etag, entry->variant);
+	request->send(response);
+}
+
+/******************************************************************************
+* Function Name: asset_printCache
+* Description  : RAMキャッシュの状態を表示する（CACHE CLEAR -> 破棄）
+* Arguments    : command.command2 = CLEAR
+* Return Value : none
+******************************************************************************/
+void asset_printCache(cli_cmd_t command)
+{
+	asset_stats_t stats;
+
+	if (0 == strcmp(command.command2, "CLEAR")) {
+		ASSET_clearCache();
+	}
+
+	ASSET_getStats(&stats);
+	command.out->printf("- Budget       : %u / %u bytes (%s)\n", cacheUsed, cacheBudget, cachePsram ? "PSRAM" : "heap");
+	command.out->printf("- Requests     : hit %u, miss %u, uncached %u, embedded %u\n", stats.hits, stats.misses, stats.uncached, stats.embedded);
+	command.out->printf("- Served Bytes : %u\n", stats.bytes);
+	command.out->printf("- Evictions    : %u, invalidations %u\n", stats.evictions, stats.invalidations);
+	command.out->printf("- Handler Time : hit %u us, miss %u us (average)\n",
+		stats.hits ? (stats.hit_us / stats.hits) : 0, stats.misses ? (stats.miss_us / stats.misses) : 0);
+
+	xSemaphoreTake(xMutexCache, portMAX_DELAY);
+	for (uint8_t i = 0; i < ASSET_CACHE_ENTRIES; i++) {
+		if (cacheList[i]) {
+			command.out->printf("  %6u %s%s\n", cacheList[i]->len, cacheList[i]->path.c_str(), cacheList[i]->gzipped ? " (gzip)" : "");
+		}
+	}
+	xSemaphoreGive(xMutexCache);
+}
+
+#ifdef SRV_EMBEDDED_ASSETS
+/******************************************************************************
+* Function Name: asset_sendEmbedded
+* Description  : 組み込みファイルを応答する
+* Arguments    : request - HTTP request, asset - embedded asset
+* Return Value : none
+******************************************************************************/
+void asset_sendEmbedded(AsyncWebServerRequest * request, const asset_embedded_t * asset)
+{
+	AsyncWebServerResponse * response;
+
+	if (request->hasHeader("If-None-Match") && (request->header("If-None-Match") == asset->etag)) {
+		response = request->beginResponse(304);
+	} else {
+		// the response reads the data straight from flash
+		response = request->beginResponse(200, asset->contentType, asset->data, asset->len);
+		if (asset->gzipped) {
+			response->addHeader("Content-Encoding", "gzip");
+		}
+	}
+
+	asset_addCacheHeaders(response, String(asset->path), asset->etag, asset->gzipped);
+	request->send(response);
+}
+#endif
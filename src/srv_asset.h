@@ -0,0 +1,70 @@
+// --------------------------------------------------------
+// Copyright (c) 2025 rapid4mifu 
+//
+// These codes are licensed under GPL v3.0
+// https://opensource.org/license/GPL-3.0
+// --------------------------------------------------------
+
+// This header file is related to the static assets
+//  served by the web server from LittleFS
+//
+// - a precompressed variant (<path>.gz) is preferred when it exists
+// - every response carries an ETag (hash of the contents, taken at the
+//   first read of the file), a matching If-None-Match is answered with
+//   304 Not Modified
+// - assets under ASSET_CACHE_LONG_DIRS are cached by the browser for a year,
+//   the others are revalidated on every page load
+// - recently used assets are held in RAM (PSRAM if available) up to the
+//   budget and served without touching the file system
+// - with SRV_EMBEDDED_ASSETS, public_html is compiled into the firmware
+//   (src/assets_embedded.h, generated by scripts/embed_assets.py) and
+//   looked up by a perfect hash before the file system
+
+#ifndef __SRV_ASSET_H
+#define __SRV_ASSET_H
+
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+
+// RAM budget of the asset cache [bytes]
+#ifndef ASSET_CACHE_BUDGET
+#define ASSET_CACHE_BUDGET (48 * 1024)
+#endif
+#ifndef ASSET_CACHE_BUDGET_PSRAM
+#define ASSET_CACHE_BUDGET_PSRAM (512 * 1024)
+#endif
+// number of assets held in the cache
+#ifndef ASSET_CACHE_ENTRIES
+#define ASSET_CACHE_ENTRIES (16)
+#endif
+
+// number of files whose ETag is kept (the file is hashed again once dropped)
+#ifndef ASSET_ETAG_ENTRIES
+#define ASSET_ETAG_ENTRIES (32)
+#endif
+
+// max-age of the versioned assets [s]
+#ifndef ASSET_CACHE_LONG_AGE
+#define ASSET_CACHE_LONG_AGE (31536000)
+#endif
+
+typedef struct {
+	uint32_t hits;			// requests served from RAM
+	uint32_t misses;		// requests served from the file system
+	uint32_t uncached;		// misses too large to be cached
+	uint32_t bytes;			// body bytes served from RAM
+	uint32_t evictions;		// assets evicted to stay in the budget
+	uint32_t invalidations;	// cache cleared (file system update)
+	uint32_t embedded;		// requests served from the firmware image
+	uint32_t hit_us;		// total handler time of the hits [us]
+	uint32_t miss_us;		// total handler time of the misses [us]
+} asset_stats_t;
+
+bool ASSET_initCache(void);
+void ASSET_clearCache(void);
+void ASSET_getStats(asset_stats_t * stats);
+
+const char * ASSET_getMimeType(const String & path);
+bool ASSET_sendFile(AsyncWebServerRequest * request, const String & path);
+
+#endif
@@ -0,0 +1,105 @@
+// --------------------------------------------------------
+// Copyright (c) 2025 rapid4mifu 
+//
+// These codes are licensed under GPL v3.0
+// https://opensource.org/license/GPL-3.0
+// --------------------------------------------------------
+
+// This software module is related to the static assets compiled into the firmware
+
+#include "srv_embedded.h"
+
+#ifdef SRV_EMBEDDED_ASSETS
+
+#include <string.h>
+
+#include "assets_embedded.h"
+
+static constexpr uint32_t asset_hashPath(const char * path);
+static constexpr bool asset_isEmbeddedValid(void);
+
+/******************************************************************************
+* Function Name: ASSET_findEmbedded
+* Description  : 組み込みファイルテーブルを検索する
+* Arguments    : path - requested path
+* Return Value : embedded asset (NULL -> not embedded)
+******************************************************************************/
+const asset_embedded_t * ASSET_findEmbedded(const char * path)
+{
+	const asset_embedded_t * asset = &assetEmbedded[asset_hashPath(path) & (ASSET_EMBEDDED_SIZE - 1)];
+
+	if ((NULL == asset->path) || (0 != strcmp(asset->path, path))) {
+		return NULL;
+	}
+
+	return asset;
+}
+
+/******************************************************************************
+* Function Name: ASSET_getEmbeddedSize
+* Description  : 組み込みファイルテーブルのスロット数を取得する
+* Arguments    : none
+* Return Value : number of slots (power of 2)
+******************************************************************************/
+size_t ASSET_getEmbeddedSize(void)
+{
+	return ASSET_EMBEDDED_SIZE;
+}
+
+/******************************************************************************
+* Function Name: ASSET_getEmbedded
+* Description  : 組み込みファイルテーブルのスロットを取得する
+* Arguments    : slot - slot number
+* Return Value : embedded asset (NULL -> empty slot or out of range)
+******************************************************************************/
+const asset_embedded_t * ASSET_getEmbedded(size_t slot)
+{
+	if ((ASSET_EMBEDDED_SIZE <= slot) || (NULL == assetEmbedded[slot].path)) {
+		return NULL;
+	}
+
+	return &assetEmbedded[slot];
+}
+
+/******************************************************************************
+* Function Name: asset_hashPath
+* Description  : 組み込みファイルテーブルのハッシュ値を計算する（FNV-1a）
+* Arguments    : path - requested path
+* Return Value : hash value (the lower bits give the table slot)
+******************************************************************************/
+constexpr uint32_t asset_hashPath(const char * path)
+{
+	uint32_t hash = ASSET_EMBEDDED_SEED;
+
+	while (*path) {
+		hash = (hash ^ (uint8_t)*path++) * 16777619UL;
+	}
+
+	// same folding as scripts/embed_assets.py
+	return hash ^ (hash >> 16);
+}
+
+/******************************************************************************
+* Function Name: asset_isEmbeddedValid
+* Description  : 組み込みファイルテーブルの整合性を確認する（コンパイル時）
+* Arguments    : none
+* Return Value : true -> every asset is found in its own slot
+******************************************************************************/
+constexpr bool asset_isEmbeddedValid(void)
+{
+	if (0 != (ASSET_EMBEDDED_SIZE & (ASSET_EMBEDDED_SIZE - 1))) {
+		return false;
+	}
+
+	for (size_t i = 0; i < ASSET_EMBEDDED_SIZE; i++) {
+		if ((NULL != assetEmbedded[i].path) && (i != (asset_hashPath(assetEmbedded[i].path) & (ASSET_EMBEDDED_SIZE - 1)))) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static_assert(asset_isEmbeddedValid(), "assets_embedded.h is out of date, run scripts/embed_assets.py");
+
+#endif /* SRV_EMBEDDED_ASSETS */
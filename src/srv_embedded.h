@@ -0,0 +1,38 @@
+// --------------------------------------------------------
+// Copyright (c) 2025 rapid4mifu 
+//
+// These codes are licensed under GPL v3.0
+// https://opensource.org/license/GPL-3.0
+// --------------------------------------------------------
+
+// This header file is related to the static assets compiled into the firmware
+//  (-D SRV_EMBEDDED_ASSETS, served by srv_asset.cpp)
+//
+// public_html is turned into src/assets_embedded.h by scripts/embed_assets.py,
+// a table indexed by a perfect hash of the path, so that a lookup is
+// a single probe and a single string compare
+
+#ifndef __SRV_EMBEDDED_H
+#define __SRV_EMBEDDED_H
+
+// hardware independent (built on the host as well, see board.h)
+#include <stdint.h>
+#include <stddef.h>
+
+// asset linked into the firmware (generated by scripts/embed_assets.py)
+typedef struct {
+	const char * path;			// requested path (NULL -> empty slot)
+	const uint8_t * data;		// file contents
+	size_t len;					// file size
+	const char * contentType;	// MIME type
+	const char * etag;			// entity tag
+	bool gzipped;				// data is gzip compressed
+} asset_embedded_t;
+
+#ifdef SRV_EMBEDDED_ASSETS
+const asset_embedded_t * ASSET_findEmbedded(const char * path);
+size_t ASSET_getEmbeddedSize(void);
+const asset_embedded_t * ASSET_getEmbedded(size_t slot);
+#endif
+
+#endif /* __SRV_EMBEDDED_H */
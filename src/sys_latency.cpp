@@ -0,0 +1,299 @@
+// --------------------------------------------------------
+// Copyright (c) 2025 rapid4mifu 
+//
+// These codes are licensed under GPL v3.0
+// https://opensource.org/license/GPL-3.0
+// --------------------------------------------------------
+
+// This software module is related to the latency probes of the hot paths
+
+#include "sys_latency.h"
+
+#ifdef SYS_LATENCY_ENABLE
+
+#include <atomic>
+
+#include "task_cli.h"
+
+// the host build measures the host CPU, the virtual clock of the shim has no cycles
+#if defined(RMPP_HOST)
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define SYS_LATENCY_RDTSC
+#endif
+#elif defined(ESP32)
+#include <esp_cpu.h>
+#endif
+
+// the probes are called from the interrupt handlers in IRAM
+#if defined(ESP32) && !defined(RMPP_HOST)
+#define SYS_LATENCY_ATTR IRAM_ATTR
+#else
+#define SYS_LATENCY_ATTR
+#endif
+
+/* histograms (updated from tasks and interrupts) */
+static std::atomic<uint32_t> histogram[SYS_LAT_NUM][SYS_LATENCY_BUCKETS];
+static std::atomic<uint32_t> cntExpired[SYS_LAT_NUM];
+static std::atomic<uint32_t> maxSpan[SYS_LAT_NUM];
+static std::atomic<uint32_t> startSpan[SYS_LAT_NUM];	// 0 -> not started
+
+static uint32_t cyclesPerUs = 1;
+
+static const char * const probeName[SYS_LAT_NUM] = {
+	"WS -> duty",
+	"fault -> off",
+	"fault -> task",
+};
+
+static uint32_t sys_getPercentile(const uint32_t * bucket, uint32_t count, uint32_t max, uint8_t percent);
+static void sys_handleLatency(cli_cmd_t command);
+
+/******************************************************************************
+* Function Name: SYS_initLatency
+* Description  : レイテンシ計測の初期化
+* Arguments    : none
+* Return Value : true  -> initialization succeeded,
+                 false -> initialization failed
+******************************************************************************/
+bool SYS_initLatency(void)
+{
+#if defined(RMPP_HOST)
+#if defined(SYS_LATENCY_RDTSC)
+	// the rate of the time stamp counter against the monotonic clock (10 ms)
+	struct timespec begin;
+	struct timespec now;
+	uint64_t tsc = __rdtsc();
+	int64_t elapsed;
+
+	clock_gettime(CLOCK_MONOTONIC, &begin);
+	do {
+		clock_gettime(CLOCK_MONOTONIC, &now);
+		elapsed = (now.tv_sec - begin.tv_sec) * 1000000000LL + (now.tv_nsec - begin.tv_nsec);
+	} while (10000000LL > elapsed);
+	cyclesPerUs = (uint32_t)((__rdtsc() - tsc) * 1000 / elapsed);
+#else
+	// nanoseconds of the monotonic clock
+	cyclesPerUs = 1000;
+#endif
+#else
+#if defined(ESP32)
+	cyclesPerUs = getCpuFrequencyMhz();
+#else
+	cyclesPerUs = rp2040.f_cpu() / 1000000;
+#endif
+#endif
+	CLI_addCommand("LAT", sys_handleLatency);
+	if (0 == cyclesPerUs) {
+		cyclesPerUs = 1;
+	}
+
+	SYS_clearLatency();
+	return true;
+}
+
+/******************************************************************************
+* Function Name: SYS_getLatencyCycles
+* Description  : サイクルカウンタを取得する
+* Arguments    : none
+* Return Value : cycle counter (wraps around)
+******************************************************************************/
+uint32_t SYS_LATENCY_ATTR SYS_getLatencyCycles(void)
+{
+#if defined(RMPP_HOST)
+#if defined(SYS_LATENCY_RDTSC)
+	return (uint32_t)__rdtsc();
+#else
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (uint32_t)(now.tv_sec * 1000000000ULL + now.tv_nsec);
+#endif
+#elif defined(ESP32)
+	return esp_cpu_get_cycle_count();
+#else
+	return rp2040.getCycleCount();
+#endif
+}
+
+/******************************************************************************
+* Function Name: SYS_getLatencyRate
+* Description  : サイクルカウンタの周波数を取得する
+* Arguments    : none
+* Return Value : cycles per microsecond
+******************************************************************************/
+uint32_t SYS_getLatencyRate(void)
+{
+	return cyclesPerUs;
+}
+
+/******************************************************************************
+* Function Name: SYS_recordLatency
+* Description  : 計測した時間をヒストグラムに加える
+* Arguments    : probe - sys_latency_probe_t, cycles - span [cycles]
+* Return Value : none
+******************************************************************************/
+void SYS_LATENCY_ATTR SYS_recordLatency(uint8_t probe, uint32_t cycles)
+{
+	// bucket n holds the spans from 2^(n-1) to below 2^n cycles
+	uint8_t bucket = (0 == cycles) ? 0 : (32 - __builtin_clz(cycles));
+	uint32_t max = maxSpan[probe].load(std::memory_order_relaxed);
+
+	histogram[probe][bucket].fetch_add(1, std::memory_order_relaxed);
+	while ((max < cycles) && !maxSpan[probe].compare_exchange_weak(max, cycles, std::memory_order_relaxed)) {
+	}
+}
+
+/******************************************************************************
+* Function Name: SYS_startLatency
+* Description  : タスクをまたぐ計測を開始する
+* Arguments    : probe - sys_latency_probe_t
+* Return Value : none
+******************************************************************************/
+void SYS_LATENCY_ATTR SYS_startLatency(uint8_t probe)
+{
+	uint32_t now = SYS_getLatencyCycles();
+
+	startSpan[probe].store((0 != now) ? now : 1, std::memory_order_relaxed);
+}
+
+/******************************************************************************
+* Function Name: SYS_stopLatency
+* Description  : タスクをまたぐ計測を終了する（開始されていなければ何もしない）
+* Arguments    : probe - sys_latency_probe_t
+* Return Value : none
+******************************************************************************/
+void SYS_LATENCY_ATTR SYS_stopLatency(uint8_t probe)
+{
+	uint32_t now = SYS_getLatencyCycles();
+	uint32_t start = startSpan[probe].exchange(0, std::memory_order_relaxed);
+	uint32_t span = now - start;
+
+	if (0 == start) {
+		return;
+	}
+
+	if (((uint64_t)SYS_LATENCY_EXPIRE * cyclesPerUs) < span) {
+		cntExpired[probe].fetch_add(1, std::memory_order_relaxed);
+	} else {
+		SYS_recordLatency(probe, span);
+	}
+}
+
+/******************************************************************************
+* Function Name: SYS_cancelLatency
+* Description  : タスクをまたぐ計測を取り消す（終了処理まで到達しない場合）
+* Arguments    : probe - sys_latency_probe_t
+* Return Value : none
+******************************************************************************/
+void SYS_LATENCY_ATTR SYS_cancelLatency(uint8_t probe)
+{
+	startSpan[probe].store(0, std::memory_order_relaxed);
+}
+
+/******************************************************************************
+* Function Name: SYS_getLatencyStats
+* Description  : 計測結果の統計（パーセンタイル）を取得する
+* Arguments    : probe - sys_latency_probe_t, stats - statistics (output)
+* Return Value : none
+******************************************************************************/
+void SYS_getLatencyStats(uint8_t probe, sys_latency_stats_t * stats)
+{
+	uint32_t bucket[SYS_LATENCY_BUCKETS];
+	uint32_t count = 0;
+
+	// the total is taken from the same copy as the percentiles
+	for (uint8_t i = 0; i < SYS_LATENCY_BUCKETS; i++) {
+		bucket[i] = histogram[probe][i].load(std::memory_order_relaxed);
+		count += bucket[i];
+	}
+
+	stats->count = count;
+	stats->expired = cntExpired[probe].load(std::memory_order_relaxed);
+	stats->max = maxSpan[probe].load(std::memory_order_relaxed);
+	stats->p50 = sys_getPercentile(bucket, count, stats->max, 50);
+	stats->p99 = sys_getPercentile(bucket, count, stats->max, 99);
+}
+
+/******************************************************************************
+* Function Name: SYS_getLatencyName
+* Description  : プローブの名前を取得する
+* Arguments    : probe - sys_latency_probe_t
+* Return Value : name
+******************************************************************************/
+const char * SYS_getLatencyName(uint8_t probe)
+{
+	return (SYS_LAT_NUM > probe) ? probeName[probe] : "";
+}
+
+/******************************************************************************
+* Function Name: SYS_clearLatency
+* Description  : 全プローブの計測結果をクリアする
+* Arguments    : none
+* Return Value : none
+******************************************************************************/
+void SYS_clearLatency(void)
+{
+	for (uint8_t i = 0; i < SYS_LAT_NUM; i++) {
+		for (uint8_t n = 0; n < SYS_LATENCY_BUCKETS; n++) {
+			histogram[i][n].store(0);
+		}
+		cntExpired[i].store(0);
+		maxSpan[i].store(0);
+		startSpan[i].store(0);
+	}
+}
+
+/******************************************************************************
+* Function Name: sys_getPercentile
+* Description  : ヒストグラムからパーセンタイルを求める
+* Arguments    : bucket - histogram, count - total count,
+                 max - longest span, percent - percentile
+* Return Value : upper bound of the bucket [cycles] (limited to the longest span)
+******************************************************************************/
+uint32_t sys_getPercentile(const uint32_t * bucket, uint32_t count, uint32_t max, uint8_t percent)
+{
+	uint64_t rank = ((uint64_t)count * percent + 99) / 100;
+	uint64_t sum = 0;
+
+	if (0 == count) {
+		return 0;
+	}
+
+	for (uint8_t i = 0; i < SYS_LATENCY_BUCKETS; i++) {
+		sum += bucket[i];
+		if (sum >= rank) {
+			uint32_t upper = (32 > i) ? ((1UL << i) - 1) : UINT32_MAX;
+			return (upper < max) ? upper : max;
+		}
+	}
+	return max;
+}
+
+/******************************************************************************
+* Function Name: sys_handleLatency
+* Description  : レイテンシ計測に関するコンソール処理
+* Arguments    : command - [CLEAR]
+* Return Value : none
+******************************************************************************/
+void sys_handleLatency(cli_cmd_t command)
+{
+	if (0 == strcmp(command.command2, "CLEAR")) {
+		SYS_clearLatency();
+	}
+
+	for (uint8_t i = 0; i < SYS_LAT_NUM; i++) {
+		sys_latency_stats_t stats;
+		SYS_getLatencyStats(i, &stats);
+
+		// in units of 0.1 us
+		uint32_t p50 = (uint64_t)stats.p50 * 10 / cyclesPerUs;
+		uint32_t p99 = (uint64_t)stats.p99 * 10 / cyclesPerUs;
+		uint32_t max = (uint64_t)stats.max * 10 / cyclesPerUs;
+
+		command.out->printf("- %-13s : %u spans, p50 %u.%u us, p99 %u.%u us, max %u.%u us (expired %u)\n",
+			probeName[i], stats.count, p50 / 10, p50 % 10, p99 / 10, p99 % 10, max / 10, max % 10, stats.expired);
+	}
+}
+
+#endif /* SYS_LATENCY_ENABLE */
@@ -0,0 +1,85 @@
+// --------------------------------------------------------
+// Copyright (c) 2025 rapid4mifu 
+//
+// These codes are licensed under GPL v3.0
+// https://opensource.org/license/GPL-3.0
+// --------------------------------------------------------
+
+// This header file is related to the latency probes of the hot paths
+//
+// a probe measures a span on the cpu cycle counter and counts it in a
+// histogram of power of 2 buckets (lock-free, safe in the ISR),
+// the percentiles are printed by the LAT command
+//
+// - SYS_LATENCY_SCOPE(probe) : from here to the end of the block
+// - SYS_LATENCY_START(probe) / SYS_LATENCY_STOP(probe) : across tasks,
+//   the span of the latest start is counted by the first stop after it
+//   (both ends must run on the same core, the cycle counters of the
+//   cores are not synchronized)
+//
+// the probes are compiled in with -D SYS_LATENCY_ENABLE only,
+// otherwise the macros expand to nothing
+//
+// hardware independent apart from the cycle counter
+// (ESP32 : CCOUNT, RP2040 : rp2040.getCycleCount, host : rdtsc or clock_gettime)
+
+#ifndef __SYS_LATENCY_H
+#define __SYS_LATENCY_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// a started span is discarded when no stop follows within this time [us]
+#ifndef SYS_LATENCY_EXPIRE
+#define SYS_LATENCY_EXPIRE (100000)
+#endif
+// number of histogram buckets (bucket n counts spans from 2^(n-1) to below 2^n cycles)
+#define SYS_LATENCY_BUCKETS (33)
+
+typedef enum {
+	SYS_LAT_WS_TO_DUTY = 0,		/* WebSocket frame received -> PWM duty written */
+	SYS_LAT_FAULT_TO_OFF,		/* fault edge interrupt -> output pins cut */
+	SYS_LAT_FAULT_TO_TASK,		/* fault edge interrupt -> protection handled by the task */
+	SYS_LAT_NUM
+} sys_latency_probe_t;
+
+typedef struct {
+	uint32_t count;		// spans counted
+	uint32_t expired;	// spans discarded (no stop within SYS_LATENCY_EXPIRE)
+	uint32_t p50;		// median [cycles] (upper bound of the bucket)
+	uint32_t p99;		// 99th percentile [cycles] (upper bound of the bucket)
+	uint32_t max;		// longest span [cycles]
+} sys_latency_stats_t;
+
+#ifdef SYS_LATENCY_ENABLE
+bool SYS_initLatency(void);
+uint32_t SYS_getLatencyCycles(void);
+uint32_t SYS_getLatencyRate(void);
+void SYS_recordLatency(uint8_t probe, uint32_t cycles);
+void SYS_startLatency(uint8_t probe);
+void SYS_stopLatency(uint8_t probe);
+void SYS_cancelLatency(uint8_t probe);
+void SYS_getLatencyStats(uint8_t probe, sys_latency_stats_t * stats);
+const char * SYS_getLatencyName(uint8_t probe);
+void SYS_clearLatency(void);
+
+typedef struct sys_latency_scope {
+	uint8_t probe;
+	uint32_t start;
+
+	sys_latency_scope(uint8_t p) : probe(p), start(SYS_getLatencyCycles()) {}
+	~sys_latency_scope() { SYS_recordLatency(probe, SYS_getLatencyCycles() - start); }
+} sys_latency_scope_t;
+
+#define SYS_LATENCY_SCOPE(probe)	sys_latency_scope_t latencyScope(probe)
+#define SYS_LATENCY_START(probe)	SYS_startLatency(probe)
+#define SYS_LATENCY_STOP(probe)		SYS_stopLatency(probe)
+#define SYS_LATENCY_CANCEL(probe)	SYS_cancelLatency(probe)
+#else
+#define SYS_LATENCY_SCOPE(probe)	do {} while (0)
+#define SYS_LATENCY_START(probe)	do {} while (0)
+#define SYS_LATENCY_STOP(probe)		do {} while (0)
+#define SYS_LATENCY_CANCEL(probe)	do {} while (0)
+#endif
+
+#endif /* __SYS_LATENCY_H */
@@ -0,0 +1,413 @@
+// --------------------------------------------------------
+// Copyright (c) 2025 rapid4mifu 
+//
+// These codes are licensed under GPL v3.0
+// https://opensource.org/license/GPL-3.0
+// --------------------------------------------------------
+
+// This software module is related to the runtime profile of the tasks
+
+#include "sys_perf.h"
+#include "task_cli.h"
+#include "task_server.h"
+
+#include "rmpp_cmd.h"
+
+#include <atomic>
+
+#if defined(TARGET_RP2040) || defined(TARGET_RP2350)
+#include <FreeRTOS.h>
+#include <task.h>
+#include <timers.h>
+#endif
+
+// the run time counters of all cores add up to this many times the total
+#if defined(portNUM_PROCESSORS)
+#define SYS_PERF_NUM_CORES portNUM_PROCESSORS
+#elif defined(configNUMBER_OF_CORES)
+#define SYS_PERF_NUM_CORES configNUMBER_OF_CORES
+#else
+#define SYS_PERF_NUM_CORES 1
+#endif
+
+// WebSocket messages per window (each carries several packets)
+#ifndef SYS_PERF_WS_MSG
+#define SYS_PERF_WS_MSG (2)
+#endif
+// coalescing tag of the profile messages
+#define SYS_PERF_TAG(msg) (0x60 | (msg))
+// the heap is reported in these units [bytes]
+#define SYS_PERF_HEAP_UNIT (64)
+
+typedef struct {
+	UBaseType_t number;	// task number
+	uint32_t counter;	// run time counter at the previous window
+} sys_perf_counter_t;
+
+/* profile (written by the timer service task, read under the sequence lock) */
+static sys_perf_t stPerf = {};
+static_assert(0 == sizeof(sys_perf_t) % sizeof(uint32_t), "the profile is copied in words");
+static std::atomic<uint32_t> seqLock(0);
+
+/* work area of the sampling (timer service task only) */
+static TaskStatus_t stStatus[SYS_PERF_TASK_MAX];
+static sys_perf_counter_t stCounter[SYS_PERF_TASK_MAX];
+static uint8_t numCounter = 0;
+static uint32_t totalPrev = 0;
+static uint8_t publishNext = 0;
+
+static TimerHandle_t hTimerPerf = NULL;
+static std::atomic<bool> perfEnabled(false);
+static std::atomic<bool> restartRequired(false);
+
+static void sys_onPerfTimer(TimerHandle_t xTimer);
+static void sys_samplePerf(void);
+static void sys_publishPerf(void);
+static uint8_t sys_packPerf(uint8_t * buf);
+static uint8_t sys_packPerfTask(uint8_t * buf, uint8_t slot);
+static bool sys_findCounter(UBaseType_t number, uint32_t * counter);
+static void sys_handlePerf(cli_cmd_t command);
+
+/******************************************************************************
+* Function Name: SYS_initPerf
+* Description  : タスクプロファイルの初期化
+* Arguments    : none
+* Return Value : true  -> initialization succeeded,
+                 false -> initialization failed
+******************************************************************************/
+bool SYS_initPerf(void)
+{
+	hTimerPerf = xTimerCreate("perf_timer", pdMS_TO_TICKS(SYS_PERF_WINDOW), pdTRUE, 0, sys_onPerfTimer);
+	if (NULL == hTimerPerf) {
+		Serial.println(" [failure] Failed to create profile timer.");
+		return false;
+	}
+
+	CLI_addCommand("PERF", sys_handlePerf);
+	SYS_enablePerf(SYS_PERF_ENABLE);
+
+	return true;
+}
+
+/******************************************************************************
+* Function Name: SYS_enablePerf
+* Description  : タスクプロファイルの有効・無効を切り替える
+* Arguments    : enable - true -> on, false -> off
+* Return Value : none
+******************************************************************************/
+void SYS_enablePerf(bool enable)
+{
+	if (NULL == hTimerPerf) {
+		return;
+	}
+
+	if (enable) {
+		// the first window after a pause has no previous counters
+		restartRequired.store(true);
+		perfEnabled.store(true);
+		xTimerStart(hTimerPerf, 0);
+	} else {
+		perfEnabled.store(false);
+		xTimerStop(hTimerPerf, 0);
+	}
+}
+
+/******************************************************************************
+* Function Name: SYS_isPerfEnabled
+* Description  : タスクプロファイルが有効か判定する
+* Arguments    : none
+* Return Value : true -> on, false -> off
+******************************************************************************/
+bool SYS_isPerfEnabled(void)
+{
+	return perfEnabled.load(std::memory_order_relaxed);
+}
+
+/******************************************************************************
+* Function Name: SYS_getPerf
+* Description  : 最新のタスクプロファイルを取得する
+* Arguments    : perf - copy of the profile (output)
+* Return Value : true -> the profile is copied, false -> no profile yet
+******************************************************************************/
+bool SYS_getPerf(sys_perf_t * perf)
+{
+	const volatile uint32_t * src = (const volatile uint32_t *)&stPerf;
+	uint32_t * dst = (uint32_t *)perf;
+	uint32_t seq;
+
+	// retried while the timer service task rewrites the profile
+	// (the words are read one by one, the compiler can't merge them with
+	//  the reads of the sequence or move them out of the loop)
+	while (true) {
+		seq = seqLock.load(std::memory_order_acquire);
+		if (0 == (seq & 1)) {
+			for (size_t i = 0; i < sizeof(sys_perf_t) / sizeof(uint32_t); i++) {
+				dst[i] = src[i];
+			}
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if (seq == seqLock.load(std::memory_order_relaxed)) {
+				break;
+			}
+		}
+	}
+
+	return (0 != perf->seq);
+}
+
+/******************************************************************************
+* Function Name: sys_onPerfTimer
+* Description  : プロファイル周期のタイマ処理（タイマサービスタスク）
+* Arguments    : xTimer - profile timer
+* Return Value : none
+******************************************************************************/
+void sys_onPerfTimer(TimerHandle_t xTimer)
+{
+	if (false == SYS_isPerfEnabled()) {
+		return;
+	}
+
+	sys_samplePerf();
+	sys_publishPerf();
+}
+
+/******************************************************************************
+* Function Name: sys_samplePerf
+* Description  : タスクの状態を取得してプロファイルを更新する
+* Arguments    : none
+* Return Value : none
+******************************************************************************/
+void sys_samplePerf(void)
+{
+	uint32_t timeStart = micros();
+	uint32_t total = 0;
+	uint32_t elapsed;
+	uint32_t idle = 0;
+	uint32_t heapFree;
+	uint32_t heapMin;
+	UBaseType_t count;
+	bool valid;
+
+	if (restartRequired.exchange(false)) {
+		numCounter = 0;
+		totalPrev = 0;
+	}
+
+	// zero -> the array is too small for the tasks
+	count = uxTaskGetSystemState(stStatus, SYS_PERF_TASK_MAX, &total);
+	if (0 == count) {
+		seqLock.fetch_add(1, std::memory_order_acq_rel);
+		stPerf.overflow++;
+		seqLock.fetch_add(1, std::memory_order_release);
+		return;
+	}
+
+	// the total stays 0 without run time statistics (configGENERATE_RUN_TIME_STATS)
+	elapsed = (total - totalPrev) * SYS_PERF_NUM_CORES;
+	valid = (0 != totalPrev) && (0 != elapsed);
+
+#if defined(ESP32)
+	heapFree = ESP.getFreeHeap();
+	heapMin = ESP.getMinFreeHeap();
+#else
+	heapFree = rp2040.getFreeHeap();
+	heapMin = ((0 == stPerf.heap_min) || (heapFree < stPerf.heap_min)) ? heapFree : stPerf.heap_min;
+#endif
+
+	seqLock.fetch_add(1, std::memory_order_acq_rel);
+
+	for (UBaseType_t i = 0; i < count; i++) {
+		const TaskStatus_t * status = &stStatus[i];
+		sys_perf_task_t * task = &stPerf.task[i];
+		uint32_t counter;
+
+		strncpy(task->name, status->pcTaskName, SYS_PERF_NAME_LEN);
+		task->name[SYS_PERF_NAME_LEN] = '\0';
+		task->stack_free = (0xFFFF > status->usStackHighWaterMark) ? status->usStackHighWaterMark : 0xFFFF;
+		task->priority = status->uxCurrentPriority;
+		task->cpu = SYS_PERF_CPU_NONE;
+
+		if (valid && sys_findCounter(status->xTaskNumber, &counter)) {
+			uint32_t delta = status->ulRunTimeCounter - counter;
+			uint32_t cpu = (uint64_t)delta * 1000 / elapsed;
+
+			task->cpu = (1000 > cpu) ? cpu : 1000;
+			if (0 == strncmp(status->pcTaskName, "IDLE", 4)) {
+				idle += delta;
+			}
+		}
+	}
+
+	stPerf.seq++;
+	stPerf.count = count;
+	stPerf.load = valid ? (1000 - (uint16_t)((uint64_t)((idle < elapsed) ? idle : elapsed) * 1000 / elapsed)) : SYS_PERF_CPU_NONE;
+	stPerf.heap_free = heapFree;
+	stPerf.heap_min = heapMin;
+	stPerf.time_sample = (uint16_t)(micros() - timeStart);
+	if (stPerf.time_max < stPerf.time_sample) {
+		stPerf.time_max = stPerf.time_sample;
+	}
+
+	seqLock.fetch_add(1, std::memory_order_release);
+
+	// counters of this window (the tasks may have been created or deleted)
+	for (UBaseType_t i = 0; i < count; i++) {
+		stCounter[i].number = stStatus[i].xTaskNumber;
+		stCounter[i].counter = stStatus[i].ulRunTimeCounter;
+	}
+	numCounter = count;
+	totalPrev = total;
+}
+
+/******************************************************************************
+* Function Name: sys_publishPerf
+* Description  : プロファイルをクライアントへ送信する
+*                (1周期あたり SYS_PERF_WS_MSG メッセージ、タスクは順に送る)
+* Arguments    : none
+* Return Value : none
+******************************************************************************/
+void sys_publishPerf(void)
+{
+	uint8_t sent = 0;
+
+	if (publishNext >= stPerf.count) {
+		publishNext = 0;
+	}
+
+	for (uint8_t i = 0; i < SYS_PERF_WS_MSG; i++) {
+		ws_binary_t * msg = SRV_allocWsBinary();
+		uint8_t len = 0;
+
+		if (NULL == msg) {
+			return;
+		}
+
+		if (0 == i) {
+			len += sys_packPerf(&msg->data[len]);
+		}
+		while ((RMPP_PACKET_LEN_MAX <= (WS_LEN_BINARY_MAX - len)) && (sent < stPerf.count)) {
+			len += sys_packPerfTask(&msg->data[len], publishNext);
+			publishNext = (publishNext + 1) % stPerf.count;
+			sent++;
+		}
+
+		// several packets back to back in one message
+		msg->tag = SYS_PERF_TAG(i);
+		msg->len = len;
+		SRV_pushWsBinary(msg);
+	}
+}
+
+/******************************************************************************
+* Function Name: sys_packPerf
+* Description  : RD_PERF コマンドのパケットを作成する
+* Arguments    : buf - packet buffer
+* Return Value : packet length
+******************************************************************************/
+uint8_t sys_packPerf(uint8_t * buf)
+{
+	uint8_t * cmd = RMPP_PACKET_CMD(buf);
+	uint32_t heapFree = stPerf.heap_free / SYS_PERF_HEAP_UNIT;
+	uint32_t heapMin = stPerf.heap_min / SYS_PERF_HEAP_UNIT;
+
+	heapFree = (0xFFFF > heapFree) ? heapFree : 0xFFFF;
+	heapMin = (0xFFFF > heapMin) ? heapMin : 0xFFFF;
+
+	cmd[0] = RMPP_CMDID_RD_PERF;
+	cmd[1] = stPerf.count;
+	cmd[2] = stPerf.load & 0xFF;
+	cmd[3] = stPerf.load >> 8;
+	cmd[4] = heapFree & 0xFF;
+	cmd[5] = heapFree >> 8;
+	cmd[6] = heapMin & 0xFF;
+	cmd[7] = heapMin >> 8;
+	cmd[8] = stPerf.time_sample & 0xFF;
+	cmd[9] = stPerf.time_sample >> 8;
+
+	return RMPP_encodePacket(buf, RMPP_CMD_LEN_RD_PERF);
+}
+
+/******************************************************************************
+* Function Name: sys_packPerfTask
+* Description  : RD_PERF_TASK コマンドのパケットを作成する
+* Arguments    : buf - packet buffer, slot - task slot in the profile
+* Return Value : packet length
+******************************************************************************/
+uint8_t sys_packPerfTask(uint8_t * buf, uint8_t slot)
+{
+	uint8_t * cmd = RMPP_PACKET_CMD(buf);
+	const sys_perf_task_t * task = &stPerf.task[slot];
+	uint8_t lenName = strlen(task->name);
+	uint8_t bytes = 6 + lenName;
+
+	static_assert((6 + SYS_PERF_NAME_LEN) <= RMPP_BYTES_DAT_RD_PERF_TASK, "the task name does not fit in RD_PERF_TASK");
+
+	cmd[0] = RMPP_CMDID_RD_PERF_TASK(bytes);
+	cmd[1] = slot;
+	cmd[2] = task->cpu & 0xFF;
+	cmd[3] = task->cpu >> 8;
+	cmd[4] = task->stack_free & 0xFF;
+	cmd[5] = task->stack_free >> 8;
+	cmd[6] = task->priority;
+	memcpy(&cmd[7], task->name, lenName);
+
+	return RMPP_encodePacket(buf, RMPP_CMD_LEN_MIN + bytes);
+}
+
+/******************************************************************************
+* Function Name: sys_findCounter
+* Description  : 前回の周期のランタイムカウンタを検索する
+* Arguments    : number - task number, counter - run time counter (output)
+* Return Value : true -> found, false -> the task is new
+******************************************************************************/
+bool sys_findCounter(UBaseType_t number, uint32_t * counter)
+{
+	for (uint8_t i = 0; i < numCounter; i++) {
+		if (number == stCounter[i].number) {
+			*counter = stCounter[i].counter;
+			return true;
+		}
+	}
+	return false;
+}
+
+/******************************************************************************
+* Function Name: sys_handlePerf
+* Description  : タスクプロファイルに関するコンソール処理
+* Arguments    : command - [ON|OFF]
+* Return Value : none
+******************************************************************************/
+void sys_handlePerf(cli_cmd_t command)
+{
+	static sys_perf_t perf;
+
+	if (0 == strcmp(command.command2, "ON")) {
+		SYS_enablePerf(true);
+	} else if (0 == strcmp(command.command2, "OFF")) {
+		SYS_enablePerf(false);
+	}
+
+	command.out->printf("- Profile  : %s (window %u ms)\n", SYS_isPerfEnabled() ? "on" : "off", SYS_PERF_WINDOW);
+	if (false == SYS_getPerf(&perf)) {
+		return;
+	}
+
+	if (SYS_PERF_CPU_NONE != perf.load) {
+		command.out->printf("- CPU load : %u.%u %%\n", perf.load / 10, perf.load % 10);
+	} else {
+		command.out->println("- CPU load : ---");
+	}
+	command.out->printf("- Heap     : free %u bytes, minimum %u bytes\n", perf.heap_free, perf.heap_min);
+	command.out->printf("- Sampling : %u us (max %u us), window %u, skipped %u\n",
+		perf.time_sample, perf.time_max, perf.seq, perf.overflow);
+
+	command.out->println("Name        CPU[%]  Stack  Priority");
+	command.out->println("-----------------------------------");
+	for (uint8_t i = 0; i < perf.count; i++) {
+		const sys_perf_task_t * task = &perf.task[i];
+		if (SYS_PERF_CPU_NONE != task->cpu) {
+			command.out->printf("%-10s  %3u.%u  %5u  %8u\n", task->name, task->cpu / 10, task->cpu % 10, task->stack_free, task->priority);
+		} else {
+			command.out->printf("%-10s    ---  %5u  %8u\n", task->name, task->stack_free, task->priority);
+		}
+	}
+}
@@ -0,0 +1,70 @@
+// --------------------------------------------------------
+// Copyright (c) 2025 rapid4mifu 
+//
+// These codes are licensed under GPL v3.0
+// https://opensource.org/license/GPL-3.0
+// --------------------------------------------------------
+
+// This header file is related to the runtime profile of the tasks
+//
+// once per SYS_PERF_WINDOW the task states are taken from FreeRTOS
+// (uxTaskGetSystemState) on the timer service task, the cpu share of each
+// task is the growth of its run time counter over the window,
+// the profile is printed by the PERF command and sent to the web UI as
+// RD_PERF / RD_PERF_TASK packets (see rmpp_cmd.h)
+//
+// the cost is a single pass over the task list per window with the
+// scheduler suspended, and nothing at all while the profile is off
+//
+// the context switches of a task are not counted, FreeRTOS keeps no such
+// counter in TaskStatus_t and the traceTASK_SWITCHED_IN hook can't be set
+// in the prebuilt kernel of the Arduino cores (the host shim counts them,
+// see SIM_getTaskStats)
+
+#ifndef __SYS_PERF_H
+#define __SYS_PERF_H
+
+#include <Arduino.h>
+
+// profile window [ms]
+#ifndef SYS_PERF_WINDOW
+#define SYS_PERF_WINDOW (1000)
+#endif
+// profile at start-up (it can be switched with the PERF command)
+#ifndef SYS_PERF_ENABLE
+#define SYS_PERF_ENABLE false
+#endif
+// maximum number of tasks in the profile
+#ifndef SYS_PERF_TASK_MAX
+#define SYS_PERF_TASK_MAX (32)
+#endif
+// length of the task name kept in the profile (without terminator)
+#define SYS_PERF_NAME_LEN (9)
+
+#define SYS_PERF_CPU_NONE (0xFFFF)
+
+typedef struct {
+	char name[SYS_PERF_NAME_LEN + 1];	// task name (may be truncated)
+	uint16_t cpu;			// cpu share over the window [0.1%] (SYS_PERF_CPU_NONE -> not measured)
+	uint16_t stack_free;	// minimum free stack ever (bytes on ESP32, words elsewhere)
+	uint8_t priority;		// current priority
+} sys_perf_task_t;
+
+typedef struct {
+	uint32_t seq;			// window number (0 -> no profile yet)
+	uint8_t count;			// number of tasks
+	uint16_t load;			// cpu load (all but the idle tasks) [0.1%]
+	uint32_t heap_free;		// free heap [bytes]
+	uint32_t heap_min;		// minimum free heap ever [bytes]
+	uint16_t time_sample;	// time taken by the last sampling [us]
+	uint16_t time_max;		// longest sampling [us]
+	uint32_t overflow;		// windows skipped (more tasks than SYS_PERF_TASK_MAX)
+	sys_perf_task_t task[SYS_PERF_TASK_MAX];
+} sys_perf_t;
+
+bool SYS_initPerf(void);
+void SYS_enablePerf(bool enable);
+bool SYS_isPerfEnabled(void);
+bool SYS_getPerf(sys_perf_t * perf);
+
+#endif /* __SYS_PERF_H */
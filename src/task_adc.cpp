@@ -0,0 +1,350 @@
+// --------------------------------------------------------
+// Copyright (c) 2025 rapid4mifu 
+//
+// These codes are licensed under GPL v3.0
+// https://opensource.org/license/GPL-3.0
+// --------------------------------------------------------
+
+#include "task_adc.h"
+#include "task_cli.h"
+
+#include "board.h"
+
+#include <atomic>
+
+#if defined(TARGET_RP2040) || defined(TARGET_RP2350)
+#include <FreeRTOS.h>
+#include <task.h>
+#endif
+
+#ifndef ARDUINO_ISR_ATTR
+#define ARDUINO_ISR_ATTR
+#endif
+
+#if defined(ESP32)
+#ifndef APP_CPU_NUM
+#define APP_CPU_NUM (1)
+#endif
+#endif
+
+// the continuous driver can not convert slower than this [Hz]
+#define ADC_SAMPLE_FREQ_MIN (20000)
+// no frame within this time -> the conversion has stalled [ms]
+#define ADC_FRAME_TIMEOUT (100)
+
+static_assert(0 == (ADC_RING_LEN & (ADC_RING_LEN - 1)), "ADC_RING_LEN must be a power of 2");
+#if !defined(ESP32)
+static_assert(0 == (configTICK_RATE_HZ % ADC_FRAME_RATE), "ADC_FRAME_RATE must divide the tick rate");
+#endif
+
+typedef struct {
+	uint8_t pin;				/* analog input pin */
+	volatile uint16_t last;		/* average of the last frame [mV] */
+	volatile uint32_t filter;	/* low-pass filter [mV] (ADC_FILTER_SHIFT fractional bits) */
+} adc_input_t;
+
+static adc_input_t stInput[ADC_NUM_INPUT_MAX];
+static uint8_t numInput = 0;
+static uint32_t numOversample = ADC_OVERSAMPLE;	// conversions averaged per input and frame
+
+/* frame ring (written by the process task only) */
+static adc_frame_t ringFrame[ADC_RING_LEN];
+static std::atomic<uint32_t> seqFrame(0);	// sequence number of the newest frame
+static uint32_t cntReadFail = 0;
+static uint32_t cntTimeout = 0;
+
+/* process task handle */
+static TaskHandle_t hTaskAdc = NULL;
+
+static CallbackOnAdcFrame cbOnAdcFrame = NULL;
+
+static void adc_processTask(void* pvParameters);
+#if defined(ESP32)
+static void adc_onFrameDone(void);
+#endif
+static bool adc_readFrame(adc_frame_t * frame);
+static void adc_pushFrame(adc_frame_t * frame);
+static void adc_printStatus(cli_cmd_t command);
+
+/******************************************************************************
+* Function Name: ADC_initTask
+* Description  : アナログ入力の取得処理の初期化
+* Arguments    : none
+* Return Value : true  -> initialization succeeded,
+                 false -> initialization failed
+******************************************************************************/
+bool ADC_initTask(void)
+{
+	BaseType_t taskCreated;
+
+	CLI_addCommand("ADC", adc_printStatus);
+
+	if (0 == numInput) {
+		return true;
+	}
+
+	Serial.printf("ADC task is now starting ... (%u inputs, %u frames/s)\n", numInput, ADC_FRAME_RATE);
+#if defined(ESP32)
+	// above the RMPP task, the frame listener samples the back-EMF and checks
+	// the over-current while the RMPP task is busy
+	taskCreated = xTaskCreateUniversal(adc_processTask, "adc_task", 2048, nullptr, 5, &hTaskAdc, APP_CPU_NUM);
+#else
+	taskCreated = xTaskCreate(adc_processTask, "adc_task", configMINIMAL_STACK_SIZE * 2, nullptr, 5, &hTaskAdc);
+#endif
+	if (pdPASS != taskCreated) {
+		Serial.println(" [failure] Failed to create ADC task.");
+		return false;
+	}
+
+#if defined(ESP32)
+	uint8_t pins[ADC_NUM_INPUT_MAX];
+	uint32_t freq;
+
+	for (uint8_t i = 0; i < numInput; i++) {
+		pins[i] = stInput[i].pin;
+	}
+
+	// the driver can not convert slower than ADC_SAMPLE_FREQ_MIN, so a few
+	// inputs average more conversions instead (a higher frequency alone
+	// would raise the frame rate)
+	while (ADC_SAMPLE_FREQ_MIN > ((uint32_t)ADC_FRAME_RATE * numOversample * numInput)) {
+		numOversample++;
+	}
+	freq = (uint32_t)ADC_FRAME_RATE * numOversample * numInput;
+
+	// the driver averages the conversions per pin and
+	// returns calibrated voltages (eFuse calibration)
+	if ((false == analogContinuous(pins, numInput, numOversample, freq, adc_onFrameDone))
+	 || (false == analogContinuousStart())) {
+		Serial.println(" [failure] Failed to start the continuous ADC.");
+		return false;
+	}
+#endif
+
+	return true;
+}
+
+/******************************************************************************
+* Function Name: ADC_attachInput
+* Description  : 取得するアナログ入力を登録する（ADC_initTask の前に呼び出す）
+* Arguments    : pin - analog input pin
+* Return Value : input id (ADC_INPUT_NONE -> no room for the input)
+******************************************************************************/
+int8_t ADC_attachInput(uint8_t pin)
+{
+	for (uint8_t i = 0; i < numInput; i++) {
+		if (pin == stInput[i].pin) {
+			return i;
+		}
+	}
+
+	if ((NULL != hTaskAdc) || (ADC_NUM_INPUT_MAX <= numInput)) {
+		return ADC_INPUT_NONE;
+	}
+
+	pinMode(pin, INPUT);
+	stInput[numInput].pin = pin;
+	stInput[numInput].last = 0;
+	stInput[numInput].filter = 0;
+
+	return numInput++;
+}
+
+/******************************************************************************
+* Function Name: ADC_getMilliVolts
+* Description  : フィルタ後の電圧を取得する
+* Arguments    : input - input id
+* Return Value : voltage [mV]
+******************************************************************************/
+uint16_t ADC_getMilliVolts(int8_t input)
+{
+	if ((0 > input) || (numInput <= input)) {
+		return 0;
+	}
+	return ADC_getFilterOutput(stInput[input].filter);
+}
+
+/******************************************************************************
+* Function Name: ADC_getLastMilliVolts
+* Description  : 最新フレームの電圧（フィルタ前）を取得する
+* Arguments    : input - input id
+* Return Value : voltage [mV]
+******************************************************************************/
+uint16_t ADC_getLastMilliVolts(int8_t input)
+{
+	if ((0 > input) || (numInput <= input)) {
+		return 0;
+	}
+	return stInput[input].last;
+}
+
+/******************************************************************************
+* Function Name: ADC_getSequence
+* Description  : 最新フレームの通し番号を取得する
+* Arguments    : none
+* Return Value : sequence number (0 -> no frame yet)
+******************************************************************************/
+uint32_t ADC_getSequence(void)
+{
+	return seqFrame.load(std::memory_order_acquire);
+}
+
+/******************************************************************************
+* Function Name: ADC_getFrame
+* Description  : リングからフレームを取り出す
+* Arguments    : seq - sequence number, frame - copy of the frame (output)
+* Return Value : true  -> the frame is copied,
+                 false -> the frame is not converted yet or already overwritten
+******************************************************************************/
+bool ADC_getFrame(uint32_t seq, adc_frame_t * frame)
+{
+	uint32_t newest = seqFrame.load(std::memory_order_acquire);
+
+	if ((0 == seq) || ((int32_t)(newest - seq) < 0) || ((ADC_RING_LEN - 1) <= (newest - seq))) {
+		return false;
+	}
+
+	*frame = ringFrame[seq & (ADC_RING_LEN - 1)];
+
+	// the slot is reused once the writer is a whole ring ahead
+	newest = seqFrame.load(std::memory_order_acquire);
+	return (seq == frame->seq) && ((ADC_RING_LEN - 1) > (newest - seq));
+}
+
+/******************************************************************************
+* Function Name: ADC_attachFrameListener
+* Description  : フレーム取得時のコールバック関数を設定（ADCタスクから呼び出される）
+* Arguments    : callback - function pointer
+* Return Value : none
+******************************************************************************/
+void ADC_attachFrameListener(CallbackOnAdcFrame callback)
+{
+	cbOnAdcFrame = callback;
+}
+
+/******************************************************************************
+* Function Name: adc_processTask
+* Description  : アナログ入力の取得処理
+* Arguments    : none
+* Return Value : none
+******************************************************************************/
+void adc_processTask(void* pvParameters)
+{
+#if !defined(ESP32)
+	TickType_t tickWake = xTaskGetTickCount();
+#endif
+
+	while (true) {
+		uint32_t seq = seqFrame.load(std::memory_order_relaxed) + 1;
+		adc_frame_t * frame = &ringFrame[seq & (ADC_RING_LEN - 1)];
+
+#if defined(ESP32)
+		// one notification per converted frame
+		if (0 == ulTaskNotifyTake(pdFALSE, pdMS_TO_TICKS(ADC_FRAME_TIMEOUT))) {
+			cntTimeout++;
+			continue;
+		}
+#else
+		vTaskDelayUntil(&tickWake, configTICK_RATE_HZ / ADC_FRAME_RATE);
+#endif
+
+		// the slot is invalid while it is rewritten
+		frame->seq = 0;
+		if (adc_readFrame(frame)) {
+			frame->seq = seq;
+			adc_pushFrame(frame);
+		} else {
+			cntReadFail++;
+		}
+	}
+}
+
+#if defined(ESP32)
+/******************************************************************************
+* Function Name: adc_onFrameDone
+* Description  : 連続変換のフレーム完了の割り込み処理
+* Arguments    : none
+* Return Value : none
+******************************************************************************/
+void ARDUINO_ISR_ATTR adc_onFrameDone(void)
+{
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+	vTaskNotifyGiveFromISR(hTaskAdc, &xHigherPriorityTaskWoken);
+	portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+#endif
+
+/******************************************************************************
+* Function Name: adc_readFrame
+* Description  : 全入力の1フレーム分の電圧を読み取る
+* Arguments    : frame - frame to fill in
+* Return Value : true -> the frame is read
+******************************************************************************/
+bool adc_readFrame(adc_frame_t * frame)
+{
+#if defined(ESP32)
+	adc_continuous_data_t * result = NULL;
+
+	if (false == analogContinuousRead(&result, 0)) {
+		return false;
+	}
+	// the results are in the order the pins were given
+	for (uint8_t i = 0; i < numInput; i++) {
+		frame->mv[i] = (0 < result[i].avg_read_mvolts) ? result[i].avg_read_mvolts : 0;
+	}
+#else
+	for (uint8_t i = 0; i < numInput; i++) {
+		uint32_t sum = 0;
+		for (uint8_t n = 0; n < ADC_OVERSAMPLE; n++) {
+			sum += analogRead(stInput[i].pin);
+		}
+		frame->mv[i] = ADC_averageRaw(sum, ADC_OVERSAMPLE);
+	}
+#endif
+	frame->time = micros();
+
+	return true;
+}
+
+/******************************************************************************
+* Function Name: adc_pushFrame
+* Description  : フレームを公開し、フィルタを更新する
+* Arguments    : frame - converted frame
+* Return Value : none
+******************************************************************************/
+void adc_pushFrame(adc_frame_t * frame)
+{
+	bool first = (1 == frame->seq);
+
+	for (uint8_t i = 0; i < numInput; i++) {
+		adc_input_t * input = &stInput[i];
+		uint16_t mv = frame->mv[i];
+
+		// exponential moving average (see adc_filter.h)
+		input->filter = first ? ADC_startFilter(mv) : ADC_updateFilter(input->filter, mv);
+		input->last = mv;
+	}
+
+	seqFrame.store(frame->seq, std::memory_order_release);
+
+	if (NULL != cbOnAdcFrame) {
+		cbOnAdcFrame(frame);
+	}
+}
+
+/******************************************************************************
+* Function Name: adc_printStatus
+* Description  : アナログ入力の状態をコンソールに出力する
+* Arguments    : none
+* Return Value : none
+******************************************************************************/
+void adc_printStatus(cli_cmd_t command)
+{
+	for (uint8_t i = 0; i < numInput; i++) {
+		command.out->printf("- Input %u (pin %2u) : %4u mV (last %4u mV)\n", i, stInput[i].pin,
+			ADC_getMilliVolts(i), ADC_getLastMilliVolts(i));
+	}
+	command.out->printf("- Frames           : %u (%u Hz, %u conversions / input)\n", ADC_getSequence(), ADC_FRAME_RATE, numOversample);
+	command.out->printf("- Errors           : read %u, timeout %u\n", cntReadFail, cntTimeout);
+}
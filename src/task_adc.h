@@ -0,0 +1,66 @@
+// --------------------------------------------------------
+// Copyright (c) 2025 rapid4mifu 
+//
+// These codes are licensed under GPL v3.0
+// https://opensource.org/license/GPL-3.0
+// --------------------------------------------------------
+
+// background acquisition of the analog inputs
+//
+// the inputs are converted continuously (DMA on ESP32) and averaged over
+// ADC_OVERSAMPLE conversions per frame, each frame of calibrated voltages
+// is kept in a ring and folded into a low-pass filter, so the readers only
+// load the latest value
+//
+// the frame rate is exactly ADC_FRAME_RATE on every input count (the RMPP
+// trip, stream and back-EMF timing are derived from it), the task wakes on
+// every frame because the frame listener must see each one (a single frame
+// over the trip level cuts the output), the listener notifies the RMPP task
+// only on a trip or a back-EMF sample and the server once per stream block
+
+#ifndef __TASK_ADC_H__	/* 二重定義防止 */
+
+#include <Arduino.h>
+
+#include "adc_filter.h"
+
+// frames per second (every input is sampled once per frame)
+#ifndef ADC_FRAME_RATE
+#if defined(ESP32)
+#define ADC_FRAME_RATE (2000)
+#else
+// paced by the tick (configTICK_RATE_HZ must be a multiple of it)
+#define ADC_FRAME_RATE (1000)
+#endif
+#endif
+// conversions averaged per input and frame
+// (more on ESP32 when the rate would fall below the minimum of the driver)
+#ifndef ADC_OVERSAMPLE
+#define ADC_OVERSAMPLE (8)
+#endif
+// number of frames kept in the ring (power of 2)
+#define ADC_RING_LEN (64)
+#define ADC_NUM_INPUT_MAX (8)
+
+#define ADC_INPUT_NONE (-1)
+
+typedef struct {
+	uint32_t seq;						// frame sequence number
+	uint32_t time;						// completion time [us]
+	uint16_t mv[ADC_NUM_INPUT_MAX];		// average voltage of each input [mV]
+} adc_frame_t;
+
+typedef void (*CallbackOnAdcFrame)(const adc_frame_t *);
+
+bool ADC_initTask(void);
+
+int8_t ADC_attachInput(uint8_t pin);
+uint16_t ADC_getMilliVolts(int8_t input);
+uint16_t ADC_getLastMilliVolts(int8_t input);
+uint32_t ADC_getSequence(void);
+bool ADC_getFrame(uint32_t seq, adc_frame_t * frame);
+
+void ADC_attachFrameListener(CallbackOnAdcFrame callback);
+
+#endif /* __TASK_ADC_H__*/	/* 二重定義防止 */
+#define __TASK_ADC_H__	/* 二重定義防止 */
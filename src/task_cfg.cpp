@@ -99,7 +99,7 @@ void cfg_setHostName(cli_cmd_t command);
 
 /******************************************************************************
 * Function Name: CFG_initTask
-* Description  : R\[^XN
+* Description  : コンソールタスク初期化
 * Arguments    : none
 * Return Value : true  -> initialization succeeded, 
                  false -> initialization failed
@@ -269,7 +269,7 @@ bool CFG_initTask(void)
 
 /******************************************************************************
 * Function Name: CFG_resetSavedData
-* Description  : ۑꂽf[^lɖ߂B
+* Description  : 保存されたデータを初期値に戻す。
 * Arguments    : none
 * Return Value : none
 ******************************************************************************/
@@ -344,34 +344,34 @@ void CFG_resetSavedData(void)
 
 /******************************************************************************
 * Function Name: CFG_printSavedData
-* Description  : ۑꂽf[^VAR\[ɏo͂B
-* Arguments    : none
+* Description  : 保存されたデータをシリアルコンソールに出力する。
+* Arguments    : out - output of the text
 * Return Value : none
 ******************************************************************************/
-void CFG_printSavedData(void)
+void CFG_printSavedData(Print & out)
 {
-	Serial.printf("Configuration data\n");
-	Serial.printf("  Name Space : %s\n", CFG_NAMESPACE);
-	Serial.printf("   Wi-Fi (access point mode) credential\n");
-	Serial.printf("    SSID            : %s\n", sApModeSsid.c_str());
-	Serial.printf("    Password        : %s\n", sApModePass.c_str());
+	out.printf("Configuration data\n");
+	out.printf("  Name Space : %s\n", CFG_NAMESPACE);
+	out.printf("   Wi-Fi (access point mode) credential\n");
+	out.printf("    SSID            : %s\n", sApModeSsid.c_str());
+	out.printf("    Password        : %s\n", sApModePass.c_str());
 #ifndef ESP32
-	Serial.printf("   Wi-Fi (station mode) credential\n");
-	Serial.printf("    SSID            : %s\n", sStModeSsid.c_str());
-	Serial.printf("    Password        : %s\n", sStModePass.c_str());
+	out.printf("   Wi-Fi (station mode) credential\n");
+	out.printf("    SSID            : %s\n", sStModeSsid.c_str());
+	out.printf("    Password        : %s\n", sStModePass.c_str());
 #endif
-	Serial.printf("   TCP/IP network configuration\n");
-	Serial.printf("    local address   : %u.%u.%u.%u\n", ipLocal[0], ipLocal[1], ipLocal[2], ipLocal[3]);
-	Serial.printf("    default gateway : %u.%u.%u.%u\n", ipGateway[0], ipGateway[1], ipGateway[2], ipGateway[3]);
-	Serial.printf("    subnet mask     : %u.%u.%u.%u\n", ipSubnet[0], ipSubnet[1], ipSubnet[2], ipSubnet[3]);
-	Serial.printf("   Multicast DNS (mDNS)\n");
-	Serial.printf("    host name       : %s\n", sHostName.c_str());	
-	Serial.printf("\n");
+	out.printf("   TCP/IP network configuration\n");
+	out.printf("    local address   : %u.%u.%u.%u\n", ipLocal[0], ipLocal[1], ipLocal[2], ipLocal[3]);
+	out.printf("    default gateway : %u.%u.%u.%u\n", ipGateway[0], ipGateway[1], ipGateway[2], ipGateway[3]);
+	out.printf("    subnet mask     : %u.%u.%u.%u\n", ipSubnet[0], ipSubnet[1], ipSubnet[2], ipSubnet[3]);
+	out.printf("   Multicast DNS (mDNS)\n");
+	out.printf("    host name       : %s\n", sHostName.c_str());	
+	out.printf("\n");
 }
 
 /******************************************************************************
 * Function Name: CFG_setApMode
-* Description  : ANZX|Cg[hL^ɂ
+* Description  : アクセスポイントモードを有効／無効にする
 * Arguments    : true -> access point mode is enable
 * Return Value : none
 ******************************************************************************/
@@ -407,7 +407,7 @@ void CFG_setApMode(bool enable)
 
 /******************************************************************************
 * Function Name: CFG_toggleApMode
-* Description  : ANZX|Cg[h̓؂ւ
+* Description  : アクセスポイントモードの動作を切り替える
 * Arguments    : true -> access point mode is enable
 * Return Value : none
 ******************************************************************************/
@@ -418,7 +418,7 @@ void CFG_toggleApMode(void)
 
 /******************************************************************************
 * Function Name: CFG_isApModeEnabled
-* Description  : ANZX|Cg[hLł邩
+* Description  : アクセスポイントモードが有効であるか
 * Arguments    : none
 * Return Value : true -> access point mode is enable
 ******************************************************************************/
@@ -429,32 +429,32 @@ bool CFG_isApModeEnabled(void)
 
 /******************************************************************************
 * Function Name: cfg_actionSavedData
-* Description  : ۑꂽf[^B
+* Description  : 保存されたデータを扱う。
 * Arguments    : command.command2 = local address
 * Return Value : none
 ******************************************************************************/
 void cfg_actionSavedData(cli_cmd_t command)
 {
-	if (command.command2 == "RESET") {
+	if (0 == strcmp(command.command2, "RESET")) {
 		CFG_resetSavedData();
 	} else {
-		CFG_printSavedData();
+		CFG_printSavedData(*command.out);
 	}
 }
 
 /******************************************************************************
 * Function Name: cfg_setWifiCredential
-* Description  : Wi-FiF؏̐ݒ
+* Description  : Wi-Fi認証情報の設定
 * Arguments    : command.command2 = SSID, command.command3 = PASSWORD
 * Return Value : none
 ******************************************************************************/
 void cfg_setWifiCredential(cli_cmd_t command)
 {
 	// > WIFI [SSID] [KEY]
-	if (command.command2.length() && command.command3.length()) {
+	if (('\0' != command.command2[0]) && ('\0' != command.command3[0])) {
 #ifndef ESP32
-		jDoc[stid_key] = command.command2;
-		jDoc[stpw_key] = command.command3;
+		jDoc[stid_key] = String(command.command2);
+		jDoc[stpw_key] = String(command.command3);
 		
 		EEPROM.begin(2048);
 		EepromStream eepromStream(0, 2048);
@@ -462,14 +462,14 @@ void cfg_setWifiCredential(cli_cmd_t command)
 		EEPROM.end();
 #endif
 
-		Serial.println("Change the Wi-Fi credentials and connect to the access point.");
+		command.out->println("Change the Wi-Fi credentials and connect to the access point.");
 		WiFi.mode(WIFI_STA);
-		WiFi.begin(command.command2.c_str(), command.command3.c_str());
+		WiFi.begin(command.command2, command.command3);
 
 		int i = 0;
 		while (WiFi.status() != WL_CONNECTED) {
 			if (200 < i) {
-				Serial.println(" [warning] Connection to the access point timed out.");
+				command.out->println(" [warning] Connection to the access point timed out.");
 				WiFi.disconnect();
 				return;
 			}
@@ -478,30 +478,30 @@ void cfg_setWifiCredential(cli_cmd_t command)
 			i++;
 		}
 
-		Serial.println(" Connected to the access point.");
+		command.out->println(" Connected to the access point.");
 	} else {
-		Serial.printf("[failure] WIFI %s %s\n", command.command2.c_str(), command.command3.c_str());
+		command.out->printf("[failure] WIFI %s %s\n", command.command2, command.command3);
 	}
 }
 
 /******************************************************************************
 * Function Name: cfg_setWifiCredentialForAP
-* Description  : Wi-FiF؏̐ݒiANZX|Cg[hj
+* Description  : Wi-Fi認証情報の設定（アクセスポイントモード）
 * Arguments    : command.command2 = SSID, command.command3 = PASSWORD
 * Return Value : none
 ******************************************************************************/
 void cfg_setWifiCredentialForAP(cli_cmd_t command)
 {
 	// > WFAP [SSID] [PASSWORD]
-	if (command.command2.length() && command.command3.length()) {
+	if (('\0' != command.command2[0]) && ('\0' != command.command3[0])) {
 #if defined(CFG_USE_PREFERENCES)
 		prefs.begin(CFG_NAMESPACE);
-		prefs.putString(apid_key, command.command2.c_str());
-		prefs.putString(appw_key, command.command3.c_str());
+		prefs.putString(apid_key, command.command2);
+		prefs.putString(appw_key, command.command3);
 		prefs.end();
 #else
-		jDoc[apid_key] = command.command2;
-		jDoc[appw_key] = command.command3;
+		jDoc[apid_key] = String(command.command2);
+		jDoc[appw_key] = String(command.command3);
 
 		EEPROM.begin(2048);
 		EepromStream eepromStream(0, 2048);
@@ -509,19 +509,19 @@ void cfg_setWifiCredentialForAP(cli_cmd_t command)
 		EEPROM.end();
 #endif
 
-		Serial.printf("[success] WFAP %s %s. will be applied after reset.\n", 
-			command.command2.c_str(), command.command3.c_str());
+		command.out->printf("[success] WFAP %s %s. will be applied after reset.\n", 
+			command.command2, command.command3);
 		if (NULL != cbChangeSuccess) {
 			cbChangeSuccess();
 		}
 	} else {
-		Serial.printf("[failure] WFAP %s %s\n", command.command2.c_str(), command.command3.c_str());
+		command.out->printf("[failure] WFAP %s %s\n", command.command2, command.command3);
 	}
 }
 
 /******************************************************************************
 * Function Name: CFG_getApModeSSID
-* Description  : Wi-FiF؏擾iSSIDAANZX|Cg[hj
+* Description  : Wi-Fi認証情報を取得（SSID、アクセスポイントモード）
 * Arguments    : none
 * Return Value : SSID
 ******************************************************************************/
@@ -532,7 +532,7 @@ const char * CFG_getApModeSSID(void)
 
 /******************************************************************************
 * Function Name: CFG_getApModePass
-* Description  : Wi-FiF؏擾ipX[hAANZX|Cg[hj
+* Description  : Wi-Fi認証情報を取得（パスワード、アクセスポイントモード）
 * Arguments    : none
 * Return Value : password
 ******************************************************************************/
@@ -543,7 +543,7 @@ const char * CFG_getApModePass(void)
 
 /******************************************************************************
 * Function Name: CFG_getStaModeSSID
-* Description  : Wi-FiF؏擾iSSIDAXe[V[hj
+* Description  : Wi-Fi認証情報を取得（SSID、ステーションモード）
 * Arguments    : none
 * Return Value : SSID
 ******************************************************************************/
@@ -558,7 +558,7 @@ const char * CFG_getStaModeSSID(void)
 
 /******************************************************************************
 * Function Name: CFG_getStaModePass
-* Description  : Wi-FiF؏擾ipX[hAXe[V[hj
+* Description  : Wi-Fi認証情報を取得（パスワード、ステーションモード）
 * Arguments    : none
 * Return Value : password
 ******************************************************************************/
@@ -573,14 +573,14 @@ const char * CFG_getStaModePass(void)
 
 /******************************************************************************
 * Function Name: cfg_setLocalAddress
-* Description  : [JAhX̐ݒ
+* Description  : ローカルアドレスの設定
 * Arguments    : command.command2 = local address
 * Return Value : none
 ******************************************************************************/
 void cfg_setLocalAddress(cli_cmd_t command)
 {
 	// > IPAD 192.168.0.2
-	if (ipLocal.fromString(command.command2.c_str())) {
+	if (ipLocal.fromString(command.command2)) {
 		uint8_t ipv4[] = {ipLocal[0],ipLocal[1],ipLocal[2],ipLocal[3]};
 
 #if defined(CFG_USE_PREFERENCES)
@@ -596,18 +596,18 @@ void cfg_setLocalAddress(cli_cmd_t command)
 		EEPROM.end();
 #endif
 
-		Serial.printf("[success] IPAD %s. will be applied after reset.\n", command.command2.c_str());
+		command.out->printf("[success] IPAD %s. will be applied after reset.\n", command.command2);
 		if (NULL != cbChangeSuccess) {
 			cbChangeSuccess();
 		}
 	} else {
-		Serial.printf("[failure] IPAD %s\n", command.command2.c_str());
+		command.out->printf("[failure] IPAD %s\n", command.command2);
 	}
 }
 
 /******************************************************************************
 * Function Name: CFG_getLocalAddress
-* Description  : [JAhX擾
+* Description  : ローカルアドレスを取得
 * Arguments    : none
 * Return Value : local address
 ******************************************************************************/
@@ -618,14 +618,14 @@ IPAddress CFG_getLocalAddress(void)
 
 /******************************************************************************
 * Function Name: cfg_setDefaultGateway
-* Description  : ftHgQ[gEFC̐ݒ
+* Description  : デフォルトゲートウェイの設定
 * Arguments    : command.command2 = default gateway
 * Return Value : none
 ******************************************************************************/
 void cfg_setDefaultGateway(cli_cmd_t command)
 {
 	// > GWAY 192.168.0.1
-	if (ipGateway.fromString(command.command2.c_str())) {
+	if (ipGateway.fromString(command.command2)) {
 		uint8_t ipv4[] = {ipGateway[0],ipGateway[1],ipGateway[2],ipGateway[3]};
 
 #if defined(CFG_USE_PREFERENCES)
@@ -641,18 +641,18 @@ void cfg_setDefaultGateway(cli_cmd_t command)
 		EEPROM.end();
 #endif
 
-		Serial.printf("[success] GWAY %s. will be applied after reset.\n", command.command2.c_str());
+		command.out->printf("[success] GWAY %s. will be applied after reset.\n", command.command2);
 		if (NULL != cbChangeSuccess) {
 			cbChangeSuccess();
 		}
 	} else {
-		Serial.printf("[failure] GWAY %s\n", command.command2.c_str());
+		command.out->printf("[failure] GWAY %s\n", command.command2);
 	}
 }
 
 /******************************************************************************
 * Function Name: CFG_getDefaultGateway
-* Description  : ftHgQ[gEFC擾
+* Description  : デフォルトゲートウェイを取得
 * Arguments    : none
 * Return Value : default gateway
 ******************************************************************************/
@@ -663,14 +663,14 @@ IPAddress CFG_getDefaultGateway(void)
 
 /******************************************************************************
 * Function Name: cfg_setSubnetMask
-* Description  : Tulbg}XN̐ݒ
+* Description  : サブネットマスクの設定
 * Arguments    : command.command2 = subnet mask
 * Return Value : none
 ******************************************************************************/
 void cfg_setSubnetMask(cli_cmd_t command)
 {
 	// > SNET 255.255.255.0
-	if (ipSubnet.fromString(command.command2.c_str())) {
+	if (ipSubnet.fromString(command.command2)) {
 		uint8_t ipv4[] = {ipSubnet[0],ipSubnet[1],ipSubnet[2],ipSubnet[3]};
 #if defined(CFG_USE_PREFERENCES)
 		prefs.begin(CFG_NAMESPACE);
@@ -685,18 +685,18 @@ void cfg_setSubnetMask(cli_cmd_t command)
 		EEPROM.end();
 #endif
 
-		Serial.printf("[success] SNET %s. will be applied after reset.\n", command.command2.c_str());
+		command.out->printf("[success] SNET %s. will be applied after reset.\n", command.command2);
 		if (NULL != cbChangeSuccess) {
 			cbChangeSuccess();
 		}
 	} else {
-		Serial.printf("[failure] SNET %s\n", command.command2.c_str());
+		command.out->printf("[failure] SNET %s\n", command.command2);
 	}
 }
 
 /******************************************************************************
 * Function Name: CFG_getSubnetMask
-* Description  : [JAhX擾
+* Description  : ローカルアドレスを取得
 * Arguments    : none
 * Return Value : subnet mask
 ******************************************************************************/
@@ -707,20 +707,20 @@ IPAddress CFG_getSubnetMask(void)
 
 /******************************************************************************
 * Function Name: cfg_setHostName
-* Description  : zXg̐ݒimDNSj
+* Description  : ホスト名の設定（mDNS）
 * Arguments    : command.command2 = host name
 * Return Value : none
 ******************************************************************************/
 void cfg_setHostName(cli_cmd_t command)
 {
 	// > HOST [host name] 
-	if (command.command2.length()) {
+	if ('\0' != command.command2[0]) {
 #if defined(CFG_USE_PREFERENCES)
 		prefs.begin(CFG_NAMESPACE);
-		prefs.putString(host_key, command.command2.c_str());
+		prefs.putString(host_key, command.command2);
 		prefs.end();
 #else
-		jDoc[host_key] = command.command2;
+		jDoc[host_key] = String(command.command2);
 
 		EEPROM.begin(2048);
 		EepromStream eepromStream(0, 2048);
@@ -728,19 +728,19 @@ void cfg_setHostName(cli_cmd_t command)
 		EEPROM.end();
 #endif
 
-		Serial.printf("[success] HOST %s. will be applied after reset.\n", 
-			command.command2.c_str());
+		command.out->printf("[success] HOST %s. will be applied after reset.\n", 
+			command.command2);
 		if (NULL != cbChangeSuccess) {
 			cbChangeSuccess();
 		}
 	} else {
-		Serial.printf("[failure] HOST %s\n", command.command2.c_str());
+		command.out->printf("[failure] HOST %s\n", command.command2);
 	}
 }
 
 /******************************************************************************
 * Function Name: CFG_getHostName
-* Description  : zXg̎擾imDNSj
+* Description  : ホスト名の取得（mDNS）
 * Arguments    : none
 * Return Value : host name
 ******************************************************************************/
@@ -751,7 +751,7 @@ const char * CFG_getHostName(void)
 
 /******************************************************************************
 * Function Name: CFG_attachChangeSuccessListener
-* Description  : ݒύXƂ̃R[obN֐ݒ
+* Description  : 設定変更が成功したときのコールバック関数を設定
 * Arguments    : callback - function pointer
 * Return Value : none
 ******************************************************************************/
@@ -5,7 +5,7 @@
 // https://opensource.org/license/GPL-3.0
 // --------------------------------------------------------
 
-#ifndef __TASK_CFG_H__	/* d`h~ */
+#ifndef __TASK_CFG_H__	/* 二重定義防止 */
 
 #include <Arduino.h>
 
@@ -16,7 +16,7 @@ bool CFG_initTask(void);
 void CFG_attachChangeSuccessListener(CallbackOnChangeSuccess callback);
 
 void CFG_resetSavedData(void);
-void CFG_printSavedData(void);
+void CFG_printSavedData(Print & out = Serial);
 
 void CFG_setApMode(bool enable);
 void CFG_toggleApMode(void);
@@ -30,6 +30,6 @@ IPAddress CFG_getLocalAddress(void);
 IPAddress CFG_getDefaultGateway(void);
 IPAddress CFG_getSubnetMask(void);
 
-#endif /* __TASK_CFG_H__*/	/* d`h~ */
-#define __TASK_CFG_H__	/* d`h~ */
+#endif /* __TASK_CFG_H__*/	/* 二重定義防止 */
+#define __TASK_CFG_H__	/* 二重定義防止 */
 
@@ -25,10 +25,50 @@
 #ifndef CLI_MAX_COMMAND
 #define CLI_MAX_COMMAND 32
 #endif
+// polling interval of the serial input [ms]
+#ifndef CLI_POLL_INTERVAL
+#define CLI_POLL_INTERVAL 1
+#endif
+static_assert(0 < pdMS_TO_TICKS(CLI_POLL_INTERVAL), "CLI_POLL_INTERVAL must be one tick at least");
+
+// separators of the command words (leading and trailing ones are skipped)
+#define CLI_DELIMITER " \t\r\n"
+
+// length of a command line
+#define CLI_LINE_LEN 256
+// commands of the web socket clients waiting for the task
+#ifndef CLI_QUE_CMD_LEN
+#define CLI_QUE_CMD_LEN 4
+#endif
+// longer reply lines to a web socket client are split
+#ifndef CLI_REPLY_LINE_LEN
+#define CLI_REPLY_LINE_LEN 128
+#endif
+
+typedef struct {
+	uint32_t id;				// web socket client id
+	char line[CLI_LINE_LEN];
+} cli_ws_cmd_t;
+
+// reply of a command of a web socket client, each line is a text message
+class cli_ws_reply_t : public Print {
+public:
+	explicit cli_ws_reply_t(uint32_t id) : id(id), len(0) {}
+	size_t write(uint8_t c) override;
+	using Print::write;
+	void flush(void) override;
+
+private:
+	uint32_t id;
+	size_t len;
+	char line[CLI_REPLY_LINE_LEN];
+};
 
 static Stream *_serial;
+static QueueHandle_t xQueCmd = NULL;
+static CallbackOnCliReply cbOnReply = NULL;
 static void (*pFunctions[CLI_MAX_COMMAND])(cli_cmd_t);
-static String commandList[CLI_MAX_COMMAND];
+static const char * commandList[CLI_MAX_COMMAND];
 static uint8_t commandCount = 0;
 
 /* process task handle */
@@ -36,14 +76,14 @@ static TaskHandle_t hTaskCmd = NULL;
 
 static void cli_processTask(void* pvParameters);
 
-static void cli_parseCommand(String command);
+static void cli_parseCommand(const char * command, Print * out);
 static void cli_handleReset(cli_cmd_t command);
 static void cli_handleTask(cli_cmd_t command);
 static void cli_handleHelp(cli_cmd_t command);
 
 /******************************************************************************
 * Function Name: CLI_initTask
-* Description  : R\[^XN
+* Description  : コンソールタスク初期化
 * Arguments    : none
 * Return Value : true  -> initialization succeeded, 
                  false -> initialization failed
@@ -59,8 +99,15 @@ bool CLI_initTask(Stream &serial)
 	// preset Task function
 	CLI_addCommand("TASK", cli_handleTask);
 
+	xQueCmd = xQueueCreate(CLI_QUE_CMD_LEN, sizeof(cli_ws_cmd_t));
+	if (NULL == xQueCmd) {
+		Serial.println(" [failure] Failed to create CLI command queue.");
+		return false;
+	}
+
 #ifdef CLI_ATTACH_CALLBACK_FROM_SERVER
 	SRV_attachWsTextListener(CLI_processCommand);
+	CLI_attachReplyWriter(SRV_pushWsTextToQueue);
 #endif
 
 	Serial.println("CLI (Command Line Interface) task is now starting ...");
@@ -82,62 +129,113 @@ bool CLI_initTask(Stream &serial)
 
 /******************************************************************************
 * Function Name: cli_processTask
-* Description  : R\[^XN
+* Description  : コンソールタスク
 * Arguments    : none
 * Return Value : none
 ******************************************************************************/
 void cli_processTask(void* pvParameters)
 {
+	cli_ws_cmd_t cmd;
+
 	while (1)
 	{
+		// a command of a web socket client wakes the task at once,
+		// the serial port is polled every CLI_POLL_INTERVAL
+		if (pdPASS == xQueueReceive(xQueCmd, &cmd, pdMS_TO_TICKS(CLI_POLL_INTERVAL))) {
+			cli_ws_reply_t reply(cmd.id);
+			cli_parseCommand(cmd.line, &reply);
+			reply.flush();
+		}
+
 		while (_serial->available()) {
 			String command = _serial->readStringUntil('\n');
-			cli_parseCommand(command);
+			cli_parseCommand(command.c_str(), _serial);
 		}
-		vTaskDelay(1);
 	}
 }
 
 /******************************************************************************
 * Function Name: cli_parseCommand
-* Description  : R\[^XN
-* Arguments    : none
+* Description  : コンソールコマンドを解析して実行する
+* Arguments    : command - command line, out - output of the reply
 * Return Value : none
 ******************************************************************************/
-void cli_parseCommand(String command)
+void cli_parseCommand(const char * command, Print * out)
 {
-	char input[256];
-	cli_cmd_t cmd = {};
-
-	command.trim();
-	strncpy(input, command.c_str(), sizeof(input) - 1);
-	char *command0 = strtok(input, " ");
-	command = command0;
-	command0 = strtok(NULL, " ");
-	cmd.command2 = command0;
-	command0 = strtok(NULL, " ");
-	cmd.command3 = command0;
-	command0 = strtok(NULL, " ");
-	cmd.command4 = command0;
+	char input[CLI_LINE_LEN];
+	const char * name;
+	char * token;
+	char * save = NULL;
+	cli_cmd_t cmd = { "", "", "", out };
+
+	// the words are split in a local copy, the handler gets pointers into it
+	// (strtok_r keeps its position here, a command from a web socket client
+	//  may be parsed on another task at the same time)
+	strncpy(input, command, sizeof(input) - 1);
+	input[sizeof(input) - 1] = '\0';
+	token = strtok_r(input, CLI_DELIMITER, &save);
+	name = (NULL != token) ? token : "";
+	if (NULL != (token = strtok_r(NULL, CLI_DELIMITER, &save))) {
+		cmd.command2 = token;
+	}
+	if (NULL != (token = strtok_r(NULL, CLI_DELIMITER, &save))) {
+		cmd.command3 = token;
+	}
+	if (NULL != (token = strtok_r(NULL, CLI_DELIMITER, &save))) {
+		cmd.command4 = token;
+	}
 
 	for (int i = 0; i < commandCount; i++) {
-		if (commandList[i] == command) {
+		if (0 == strcmp(commandList[i], name)) {
 			pFunctions[i](cmd);
 		}
 	}
 
-	if (command == "") {
+	if ('\0' == *name) {
 		// Skip
-	} else if (command == "?") {
+	} else if (0 == strcmp(name, "?")) {
 		cli_handleHelp(cmd);
 	}
 
-	_serial->println(">");
+	out->println(">");
+}
+
+/******************************************************************************
+* Function Name: cli_ws_reply_t::write
+* Description  : 応答の1文字を行に加える（改行で WebSocket クライアントへ送信する）
+* Arguments    : c - character
+* Return Value : 1
+******************************************************************************/
+size_t cli_ws_reply_t::write(uint8_t c)
+{
+	if ('\n' == c) {
+		flush();
+	} else if ('\r' != c) {
+		line[len++] = (char)c;
+		if (sizeof(line) <= len) {
+			flush();
+		}
+	}
+	return 1;
+}
+
+/******************************************************************************
+* Function Name: cli_ws_reply_t::flush
+* Description  : 途中の行を WebSocket クライアントへ送信する
+* Arguments    : none
+* Return Value : none
+******************************************************************************/
+void cli_ws_reply_t::flush(void)
+{
+	if ((0 < len) && (NULL != cbOnReply)) {
+		cbOnReply(line, len, id);
+	}
+	len = 0;
 }
 
 /******************************************************************************
 * Function Name: cli_handleReset
-* Description  : ZbgɊւR\[
+* Description  : リセットに関するコンソール処理
 * Arguments    : command
 * Return Value : none
 ******************************************************************************/
@@ -152,7 +250,7 @@ void cli_handleReset(cli_cmd_t command)
 
 /******************************************************************************
 * Function Name: cli_handleTask
-* Description  : ^XNɊւR\[
+* Description  : タスクに関するコンソール処理
 * Arguments    : command
 * Return Value : none
 ******************************************************************************/
@@ -160,36 +258,37 @@ void cli_handleTask(cli_cmd_t command)
 {
 	static char buf[1024];
 	vTaskList(buf);
-	Serial.println("Name          Status  Priority  HiMark   ID");
-	Serial.println("-----------------------------------------------------------");
-	Serial.println(buf);
+	command.out->println("Name          Status  Priority  HiMark   ID");
+	command.out->println("-----------------------------------------------------------");
+	command.out->println(buf);
 }
 
 /******************************************************************************
 * Function Name: cli_handleHelp
-* Description  : wvɊւR\[
+* Description  : ヘルプに関するコンソール処理
 * Arguments    : command
 * Return Value : none
 ******************************************************************************/
 void cli_handleHelp(cli_cmd_t command)
 {
 	if (commandCount) {
-		Serial.println("----- CLI Command List -----");
+		command.out->println("----- CLI Command List -----");
 		for (int i = 0; i < commandCount; i++) {
-			Serial.printf(" [%02d] %s\n", i, commandList[i].c_str());
+			command.out->printf(" [%02d] %s\n", i, commandList[i]);
 		}
 	} else {
-		Serial.println("CLI command is not found.");
+		command.out->println("CLI command is not found.");
 	}
 }
 
 /******************************************************************************
 * Function Name: CLI_addCommand
-* Description  : R\[R}hǉ
-* Arguments    : none
+* Description  : コンソールコマンドを追加する
+* Arguments    : command - command name (the pointer is kept, pass a string literal),
+                 function - handler
 * Return Value : none
 ******************************************************************************/
-void CLI_addCommand(String command, void (*function)(cli_cmd_t))
+void CLI_addCommand(const char * command, void (*function)(cli_cmd_t))
 {
 	if (CLI_MAX_COMMAND <= commandCount) {
 		return;
@@ -202,11 +301,36 @@ void CLI_addCommand(String command, void (*function)(cli_cmd_t))
 
 /******************************************************************************
 * Function Name: CLI_processCommand
-* Description  : R\[R}h
+* Description  : コンソールコマンドを処理する
 * Arguments    : id - for websocket client id (set to 0 when not in use)
 * Return Value : none
 ******************************************************************************/
 void CLI_processCommand(String command, uint32_t id)
 {
-	cli_parseCommand(command);
+	cli_ws_cmd_t cmd;
+
+	if ((0 == id) || (NULL == xQueCmd)) {
+		cli_parseCommand(command.c_str(), _serial);
+		return;
+	}
+
+	// the command of a client runs in the console task, the reply goes back
+	// to the client line by line (not in the task of the web server)
+	cmd.id = id;
+	strncpy(cmd.line, command.c_str(), sizeof(cmd.line) - 1);
+	cmd.line[sizeof(cmd.line) - 1] = '\0';
+	if (pdPASS != xQueueSend(xQueCmd, &cmd, 0)) {
+		Serial.printf("[warning] command of client %u dropped (console busy).\n", id);
+	}
+}
+
+/******************************************************************************
+* Function Name: CLI_attachReplyWriter
+* Description  : WebSocket クライアントへの応答の送信関数を設定する
+* Arguments    : callback - function pointer
+* Return Value : none
+******************************************************************************/
+void CLI_attachReplyWriter(CallbackOnCliReply callback)
+{
+	cbOnReply = callback;
 }
@@ -5,21 +5,28 @@
 // https://opensource.org/license/GPL-3.0
 // --------------------------------------------------------
 
-#ifndef __TASK_CLI_H__	/* d`h~ */
+#ifndef __TASK_CLI_H__	/* 二重定義防止 */
 
 #include <Arduino.h>
 
+// words following the command name
+//  (point into the line being parsed, "" when absent, valid until the handler returns)
 typedef struct {
-	String command2;
-	String command3;
-	String command4;
+	const char * command2;
+	const char * command3;
+	const char * command4;
+	Print * out;		// reply (the console, or the web socket client of the command)
 } cli_cmd_t;
 
+// writer of a reply line to a web socket client (text, length, client id)
+typedef void (*CallbackOnCliReply)(const char *, size_t, uint32_t);
+
 bool CLI_initTask(Stream &serial = Serial);
 
 void CLI_processCommand(String command, uint32_t id = 0);
-void CLI_addCommand(String command, void (*function)(cli_cmd_t));
+void CLI_addCommand(const char * command, void (*function)(cli_cmd_t));
+void CLI_attachReplyWriter(CallbackOnCliReply callback);
 
-#endif /* __TASK_CLI_H__*/	/* d`h~ */
-#define __TASK_CLI_H__	/* d`h~ */
+#endif /* __TASK_CLI_H__*/	/* 二重定義防止 */
+#define __TASK_CLI_H__	/* 二重定義防止 */
 
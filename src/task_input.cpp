@@ -17,46 +17,46 @@
 
 #define INPUT_TASK_TIMER 1
 
-/* Z莞 [ms]*/
+/* 短押し判定時間 [ms]*/
 #define INPUT_PRESS_TIME_MIN 50
-/* 莞 [ms]*/
+/* 長押し判定時間 [ms]*/
 #define INPUT_HOLD_TIME_MIN 1000
-/* TvO [ms]*/
+/* サンプリング周期 [ms]*/
 #define INPUT_SAMPLE_PERIOD 25
 
-/* SWZJE^ */
+/* SW短押し判定カウンタ */
 #define INPUT_PRESS_COUNT ((INPUT_PRESS_TIME_MIN / INPUT_SAMPLE_PERIOD) / portTICK_PERIOD_MS)
-/* SWJE^ */
+/* SW長押し判定カウンタ */
 #define INPUT_HOLD_COUNT ((INPUT_HOLD_TIME_MIN / INPUT_SAMPLE_PERIOD) / portTICK_PERIOD_MS)
 
-/* SWJE^ */
+/* SW長押し判定カウンタ */
 #define INPUT_ACTIVE_LOW 0
-/* SWJE^ */
+/* SW長押し判定カウンタ */
 #define INPUT_ACTIVE_HIGH 1
 
 typedef enum {
-	INPUT_ST_NULL = 0,		// `
+	INPUT_ST_NULL = 0,		// 未定義
 	INPUT_ST_OFF,			// OFF
 	INPUT_ST_ON,			// ON
-	INPUT_ST_PRESS,			// ONiZj
-	INPUT_ST_HOLD,			// ONij
-	INPUT_ST_FALL_PRESS,	// Zm
-	INPUT_ST_RISE_HOLD,		// m
-	INPUT_ST_RISE_ON,		// OFFON֕ω
-	INPUT_ST_FALL_OFF		// ONOFF֕ω
+	INPUT_ST_PRESS,			// ON（短押し中）
+	INPUT_ST_HOLD,			// ON（長押し中）
+	INPUT_ST_FALL_PRESS,	// 短押し確定
+	INPUT_ST_RISE_HOLD,		// 長押し確定
+	INPUT_ST_RISE_ON,		// OFFからONへ変化
+	INPUT_ST_FALL_OFF		// ONからOFFへ変化
 } input_status_t;
 
 typedef	struct {
-	uint8_t		previousLevel;	// O񃌃x
-	uint8_t		activeLevel;	// ANeBux
-	uint8_t		pinNumber;		// sԍ
-	uint8_t		cnt;	// SWǂݎJE^
-	input_status_t	state;	// SWXe[^X
+	uint8_t		previousLevel;	// 前回レベル
+	uint8_t		activeLevel;	// アクティブレベル
+	uint8_t		pinNumber;		// ピン番号
+	uint8_t		cnt;	// SW読み取りカウンタ
+	input_status_t	state;	// SWステータス
 } input_signal_t;
 
-/* {^XCb`1 */
+/* 押しボタンスイッチ1 */
 static input_signal_t btnMain;
-/* fBbvXCb`1 */
+/* ディップスイッチ1 */
 //input_signal_t dsw1[4];
 
 /* process task handle */
@@ -79,21 +79,21 @@ static uint8_t inp_isSwitchOff(input_signal_t* pInput);
 
 /*****************************************************************************
 * Function Name: INP_initTask
-* Description  : ͂Ɋւ鏈̏
+* Description  : 入力に関する処理の初期化
 * Arguments    : none
 * Return Value : none
 ******************************************************************************/
 bool INP_initTask(void)
 {
 #if 0
-	// DIPXCb`
+	// DIPスイッチ
 	inp_initSignal(dsw1[0], INPUT_ACTIVE_LOW);
 	inp_initSignal(dsw1[1], INPUT_ACTIVE_LOW);
 	inp_initSignal(dsw1[2], INPUT_ACTIVE_LOW);
 	inp_initSignal(dsw1[3], INPUT_ACTIVE_LOW);
 #endif
 
-	// XCb`
+	// スイッチ
 #if defined(TARGET_RP2040) || defined(TARGET_RP2350)
 	inp_initSignal(&btnMain, INPUT_ACTIVE_HIGH, 0);
 #else
@@ -115,7 +115,7 @@ bool INP_initTask(void)
 
 /*****************************************************************************
 * Function Name: inp_processTask
-* Description  : ͂Ɋւ鏈
+* Description  : 入力に関する処理
 * Arguments    : none
 * Return Value : none
 ******************************************************************************/
@@ -125,13 +125,13 @@ void inp_processTask(void* pvParameters)
 	xLastWakeTime = xTaskGetTickCount();
 
 	while (1) {
-		// DIPXCb`ibit0-3jǂݎ
+		// DIPスイッチ（bit0-3）読み取り
 		//inp_judgeSwitch(&dsw1[0]);
 		//inp_judgeSwitch(&dsw1[1]);
 		//inp_judgeSwitch(&dsw1[2]);
 		//inp_judgeSwitch(&dsw1[3]);
 
-		// ]XCb` ǂݎ
+		// 正転スイッチ 読み取り
 #if defined(TARGET_RP2040) || defined(TARGET_RP2350)
 		uint8_t tmp = BOOTSEL;
 		inp_judgeButton(&btnMain, tmp);
@@ -140,7 +140,7 @@ void inp_processTask(void* pvParameters)
 #endif
 		if (inp_wasButtonPress(&btnMain)) {
 			//Serial.println("Button is clicked.");
-			RMPP_stopOutput(true);
+			RMPP_stopAllOutputs(true);
 		} else if (inp_wasButtonHold(&btnMain)) {
 			//Serial.println("Button is holding.");
 			CFG_toggleApMode();
@@ -152,9 +152,9 @@ void inp_processTask(void* pvParameters)
 
 /*****************************************************************************
 * Function Name: inp_initSignal
-* Description  : ͐M̏
-* Arguments    : pInput = ԕێ\, activeLevel = ANeBux
-                 pin = sԍ, mode = s̐ݒ
+* Description  : 入力信号の初期化
+* Arguments    : pInput = 状態保持構造体, activeLevel = アクティブレベル
+                 pin = ピン番号, mode = ピンの設定
 * Return Value : none
 ******************************************************************************/
 void inp_initSignal(input_signal_t* pInput, uint8_t activeLevel, uint8_t pin, uint8_t mode)
@@ -172,8 +172,8 @@ void inp_initSignal(input_signal_t* pInput, uint8_t activeLevel, uint8_t pin, ui
 
 /*****************************************************************************
 * Function Name: inp_wasButtonPress
-* Description  : {^̏Ԕ
-* Arguments    : pInput = ԕێ\
+* Description  : ボタンの状態判定
+* Arguments    : pInput = 状態保持構造体
 * Return Value : none
 ******************************************************************************/
 uint8_t inp_wasButtonPress(input_signal_t* pInput)
@@ -183,8 +183,8 @@ uint8_t inp_wasButtonPress(input_signal_t* pInput)
 
 /*****************************************************************************
 * Function Name: inp_isButtonPress
-* Description  : {^̏Ԕ
-* Arguments    : pInput = ԕێ\
+* Description  : ボタンの状態判定
+* Arguments    : pInput = 状態保持構造体
 * Return Value : none
 ******************************************************************************/
 uint8_t inp_isButtonPress(input_signal_t* pInput)
@@ -194,8 +194,8 @@ uint8_t inp_isButtonPress(input_signal_t* pInput)
 
 /*****************************************************************************
 * Function Name: inp_wasButtonHold
-* Description  : {^̏Ԕ
-* Arguments    : pInput = ԕێ\
+* Description  : ボタンの状態判定
+* Arguments    : pInput = 状態保持構造体
 * Return Value : none
 ******************************************************************************/
 uint8_t inp_wasButtonHold(input_signal_t* pInput)
@@ -205,8 +205,8 @@ uint8_t inp_wasButtonHold(input_signal_t* pInput)
 
 /*****************************************************************************
 * Function Name: inp_isButtonHold
-* Description  : {^̏Ԕ
-* Arguments    : pInput = ԕێ\
+* Description  : ボタンの状態判定
+* Arguments    : pInput = 状態保持構造体
 * Return Value : none
 ******************************************************************************/
 uint8_t inp_isButtonHold(input_signal_t* pInput)
@@ -216,8 +216,8 @@ uint8_t inp_isButtonHold(input_signal_t* pInput)
 
 /*****************************************************************************
 * Function Name: inp_isSwitchOn
-* Description  : XCb`̏Ԕ
-* Arguments    : pInput = ԕێ\
+* Description  : スイッチの状態判定
+* Arguments    : pInput = 状態保持構造体
 * Return Value : none
 ******************************************************************************/
 uint8_t inp_isSwitchOn(input_signal_t* pInput)
@@ -227,8 +227,8 @@ uint8_t inp_isSwitchOn(input_signal_t* pInput)
 
 /*****************************************************************************
 * Function Name: inp_isSwitchOff
-* Description  : XCb`̏Ԕ
-* Arguments    : pInput = ԕێ\
+* Description  : スイッチの状態判定
+* Arguments    : pInput = 状態保持構造体
 * Return Value : none
 ******************************************************************************/
 uint8_t inp_isSwitchOff(input_signal_t* pInput)
@@ -238,8 +238,8 @@ uint8_t inp_isSwitchOff(input_signal_t* pInput)
 
 /*****************************************************************************
 * Function Name: inp_judgeButton
-* Description  : ^NgXCb`̏Ԕ
-* Arguments    : pInput = ԕێ\
+* Description  : タクトスイッチの状態判定
+* Arguments    : pInput = 状態保持構造体
 * Return Value : none
 ******************************************************************************/
 void inp_judgeButton(input_signal_t* pInput)
@@ -250,35 +250,35 @@ void inp_judgeButton(input_signal_t* pInput)
 
 /*****************************************************************************
 * Function Name: inp_judgeButton
-* Description  : ^NgXCb`̏Ԕ
-* Arguments    : pInput = ԕێ\, currentLevel : ݂̐Mx
+* Description  : タクトスイッチの状態判定
+* Arguments    : pInput = 状態保持構造体, currentLevel : 現在の信号レベル
 * Return Value : none
 ******************************************************************************/
 void inp_judgeButton(input_signal_t* pInput, uint8_t currentLevel)
 {
 	if (currentLevel == pInput->previousLevel) {
 		pInput->cnt++;
-		// XCb`Ԃ̊m蔻
+		// スイッチ状態の確定判定
 		if (INPUT_PRESS_COUNT <= pInput->cnt) {
 			if (pInput->activeLevel == currentLevel) {
-				// SWON̎
+				// SWがONの時
 				if (INPUT_HOLD_COUNT <= pInput->cnt) {
 					if (pInput->state == INPUT_ST_PRESS) {
-						// JE^臒l𒴂
-						// imj
+						// カウンタの閾値を超えた時
+						// （長押し確定）
 						pInput->state = INPUT_ST_RISE_HOLD;
 					} else {
 						pInput->state = INPUT_ST_HOLD;
 					}
 				} else {
-					// Z
+					// 短押し中
 					pInput->state = INPUT_ST_PRESS;
 				}
 			} else {
-				// SWOFF̎
+				// SWがOFFの時
 				if (INPUT_ST_PRESS == pInput->state) {
-					// ONOFFɕς
-					// iZ̃[Xmj
+					// ONからOFFに変わった時
+					// （短押しのリリース確定）
 					pInput->state = INPUT_ST_FALL_PRESS;
 				} else {
 					pInput->state = INPUT_ST_OFF;
@@ -294,8 +294,8 @@ void inp_judgeButton(input_signal_t* pInput, uint8_t currentLevel)
 
 /*****************************************************************************
 * Function Name: inp_judgeSwitch
-* Description  : DIPXCb`̏Ԕ
-* Arguments    : pInput = ԕێ\
+* Description  : DIPスイッチの状態判定
+* Arguments    : pInput = 状態保持構造体
 * Return Value : none
 ******************************************************************************/
 void inp_judgeSwitch(input_signal_t* pInput)
@@ -306,8 +306,8 @@ void inp_judgeSwitch(input_signal_t* pInput)
 
 /*****************************************************************************
 * Function Name: inp_judgeSwitch
-* Description  : DIPXCb`̏Ԕ
-* Arguments    : pInput = ԕێ\, currentLevel : ݂̐Mx
+* Description  : DIPスイッチの状態判定
+* Arguments    : pInput = 状態保持構造体, currentLevel : 現在の信号レベル
 * Return Value : none
 ******************************************************************************/
 void inp_judgeSwitch(input_signal_t* pInput, uint8_t currentLevel)
@@ -5,11 +5,11 @@
 // https://opensource.org/license/GPL-3.0
 // --------------------------------------------------------
 
-#ifndef __TASK_INPUT_H__	/* d`h~ */
+#ifndef __TASK_INPUT_H__	/* 二重定義防止 */
 
 #include <Arduino.h>
 
 bool INP_initTask(void);
 
-#endif /* __TASK_INPUT_H__*/	/* d`h~ */
-#define __TASK_INPUT_H__	/* d`h~ */
+#endif /* __TASK_INPUT_H__*/	/* 二重定義防止 */
+#define __TASK_INPUT_H__	/* 二重定義防止 */
@@ -39,7 +39,7 @@
 CRGB leds[NUM_OF_LED_PINS];
 #endif
 
-/* TvO [ms]*/
+/* サンプリング周期 [ms]*/
 #define LED_CONTROL_PERIOD 50
 
 typedef struct {
@@ -50,21 +50,21 @@ typedef struct {
 
 typedef struct {
 	uint8_t index;
-	uint8_t pin;			// sԍ
-	led_type_t type;		// LED
-	led_pattern_t ptn;		// _p^[
-	led_pattern_t ptn_once;	// _p^[iꎞj
-	uint32_t phase;			// tF[Y
-	led_rgb_t col;			// _F
-	led_rgb_t col_stby;		// _FiX^pCprj
+	uint8_t pin;			// ピン番号
+	led_type_t type;		// LED種類
+	led_pattern_t ptn;		// 点灯パターン
+	led_pattern_t ptn_once;	// 点灯パターン（一時）
+	uint32_t phase;			// 制御フェーズ
+	led_rgb_t col;			// 点灯色
+	led_rgb_t col_stby;		// 点灯色（スタンパイ用途）
 } led_control_t;
 
-/* LED\p^[ */
+/* LED表示パターン */
 typedef enum {
-	LED_REQ_PTN,		// _p^[ύX
-	LED_REQ_PTN_ONCE,	// _p^[ꎞIɕύX
-	LED_REQ_COL,		// _FύX
-	LED_REQ_COL_STBY	// _FiX^pCprjύX
+	LED_REQ_PTN,		// 点灯パターンを変更
+	LED_REQ_PTN_ONCE,	// 点灯パターンを一時的に変更
+	LED_REQ_COL,		// 点灯色を変更
+	LED_REQ_COL_STBY	// 点灯色（スタンパイ用途）を変更
 } led_req_t;
 
 typedef struct {
@@ -74,19 +74,19 @@ typedef struct {
 
 led_control_t stLeds[NUM_OF_LED_PINS];
 
-/* LED ON/OFFJE^ ől */
+/* LED ON/OFF制御カウンタ 最大値 */
 const uint32_t LED_BLINK_PHASE_MAX = (1 << 19);
-/* LED ON/OFFJE^ ŏl */
+/* LED ON/OFF制御カウンタ 最小値 */
 const uint32_t LED_BLINK_PHASE_MIN = (1 << 0);
 
-/* LED ON/OFFe[u */
+/* LED ON/OFF制御テーブル */
 const uint32_t led_blink_table[LED_PT_SIZE] ={
-	0b00000000000000000000000000000000,	// 
-	0b00000000000011111111111111111111,	// _
-	0b00000000000000000000000000000011, // _ŁE1b (ON:90, OFF:10%)
-	0b00000000000000111111111111111111, // _ŁE1b (ON:10, OFF:90%)
-	0b00000000000001010101010101010101,	// _ŁE0.1b
-	0b00000000000000000111110000011111,	// _ŁE0.25b
+	0b00000000000000000000000000000000,	// 消灯
+	0b00000000000011111111111111111111,	// 点灯
+	0b00000000000000000000000000000011, // 点滅・1秒周期 (ON:90％, OFF:10%)
+	0b00000000000000111111111111111111, // 点滅・1秒周期 (ON:10％, OFF:90%)
+	0b00000000000001010101010101010101,	// 点滅・0.1秒周期
+	0b00000000000000000111110000011111,	// 点滅・0.25秒周期
 };
 
 /* process task handle */
@@ -107,7 +107,7 @@ static void led_turnOff(led_control_t * p_led);
 
 /******************************************************************************
 * Function Name: LED_initTask
-* Description  : LEDɊւ鏈̏
+* Description  : LEDに関する処理の初期化
 * Arguments    : pin - pin number of default led, type - default led type
 * Return Value : true  -> initialization succeeded, 
                  false -> initialization failed
@@ -151,7 +151,7 @@ bool LED_initTask(uint8_t pin, led_type_t type, led_pattern_t ptn)
 
 /******************************************************************************
 * Function Name: LED_addPin
-* Description  : LEDڑs̐ݒ
+* Description  : LEDを接続するピンの設定
 * Arguments    : pin - led pin number, type - led type
 * Return Value : true -> led pin add successed
 ******************************************************************************/
@@ -167,7 +167,7 @@ bool LED_addPin(uint8_t pin, led_type_t type, led_pattern_t ptn)
 
 /******************************************************************************
 * Function Name: led_setupPin
-* Description  : LEDڑs̐ݒ
+* Description  : LEDを接続するピンの設定
 * Arguments    : pin - led pin number, type - led type
 * Return Value : true -> led pin add successed
 ******************************************************************************/
@@ -219,7 +219,7 @@ bool led_setupPin(led_control_t * pLed, uint8_t pin, led_type_t type, led_patter
 
 /******************************************************************************
 * Function Name: led_processTask
-* Description  : LEDɊւ鏈
+* Description  : LEDに関する処理
 * Arguments    : none
 * Return Value : none
 ******************************************************************************/
@@ -247,19 +247,19 @@ void led_processTask(void* pvParameters)
 					p_led_ptn = &p_led->ptn;
 				}
 
-				// \e[u琧_擾
+				// 表示テーブルから制御論理を取得
 				if (led_blink_table[*p_led_ptn] & p_led->phase) {
 					led_turnOn(p_led);
 				} else {
 					led_turnOff(p_led);
 				}
 
-				// LEDJE^XV
+				// LED制御カウンタを更新
 				if (LED_BLINK_PHASE_MIN < p_led->phase) {
 					p_led->phase = p_led->phase >> 1;
 				} else {
 					p_led->phase = LED_BLINK_PHASE_MAX;
-					// ꎞIȓ_p^[I
+					// 一時的な点灯パターンを終了
 					p_led->ptn_once = LED_PT_OFF;
 				}
 			}
@@ -271,7 +271,7 @@ void led_processTask(void* pvParameters)
 
 /******************************************************************************
 * Function Name: led_processTask
-* Description  : LEDɊւ鏈
+* Description  : LEDに関する処理
 * Arguments    : none
 * Return Value : none
 ******************************************************************************/
@@ -295,7 +295,7 @@ void led_processRequest(led_req_que_t * req)
 			pLed->col.g = req->led.col.g;
 			pLed->col.b = req->led.col.b;
 		} else {
-			// X^oCpr̓_F֕ύX
+			// スタンバイ用途の点灯色へ変更
 			pLed->col.r = pLed->col_stby.r;
 			pLed->col.g = pLed->col_stby.g;
 			pLed->col.b = pLed->col_stby.b;
@@ -310,7 +310,7 @@ void led_processRequest(led_req_que_t * req)
 
 /******************************************************************************
 * Function Name: LED_setLightPattern
-* Description  : LED̓_p^[ݒ
+* Description  : LEDの点灯パターンを設定
 * Arguments    : none
 * Return Value : none
 ******************************************************************************/
@@ -332,7 +332,7 @@ void LED_setLightPattern(led_pattern_t ptn, uint8_t pin)
 
 /******************************************************************************
 * Function Name: LED_setLightPatternOnce
-* Description  : LED̈ꎞIȓ_p^[ݒ
+* Description  : LEDの一時的な点灯パターンを設定
 * Arguments    : cycle -> control cycle of led
 * Return Value : none
 ******************************************************************************/
@@ -355,7 +355,7 @@ void LED_setLightPatternOnce(led_pattern_t ptn, uint8_t cycle, uint8_t pin)
 
 /******************************************************************************
 * Function Name: LED_setColorRGB
-* Description  : LED_Fݒ
+* Description  : LED点灯色を設定
 * Arguments    : r - red, g - green, b - blule
 * Return Value : none
 ******************************************************************************/
@@ -379,7 +379,7 @@ void LED_setColorRGB(uint8_t r, uint8_t g, uint8_t b, uint8_t pin)
 
 /******************************************************************************
 * Function Name: LED_setColor
-* Description  : LED_Fݒ
+* Description  : LED点灯色を設定
 * Arguments    : color - LED_COLOR enum
 * Return Value : none
 ******************************************************************************/
@@ -393,7 +393,7 @@ void LED_setColor(LED_COLOR color, uint8_t pin)
 
 /******************************************************************************
 * Function Name: LED_setColorForStandbyRGB
-* Description  : LED_FݒiX^oCprj
+* Description  : LED点灯色を設定（スタンバイ用途）
 * Arguments    : r - red, g - green, b - blule
 * Return Value : none
 ******************************************************************************/
@@ -417,7 +417,7 @@ void LED_setColorForStandbyRGB(uint8_t r, uint8_t g, uint8_t b, uint8_t pin)
 
 /******************************************************************************
 * Function Name: LED_setColorForStandby
-* Description  : LED_FݒiX^oCj
+* Description  : LED点灯色を設定（スタンバイ時）
 * Arguments    : color - LED_COLOR enum
 * Return Value : none
 ******************************************************************************/
@@ -431,7 +431,7 @@ void LED_setColorForStandby(LED_COLOR color, uint8_t pin)
 
 /******************************************************************************
 * Function Name: led_convertColorToRGB
-* Description  : LED̐FRGBlɕϊ
+* Description  : LEDの色をRGB値に変換
 * Arguments    : color - LED_COLOR enum
 * Return Value : none
 ******************************************************************************/
@@ -485,7 +485,7 @@ void led_convertColorToRGB(led_rgb_t * rgb, LED_COLOR color)
 
 /******************************************************************************
 * Function Name: led_getAssignedCtrlStruct
-* Description  : ς݂LED\̂擾
+* Description  : 割当済みのLED制御構造体を取得
 * Arguments    : pin - pin number (0 -> default led)
 * Return Value : NULL -> Unassigned struct (don't use)
 ******************************************************************************/
@@ -501,7 +501,7 @@ led_control_t* led_getAssignedCtrlStruct(const uint8_t pin)
 
 /******************************************************************************
 * Function Name: led_getCtrlStruct
-* Description  : LED\̂擾
+* Description  : LED制御構造体を取得
 * Arguments    : pin - pin number (0 -> empty struct)
 * Return Value : NULL -> Unassigned struct (don't use)
 ******************************************************************************/
@@ -521,7 +521,7 @@ led_control_t* led_getCtrlStruct(const uint8_t pin)
 
 /******************************************************************************
 * Function Name: led_turnOn
-* Description  : LED_
+* Description  : LEDを点灯する
 * Arguments    : p_led - pointer of led_control_t
 * Return Value : none
 ******************************************************************************/
@@ -549,7 +549,7 @@ void led_turnOn(led_control_t * p_led)
 
 /******************************************************************************
 * Function Name: led_turnOff
-* Description  : LED
+* Description  : LEDを消灯する
 * Arguments    : p_led - pointer of led_control_t
 * Return Value : none
 ******************************************************************************/
@@ -5,17 +5,17 @@
 // https://opensource.org/license/GPL-3.0
 // --------------------------------------------------------
 
-#ifndef __TASK_LED_H__	/* d`h~ */
+#ifndef __TASK_LED_H__	/* 二重定義防止 */
 
 #include <Arduino.h>
 
-/* LED^Cv */
+/* LEDタイプ */
 typedef enum {
 	LED_TYPE_1COLOR,
 	LED_TYPE_RGB_SERIAL
 } led_type_t;
 
-/* LED\F */
+/* LED表示色 */
 typedef enum LED_COLOR {
 	LED_COL_STNDBY,
 	LED_COL_RED,
@@ -27,14 +27,14 @@ typedef enum LED_COLOR {
 	LED_COL_WHITE
 } led_color_t;
 
-/* LED\p^[ */
+/* LED表示パターン */
 typedef enum {
-	LED_PT_OFF,			// 
-	LED_PT_ON,			// _
-	LED_PT_BLINK_ON10,	// _ŁE1b (ON:90, OFF:10%)
-	LED_PT_BLINK_ON90,	// _ŁE1b (ON:90, OFF:10%)
-	LED_PT_BLINK_FAST,	// _ŁE0.1b
-	LED_PT_BLINK_SLOW,	// _ŁE0.25b
+	LED_PT_OFF,			// 消灯
+	LED_PT_ON,			// 点灯
+	LED_PT_BLINK_ON10,	// 点滅・1秒周期 (ON:90％, OFF:10%)
+	LED_PT_BLINK_ON90,	// 点滅・1秒周期 (ON:90％, OFF:10%)
+	LED_PT_BLINK_FAST,	// 点滅・0.1秒周期
+	LED_PT_BLINK_SLOW,	// 点滅・0.25秒周期
 	LED_PT_SIZE,
 } led_pattern_t;
 
@@ -48,6 +48,6 @@ void LED_setColor(LED_COLOR color, uint8_t pin = 0);
 void LED_setColorForStandbyRGB(uint8_t r, uint8_t g, uint8_t b, uint8_t pin = 0);
 void LED_setColorForStandby(LED_COLOR color, uint8_t pin = 0);
 
-#endif /* __TASK_LED_H__*/	/* d`h~ */
-#define __TASK_LED_H__	/* d`h~ */
+#endif /* __TASK_LED_H__*/	/* 二重定義防止 */
+#define __TASK_LED_H__	/* 二重定義防止 */
 
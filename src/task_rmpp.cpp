@@ -13,11 +13,21 @@
 #include "task_cli.h"
 #include "task_cfg.h"
 #include "task_led.h"
+#include "task_adc.h"
 
 #include "board.h"
+#include "rmpp_alive.h"
 #include "rmpp_cmd.h"
+#include "rmpp_ramp.h"
+#include "rmpp_speed.h"
+#include "rmpp_stream.h"
+#include "sys_latency.h"
+
+#include <atomic>
 
 #if defined(ESP32)
+#include <hal/gpio_ll.h>
+#include <soc/gpio_sig_map.h>
 #define RMPP_PWM_WRITE ledcWrite
 #define RMPP_TEMP_READ temperatureRead
 #elif defined(TARGET_RP2040) || defined(TARGET_RP2350)
@@ -28,6 +38,10 @@
 #define RMPP_TEMP_READ analogReadTemp
 #endif
 
+#ifndef IRAM_ATTR
+#define IRAM_ATTR
+#endif
+
 #if defined(ESP32)
 #ifndef APP_CPU_NUM
 #define APP_CPU_NUM (1)
@@ -35,20 +49,107 @@
 #endif
 
 #define RMPP_STATUS_INTERVAL 200 // [ms]
+#define RMPP_STATUS_KEEPALIVE 600 // [ms]
 #define RMPP_ALIVE_TIMEOUT 3000 // [ms]
 #define RMPP_SERIAL_DEBUG_INTERVAL 10000 // [ms]
 #define RMPP_INHBIT_TIME 1000 // [ms]
 
+// control sessions (one per WebSocket client sending output commands)
+#ifndef RMPP_SESSION_MAX
+#define RMPP_SESSION_MAX 8
+#endif
+#define RMPP_SESSION_WINDOW 1000 // [ms]
+#ifndef RMPP_SESSION_RATE_MAX
+#define RMPP_SESSION_RATE_MAX 50 // output commands per window (stop commands are never limited)
+#endif
+
+// requests to the process task (the only context that changes the output state)
+#ifndef RMPP_QUE_REQ_LEN
+#define RMPP_QUE_REQ_LEN 16
+#endif
+#define RMPP_REQ_WAIT 10 // [ms] a client change may wait this long for a free slot
+#define RMPP_REQ_CH_ALL 0xFF // channel id of a request to every channel
+
+// default ramp (time from 0 to the full duty)
+#ifndef RMPP_RAMP_ACC_CURVE
+#define RMPP_RAMP_ACC_CURVE RMPP_RAMP_SCURVE
+#endif
+#ifndef RMPP_RAMP_ACC_TIME
+#define RMPP_RAMP_ACC_TIME 1500 // [ms]
+#endif
+#ifndef RMPP_RAMP_BRK_CURVE
+#define RMPP_RAMP_BRK_CURVE RMPP_RAMP_LINEAR
+#endif
+#ifndef RMPP_RAMP_BRK_TIME
+#define RMPP_RAMP_BRK_TIME 800 // [ms]
+#endif
+
+// back-EMF speed control
+//  (the ramp duty becomes the speed target, the full duty is RMPP_BEMF_FULL)
+#ifndef RMPP_SPEED_CTRL
+#define RMPP_SPEED_CTRL false // enabled at startup
+#endif
+#ifndef RMPP_BEMF_FULL
+#define RMPP_BEMF_FULL 12000 // back-EMF at the full speed [mV]
+#endif
+#ifndef RMPP_BEMF_SETTLE
+#define RMPP_BEMF_SETTLE 400 // gate time before sampling (current decay) [us]
+#endif
+
+// software over-current trip
+//  (acts on the ADC frames, well before the driver's own protection)
+#ifndef RMPP_TRIP_PEAK
+#define RMPP_TRIP_PEAK 3000 // current of a single frame [mA]
+#endif
+#ifndef RMPP_TRIP_AVG
+#define RMPP_TRIP_AVG 2000 // average current [mA]
+#endif
+// time constant of the average current (2^n ADC frames)
+#define RMPP_CURRENT_AVG_SHIFT 6
+
+// ADC frames to wait after gating the output
+//  (the frame in progress, the frames within the settle time and one clean frame)
+#define RMPP_BEMF_FRAMES (2 + (RMPP_BEMF_SETTLE * ADC_FRAME_RATE + 999999) / 1000000)
+// a measurement still open at the next control period is given up
+// (the output is not kept gated when the ADC has stalled)
+static_assert((RMPP_BEMF_FRAMES * RMPP_SPEED_RATE) < ADC_FRAME_RATE, "the back-EMF measurement must end within a speed control period");
+
+// task notification bits for the process task
+#define RMPP_NOTIFY_INHBIT	(1UL << 0)	// output inhbit time elapsed
+#define RMPP_NOTIFY_STATUS	(1UL << 1)	// status sampling interval elapsed
+#define RMPP_NOTIFY_CHANGE	(1UL << 2)	// mode, flags or duty changed
+#define RMPP_NOTIFY_RAMP	(1UL << 3)	// ramp control period elapsed or target changed
+#define RMPP_NOTIFY_SPEED	(1UL << 4)	// speed control period elapsed
+#define RMPP_NOTIFY_TRIP	(1UL << 5)	// software over-current trip
+#define RMPP_NOTIFY_REQUEST	(1UL << 6)	// request queued
+#define RMPP_NOTIFY_STOP	(1UL << 7)	// stop requested while the request queue was full
+#define RMPP_NOTIFY_FAULT(ch)	(1UL << (8 + (ch)))	// fault signal edge detected (per channel)
+#define RMPP_NOTIFY_FAULT_ALL	(((1UL << RMPP_NUM_CH) - 1) << 8)
+#define RMPP_NOTIFY_BEMF	(1UL << 24)	// back-EMF sampled (after the fault bits of RMPP_NUM_CH_MAX channels)
+
+// coalescing tag of the full status frame (per channel)
+#define RMPP_TAG_STATUS_FULL(ch)	(0x80 | (ch))
+// coalescing tag of the telemetry frame (per channel)
+#define RMPP_TAG_TELEMETRY(ch)		(0x40 | (ch))
+
+// a packet must fit in the server's binary message buffer
+// (the full status may be followed by a duty difference)
+static_assert((2 * RMPP_PACKET_LEN_MAX) <= WS_LEN_BINARY_MAX, "WS_LEN_BINARY_MAX is too small for two RMPP packets");
+// so must a stream block in the server's stream buffer
+static_assert(RMPP_STREAM_BLOCK_LEN <= WS_LEN_STREAM_MAX, "WS_LEN_STREAM_MAX is too small for a stream block");
+// the stream is a decimation of the ADC frames
+static_assert((RMPP_STREAM_RATE <= ADC_FRAME_RATE) && (0 == ADC_FRAME_RATE % RMPP_STREAM_RATE), "ADC_FRAME_RATE must be a multiple of RMPP_STREAM_RATE");
+
 #define PWM_DUTY_100 (1 << PWM_RES)
 #define PWM_DUTY_MAX (PWM_DUTY_100 - 1)
 
 typedef enum {
-	RMPP_MODE_INIT = 0,	/*  */
-	RMPP_MODE_OFF,		/* o̓It */
-	RMPP_MODE_ON,		/* o̓I */
-	RMPP_MODE_INHBIT,	/* o͋֎~ */
-	RMPP_MODE_FAULT,	/* Qv */
-	RMPP_MODE_FAIL		/* ̏v */
+	RMPP_MODE_INIT = 0,	/* 初期化 */
+	RMPP_MODE_OFF,		/* 出力オフ */
+	RMPP_MODE_ON,		/* 出力オン */
+	RMPP_MODE_INHBIT,	/* 出力禁止期間 */
+	RMPP_MODE_FAULT,	/* 障害要因発生 */
+	RMPP_MODE_FAIL		/* 故障要因発生 */
 } rmpp_mode_t;
 
 typedef struct {
@@ -65,11 +166,37 @@ typedef struct {
 	uint8_t rsv2:1;
 	uint8_t rsv3:1;
 	uint8_t OverCurrent:1;
-	uint8_t rsv5:1;
+	uint8_t SwTrip:1;
 	uint8_t rsv6:1;
 	uint8_t rsv7:1;
 } status_flag_t;
 
+typedef struct {
+	uint16_t volt_in;		/* Input voltage */
+	int8_t temp_cpu;		/* CPU temperture */
+	int8_t adcVin;			/* ADC input id of the input voltage */
+} rmpp_info_t;
+
+typedef struct {
+	uint8_t pwm1;			/* PWM output 1 (active low) */
+	uint8_t pwm2;			/* PWM output 2 (active low) */
+	uint8_t fault;			/* fault signal input */
+	uint8_t bemf;			/* back-EMF sense input (RMPP_PIN_NONE -> none) */
+	uint8_t isense;			/* current sense input (RMPP_PIN_NONE -> none) */
+} rmpp_ch_pin_t;
+
+typedef enum {
+	RMPP_BEMF_IDLE = 0,	/* no measurement */
+	RMPP_BEMF_WAIT,		/* output gated, waiting for the frame (set by the process task) */
+	RMPP_BEMF_DONE		/* sampled, the output is restored by the process task (set by the ADC task) */
+} rmpp_bemf_state_t;
+
+typedef struct {
+	volatile uint16_t now;		/* last ADC frame [mA] */
+	volatile uint32_t avg;		/* moving average [mA] (RMPP_CURRENT_AVG_SHIFT fractional bits) */
+	std::atomic<uint16_t> peak;	/* peak since the last telemetry frame [mA] */
+} rmpp_current_t;
+
 typedef struct {
 	union {
 		uint8_t ui8;
@@ -79,192 +206,1353 @@ typedef struct {
 		uint8_t ui8;
 		status_flag_t bit;
 	} status;
-	uint16_t volt_in;		/* Input voltage */
 	uint16_t duty_set;		/* Output duty */
-	int8_t temp_cpu;		/* CPU temperture */
-} rmpp_info_t;
+} rmpp_ch_info_t;
+
+typedef struct {
+	uint8_t index;				/* channel id */
+	rmpp_ch_pin_t pin;			/* pin assignment */
+	rmpp_ch_info_t info;		/* current state */
+	rmpp_ch_info_t sent;		/* last state published to the clients */
+	rmpp_ramp_t ramp;			/* duty ramp */
+	rmpp_speed_pi_t pi;			/* speed controller */
+	int32_t bemf;				/* last measured back-EMF [mV] */
+	std::atomic<uint8_t> bemfState;	/* back-EMF measurement (rmpp_bemf_state_t) */
+	uint32_t bemfSeq;			/* first ADC frame clear of the gate time */
+	int32_t bemfSample;			/* back-EMF of that frame [mV] (set by the ADC task) */
+	int8_t adcBemf;				/* ADC input id of the back-EMF sense */
+	int8_t adcIsense;			/* ADC input id of the current sense */
+	rmpp_current_t current;		/* output current (updated by the ADC task) */
+	std::atomic<bool> trip;		/* software over-current trip (set by the ADC task, cleared by rmpp_clearFault) */
+	bool statusFullRequired;	/* the next status frame must be a full one */
+	TickType_t tickFull;		/* last full status frame */
+	TimerHandle_t hTimerInhbit;	/* output inhbit timer handle */
+	rmpp_alive_t alive;			/* last command of the owner */
+	uint32_t owner;				/* client id in control of the output (0 -> none) */
+	uint8_t cmdLast[2];			/* last output command of the owner */
+} rmpp_ch_t;
+
+typedef enum {
+	RMPP_REQ_OUTPUT,	/* output command of a client */
+	RMPP_REQ_START,		/* start the output */
+	RMPP_REQ_STOP,		/* stop the output */
+	RMPP_REQ_DUTY,		/* set the output duty */
+	RMPP_REQ_CONNECT,	/* a client has connected */
+	RMPP_REQ_DISCONNECT,	/* a client has disconnected */
+	RMPP_REQ_RAMP,		/* change a ramp profile (console) */
+	RMPP_REQ_GAIN		/* change the speed control gains (console) */
+} rmpp_req_t;
+
+typedef struct {
+	rmpp_req_t req;
+	uint8_t index;		/* channel id (RMPP_REQ_CH_ALL -> every channel) */
+	uint8_t data[2];	/* output command [duty low][direction | duty high], [profile][curve] (RAMP) */
+	uint16_t value;		/* direction (START), inhbit (STOP), duty (DUTY), clients (CONNECT / DISCONNECT),
+						   time [ms] (RAMP), kp (GAIN) */
+	uint16_t param;		/* ki (GAIN) */
+	uint32_t id;		/* websocket client id */
+	uint32_t seq;		/* order of the requests (set by rmpp_postRequest) */
+} rmpp_req_que_t;
+
+typedef struct {
+	uint32_t id;			/* client id (0 -> free) */
+	TickType_t tickWindow;	/* start of the rate window */
+	uint16_t cntWindow;		/* commands in the current window */
+	uint16_t rate;			/* commands in the last window */
+	uint32_t cntAccepted;	/* commands applied */
+	uint32_t cntCoalesced;	/* commands equal to the last one */
+	uint32_t cntRejected;	/* commands over the rate or from a non-owner */
+} rmpp_session_t;
+
+/* pin assignment of the output channels (board.h) */
+static constexpr rmpp_ch_pin_t rmppChPins[] = RMPP_CH_PINS;
+#define RMPP_NUM_CH (sizeof(rmppChPins) / sizeof(rmppChPins[0]))
+
+// the channel id is carried in 4 bits of RD_STATUS_DIFF and in the notification bits
+static_assert((0 < RMPP_NUM_CH) && (RMPP_NUM_CH <= RMPP_NUM_CH_MAX), "RMPP_CH_PINS must define 1 to RMPP_NUM_CH_MAX channels");
 
 static rmpp_info_t stRmpp;
+static rmpp_ch_t stCh[RMPP_NUM_CH];
+/* control sessions (accessed from the process task only) */
+static rmpp_session_t stSession[RMPP_SESSION_MAX];
 static bool srvStarted = false;
 
+/* status publisher counters */
+static uint32_t cntStatusFull = 0;
+static uint32_t cntStatusDiff = 0;
+static uint32_t cntStatusSuppressed = 0;
+
 /* process task handle */
 static TaskHandle_t hTaskRmpp = NULL;
-/* output inhbit timer handle */
-static TimerHandle_t hTimerInhbit = NULL;
-/* control alive timer handle */
-static TimerHandle_t hTimerAlive = NULL;
+/* request queue handle */
+static QueueHandle_t xQueRmpp = NULL;
+/* stops that did not fit in the request queue (bit per channel) */
+static std::atomic<uint32_t> stopRequest(0);
+static std::atomic<uint32_t> stopInhbit(0);
+static std::atomic<uint32_t> cntReqDropped(0);
+/* order of the requests, and of the last stop that did not fit (per channel) */
+static std::atomic<uint32_t> seqRequest(0);
+static std::atomic<uint32_t> seqStop[RMPP_NUM_CH_MAX];
+/* channels whose queued requests may be older than the stop (process task only) */
+static uint32_t staleMask = 0;
+static uint32_t cntReqStale = 0;
+/* status sampling timer handle */
+static TimerHandle_t hTimerStatus = NULL;
+/* ramp control timer handle (runs only while a duty is ramping) */
+#if defined(ESP32)
+static hw_timer_t * hTimerRamp = NULL;
+#else
+static TimerHandle_t hTimerRamp = NULL;
+#endif
+static bool rampRunning = false;
+static uint32_t cntRampUpdates = 0;
+/* ramp profiles (shared by all channels) */
+static rmpp_ramp_profile_t rampAccel;
+static rmpp_ramp_profile_t rampBrake;
+/* console names of the curves (rmpp_ramp_curve_t) */
+static const char * const rampCurveName[] = { "OFF", "LINEAR", "SCURVE", "TABLE" };
+/* speed control timer handle (runs only while the speed control is enabled) */
+static TimerHandle_t hTimerSpeed = NULL;
+static bool speedCtrl = RMPP_SPEED_CTRL;
+static rmpp_speed_gain_t speedGain = { RMPP_SPEED_KP, RMPP_SPEED_KI };
+static uint32_t cntSpeedUpdates = 0;
+static uint32_t cntBemfTimeout = 0;
+/* software over-current trip thresholds [mA] */
+static volatile uint16_t tripPeak = RMPP_TRIP_PEAK;
+static volatile uint16_t tripAvg = RMPP_TRIP_AVG;
+static uint32_t cntTrip = 0;
 static size_t connectClients;
 
 static void rmpp_processTask(void* pvParameters);
+static bool rmpp_postRequest(const rmpp_req_que_t * req, TickType_t wait);
+static void rmpp_processRequest(const rmpp_req_que_t * req);
+static void rmpp_processStopRequest(void);
+static bool rmpp_isStaleRequest(const rmpp_req_que_t * req);
+static void rmpp_processInhbit(void);
+static void rmpp_onFaultEdge(void * arg);
+static void rmpp_onStatusTimer(TimerHandle_t xTimer);
+#if defined(ESP32)
+static void rmpp_onRampTimer(void);
+#else
+static void rmpp_onRampTimer(TimerHandle_t xTimer);
+#endif
+static void rmpp_processRamp(void);
+static void rmpp_writeDuty(rmpp_ch_t * ch, uint16_t duty);
+static void rmpp_handleRampCommand(cli_cmd_t command);
+static void rmpp_printRamp(Print & out);
+static void rmpp_onSpeedTimer(TimerHandle_t xTimer);
+static void rmpp_processSpeed(void);
+static bool rmpp_isSpeedControlled(const rmpp_ch_t * ch);
+static void rmpp_startBemf(rmpp_ch_t * ch);
+static void rmpp_endBemf(rmpp_ch_t * ch);
+static void rmpp_processBemf(void);
+static void rmpp_handleSpeedCommand(cli_cmd_t command);
+static void rmpp_printSpeed(Print & out);
+static void rmpp_handleAdcFrame(const adc_frame_t * frame);
+static void rmpp_stopOutputOnTrip(rmpp_ch_t * ch);
+static void rmpp_publishTelemetry(rmpp_ch_t * ch);
+static void rmpp_handleTripCommand(cli_cmd_t command);
+static void rmpp_publishStatus(rmpp_ch_t * ch);
+static void rmpp_notifyStatusChange(void);
+static void rmpp_updateLed(void);
+static rmpp_ch_t * rmpp_getChannel(uint8_t index);
 
 static void rmpp_handleWsBinaryData(uint8_t * data, size_t len, uint32_t id);
 static void rmpp_handleWsClientChange(uint32_t id, size_t clientCount);
+static void rmpp_handleWsDisconnect(uint32_t id, size_t clientCount);
+static void rmpp_changeClients(uint32_t id, uint16_t clientCount, bool disconnect);
+static rmpp_session_t * rmpp_getSession(uint32_t id);
+static bool rmpp_countSessionCommand(rmpp_session_t * session);
+static void rmpp_printSessions(cli_cmd_t command);
 static void rmpp_handleWiFiEvent(SYS_WIFI_EVENT_PARAM param);
 static void rmpp_handleCfgChangeSuccess(void);
 static void rmpp_printStatus(cli_cmd_t command);
 
-static void rmpp_parseOutputCommand(uint8_t * data, uint16_t len);
-static void rmpp_stopOutputOnFault(void);
-static void rmpp_turnOutputOff(void);
-static void rmpp_clearFault(void);
+static void rmpp_processCommand(uint8_t * cmd, uint8_t len, uint32_t id);
+static void rmpp_parseOutputCommand(uint8_t * data, uint8_t len, uint32_t id);
+static void rmpp_parseOutputChCommand(uint8_t * data, uint8_t len, uint32_t id);
+static void rmpp_parseStreamCommand(uint8_t * data, uint8_t len, uint32_t id);
+static void rmpp_controlOutput(rmpp_ch_t * ch, const uint8_t * data, uint32_t id);
+static void rmpp_startOutput(rmpp_ch_t * ch, rmpp_dir_t dir);
+static void rmpp_stopOutput(rmpp_ch_t * ch, bool inhbit);
+static void rmpp_setOutputDuty(rmpp_ch_t * ch, uint16_t duty);
+static void rmpp_stopOutputOnFault(rmpp_ch_t * ch);
+static void rmpp_turnOutputOff(rmpp_ch_t * ch);
+static void rmpp_cutOutputFromISR(const rmpp_ch_t * ch);
+static void rmpp_restoreOutputPins(const rmpp_ch_t * ch);
+static void rmpp_clearFault(rmpp_ch_t * ch);
 static void rmpp_clearInhbit(TimerHandle_t xTimer);
-static void rmpp_onAliveTimeout(TimerHandle_t xTimer);
+static void rmpp_checkAlive(rmpp_ch_t * ch);
+
+typedef struct {
+	uint8_t cmdid;				// command id
+	uint8_t bytes_dat;			// number of data bytes
+	rmpp_cmd_handler_t handler;	// command handler
+} rmpp_cmd_entry_t;
+
+typedef struct {
+	rmpp_cmd_entry_t entry[RMPP_NUM_CMD_KIND];
+} rmpp_cmd_table_t;
+
+/* commands received from the client */
+static constexpr rmpp_cmd_entry_t rmppCmdList[] = {
+	{ RMPP_CMDID_WR_OUTPUT, RMPP_BYTES_DAT_WR_OUTPUT, rmpp_parseOutputCommand },
+	{ RMPP_CMDID_WR_OUTPUT_CH, RMPP_BYTES_DAT_WR_OUTPUT_CH, rmpp_parseOutputChCommand },
+	{ RMPP_CMDID_WR_STREAM, RMPP_BYTES_DAT_WR_STREAM, rmpp_parseStreamCommand },
+};
+
+/******************************************************************************
+* Function Name: rmpp_isCmdListValid
+* Description  : コマンド一覧の整合性をコンパイル時に検査する
+* Arguments    : none
+* Return Value : true -> payload sizes match the command ids and no command kind is duplicated
+******************************************************************************/
+static constexpr bool rmpp_isCmdListValid(void)
+{
+	for (const rmpp_cmd_entry_t & cmd : rmppCmdList) {
+		if ((RMPP_GET_BYTES_DAT(cmd.cmdid) != cmd.bytes_dat) || (nullptr == cmd.handler)) {
+			return false;
+		}
+		uint8_t count = 0;
+		for (const rmpp_cmd_entry_t & other : rmppCmdList) {
+			if (RMPP_GET_CMD_KIND(other.cmdid) == RMPP_GET_CMD_KIND(cmd.cmdid)) {
+				count++;
+			}
+		}
+		if (1 != count) {
+			return false;
+		}
+	}
+	return true;
+}
+static_assert(rmpp_isCmdListValid(), "RMPP command list is inconsistent");
+
+/******************************************************************************
+* Function Name: rmpp_makeCmdTable
+* Description  : コマンド種別をインデックスとするディスパッチテーブルを生成する
+* Arguments    : none
+* Return Value : dispatch table
+******************************************************************************/
+static constexpr rmpp_cmd_table_t rmpp_makeCmdTable(void)
+{
+	rmpp_cmd_table_t table = {};
+	for (const rmpp_cmd_entry_t & cmd : rmppCmdList) {
+		table.entry[RMPP_GET_CMD_KIND(cmd.cmdid)] = cmd;
+	}
+	return table;
+}
+
+/* command dispatch table (indexed by command kind) */
+static constexpr rmpp_cmd_table_t rmppCmdTable = rmpp_makeCmdTable();
 
 /******************************************************************************
 * Function Name: RMPP_initTask
-* Description  : p[pbNɊւ鏈̏
+* Description  : パワーパックに関する処理の初期化
 * Arguments    : none
-* Return Value : true  -> initialization succeeded, 
+* Return Value : true  -> initialization succeeded,
                  false -> initialization failed
 ******************************************************************************/
 bool RMPP_initTask(void)
 {
-	stRmpp.output.bit.mode = RMPP_MODE_INIT;
 	connectClients = 0;
 
-#if defined(ESP32)
-	ledcAttach(PIN_PWM1, PWM_FRQ, PWM_RES);
-	ledcWrite(PIN_PWM1, 0);
-	ledcAttach(PIN_PWM2, PWM_FRQ, PWM_RES);
-	ledcWrite(PIN_PWM2, 0);
-#else
+#if !defined(ESP32)
 	analogWriteFreq(PWM_FRQ);
 	analogWriteResolution(PWM_RES);
+#endif
+
+	for (uint8_t i = 0; i < RMPP_NUM_CH; i++) {
+		rmpp_ch_t * ch = &stCh[i];
+
+		ch->index = i;
+		ch->pin = rmppChPins[i];
+		ch->info.output.bit.mode = RMPP_MODE_INIT;
+		ch->statusFullRequired = true;
 
-	pinMode(PIN_PWM1, OUTPUT);
-	analogWrite(PIN_PWM1, 0);
-	pinMode(PIN_PWM2, OUTPUT);
-	analogWrite(PIN_PWM2, 0);
+#if defined(ESP32)
+		ledcAttach(ch->pin.pwm1, PWM_FRQ, PWM_RES);
+		ledcWrite(ch->pin.pwm1, 0);
+		ledcAttach(ch->pin.pwm2, PWM_FRQ, PWM_RES);
+		ledcWrite(ch->pin.pwm2, 0);
+#else
+		pinMode(ch->pin.pwm1, OUTPUT);
+		analogWrite(ch->pin.pwm1, 0);
+		pinMode(ch->pin.pwm2, OUTPUT);
+		analogWrite(ch->pin.pwm2, 0);
 #endif
+		pinMode(ch->pin.fault, INPUT);
+		ch->adcBemf = (RMPP_PIN_NONE != ch->pin.bemf) ? ADC_attachInput(ch->pin.bemf) : ADC_INPUT_NONE;
+		ch->adcIsense = (RMPP_PIN_NONE != ch->pin.isense) ? ADC_attachInput(ch->pin.isense) : ADC_INPUT_NONE;
+
+		// the timer id tells the callback which channel has expired
+		/* output inhbit timer handle */
+		ch->hTimerInhbit = xTimerCreate("inhbit_timer", pdMS_TO_TICKS(RMPP_INHBIT_TIME), pdFALSE, ch, rmpp_clearInhbit);
+		if (NULL == ch->hTimerInhbit) {
+			Serial.println(" [failure] Failed to create RMPP output inhbit timer.");
+			return false;
+		}
+	}
 
-	pinMode(PIN_VIN, INPUT);
-	pinMode(PIN_FAULT, INPUT);
+	stRmpp.adcVin = ADC_attachInput(PIN_VIN);
+	ADC_attachFrameListener(rmpp_handleAdcFrame);
+	SRV_attachWsStreamSource(RMPP_packStreamBlock);
 
 	SRV_attachWsBinaryListener(rmpp_handleWsBinaryData);
 	SRV_attachWsTextListener(CLI_processCommand);
+	CLI_attachReplyWriter(SRV_pushWsTextToQueue);
 	SRV_attachWsConnectListener(rmpp_handleWsClientChange);
-	SRV_attachWsDisconnectListener(rmpp_handleWsClientChange);
+	SRV_attachWsDisconnectListener(rmpp_handleWsDisconnect);
 	SYS_attachWiFiEventListener(rmpp_handleWiFiEvent);
 	CFG_attachChangeSuccessListener(rmpp_handleCfgChangeSuccess);
 	CLI_addCommand("RMPP", rmpp_printStatus);
+	CLI_addCommand("RAMP", rmpp_handleRampCommand);
+	CLI_addCommand("SPEED", rmpp_handleSpeedCommand);
+	CLI_addCommand("TRIP", rmpp_handleTripCommand);
+	CLI_addCommand("SESSION", rmpp_printSessions);
+
+	RMPP_makeRampProfile(&rampAccel, RMPP_RAMP_ACC_CURVE, RMPP_RAMP_ACC_TIME, PWM_DUTY_100);
+	RMPP_makeRampProfile(&rampBrake, RMPP_RAMP_BRK_CURVE, RMPP_RAMP_BRK_TIME, PWM_DUTY_100);
+
+	/* ramp control timer handle */
+#if defined(ESP32)
+	// hardware timer (1 MHz count), the alarm notifies the task at the control rate
+	hTimerRamp = timerBegin(1000000);
+	if (NULL != hTimerRamp) {
+		timerAttachInterrupt(hTimerRamp, rmpp_onRampTimer);
+		timerAlarm(hTimerRamp, 1000000 / RMPP_RAMP_RATE, true, 0);
+		timerStop(hTimerRamp);
+	}
+#else
+	hTimerRamp = xTimerCreate("ramp_timer", pdMS_TO_TICKS(1000 / RMPP_RAMP_RATE), pdTRUE, 0, rmpp_onRampTimer);
+#endif
+	if (NULL == hTimerRamp) {
+		Serial.println(" [failure] Failed to create RMPP ramp control timer.");
+		return false;
+	}
+
+	/* speed control timer handle */
+	hTimerSpeed = xTimerCreate("speed_timer", pdMS_TO_TICKS(1000 / RMPP_SPEED_RATE), pdTRUE, 0, rmpp_onSpeedTimer);
+	if (NULL == hTimerSpeed) {
+		Serial.println(" [failure] Failed to create RMPP speed control timer.");
+		return false;
+	}
 
-	/* output inhbit timer handle */
-	hTimerInhbit = xTimerCreate("inhbit_timer", RMPP_INHBIT_TIME, pdFALSE, 0, rmpp_clearInhbit);
-	if (NULL == hTimerInhbit) {
-		Serial.println(" [failure] Failed to create RMPP output inhbit timer.");
+	/* status sampling timer handle */
+	hTimerStatus = xTimerCreate("status_timer", pdMS_TO_TICKS(RMPP_STATUS_INTERVAL), pdTRUE, 0, rmpp_onStatusTimer);
+	if (NULL == hTimerStatus) {
+		Serial.println(" [failure] Failed to create RMPP status sampling timer.");
 		return false;
 	}
-	/* control alive timer handle */
-	hTimerAlive = xTimerCreate("alive_timer", RMPP_ALIVE_TIMEOUT, pdTRUE, 0, rmpp_onAliveTimeout);
-	if (NULL == hTimerAlive) {
-		Serial.println(" [failure] Failed to create RMPP control alive timer.");
+
+	/* request queue handle */
+	xQueRmpp = xQueueCreate(RMPP_QUE_REQ_LEN, sizeof(rmpp_req_que_t));
+	if (NULL == xQueRmpp) {
+		Serial.println(" [failure] Failed to create RMPP request queue.");
 		return false;
 	}
 
-	Serial.println("RMPP (Railway Model Power Pack) task is now starting ...");
+	Serial.printf("RMPP (Railway Model Power Pack) task is now starting ... (%u ch)\n", RMPP_NUM_CH);
 #if defined(ESP32)
-	BaseType_t taskCreated = xTaskCreateUniversal(rmpp_processTask, "rmpp_task", 2048 , nullptr, 2, &hTaskRmpp, APP_CPU_NUM);
+	// the task blocks while idle, so it can run above the server and system tasks
+	// to keep the fault reaction latency short
+	BaseType_t taskCreated = xTaskCreateUniversal(rmpp_processTask, "rmpp_task", 2048 , nullptr, 4, &hTaskRmpp, APP_CPU_NUM);
 #else
-	BaseType_t taskCreated = xTaskCreate(rmpp_processTask, "rmpp_task", configMINIMAL_STACK_SIZE * 2, nullptr, 2, &hTaskRmpp);
+	BaseType_t taskCreated = xTaskCreate(rmpp_processTask, "rmpp_task", configMINIMAL_STACK_SIZE * 2, nullptr, 4, &hTaskRmpp);
 #endif
 	if (pdPASS != taskCreated) {
 		Serial.println(" [failure] Failed to create RMPP task.");
+	} else {
+		// fault signal monitoring (edge interrupt -> task notification)
+		for (uint8_t i = 0; i < RMPP_NUM_CH; i++) {
+#if defined(ESP32)
+			attachInterruptArg(digitalPinToInterrupt(stCh[i].pin.fault), rmpp_onFaultEdge, &stCh[i], (LOW == FAULT_DURING) ? FALLING : RISING);
+#else
+			attachInterruptParam(digitalPinToInterrupt(stCh[i].pin.fault), rmpp_onFaultEdge, (LOW == FAULT_DURING) ? FALLING : RISING, &stCh[i]);
+#endif
+		}
+		xTimerStart(hTimerStatus, 0);
+		if (speedCtrl) {
+			xTimerStart(hTimerSpeed, 0);
+		}
+	}
+
+	return (pdPASS == taskCreated) ? true : false;
+}
+
+/******************************************************************************
+* Function Name: rmpp_processTask
+* Description  : パワーパックに関する処理
+* Arguments    : none
+* Return Value : none
+******************************************************************************/
+void rmpp_processTask(void* pvParameters)
+{
+	uint32_t notify = 0;
+
+	for (uint8_t i = 0; i < RMPP_NUM_CH; i++) {
+		stCh[i].info.output.bit.mode = RMPP_MODE_OFF;
+
+		// the fault signal may already be active before the interrupt was attached
+		if (FAULT_DURING == digitalRead(stCh[i].pin.fault)) {
+			notify |= RMPP_NOTIFY_FAULT(i);
+		}
+	}
+
+	while(true) {
+		// fault signal monitoring
+		if (notify & RMPP_NOTIFY_FAULT_ALL) {
+			for (uint8_t i = 0; i < RMPP_NUM_CH; i++) {
+				if (0 == (notify & RMPP_NOTIFY_FAULT(i))) {
+					continue;
+				}
+				if (0 == stCh[i].info.status.bit.OverCurrent) {
+					rmpp_stopOutputOnFault(&stCh[i]);
+				}
+				// outputs were forced off by the interrupt,
+				// so hand the pins back to the PWM peripheral (at 0% duty)
+				rmpp_restoreOutputPins(&stCh[i]);
+			}
+			SYS_LATENCY_STOP(SYS_LAT_FAULT_TO_TASK);
+		}
+
+		// software over-current trip (the outputs were already cut by the ADC task,
+		//  the trip stays latched until the fault is cleared by a stop)
+		if (notify & RMPP_NOTIFY_TRIP) {
+			for (uint8_t i = 0; i < RMPP_NUM_CH; i++) {
+				if (stCh[i].trip.load(std::memory_order_acquire) && (0 == stCh[i].info.status.bit.SwTrip)) {
+					rmpp_stopOutputOnTrip(&stCh[i]);
+				}
+			}
+		}
+
+		// output commands, stops and client changes
+		// (the channel state is changed by this task only,
+		//  a stop that did not fit in the queue is newer than every queued
+		//  request, so it applies first and the older drive requests of
+		//  its channels are discarded)
+		if (notify & RMPP_NOTIFY_STOP) {
+			rmpp_processStopRequest();
+		}
+		if (notify & (RMPP_NOTIFY_REQUEST | RMPP_NOTIFY_STOP)) {
+			rmpp_req_que_t req;
+			while (pdPASS == xQueueReceive(xQueRmpp, &req, 0)) {
+				if (rmpp_isStaleRequest(&req)) {
+					cntReqStale++;
+					continue;
+				}
+				rmpp_processRequest(&req);
+			}
+			// the queue is empty, no request older than the stops is left
+			staleMask = 0;
+		}
+		if (notify & RMPP_NOTIFY_INHBIT) {
+			rmpp_processInhbit();
+		}
+
+		// duty ramp at the control rate
+		if (notify & RMPP_NOTIFY_RAMP) {
+			rmpp_processRamp();
+		}
+
+		// back-EMF speed control
+		// (the output is gated each period, the controller runs on the sample)
+		if (notify & RMPP_NOTIFY_BEMF) {
+			rmpp_processBemf();
+		}
+		if (notify & RMPP_NOTIFY_SPEED) {
+			rmpp_processSpeed();
+		}
+
+		if (notify & RMPP_NOTIFY_STATUS) {
+			// input voltage (in units of 0.1V)
+			stRmpp.volt_in = ADC_scaleDivider(ADC_getMilliVolts(stRmpp.adcVin), VIN_DIV, 100);
+
+			// cpu temperature (in units of 1deg)
+			stRmpp.temp_cpu = (int8_t)RMPP_TEMP_READ();
+
+			// alive monitoring of the controlling client
+			for (uint8_t i = 0; i < RMPP_NUM_CH; i++) {
+				rmpp_checkAlive(&stCh[i]);
+			}
+		}
+
+		// send power pack status to the client (web browser)
+		if (notify & (RMPP_NOTIFY_FAULT_ALL | RMPP_NOTIFY_TRIP | RMPP_NOTIFY_STATUS | RMPP_NOTIFY_CHANGE)) {
+			for (uint8_t i = 0; i < RMPP_NUM_CH; i++) {
+				rmpp_publishStatus(&stCh[i]);
+			}
+		}
+
+		// send current and power to the client
+		if (notify & RMPP_NOTIFY_STATUS) {
+			for (uint8_t i = 0; i < RMPP_NUM_CH; i++) {
+				rmpp_publishTelemetry(&stCh[i]);
+			}
+		}
+
+		// block until the next fault edge or status sampling interval
+		xTaskNotifyWait(0, UINT32_MAX, &notify, portMAX_DELAY);
+	}
+}
+
+/******************************************************************************
+* Function Name: rmpp_postRequest
+* Description  : 処理タスクへ要求を送る
+*                (キューが一杯でも停止要求は通知ビットで必ず伝える)
+* Arguments    : req - request, wait - time to wait for a free slot [ticks]
+* Return Value : true -> the request was handed to the process task
+******************************************************************************/
+bool rmpp_postRequest(const rmpp_req_que_t * req, TickType_t wait)
+{
+	rmpp_req_que_t item = *req;
+	uint32_t mask;
+
+	if ((NULL == hTaskRmpp) || (NULL == xQueRmpp)) {
+		return false;
+	}
+
+	item.seq = seqRequest.fetch_add(1);
+	if (pdPASS == xQueueSend(xQueRmpp, &item, wait)) {
+		xTaskNotify(hTaskRmpp, RMPP_NOTIFY_REQUEST, eSetBits);
+		return true;
+	}
+	cntReqDropped++;
+
+	if ((RMPP_REQ_STOP != req->req) && ((RMPP_REQ_OUTPUT != req->req) || (req->data[1] & 0xC0))) {
+		SYS_LATENCY_CANCEL(SYS_LAT_WS_TO_DUTY);
+		return false;
+	}
+
+	// a stop must never be lost, the channels are handed over in bits
+	// (the order and the inhbit bit are set first, the task takes the stop bit first)
+	mask = (RMPP_REQ_CH_ALL == req->index) ? ((1UL << RMPP_NUM_CH) - 1) : (1UL << req->index);
+	for (uint8_t i = 0; i < RMPP_NUM_CH; i++) {
+		if (mask & (1UL << i)) {
+			seqStop[i].store(item.seq);
+		}
+	}
+	if ((RMPP_REQ_STOP == req->req) && req->value) {
+		stopInhbit.fetch_or(mask);
+	}
+	stopRequest.fetch_or(mask);
+	xTaskNotify(hTaskRmpp, RMPP_NOTIFY_STOP, eSetBits);
+	return true;
+}
+
+/******************************************************************************
+* Function Name: rmpp_processRequest
+* Description  : 処理タスクへの要求を実行する
+* Arguments    : req - request
+* Return Value : none
+******************************************************************************/
+void rmpp_processRequest(const rmpp_req_que_t * req)
+{
+	rmpp_ch_t * ch = rmpp_getChannel(req->index);
+
+	switch (req->req) {
+		case RMPP_REQ_OUTPUT:
+			if (NULL != ch) {
+				rmpp_controlOutput(ch, req->data, req->id);
+			}
+			break;
+		case RMPP_REQ_START:
+			if (NULL != ch) {
+				rmpp_startOutput(ch, (rmpp_dir_t)req->value);
+			}
+			break;
+		case RMPP_REQ_STOP:
+			for (uint8_t i = 0; i < RMPP_NUM_CH; i++) {
+				if ((RMPP_REQ_CH_ALL == req->index) || (i == req->index)) {
+					rmpp_stopOutput(&stCh[i], req->value);
+				}
+			}
+			break;
+		case RMPP_REQ_DUTY:
+			if (NULL != ch) {
+				rmpp_setOutputDuty(ch, req->value);
+			}
+			break;
+		case RMPP_REQ_CONNECT:
+			rmpp_changeClients(req->id, req->value, false);
+			break;
+		case RMPP_REQ_DISCONNECT:
+			rmpp_changeClients(req->id, req->value, true);
+			break;
+		case RMPP_REQ_RAMP:
+			// the profiles are read by this task only, the range was checked by the console
+			RMPP_makeRampProfile((0 == req->data[0]) ? &rampAccel : &rampBrake, req->data[1], req->value, PWM_DUTY_100);
+			rmpp_printRamp(Serial);
+			break;
+		case RMPP_REQ_GAIN:
+			RMPP_setSpeedGain(&speedGain, req->value, req->param);
+			rmpp_printSpeed(Serial);
+			break;
+		default:
+			break;
+	}
+}
+
+/******************************************************************************
+* Function Name: rmpp_processStopRequest
+* Description  : キューを経由しなかった停止要求を実行する
+* Arguments    : none
+* Return Value : none
+******************************************************************************/
+void rmpp_processStopRequest(void)
+{
+	uint32_t mask = stopRequest.exchange(0);
+	uint32_t inhbit = stopInhbit.fetch_and(~mask) & mask;
+
+	staleMask |= mask;
+	for (uint8_t i = 0; i < RMPP_NUM_CH; i++) {
+		if (mask & (1UL << i)) {
+			rmpp_stopOutput(&stCh[i], (inhbit & (1UL << i)) ? true : false);
+		}
+	}
+}
+
+/******************************************************************************
+* Function Name: rmpp_isStaleRequest
+* Description  : キューを経由しなかった停止要求より古い出力要求かを判定する
+* Arguments    : req - request
+* Return Value : true -> the request would drive a stopped channel and is discarded
+******************************************************************************/
+bool rmpp_isStaleRequest(const rmpp_req_que_t * req)
+{
+	uint32_t mask;
+
+	if ((RMPP_REQ_START != req->req) && (RMPP_REQ_DUTY != req->req)
+	 && ((RMPP_REQ_OUTPUT != req->req) || (0 == (req->data[1] & 0xC0)))) {
+		return false;
+	}
+
+	mask = (RMPP_REQ_CH_ALL == req->index) ? staleMask : (staleMask & (1UL << req->index));
+	for (uint8_t i = 0; i < RMPP_NUM_CH; i++) {
+		// the queue holds less requests than half the range of the order
+		if ((mask & (1UL << i)) && (0 > (int32_t)(req->seq - seqStop[i].load()))) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/******************************************************************************
+* Function Name: rmpp_processInhbit
+* Description  : 出力禁止期間が終わったチャネルの出力禁止状態をクリアする
+* Arguments    : none
+* Return Value : none
+******************************************************************************/
+void rmpp_processInhbit(void)
+{
+	for (uint8_t i = 0; i < RMPP_NUM_CH; i++) {
+		rmpp_ch_t * ch = &stCh[i];
+
+		if ((RMPP_MODE_INHBIT == ch->info.output.bit.mode) && (pdFALSE == xTimerIsTimerActive(ch->hTimerInhbit))) {
+			ch->info.output.bit.mode = RMPP_MODE_OFF;
+			rmpp_notifyStatusChange();
+		}
+	}
+}
+
+/******************************************************************************
+* Function Name: rmpp_publishStatus
+* Description  : パワーパック状態をクライアントへ送信する
+*                (変化時は差分、変化がなければ一定周期で全体を送信)
+* Arguments    : ch - output channel
+* Return Value : none
+******************************************************************************/
+void rmpp_publishStatus(rmpp_ch_t * ch)
+{
+	ws_binary_t * msg;
+	uint8_t * cmd;
+	uint8_t len;
+	uint8_t voltIn = (255 > stRmpp.volt_in) ? stRmpp.volt_in : 0xFF;
+	bool full = ch->statusFullRequired || (pdMS_TO_TICKS(RMPP_STATUS_KEEPALIVE) <= (xTaskGetTickCount() - ch->tickFull));
+
+	if (false == srvStarted) {
+		return;
+	}
+
+	// the packet is built directly in the server's message buffer
+	msg = SRV_allocWsBinary();
+	if (NULL == msg) {
+		return;
 	}
+	cmd = RMPP_PACKET_CMD(&msg->data[0]);
+
+	if (full && (0 == ch->index)) {
+		// full status (also serves as the keep-alive frame)
+		cmd[0] = RMPP_CMDID_RD_STATUS;
+		cmd[1] = ch->info.output.ui8;
+		cmd[2] = ch->info.status.ui8;
+		cmd[3] = voltIn;
+		cmd[4] = stRmpp.temp_cpu + 128;
+		len = RMPP_CMD_LEN_RD_STATUS;
+	} else {
+		// differences in mode, flags and duty (voltage and temperature
+		// are left to the keep-alive frame of channel 0),
+		// the other channels send every field as their full status
+		uint8_t mask = RMPP_STATUS_DIFF_CH(ch->index);
+		len = RMPP_BYTES_CMDID + 1;
+
+		if (full || (ch->sent.output.ui8 != ch->info.output.ui8)) {
+			mask |= RMPP_STATUS_DIFF_OUTPUT;
+			cmd[len++] = ch->info.output.ui8;
+		}
+		if (full || (ch->sent.status.ui8 != ch->info.status.ui8)) {
+			mask |= RMPP_STATUS_DIFF_STATUS;
+			cmd[len++] = ch->info.status.ui8;
+		}
+		if (full || (ch->sent.duty_set != ch->info.duty_set)) {
+			mask |= RMPP_STATUS_DIFF_DUTY;
+			cmd[len++] = ch->info.duty_set & 0xFF;
+			cmd[len++] = ch->info.duty_set >> 8;
+		}
+
+		if (0 == (mask & ~RMPP_STATUS_DIFF_CH(ch->index))) {
+			cntStatusSuppressed++;
+			SRV_releaseWsBinary(msg);
+			return;
+		}
+
+		cmd[0] = RMPP_CMDID_RD_STATUS_DIFF(len - RMPP_BYTES_CMDID);
+		cmd[1] = mask;
+		len += RMPP_BYTES_CHECKSUM;
+	}
+
+	if (full) {
+		// only the newest full status is worth sending
+		msg->tag = RMPP_TAG_STATUS_FULL(ch->index);
+
+		ch->statusFullRequired = false;
+		ch->tickFull = xTaskGetTickCount();
+		cntStatusFull++;
+	} else {
+		cntStatusDiff++;
+	}
+
+	// checksum and cobs encoding
+	msg->len = RMPP_encodePacket(&msg->data[0], len);
+
+	// the full status of channel 0 has no duty, a changed duty follows
+	// as a difference in the same message (which is then never coalesced,
+	// the newer full status would not carry the duty)
+	if (full && (0 == ch->index) && (ch->sent.duty_set != ch->info.duty_set)) {
+		cmd = RMPP_PACKET_CMD(&msg->data[msg->len]);
+		cmd[0] = RMPP_CMDID_RD_STATUS_DIFF(3);
+		cmd[1] = RMPP_STATUS_DIFF_CH(0) | RMPP_STATUS_DIFF_DUTY;
+		cmd[2] = ch->info.duty_set & 0xFF;
+		cmd[3] = ch->info.duty_set >> 8;
+		msg->len += RMPP_encodePacket(&msg->data[msg->len], RMPP_BYTES_CMDID + 3 + RMPP_BYTES_CHECKSUM);
+		msg->tag = 0;
+	}
+	ch->sent = ch->info;
+
+	SRV_pushWsBinary(msg);
+}
+
+/******************************************************************************
+* Function Name: rmpp_publishTelemetry
+* Description  : 出力電流と電力をクライアントへ送信する
+* Arguments    : ch - output channel
+* Return Value : none
+******************************************************************************/
+void rmpp_publishTelemetry(rmpp_ch_t * ch)
+{
+	ws_binary_t * msg;
+	uint8_t * cmd;
+	uint32_t vin = ADC_scaleDivider(ADC_getMilliVolts(stRmpp.adcVin), VIN_DIV, 1);
+	uint16_t avg;
+	uint16_t peak;
+	uint16_t power;
+
+	if ((false == srvStarted) || (ADC_INPUT_NONE == ch->adcIsense)) {
+		return;
+	}
+
+	// the peak restarts with every frame
+	avg = ch->current.avg >> RMPP_CURRENT_AVG_SHIFT;
+	peak = ch->current.peak.exchange(0);
+	power = (vin * avg / 1000 + 5) / 10;
+
+	msg = SRV_allocWsBinary();
+	if (NULL == msg) {
+		return;
+	}
+	cmd = RMPP_PACKET_CMD(&msg->data[0]);
+
+	cmd[0] = RMPP_CMDID_RD_TELEMETRY;
+	cmd[1] = ch->index;
+	cmd[2] = ch->current.now & 0xFF;
+	cmd[3] = ch->current.now >> 8;
+	cmd[4] = avg & 0xFF;
+	cmd[5] = avg >> 8;
+	cmd[6] = peak & 0xFF;
+	cmd[7] = peak >> 8;
+	cmd[8] = power & 0xFF;
+	cmd[9] = power >> 8;
+	cmd[10] = (vin / 10) & 0xFF;
+	cmd[11] = (vin / 10) >> 8;
+
+	// only the newest telemetry is worth sending
+	msg->tag = RMPP_TAG_TELEMETRY(ch->index);
+	msg->len = RMPP_encodePacket(&msg->data[0], RMPP_CMD_LEN_RD_TELEMETRY);
+	SRV_pushWsBinary(msg);
+}
+
+/******************************************************************************
+* Function Name: rmpp_notifyStatusChange
+* Description  : 状態の変化を処理タスクへ通知する
+* Arguments    : none
+* Return Value : none
+******************************************************************************/
+void rmpp_notifyStatusChange(void)
+{
+	if (NULL != hTaskRmpp) {
+		xTaskNotify(hTaskRmpp, RMPP_NOTIFY_CHANGE, eSetBits);
+	}
+}
+
+/******************************************************************************
+* Function Name: rmpp_updateLed
+* Description  : 全チャネルの状態からLEDの表示を更新する
+* Arguments    : none
+* Return Value : none
+******************************************************************************/
+void rmpp_updateLed(void)
+{
+	bool fault = false;
+	bool on = false;
+
+	for (uint8_t i = 0; i < RMPP_NUM_CH; i++) {
+		if (RMPP_MODE_FAULT == stCh[i].info.output.bit.mode) {
+			fault = true;
+		} else if (RMPP_MODE_ON == stCh[i].info.output.bit.mode) {
+			on = true;
+		}
+	}
+
+	if (fault) {
+		LED_setColor(LED_COL_RED);
+		LED_setLightPattern(LED_PT_BLINK_FAST);
+	} else if (on) {
+		LED_setColor(LED_COL_GREEN);
+		if (connectClients) {
+			LED_setLightPattern(LED_PT_BLINK_ON90);
+		} else {
+			LED_setLightPattern(LED_PT_ON);
+		}
+	} else {
+		LED_setColor(LED_COL_STNDBY);
+		if (connectClients) {
+			LED_setLightPattern(LED_PT_BLINK_ON90);
+		} else {
+			LED_setLightPattern(LED_PT_BLINK_ON10);
+		}
+	}
+}
+
+/******************************************************************************
+* Function Name: rmpp_getChannel
+* Description  : チャネル番号から出力チャネルを取得する
+* Arguments    : index - channel id
+* Return Value : output channel (NULL -> invalid channel id)
+******************************************************************************/
+rmpp_ch_t * rmpp_getChannel(uint8_t index)
+{
+	return (RMPP_NUM_CH > index) ? &stCh[index] : NULL;
+}
+
+/******************************************************************************
+* Function Name: rmpp_onFaultEdge
+* Description  : フォルト信号の割り込み処理
+* Arguments    : arg - output channel
+* Return Value : none
+******************************************************************************/
+void IRAM_ATTR rmpp_onFaultEdge(void * arg)
+{
+	const rmpp_ch_t * ch = (const rmpp_ch_t *)arg;
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+	// turn the output off first, bookkeeping is deferred to the task
+	{
+		SYS_LATENCY_SCOPE(SYS_LAT_FAULT_TO_OFF);
+		rmpp_cutOutputFromISR(ch);
+	}
+	SYS_LATENCY_START(SYS_LAT_FAULT_TO_TASK);
+
+	xTaskNotifyFromISR(hTaskRmpp, RMPP_NOTIFY_FAULT(ch->index), eSetBits, &xHigherPriorityTaskWoken);
+	portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+/******************************************************************************
+* Function Name: rmpp_processRamp
+* Description  : 全チャネルのデューティを目標に向けて1周期分変化させる
+* Arguments    : none
+* Return Value : none
+******************************************************************************/
+void rmpp_processRamp(void)
+{
+	bool active = false;
+
+	for (uint8_t i = 0; i < RMPP_NUM_CH; i++) {
+		rmpp_ch_t * ch = &stCh[i];
+
+		if (RMPP_MODE_ON != ch->info.output.bit.mode) {
+			continue;
+		}
+		if (RMPP_updateRamp(&ch->ramp, &rampAccel, &rampBrake)) {
+			// under the speed control the ramp only moves the target
+			if (!rmpp_isSpeedControlled(ch)) {
+				rmpp_writeDuty(ch, RMPP_getRampDuty(&ch->ramp));
+			}
+			cntRampUpdates++;
+			active = true;
+		}
+	}
+
+	// the timer is owned by this task, so a new target can never be missed
+	if (active && !rampRunning) {
+#if defined(ESP32)
+		timerStart(hTimerRamp);
+#else
+		xTimerStart(hTimerRamp, 0);
+#endif
+		rampRunning = true;
+	} else if (!active && rampRunning) {
+#if defined(ESP32)
+		timerStop(hTimerRamp);
+#else
+		xTimerStop(hTimerRamp, 0);
+#endif
+		rampRunning = false;
+		// the final duty is published right away
+		rmpp_notifyStatusChange();
+	}
+}
+
+/******************************************************************************
+* Function Name: rmpp_onRampTimer
+* Description  : ランプ制御周期のタイマ処理
+* Arguments    : none
+* Return Value : none
+******************************************************************************/
+#if defined(ESP32)
+void IRAM_ATTR rmpp_onRampTimer(void)
+{
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+	xTaskNotifyFromISR(hTaskRmpp, RMPP_NOTIFY_RAMP, eSetBits, &xHigherPriorityTaskWoken);
+	portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+#else
+void rmpp_onRampTimer(TimerHandle_t xTimer)
+{
+	xTaskNotify(hTaskRmpp, RMPP_NOTIFY_RAMP, eSetBits);
+}
+#endif
+
+/******************************************************************************
+* Function Name: rmpp_isSpeedControlled
+* Description  : チャネルが速度制御の対象か判定する
+* Arguments    : ch - output channel
+* Return Value : true -> the duty is given by the speed controller
+******************************************************************************/
+bool rmpp_isSpeedControlled(const rmpp_ch_t * ch)
+{
+	return speedCtrl && (ADC_INPUT_NONE != ch->adcBemf);
+}
+
+/******************************************************************************
+* Function Name: rmpp_startBemf
+* Description  : 出力を一時的に止めて逆起電力の測定を始める
+*                (測定値はADCタスクが取得し、rmpp_processBemf で出力を戻す)
+* Arguments    : ch - output channel
+* Return Value : none
+******************************************************************************/
+void rmpp_startBemf(rmpp_ch_t * ch)
+{
+	// output circuit is Hi-Z mode, the motor is coasting
+	// (the LEDC latches the new duty at the end of the running PWM period,
+	//  which is well within the settle time)
+	RMPP_PWM_WRITE(ch->pin.pwm1, 0);
+	RMPP_PWM_WRITE(ch->pin.pwm2, 0);
+
+	// the first frame that started after the settle time is the measurement
+	ch->bemfSeq = ADC_getSequence() + RMPP_BEMF_FRAMES;
+	ch->bemfState.store(RMPP_BEMF_WAIT, std::memory_order_release);
+}
+
+/******************************************************************************
+* Function Name: rmpp_endBemf
+* Description  : 逆起電力の測定を終える（出力はブレーキに戻るので、呼び出し側でデューティを書き込む）
+* Arguments    : ch - output channel
+* Return Value : none
+******************************************************************************/
+void rmpp_endBemf(rmpp_ch_t * ch)
+{
+	ch->bemfState.store(RMPP_BEMF_IDLE, std::memory_order_relaxed);
+
+	// output circuit is back in brake mode
+	if (RMPP_MODE_ON == ch->info.output.bit.mode) {
+		RMPP_PWM_WRITE(ch->pin.pwm1, PWM_DUTY_100);
+		RMPP_PWM_WRITE(ch->pin.pwm2, PWM_DUTY_100);
+	}
+}
+
+/******************************************************************************
+* Function Name: rmpp_processBemf
+* Description  : 測定済みの逆起電力から速度制御のデューティを更新する
+* Arguments    : none
+* Return Value : none
+******************************************************************************/
+void rmpp_processBemf(void)
+{
+	int32_t vin = (int32_t)stRmpp.volt_in * 100;
+
+	for (uint8_t i = 0; i < RMPP_NUM_CH; i++) {
+		rmpp_ch_t * ch = &stCh[i];
+		int32_t target;
+		int32_t feed;
+
+		if (RMPP_BEMF_DONE != ch->bemfState.load(std::memory_order_acquire)) {
+			continue;
+		}
+		ch->bemf = ch->bemfSample;
+		rmpp_endBemf(ch);
+
+		if (RMPP_MODE_ON != ch->info.output.bit.mode) {
+			continue;
+		}
+		if (!rmpp_isSpeedControlled(ch)) {
+			// the control was turned off during the measurement
+			rmpp_writeDuty(ch, RMPP_getRampDuty(&ch->ramp));
+			continue;
+		}
+
+		// the duty that gives the target voltage on an unloaded motor,
+		// the controller only has to make up for the load
+		target = ((int32_t)RMPP_getRampDuty(&ch->ramp) * RMPP_BEMF_FULL) >> PWM_RES;
+		feed = (0 < vin) ? (target * PWM_DUTY_100 / vin) : 0;
+		rmpp_writeDuty(ch, RMPP_updateSpeedPi(&ch->pi, &speedGain, target, ch->bemf, feed, PWM_DUTY_100));
+		cntSpeedUpdates++;
+	}
+}
+
+/******************************************************************************
+* Function Name: rmpp_processSpeed
+* Description  : 全チャネルの逆起電力の測定を始める（速度制御周期）
+* Arguments    : none
+* Return Value : none
+******************************************************************************/
+void rmpp_processSpeed(void)
+{
+	// a sample that came with this period is used first
+	rmpp_processBemf();
+
+	for (uint8_t i = 0; i < RMPP_NUM_CH; i++) {
+		rmpp_ch_t * ch = &stCh[i];
+
+		if (RMPP_MODE_ON != ch->info.output.bit.mode) {
+			continue;
+		}
+
+		// no frame within a whole period (the ADC has stalled),
+		// the output goes back to the last duty
+		if (RMPP_BEMF_IDLE != ch->bemfState.load(std::memory_order_acquire)) {
+			rmpp_endBemf(ch);
+			rmpp_writeDuty(ch, ch->info.duty_set);
+			cntBemfTimeout++;
+		}
+
+		if (!rmpp_isSpeedControlled(ch)) {
+			// back to the open-loop ramp duty (once the control is turned off)
+			if (ch->info.duty_set != RMPP_getRampDuty(&ch->ramp)) {
+				rmpp_writeDuty(ch, RMPP_getRampDuty(&ch->ramp));
+			}
+			continue;
+		}
+
+		// the ramp duty is the target speed
+		if (0 == RMPP_getRampDuty(&ch->ramp)) {
+			RMPP_resetSpeedPi(&ch->pi);
+			if (ch->info.duty_set) {
+				rmpp_writeDuty(ch, 0);
+			}
+			continue;
+		}
+
+		// the task does not wait for the sample,
+		// the ADC task hands it over with RMPP_NOTIFY_BEMF
+		rmpp_startBemf(ch);
+	}
+}
+
+/******************************************************************************
+* Function Name: rmpp_handleAdcFrame
+* Description  : ADCフレーム毎に出力電流を更新し、過電流を判定する
+*                (ADCタスクから呼び出される)
+* Arguments    : frame - converted frame
+* Return Value : none
+******************************************************************************/
+void rmpp_handleAdcFrame(const adc_frame_t * frame)
+{
+	for (uint8_t i = 0; i < RMPP_NUM_CH; i++) {
+		rmpp_ch_t * ch = &stCh[i];
+		int32_t mv;
+		uint16_t ma;
+		uint16_t peak;
+		uint8_t wait = RMPP_BEMF_WAIT;
+
+		// back-EMF of the first frame clear of the gate time
+		if ((RMPP_BEMF_WAIT == ch->bemfState.load(std::memory_order_acquire)) && ((int32_t)(frame->seq - ch->bemfSeq) >= 0)) {
+			ch->bemfSample = (int32_t)frame->mv[ch->adcBemf] * BEMF_DIV;
+			if (ch->bemfState.compare_exchange_strong(wait, RMPP_BEMF_DONE, std::memory_order_release)) {
+				xTaskNotify(hTaskRmpp, RMPP_NOTIFY_BEMF, eSetBits);
+			}
+		}
+
+		if (ADC_INPUT_NONE == ch->adcIsense) {
+			continue;
+		}
+
+		mv = (int32_t)frame->mv[ch->adcIsense] - ISENSE_OFFSET_MV;
+		ma = (0 < mv) ? (uint16_t)(mv * 1000 / ISENSE_MV_PER_A) : 0;
+
+		ch->current.now = ma;
+		ch->current.avg = ch->current.avg + ma - (ch->current.avg >> RMPP_CURRENT_AVG_SHIFT);
+		peak = ch->current.peak.load(std::memory_order_relaxed);
+		while ((ma > peak) && !ch->current.peak.compare_exchange_weak(peak, ma)) {
+		}
+
+		// the output is cut right here and the trip is latched,
+		// the bookkeeping and the restore of the pins are left to the RMPP task
+		if ((RMPP_MODE_ON == ch->info.output.bit.mode) && !ch->trip.load(std::memory_order_acquire)
+		 && ((tripPeak <= ma) || (tripAvg <= (ch->current.avg >> RMPP_CURRENT_AVG_SHIFT)))) {
+			rmpp_cutOutputFromISR(ch);
+			ch->trip.store(true, std::memory_order_release);
+			xTaskNotify(hTaskRmpp, RMPP_NOTIFY_TRIP, eSetBits);
+		}
+	}
+
+	// telemetry stream (only while a client is subscribed)
+	if ((0 < SRV_countWsStreamClients()) && (0 == frame->seq % (ADC_FRAME_RATE / RMPP_STREAM_RATE))) {
+		rmpp_ch_t * ch = rmpp_getChannel(RMPP_getStreamChannel());
+		rmpp_stream_sample_t sample;
+
+		if (NULL != ch) {
+			sample.time = frame->time;
+			sample.duty = ch->info.duty_set;
+			sample.vin = (0 <= stRmpp.adcVin) ? ADC_scaleDivider(frame->mv[stRmpp.adcVin], VIN_DIV, 10) : 0;
+			sample.current = ch->current.now;
+			if (RMPP_pushStreamSample(&sample)) {
+				SRV_wakeWsStream();
+			}
+		}
+	}
+}
+
+/******************************************************************************
+* Function Name: rmpp_onSpeedTimer
+* Description  : 速度制御周期のタイマ処理
+* Arguments    : none
+* Return Value : none
+******************************************************************************/
+void rmpp_onSpeedTimer(TimerHandle_t xTimer)
+{
+	xTaskNotify(hTaskRmpp, RMPP_NOTIFY_SPEED, eSetBits);
+}
+
+/******************************************************************************
+* Function Name: rmpp_onStatusTimer
+* Description  : 状態送信周期のタイマ処理
+* Arguments    : none
+* Return Value : none
+******************************************************************************/
+void rmpp_onStatusTimer(TimerHandle_t xTimer)
+{
+	xTaskNotify(hTaskRmpp, RMPP_NOTIFY_STATUS, eSetBits);
+}
+
+/******************************************************************************
+* Function Name: rmpp_handleWsBinaryData
+* Description  : WebSocketのバイナリデータを受信したときのコールバック関数
+* Arguments    : data - received data (one or more cobs encoded packets),
+                 len - received length
+* Return Value : none
+******************************************************************************/
+void rmpp_handleWsBinaryData(uint8_t * data, size_t len, uint32_t id)
+{
+	RMPP_walkFrame(data, len, id, rmpp_processCommand);
+}
+
+/******************************************************************************
+* Function Name: rmpp_processCommand
+* Description  : デコード済みのコマンドを処理する
+* Arguments    : cmd - command data, len - command length (with checksum),
+                 id - websocket client id
+* Return Value : none
+******************************************************************************/
+void rmpp_processCommand(uint8_t * cmd, uint8_t len, uint32_t id)
+{
+	const rmpp_cmd_entry_t * entry = &rmppCmdTable.entry[RMPP_GET_CMD_KIND(cmd[0])];
+
+	if ((entry->cmdid == cmd[0]) && (nullptr != entry->handler)) {
+		entry->handler(cmd, len, id);
+	}
+}
+
+/******************************************************************************
+* Function Name: rmpp_handleWsClientChange
+* Description  : WebSocketのクライアントが接続したときのコールバック関数
+* Arguments    : id - websocket client id, clientCount - connected clients
+* Return Value : none
+******************************************************************************/
+void rmpp_handleWsClientChange(uint32_t id, size_t clientCount)
+{
+	rmpp_req_que_t req = {};
 
-	return (pdPASS == taskCreated) ? true : false;
+	req.req = RMPP_REQ_CONNECT;
+	req.id = id;
+	req.value = clientCount;
+	rmpp_postRequest(&req, pdMS_TO_TICKS(RMPP_REQ_WAIT));
 }
 
 /******************************************************************************
-* Function Name: rmpp_processTask
-* Description  : p[pbNɊւ鏈
-* Arguments    : none
+* Function Name: rmpp_handleWsDisconnect
+* Description  : WebSocketのクライアントが切断したときのコールバック関数
+* Arguments    : id - websocket client id, clientCount - connected clients
 * Return Value : none
 ******************************************************************************/
-void rmpp_processTask(void* pvParameters)
+void rmpp_handleWsDisconnect(uint32_t id, size_t clientCount)
 {
-	TickType_t tickQueueData = xTaskGetTickCount();
-	TickType_t tickDebug = xTaskGetTickCount();
-	uint8_t cmdToClient[RMPP_CMD_LEN_RD_STATUS];
+	rmpp_req_que_t req = {};
 
-	stRmpp.output.bit.mode = RMPP_MODE_OFF;
+	req.req = RMPP_REQ_DISCONNECT;
+	req.id = id;
+	req.value = clientCount;
+	rmpp_postRequest(&req, pdMS_TO_TICKS(RMPP_REQ_WAIT));
+}
 
-	while(true) {
-		// fault signal monitoring
-		if (FAULT_DURING == digitalRead(PIN_FAULT)) {
-			if (0 == stRmpp.status.bit.OverCurrent) {
-				rmpp_stopOutputOnFault();
+/******************************************************************************
+* Function Name: rmpp_changeClients
+* Description  : クライアントの接続／切断を処理する（処理タスクで実行）
+* Arguments    : id - websocket client id, clientCount - connected clients,
+                 disconnect - true -> the client has disconnected
+* Return Value : none
+******************************************************************************/
+void rmpp_changeClients(uint32_t id, uint16_t clientCount, bool disconnect)
+{
+	if (disconnect) {
+		// the session ends, the outputs it was driving run on until another
+		// client drives them or the alive timer stops them
+		for (uint8_t i = 0; i < RMPP_SESSION_MAX; i++) {
+			if (id == stSession[i].id) {
+				stSession[i].id = 0;
 			}
 		}
+		for (uint8_t i = 0; i < RMPP_NUM_CH; i++) {
+			if (id == stCh[i].owner) {
+				stCh[i].owner = 0;
+			}
+		}
+	}
 
-		// send power pack status to the client (web browser)
-		if (RMPP_STATUS_INTERVAL < (xTaskGetTickCount() - tickQueueData)) {
-			tickQueueData = xTaskGetTickCount();
-			
-			// input voltage (in units of 0.1V)
-			stRmpp.volt_in = analogRead(PIN_VIN) * 360 / 4095;
+	if (false == srvStarted) {
+		srvStarted = true;
+	}
 
-			// cpu temperature (in units of 1deg)
-			stRmpp.temp_cpu = (int8_t)RMPP_TEMP_READ();
+	connectClients = clientCount;
 
-			// command binary data 
-			cmdToClient[0] = RMPP_CMDID_RD_STATUS;
-			cmdToClient[1] = stRmpp.output.ui8;
-			cmdToClient[2] = stRmpp.status.ui8;
-			if (255 > stRmpp.volt_in) {
-				cmdToClient[3] = stRmpp.volt_in;
-			} else {
-				cmdToClient[3] = 0xFF;
-			}
-			cmdToClient[4] = stRmpp.temp_cpu + 128;
+	// a newly connected client needs the full status
+	for (uint8_t i = 0; i < RMPP_NUM_CH; i++) {
+		stCh[i].statusFullRequired = true;
+	}
+	rmpp_notifyStatusChange();
+	
+	if (clientCount) {
+		LED_setLightPattern(LED_PT_BLINK_ON90);
+	} else {
+		LED_setLightPattern(LED_PT_BLINK_ON10);
+	}
+}
 
-			if (srvStarted) {
-				SRV_pushWsBinaryToQueue(&cmdToClient[0], RMPP_CMD_LEN_RD_STATUS);
-			}
+/******************************************************************************
+* Function Name: rmpp_getSession
+* Description  : クライアントのセッションを取得する（なければ割り当てる）
+* Arguments    : id - websocket client id
+* Return Value : session (NULL -> no free session)
+******************************************************************************/
+rmpp_session_t * rmpp_getSession(uint32_t id)
+{
+	rmpp_session_t * empty = NULL;
+
+	for (uint8_t i = 0; i < RMPP_SESSION_MAX; i++) {
+		if (id == stSession[i].id) {
+			return &stSession[i];
+		}
+		if ((NULL == empty) && (0 == stSession[i].id)) {
+			empty = &stSession[i];
 		}
+	}
 
-		vTaskDelay(1);
+	if (NULL != empty) {
+		*empty = {};
+		empty->id = id;
+		empty->tickWindow = xTaskGetTickCount();
 	}
+	return empty;
 }
 
 /******************************************************************************
-* Function Name: rmpp_handleWsBinaryData
-* Description  : WebSocket̃oCif[^MƂ̃R[obN֐
-* Arguments    : data - received data, len - received length
-* Return Value : none
+* Function Name: rmpp_countSessionCommand
+* Description  : セッションのコマンド数を数え、受信レートを判定する
+* Arguments    : session - client session
+* Return Value : true -> within RMPP_SESSION_RATE_MAX, false -> over the rate
 ******************************************************************************/
-void rmpp_handleWsBinaryData(uint8_t * data, size_t len, uint32_t id)
+bool rmpp_countSessionCommand(rmpp_session_t * session)
 {
-	uint8_t len_cmd = RMPP_GET_CMD_LEN(data[0]);
+	TickType_t tickNow = xTaskGetTickCount();
+
+	if (pdMS_TO_TICKS(RMPP_SESSION_WINDOW) <= (tickNow - session->tickWindow)) {
+		session->rate = session->cntWindow;
+		session->cntWindow = 0;
+		session->tickWindow = tickNow;
+	}
 
-	if (RMPP_CMDID_WR_OUTPUT == data[0]) {
-		rmpp_parseOutputCommand(data, len_cmd);
+	if (UINT16_MAX > session->cntWindow) {
+		session->cntWindow++;
 	}
+	return (RMPP_SESSION_RATE_MAX >= session->cntWindow);
 }
 
 /******************************************************************************
-* Function Name: rmpp_handleWsClientChange
-* Description  : WebSocket̃NCAgڑ^ؒfƂ̃R[obN֐
-* Arguments    : clientCount - connected clients
+* Function Name: rmpp_printSessions
+* Description  : 制御セッションの状態をコンソールに出力する
+* Arguments    : none
 * Return Value : none
 ******************************************************************************/
-void rmpp_handleWsClientChange(uint32_t id, size_t clientCount)
+void rmpp_printSessions(cli_cmd_t command)
 {
-	if (false == srvStarted) {
-		srvStarted = true;
+	for (uint8_t i = 0; i < RMPP_SESSION_MAX; i++) {
+		const rmpp_session_t * session = &stSession[i];
+		if (session->id) {
+			command.out->printf("- Client %-4u : %u cmd/s, accepted %u, coalesced %u, rejected %u\n", session->id,
+				session->rate, session->cntAccepted, session->cntCoalesced, session->cntRejected);
+		}
 	}
-
-	connectClients = clientCount;
-	
-	if (clientCount) {
-		LED_setLightPattern(LED_PT_BLINK_ON90);
-	} else {
-		LED_setLightPattern(LED_PT_BLINK_ON10);
+	for (uint8_t i = 0; i < RMPP_NUM_CH; i++) {
+		if (stCh[i].owner) {
+			command.out->printf("- Output %u    : controlled by client %u\n", i, stCh[i].owner);
+		} else {
+			command.out->printf("- Output %u    : no controlling client\n", i);
+		}
 	}
 }
 
 /******************************************************************************
 * Function Name: rmpp_handleWiFiEvent
-* Description  : Wi-FiCxgƂ̃R[obN֐
+* Description  : Wi-Fiイベントが発生したときのコールバック関数
 * Arguments    : event - WiFi event code
 * Return Value : none
 ******************************************************************************/
@@ -348,7 +1636,7 @@ void rmpp_handleWiFiEvent(SYS_WIFI_EVENT_PARAM param)
 
 /******************************************************************************
 * Function Name: rmpp_handleCfgChangeSuccess
-* Description  : ݒύXƂ̃R[obN֐
+* Description  : 設定変更が成功したときのコールバック関数
 * Arguments    : none
 * Return Value : none
 ******************************************************************************/
@@ -359,250 +1647,693 @@ void rmpp_handleCfgChangeSuccess(void)
 
 /******************************************************************************
 * Function Name: rmpp_printStatus
-* Description  : p[pbNԂR\[ɏo͂
+* Description  : パワーパック状態をコンソールに出力する
 * Arguments    : none
 * Return Value : none
 ******************************************************************************/
 void rmpp_printStatus(cli_cmd_t command)
 {
-	float vin = (float)analogRead(PIN_VIN) * 36.0 / 4095.0;
-	Serial.printf("- Input Voltage   : %.2f V\n", vin);
-	Serial.printf("- Output Duty     : %d\n", stRmpp.duty_set);
-	Serial.printf("- CPU Temperature : %.2f deg\n", RMPP_TEMP_READ());
+	float vin = (float)ADC_getMilliVolts(stRmpp.adcVin) * VIN_DIV / 1000.0;
+	command.out->printf("- Input Voltage   : %.2f V\n", vin);
+	for (uint8_t i = 0; i < RMPP_NUM_CH; i++) {
+		command.out->printf("- Output %u        : mode %u, duty %d%s\n", i, stCh[i].info.output.bit.mode,
+			stCh[i].info.duty_set, stCh[i].info.status.bit.OverCurrent ? ", over current" : "");
+	}
+	command.out->printf("- CPU Temperature : %.2f deg\n", RMPP_TEMP_READ());
+	command.out->printf("- Status Frames   : full %u, diff %u, suppressed %u\n", cntStatusFull, cntStatusDiff, cntStatusSuppressed);
+	command.out->printf("- Requests        : dropped %u (queue full), stale %u (older than a stop)\n", cntReqDropped.load(), cntReqStale);
+
+	rmpp_stream_stats_t stream;
+	RMPP_getStreamStats(&stream);
+	command.out->printf("- Stream Samples  : pushed %u, dropped %u, blocks %u (output %u)\n", stream.pushed, stream.dropped, stream.blocks, RMPP_getStreamChannel());
+}
+
+/******************************************************************************
+* Function Name: rmpp_handleRampCommand
+* Description  : ランプの設定を変更・表示する（変更は処理タスクへ依頼する）
+* Arguments    : command.command2 = ACC / BRK,
+                 command.command3 = OFF / LINEAR / SCURVE / TABLE,
+                 command.command4 = time from 0 to the full duty [ms] (0 to RMPP_RAMP_TIME_MAX)
+* Return Value : none
+******************************************************************************/
+void rmpp_handleRampCommand(cli_cmd_t command)
+{
+	rmpp_req_que_t req = {};
+	uint8_t curve;
+	long time;
+	char * end;
+
+	if (0 == strcmp(command.command2, "ACC")) {
+		req.data[0] = 0;
+	} else if (0 == strcmp(command.command2, "BRK")) {
+		req.data[0] = 1;
+	} else {
+		rmpp_printRamp(*command.out);
+		return;
+	}
+
+	for (curve = 0; curve < sizeof(rampCurveName) / sizeof(rampCurveName[0]); curve++) {
+		if (0 == strcmp(command.command3, rampCurveName[curve])) {
+			break;
+		}
+	}
+	time = strtol(command.command4, &end, 10);
+	if ((sizeof(rampCurveName) / sizeof(rampCurveName[0]) <= curve) || (end == command.command4) || ('\0' != *end)
+	 || (0 > time) || (RMPP_RAMP_TIME_MAX < time)) {
+		command.out->printf("[warning] usage : RAMP ACC|BRK OFF|LINEAR|SCURVE|TABLE <0 - %u ms>\n", RMPP_RAMP_TIME_MAX);
+		return;
+	}
+
+	// the profiles are used by the ramp of the RMPP task, so it changes them
+	req.req = RMPP_REQ_RAMP;
+	req.index = RMPP_REQ_CH_ALL;
+	req.data[1] = curve;
+	req.value = (uint16_t)time;
+	if (!rmpp_postRequest(&req, pdMS_TO_TICKS(RMPP_REQ_WAIT))) {
+		command.out->println("[warning] the ramp profile is not changed (request queue full).");
+	}
+}
+
+/******************************************************************************
+* Function Name: rmpp_printRamp
+* Description  : ランプの設定を表示する
+* Arguments    : out - output of the text
+* Return Value : none
+******************************************************************************/
+void rmpp_printRamp(Print & out)
+{
+
+	out.printf("- Acceleration : %s, step %u, jerk %u\n", rampCurveName[rampAccel.curve], rampAccel.step, rampAccel.jerk);
+	out.printf("- Braking      : %s, step %u, jerk %u\n", rampCurveName[rampBrake.curve], rampBrake.step, rampBrake.jerk);
+	out.printf("- Updates      : %u (%u Hz)\n", cntRampUpdates, RMPP_RAMP_RATE);
+}
+
+/******************************************************************************
+* Function Name: rmpp_handleSpeedCommand
+* Description  : 速度制御の設定を変更・表示する（ゲインの変更は処理タスクへ依頼する）
+* Arguments    : command.command2 = ON / OFF / GAIN,
+                 command.command3 = proportional gain (GAIN, 0 to RMPP_SPEED_GAIN_MAX),
+                 command.command4 = integral gain (GAIN, 0 to RMPP_SPEED_GAIN_MAX)
+* Return Value : none
+******************************************************************************/
+void rmpp_handleSpeedCommand(cli_cmd_t command)
+{
+	if (0 == strcmp(command.command2, "ON")) {
+		speedCtrl = true;
+		xTimerStart(hTimerSpeed, 0);
+	} else if (0 == strcmp(command.command2, "OFF")) {
+		speedCtrl = false;
+		xTimerStop(hTimerSpeed, 0);
+		// the outputs go back to the open-loop ramp duty
+		if (NULL != hTaskRmpp) {
+			xTaskNotify(hTaskRmpp, RMPP_NOTIFY_SPEED, eSetBits);
+		}
+	} else if (0 == strcmp(command.command2, "GAIN")) {
+		rmpp_req_que_t req = {};
+		char * end[2];
+		long kp = strtol(command.command3, &end[0], 10);
+		long ki = strtol(command.command4, &end[1], 10);
+
+		if ((end[0] == command.command3) || ('\0' != *end[0]) || (0 > kp) || (RMPP_SPEED_GAIN_MAX < kp)
+		 || (end[1] == command.command4) || ('\0' != *end[1]) || (0 > ki) || (RMPP_SPEED_GAIN_MAX < ki)) {
+			command.out->printf("[warning] usage : SPEED GAIN <kp 0 - %u> <ki 0 - %u>\n", RMPP_SPEED_GAIN_MAX, RMPP_SPEED_GAIN_MAX);
+			return;
+		}
+
+		// the gains are used by the speed control of the RMPP task, so it changes them
+		req.req = RMPP_REQ_GAIN;
+		req.index = RMPP_REQ_CH_ALL;
+		req.value = (uint16_t)kp;
+		req.param = (uint16_t)ki;
+		if (!rmpp_postRequest(&req, pdMS_TO_TICKS(RMPP_REQ_WAIT))) {
+			command.out->println("[warning] the speed control gains are not changed (request queue full).");
+		}
+		return;
+	}
+
+	rmpp_printSpeed(*command.out);
+}
+
+/******************************************************************************
+* Function Name: rmpp_printSpeed
+* Description  : 速度制御の設定と状態を表示する
+* Arguments    : out - output of the text
+* Return Value : none
+******************************************************************************/
+void rmpp_printSpeed(Print & out)
+{
+	out.printf("- Speed Control : %s, kp %d, ki %d (1/%u duty per mV)\n", speedCtrl ? "on" : "off",
+		speedGain.kp, speedGain.ki, 1U << RMPP_SPEED_GAIN_FRAC);
+	for (uint8_t i = 0; i < RMPP_NUM_CH; i++) {
+		if (ADC_INPUT_NONE == stCh[i].adcBemf) {
+			out.printf("- Output %u      : no back-EMF sense\n", i);
+		} else {
+			out.printf("- Output %u      : back-EMF %d mV, duty %u\n", i, stCh[i].bemf, stCh[i].info.duty_set);
+		}
+	}
+	out.printf("- Updates       : %u (%u Hz), measurements given up %u\n", cntSpeedUpdates, RMPP_SPEED_RATE, cntBemfTimeout);
+}
+
+/******************************************************************************
+* Function Name: rmpp_handleTripCommand
+* Description  : 過電流トリップの設定を変更・表示する
+* Arguments    : command.command2 = peak current [mA],
+                 command.command3 = average current [mA]
+* Return Value : none
+******************************************************************************/
+void rmpp_handleTripCommand(cli_cmd_t command)
+{
+	if (0 < atoi(command.command2)) {
+		tripPeak = atoi(command.command2);
+	}
+	if (0 < atoi(command.command3)) {
+		tripAvg = atoi(command.command3);
+	}
+
+	command.out->printf("- Trip Level : peak %u mA, average %u mA (tripped %u times)\n", tripPeak, tripAvg, cntTrip);
+	for (uint8_t i = 0; i < RMPP_NUM_CH; i++) {
+		if (ADC_INPUT_NONE == stCh[i].adcIsense) {
+			command.out->printf("- Output %u   : no current sense\n", i);
+		} else {
+			command.out->printf("- Output %u   : %u mA (average %u mA)%s\n", i, stCh[i].current.now,
+				stCh[i].current.avg >> RMPP_CURRENT_AVG_SHIFT, stCh[i].info.status.bit.SwTrip ? ", tripped" : "");
+		}
+	}
 }
 
 /******************************************************************************
 * Function Name: rmpp_parseOutputCommand
-* Description  : o͐R}h
+* Description  : 出力制御コマンドを解析（チャネル0）
+* Arguments    : data - command data,
+                 len - command length, id - websocket client id
+* Return Value : none
+******************************************************************************/
+void rmpp_parseOutputCommand(uint8_t * data, uint8_t len, uint32_t id)
+{
+	rmpp_req_que_t req = {};
+
+	// the command is carried out by the process task
+	req.req = RMPP_REQ_OUTPUT;
+	req.index = 0;
+	req.data[0] = *(data + 1);
+	req.data[1] = *(data + 2);
+	req.id = id;
+	rmpp_postRequest(&req, 0);
+}
+
+/******************************************************************************
+* Function Name: rmpp_parseOutputChCommand
+* Description  : チャネル指定の出力制御コマンドを解析
+* Arguments    : data - command data,
+                 len - command length, id - websocket client id
+* Return Value : none
+******************************************************************************/
+void rmpp_parseOutputChCommand(uint8_t * data, uint8_t len, uint32_t id)
+{
+	rmpp_req_que_t req = {};
+
+	if (NULL == rmpp_getChannel(*(data + 1))) {
+		SYS_LATENCY_CANCEL(SYS_LAT_WS_TO_DUTY);
+		return;
+	}
+
+	// the command is carried out by the process task
+	req.req = RMPP_REQ_OUTPUT;
+	req.index = *(data + 1);
+	req.data[0] = *(data + 2);
+	req.data[1] = *(data + 3);
+	req.id = id;
+	rmpp_postRequest(&req, 0);
+}
+
+/******************************************************************************
+* Function Name: rmpp_parseStreamCommand
+* Description  : テレメトリのストリーミング購読コマンドを解析
 * Arguments    : data - command data,
-                 size - command length
+                 len - command length, id - websocket client id
+* Return Value : none
+******************************************************************************/
+void rmpp_parseStreamCommand(uint8_t * data, uint8_t len, uint32_t id)
+{
+	uint8_t index = *(data + 1);
+	bool enable = (0 != *(data + 2));
+
+	// the output is not updated by this command
+	SYS_LATENCY_CANCEL(SYS_LAT_WS_TO_DUTY);
+
+	if (enable) {
+		if (NULL == rmpp_getChannel(index)) {
+			return;
+		}
+		// the stream carries a single channel, the newest subscription wins
+		if (0 == SRV_countWsStreamClients()) {
+			RMPP_resetStream();
+		}
+		RMPP_setStreamChannel(index);
+	}
+
+	if (SRV_subscribeWsStream(id, enable)) {
+		Serial.printf("[info] client %u has %s the stream of output %u.\n", id, enable ? "subscribed to" : "unsubscribed from", index);
+	}
+}
+
+/******************************************************************************
+* Function Name: rmpp_controlOutput
+* Description  : 出力制御コマンドに従って出力を制御する（処理タスクで実行）
+* Arguments    : ch - output channel,
+                 data - [duty low][direction | duty high],
+                 id - websocket client id
 * Return Value : none
 ******************************************************************************/
-void rmpp_parseOutputCommand(uint8_t * data, uint16_t len)
+void rmpp_controlOutput(rmpp_ch_t * ch, const uint8_t * data, uint32_t id)
 {
 	uint16_t duty;
-	uint8_t dir = *(data + 2) & 0xC0;
+	uint8_t dir = *(data + 1) & 0xC0;
+	rmpp_session_t * session = rmpp_getSession(id);
+	TickType_t tickNow = xTaskGetTickCount();
+
+	if (dir) {
+		// only the client in control of the output may drive it,
+		// and only at a bounded rate (a stop is accepted from anyone at any time)
+		if ((NULL == session) || (false == rmpp_countSessionCommand(session))
+		 || ((0 != ch->owner) && (id != ch->owner))) {
+			if (NULL != session) {
+				session->cntRejected++;
+			}
+			SYS_LATENCY_CANCEL(SYS_LAT_WS_TO_DUTY);
+			return;
+		}
+	} else if (NULL != session) {
+		rmpp_countSessionCommand(session);
+	}
+
+	// an output left running by a disconnected owner is taken over by
+	// the next client that drives it (otherwise nobody could keep it alive)
+	if (dir && (0 == ch->owner) && (RMPP_MODE_ON == ch->info.output.bit.mode)) {
+		ch->owner = id;
+	}
+
+	// every accepted command keeps the output alive
+	// (rmpp_checkAlive compares this time with RMPP_ALIVE_TIMEOUT)
+	RMPP_feedAlive(&ch->alive, tickNow);
 
-	xTimerReset(hTimerAlive, 0);
+	// the slider repeats the same command, there is nothing to do for it
+	if ((RMPP_MODE_ON == ch->info.output.bit.mode) && (id == ch->owner)
+	 && (data[0] == ch->cmdLast[0]) && (data[1] == ch->cmdLast[1])) {
+		if (NULL != session) {
+			session->cntCoalesced++;
+		}
+		SYS_LATENCY_CANCEL(SYS_LAT_WS_TO_DUTY);
+		return;
+	}
+	if (NULL != session) {
+		session->cntAccepted++;
+	}
 
 	if (dir) {
-		if (RMPP_MODE_OFF == stRmpp.output.bit.mode) {
+		if (RMPP_MODE_OFF == ch->info.output.bit.mode) {
 			if (dir & 0x40) {
-				RMPP_startOutput(RMPP_DIR_FWD);
+				rmpp_startOutput(ch, RMPP_DIR_FWD);
 			} else if (dir & 0x80) {
-				RMPP_startOutput(RMPP_DIR_RVS);
+				rmpp_startOutput(ch, RMPP_DIR_RVS);
+			}
+			if (RMPP_MODE_ON == ch->info.output.bit.mode) {
+				ch->owner = id;
 			}
 		}
 
-		if (RMPP_MODE_ON == stRmpp.output.bit.mode) {
-			duty = *(data + 2) & 0x3F;
+		if (RMPP_MODE_ON == ch->info.output.bit.mode) {
+			ch->cmdLast[0] = data[0];
+			ch->cmdLast[1] = data[1];
+
+			duty = *(data + 1) & 0x3F;
 			duty = duty << 8;
-			duty = duty + *(data + 1);
+			duty = duty + *data;
 
 			// duty update
-			RMPP_setOutputDuty(duty);
-		}	
-	} else if (RMPP_MODE_OFF != stRmpp.output.bit.mode) {
-		RMPP_stopOutput();
+			rmpp_setOutputDuty(ch, duty);
+		}
+	} else if (RMPP_MODE_OFF != ch->info.output.bit.mode) {
+		rmpp_stopOutput(ch, false);
 	}
 }
 
 /******************************************************************************
 * Function Name: RMPP_resetOutput
-* Description  : o͂Zbg
+* Description  : 出力をリセットする
 * Arguments    : none
 * Return Value : none
 ******************************************************************************/
 void RMPP_resetOutput(void)
 {
-	pinMode(PIN_PWM1, INPUT_PULLDOWN);
-	pinMode(PIN_PWM2, INPUT_PULLDOWN);
+	for (uint8_t i = 0; i < RMPP_NUM_CH; i++) {
+		pinMode(rmppChPins[i].pwm1, INPUT_PULLDOWN);
+		pinMode(rmppChPins[i].pwm2, INPUT_PULLDOWN);
+	}
+}
+
+/******************************************************************************
+* Function Name: RMPP_startOutput
+* Description  : 出力動作の開始を要求する
+* Arguments    : index - channel id, dir - 進行方向
+* Return Value : none
+******************************************************************************/
+void RMPP_startOutput(uint8_t index, rmpp_dir_t dir)
+{
+	rmpp_req_que_t req = {};
+
+	req.req = RMPP_REQ_START;
+	req.index = index;
+	req.value = dir;
+	rmpp_postRequest(&req, 0);
 }
 
 /******************************************************************************
 * Function Name: rmpp_startOutput
-* Description  : o͓Jn
-* Arguments    : dir - is
+* Description  : 出力動作を開始する（処理タスクで実行）
+* Arguments    : ch - output channel, dir - 進行方向
 * Return Value : none
 ******************************************************************************/
-void RMPP_startOutput(rmpp_dir_t dir)
+void rmpp_startOutput(rmpp_ch_t * ch, rmpp_dir_t dir)
 {
-	if (RMPP_DIR_NULL == dir) {
+	if ((RMPP_DIR_NULL == dir) || (RMPP_MODE_OFF != ch->info.output.bit.mode)) {
 		return;
 	}
 
-	Serial.println("[info] output on !");
-	xTimerStart(hTimerAlive, 0);
+	Serial.printf("[info] output %u on !\n", ch->index);
+	RMPP_feedAlive(&ch->alive, xTaskGetTickCount());
+	RMPP_resetRamp(&ch->ramp, 0);
+	RMPP_resetSpeedPi(&ch->pi);
 
-	stRmpp.output.bit.mode = RMPP_MODE_ON;
-	stRmpp.status.bit.ext_ctrl = 1;
+	ch->info.output.bit.mode = RMPP_MODE_ON;
+	ch->info.status.bit.ext_ctrl = 1;
 
-	LED_setColor(LED_COL_GREEN);
-	if (connectClients) {
-		LED_setLightPattern(LED_PT_BLINK_ON90);
-	} else {
-		LED_setLightPattern(LED_PT_ON);
-	}
+	rmpp_updateLed();
 
 	// output circuit is in brake mode
-	RMPP_PWM_WRITE(PIN_PWM1, PWM_DUTY_100);
-	RMPP_PWM_WRITE(PIN_PWM2, PWM_DUTY_100);
+	RMPP_PWM_WRITE(ch->pin.pwm1, PWM_DUTY_100);
+	RMPP_PWM_WRITE(ch->pin.pwm2, PWM_DUTY_100);
 
-	if ((RMPP_DIR_FWD == dir) && (0 == stRmpp.output.bit.rvs)) {
-		stRmpp.output.bit.fwd = 1;
-	} else if ((RMPP_DIR_RVS == dir) && (0 == stRmpp.output.bit.fwd)) {
-		stRmpp.output.bit.rvs = 1;
+	if ((RMPP_DIR_FWD == dir) && (0 == ch->info.output.bit.rvs)) {
+		ch->info.output.bit.fwd = 1;
+	} else if ((RMPP_DIR_RVS == dir) && (0 == ch->info.output.bit.fwd)) {
+		ch->info.output.bit.rvs = 1;
 	}
+
+	rmpp_notifyStatusChange();
 }
 
 /******************************************************************************
 * Function Name: RMPP_stopOutput
-* Description  : o͓~
-* Arguments    : none
+* Description  : 出力動作の停止を要求する
+* Arguments    : index - channel id, inhbit - 出力禁止期間を設ける
 * Return Value : none
 ******************************************************************************/
-void RMPP_stopOutput(bool inhbit)
+void RMPP_stopOutput(uint8_t index, bool inhbit)
 {
-	if (RMPP_MODE_ON == stRmpp.output.bit.mode) {
-		rmpp_turnOutputOff();
-		LED_setColor(LED_COL_STNDBY);
-		if (connectClients) {
-			LED_setLightPattern(LED_PT_BLINK_ON90);
-		} else {
-			LED_setLightPattern(LED_PT_BLINK_ON10);
-		}
-	
+	rmpp_req_que_t req = {};
+
+	if (NULL == rmpp_getChannel(index)) {
+		return;
+	}
+
+	req.req = RMPP_REQ_STOP;
+	req.index = index;
+	req.value = inhbit;
+	rmpp_postRequest(&req, 0);
+}
+
+/******************************************************************************
+* Function Name: rmpp_stopOutput
+* Description  : 出力動作を停止する（処理タスクで実行）
+* Arguments    : ch - output channel, inhbit - 出力禁止期間を設ける
+* Return Value : none
+******************************************************************************/
+void rmpp_stopOutput(rmpp_ch_t * ch, bool inhbit)
+{
+	if (RMPP_MODE_ON == ch->info.output.bit.mode) {
+		rmpp_turnOutputOff(ch);
+
 		if (inhbit) {
-			stRmpp.output.bit.mode = RMPP_MODE_INHBIT;
-			xTimerStart(hTimerInhbit, 0);
+			ch->info.output.bit.mode = RMPP_MODE_INHBIT;
+			xTimerStart(ch->hTimerInhbit, 0);
 		} else {
-			stRmpp.output.bit.mode = RMPP_MODE_OFF;
+			ch->info.output.bit.mode = RMPP_MODE_OFF;
 		}
-	} else if (RMPP_MODE_FAULT == stRmpp.output.bit.mode) {
-		rmpp_clearFault();
+		rmpp_updateLed();
+	} else if (RMPP_MODE_FAULT == ch->info.output.bit.mode) {
+		rmpp_clearFault(ch);
 	}
+
+	rmpp_notifyStatusChange();
+}
+
+/******************************************************************************
+* Function Name: RMPP_stopAllOutputs
+* Description  : 全チャネルの出力動作の停止を要求する
+* Arguments    : inhbit - 出力禁止期間を設ける
+* Return Value : none
+******************************************************************************/
+void RMPP_stopAllOutputs(bool inhbit)
+{
+	rmpp_req_que_t req = {};
+
+	req.req = RMPP_REQ_STOP;
+	req.index = RMPP_REQ_CH_ALL;
+	req.value = inhbit;
+	rmpp_postRequest(&req, 0);
 }
 
 /******************************************************************************
 * Function Name: rmpp_stopOutputOnFault
-* Description  : tHgvɂo͓~
-* Arguments    : none
+* Description  : フォルト要因により出力動作を停止する
+* Arguments    : ch - output channel
+* Return Value : none
+******************************************************************************/
+void rmpp_stopOutputOnFault(rmpp_ch_t * ch)
+{
+	// change the mode first so that no output command is accepted
+	ch->info.output.bit.mode = RMPP_MODE_FAULT;
+	ch->info.status.bit.OverCurrent = 1;
+
+	rmpp_turnOutputOff(ch);
+	rmpp_updateLed();
+
+	Serial.printf("[warning] motor driver %u has entered protection mode.\n", ch->index);
+}
+
+/******************************************************************************
+* Function Name: rmpp_stopOutputOnTrip
+* Description  : 過電流トリップにより出力動作を停止する
+* Arguments    : ch - output channel
 * Return Value : none
 ******************************************************************************/
-void rmpp_stopOutputOnFault(void)
+void rmpp_stopOutputOnTrip(rmpp_ch_t * ch)
 {
-	rmpp_turnOutputOff();
-	LED_setColor(LED_COL_RED);
-	LED_setLightPattern(LED_PT_BLINK_FAST);
+	// change the mode first so that no output command is accepted
+	// (even if the output was stopped after the cut, the trip is latched)
+	ch->info.output.bit.mode = RMPP_MODE_FAULT;
+	ch->info.status.bit.SwTrip = 1;
+	cntTrip++;
+
+	rmpp_turnOutputOff(ch);
+	rmpp_updateLed();
 
-	stRmpp.output.bit.mode = RMPP_MODE_FAULT;
-	stRmpp.status.bit.OverCurrent = 1;
+	Serial.printf("[warning] output %u has tripped on over current (%u mA).\n", ch->index, ch->current.now);
 
-	Serial.println("[warning] motor driver has entered protection mode.");
+	// outputs were forced off by the ADC task,
+	// so hand the pins back to the PWM peripheral (at 0% duty)
+	rmpp_restoreOutputPins(ch);
+	rmpp_notifyStatusChange();
 }
 
 /******************************************************************************
 * Function Name: RMPP_setOutputDuty
-* Description  : o̓f[eBݒ肷
-* Arguments    : duty = 0 -> Duty 0%, 4095 -> Duty 100%
+* Description  : 出力デューティの設定を要求する
+* Arguments    : index - channel id,
+                 duty = 0 -> Duty 0%, 4095 -> Duty 100%
 * Return Value : none
 ******************************************************************************/
-void RMPP_setOutputDuty(uint16_t duty)
+void RMPP_setOutputDuty(uint8_t index, uint16_t duty)
 {
-	if (RMPP_MODE_ON == stRmpp.output.bit.mode) {
-		stRmpp.duty_set = (uint16_t)duty;
+	rmpp_req_que_t req = {};
+
+	req.req = RMPP_REQ_DUTY;
+	req.index = index;
+	req.value = duty;
+	rmpp_postRequest(&req, 0);
+}
 
-		// duty cycle inversion
-		// (becase PWM signal is active low)
-		duty = PWM_DUTY_100 - duty;
-		if (PWM_DUTY_MAX < duty) {
-			duty = PWM_DUTY_MAX;
+/******************************************************************************
+* Function Name: rmpp_setOutputDuty
+* Description  : 出力デューティを設定する（処理タスクで実行）
+* Arguments    : ch - output channel,
+                 duty = 0 -> Duty 0%, 4095 -> Duty 100%
+* Return Value : none
+******************************************************************************/
+void rmpp_setOutputDuty(rmpp_ch_t * ch, uint16_t duty)
+{
+	if (RMPP_MODE_ON == ch->info.output.bit.mode) {
+		if (PWM_DUTY_100 < duty) {
+			duty = PWM_DUTY_100;
 		}
 
-		if (stRmpp.output.bit.fwd) {
-			// output circuit is Forward mode
-			// (voltage polarity : OUT1 -> OUT2)
-			RMPP_PWM_WRITE(PIN_PWM2, duty);
-		} else if (stRmpp.output.bit.rvs) {
-			// output circuit is Reverse mode
-			// (voltage polarity : OUT2 -> OUT1)
-			RMPP_PWM_WRITE(PIN_PWM1, duty);
+		// nothing is written when the ramp already rests at the duty
+		if ((ch->ramp.duty == ch->ramp.target) && (RMPP_getRampDuty(&ch->ramp) == duty)) {
+			SYS_LATENCY_CANCEL(SYS_LAT_WS_TO_DUTY);
 		}
+
+		// the duty follows the target at the control rate of the task
+		RMPP_setRampTarget(&ch->ramp, duty);
+		xTaskNotify(hTaskRmpp, RMPP_NOTIFY_RAMP, eSetBits);
 	} else {
-		stRmpp.duty_set = 0;
+		ch->info.duty_set = 0;
+		rmpp_notifyStatusChange();
+	}
+}
+
+/******************************************************************************
+* Function Name: rmpp_writeDuty
+* Description  : 出力デューティをPWMに反映する
+* Arguments    : ch - output channel,
+                 duty = 0 -> Duty 0%, 4096 -> Duty 100%
+* Return Value : none
+******************************************************************************/
+void rmpp_writeDuty(rmpp_ch_t * ch, uint16_t duty)
+{
+	ch->info.duty_set = duty;
+
+	// duty cycle inversion
+	// (becase PWM signal is active low)
+	duty = PWM_DUTY_100 - duty;
+	if (PWM_DUTY_MAX < duty) {
+		duty = PWM_DUTY_MAX;
+	}
+
+	if (ch->info.output.bit.fwd) {
+		// output circuit is Forward mode
+		// (voltage polarity : OUT1 -> OUT2)
+		RMPP_PWM_WRITE(ch->pin.pwm2, duty);
+	} else if (ch->info.output.bit.rvs) {
+		// output circuit is Reverse mode
+		// (voltage polarity : OUT2 -> OUT1)
+		RMPP_PWM_WRITE(ch->pin.pwm1, duty);
 	}
+	SYS_LATENCY_STOP(SYS_LAT_WS_TO_DUTY);
 }
 
 /******************************************************************************
 * Function Name: rmpp_turnOutputOff
-* Description  : o͂Itɂ
-* Arguments    : none
+* Description  : 出力をオフにする
+* Arguments    : ch - output channel
 * Return Value : none
 ******************************************************************************/
-void rmpp_turnOutputOff(void)
+void rmpp_turnOutputOff(rmpp_ch_t * ch)
 {
 	// output circuit is Hi-Z mode
-	RMPP_PWM_WRITE(PIN_PWM1, 0);
-	RMPP_PWM_WRITE(PIN_PWM2, 0);
+	RMPP_PWM_WRITE(ch->pin.pwm1, 0);
+	RMPP_PWM_WRITE(ch->pin.pwm2, 0);
+	SYS_LATENCY_STOP(SYS_LAT_WS_TO_DUTY);
+
+	ch->info.output.bit.fwd = 0;
+	ch->info.output.bit.rvs = 0;
+	ch->info.status.bit.ext_ctrl = 0;
+	ch->info.duty_set = 0;
+	RMPP_resetRamp(&ch->ramp, 0);
+	RMPP_resetSpeedPi(&ch->pi);
+	ch->bemf = 0;
+	ch->bemfState.store(RMPP_BEMF_IDLE, std::memory_order_relaxed);
+	ch->owner = 0;
+	ch->cmdLast[0] = 0;
+	ch->cmdLast[1] = 0;
+
+	Serial.printf("[info] output %u off !\n", ch->index);
+}
 
-	stRmpp.output.bit.fwd = 0;
-	stRmpp.output.bit.rvs = 0;
-	stRmpp.status.bit.ext_ctrl = 0;
-	stRmpp.duty_set = 0;
+/******************************************************************************
+* Function Name: rmpp_cutOutputFromISR
+* Description  : 割り込み処理から出力を強制的にオフにする
+* Arguments    : ch - output channel
+* Return Value : none
+******************************************************************************/
+void IRAM_ATTR rmpp_cutOutputFromISR(const rmpp_ch_t * ch)
+{
+#if defined(ESP32)
+	// output circuit is Hi-Z mode
+	// (drive both pins low and detach them from the LEDC signal,
+	//  only register accesses are used so that it is safe in the ISR)
+	gpio_ll_set_level(&GPIO, (gpio_num_t)ch->pin.pwm1, 0);
+	gpio_ll_set_level(&GPIO, (gpio_num_t)ch->pin.pwm2, 0);
+	gpio_matrix_out(ch->pin.pwm1, SIG_GPIO_OUT_IDX, false, false);
+	gpio_matrix_out(ch->pin.pwm2, SIG_GPIO_OUT_IDX, false, false);
+#endif
+}
 
-	xTimerStop(hTimerAlive, 0);
-	Serial.println("[info] output off !");
+/******************************************************************************
+* Function Name: rmpp_restoreOutputPins
+* Description  : 強制オフした出力ピンをPWM出力に戻す
+* Arguments    : ch - output channel
+* Return Value : none
+******************************************************************************/
+void rmpp_restoreOutputPins(const rmpp_ch_t * ch)
+{
+#if defined(ESP32)
+	ledcDetach(ch->pin.pwm1);
+	ledcAttach(ch->pin.pwm1, PWM_FRQ, PWM_RES);
+	ledcWrite(ch->pin.pwm1, 0);
+	ledcDetach(ch->pin.pwm2);
+	ledcAttach(ch->pin.pwm2, PWM_FRQ, PWM_RES);
+	ledcWrite(ch->pin.pwm2, 0);
+#endif
 }
 
 /******************************************************************************
 * Function Name: rmpp_clearFault
-* Description  : tHgԂNA
-* Arguments    : none
+* Description  : フォルト状態をクリアする
+* Arguments    : ch - output channel
 * Return Value : none
 ******************************************************************************/
-void rmpp_clearFault(void)
+void rmpp_clearFault(rmpp_ch_t * ch)
 {
-	if (FAULT_CLEAR != digitalRead(PIN_FAULT)) {
-		Serial.println("[warning] motor driver is in protection mode.");
+	if (FAULT_CLEAR != digitalRead(ch->pin.fault)) {
+		Serial.printf("[warning] motor driver %u is in protection mode.\n", ch->index);
 		return;
 	}
 
-	Serial.println("[info] motor driver has resumed normal operation mode.");
+	Serial.printf("[info] motor driver %u has resumed normal operation mode.\n", ch->index);
 
-	stRmpp.output.bit.mode = RMPP_MODE_OFF;
-	stRmpp.status.bit.OverCurrent = 0;
+	ch->info.output.bit.mode = RMPP_MODE_OFF;
+	ch->info.status.bit.OverCurrent = 0;
+	ch->info.status.bit.SwTrip = 0;
+	// the ADC task may trip again once the output is turned on
+	ch->trip.store(false, std::memory_order_release);
 
-	LED_setColor(LED_COL_STNDBY);
-	if (connectClients) {
-		LED_setLightPattern(LED_PT_BLINK_ON90);
-	} else {
-		LED_setLightPattern(LED_PT_BLINK_ON10);
-	}
+	rmpp_updateLed();
 }
 
 /******************************************************************************
 * Function Name: rmpp_clearInhbit
-* Description  : o͋֎~ԂNA
-* Arguments    : none
+* Description  : 出力禁止期間のタイマ処理（状態は処理タスクで戻す）
+* Arguments    : xTimer - inhbit timer
 * Return Value : none
 ******************************************************************************/
 void rmpp_clearInhbit(TimerHandle_t xTimer)
 {
-	if (RMPP_MODE_INHBIT == stRmpp.output.bit.mode) {
-		stRmpp.output.bit.mode = RMPP_MODE_OFF;
-	}
+	xTaskNotify(hTaskRmpp, RMPP_NOTIFY_INHBIT, eSetBits);
 }
 
 /******************************************************************************
-* Function Name: rmpp_onAliveTimeout
-* Description  : ORg[̃^CAEg
-* Arguments    : none
+* Function Name: rmpp_checkAlive
+* Description  : 外部コントロールのタイムアウト判定
+*                (ステータス周期で呼び出す、判定の分解能は RMPP_STATUS_INTERVAL)
+* Arguments    : ch - output channel
 * Return Value : none
 ******************************************************************************/
-void rmpp_onAliveTimeout(TimerHandle_t xTimer)
+void rmpp_checkAlive(rmpp_ch_t * ch)
 {
-	if (RMPP_MODE_ON == stRmpp.output.bit.mode) {
-		Serial.println("alive monitoring timeout");
-		RMPP_stopOutput();
+	if ((RMPP_MODE_ON == ch->info.output.bit.mode)
+	 && RMPP_isAliveExpired(&ch->alive, xTaskGetTickCount(), pdMS_TO_TICKS(RMPP_ALIVE_TIMEOUT))) {
+		Serial.printf("alive monitoring timeout (output %u)\n", ch->index);
+		rmpp_stopOutput(ch, false);
 	}
-}
\ No newline at end of file
+}
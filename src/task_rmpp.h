@@ -7,23 +7,24 @@
 
 // This software module is part of the Railway Model Power Pack (RMPP)
 
-#ifndef __TASK_RMPP_H__	/* d`h~ */
+#ifndef __TASK_RMPP_H__	/* 二重定義防止 */
 
 #include <Arduino.h>
 
 typedef enum {
-	RMPP_DIR_NULL = 0,	/* isEw */
-	RMPP_DIR_FWD,		/* isEOi */
-	RMPP_DIR_RVS		/* isE */
+	RMPP_DIR_NULL = 0,	/* 進行方向・未指定 */
+	RMPP_DIR_FWD,		/* 進行方向・前進 */
+	RMPP_DIR_RVS		/* 進行方向・後退 */
 } rmpp_dir_t;
 
 bool RMPP_initTask(void);
 
 void RMPP_resetOutput(void);
-void RMPP_startOutput(rmpp_dir_t dir);
-void RMPP_stopOutput(bool inhbit = false);
-void RMPP_setOutputDuty(uint16_t duty);
+void RMPP_startOutput(uint8_t index, rmpp_dir_t dir);
+void RMPP_stopOutput(uint8_t index, bool inhbit = false);
+void RMPP_stopAllOutputs(bool inhbit = false);
+void RMPP_setOutputDuty(uint8_t index, uint16_t duty);
 
-#endif /* __TASK_RMPP_H__*/	/* d`h~ */
-#define __TASK_RMPP_H__	/* d`h~ */
+#endif /* __TASK_RMPP_H__*/	/* 二重定義防止 */
+#define __TASK_RMPP_H__	/* 二重定義防止 */
 
@@ -6,6 +6,9 @@
 // --------------------------------------------------------
 
 #include "task_server.h"
+#include "task_cli.h"
+#include "srv_asset.h"
+#include "sys_latency.h"
 
 #ifdef HTTP_UPDATE_ENABLE
 #include "http_update.h"
@@ -35,6 +38,7 @@ extern uint8_t _FS_end;
 
 #include <ESPAsyncWebServer.h>
 #include <LittleFS.h>
+#include <atomic>
 
 #if defined(ESP32)
 #ifndef APP_CPU_NUM
@@ -44,6 +48,10 @@ extern uint8_t _FS_end;
 
 #define SERVER_QUE_SEND_WAIT (10 / portTICK_PERIOD_MS)
 
+#ifndef SRV_QUE_BINARY_LEN
+#define SRV_QUE_BINARY_LEN 10
+#endif
+
 #ifndef SRV_CLEANUP_INTERVAL
 #define SRV_CLEANUP_INTERVAL (1000 / portTICK_PERIOD_MS)
 #endif
@@ -52,16 +60,30 @@ extern uint8_t _FS_end;
 #define SRV_REBOOT_DELAY (3000 / portTICK_PERIOD_MS)
 #endif
 
-typedef struct {
-	uint32_t id;	// client id
-	uint8_t data[WS_LEN_BINARY_MAX];	// binary data
-	uint8_t len;	// data length
-} que_ws_binary_t;
+#ifndef SRV_TEXT_RING_SIZE
+#define SRV_TEXT_RING_SIZE 2048
+#endif
+
+// queued messages of a client from which stream blocks are skipped
+#ifndef SRV_STREAM_QUEUE_MAX
+#define SRV_STREAM_QUEUE_MAX 4
+#endif
 
+// stream blocks in the pool (a block stays in the queues of the clients until it is sent)
+#ifndef SRV_STREAM_POOL_LEN
+#define SRV_STREAM_POOL_LEN (SRV_STREAM_QUEUE_MAX + 1)
+#endif
+
+// text message record in the ring buffer
+//  [header][text ...][padding to 4 bytes]
 typedef struct {
 	uint32_t id;	// client id
-	String data;	// text data
-} que_ws_text_t;
+	uint16_t len;	// text length (SRV_TEXT_WRAP -> continue at the top of the ring)
+	uint16_t rsv;
+} ws_text_header_t;
+
+#define SRV_TEXT_WRAP 0xFFFF
+#define SRV_TEXT_RECORD_SIZE(len) ((sizeof(ws_text_header_t) + (len) + 3) & ~3UL)
 
 static AsyncWebServer server(80);
 static AsyncWebSocket webSocket("/ws");
@@ -73,13 +95,36 @@ static TaskHandle_t hTaskServer = NULL;
 static TimerHandle_t hTimerReboot = NULL;
 /* binary message queue handle */
 static QueueHandle_t xQueBinToClient = NULL;
-/* text message queue handle */
-static QueueHandle_t xQueTxtToClient = NULL;
+/* free binary message buffer queue handle */
+static QueueHandle_t xQueBinFree = NULL;
+/* binary message buffer pool */
+static ws_binary_t poolBinary[SRV_QUE_BINARY_LEN];
+/* message counters */
+static srv_stats_t stStats = {};
+/* text message ring buffer (single consumer : server task) */
+static uint8_t ringText[SRV_TEXT_RING_SIZE] __attribute__((aligned(4)));
+static std::atomic<uint32_t> ringTextHead(0);	// write position
+static std::atomic<uint32_t> ringTextTail(0);	// read position
+/* mutex to serialize the text message producers */
+static SemaphoreHandle_t xMutexTxt = NULL;
+
+typedef struct {
+	std::atomic<uint32_t> id;	// client id (0 -> free slot)
+	uint32_t sent;				// blocks sent
+	uint32_t dropped;			// blocks skipped (queue backed up)
+} srv_stream_client_t;
+
+/* stream subscribers */
+static srv_stream_client_t stStreamClient[SRV_STREAM_CLIENT_MAX];
+static std::atomic<uint32_t> numStreamClient(0);
+/* stream block pool (allocated once, reused when no client refers to it) */
+static AsyncWebSocketSharedBuffer poolStream[SRV_STREAM_POOL_LEN];
 
 static CallbackOnWsConnect cbOnWsConnect = NULL;
 static CallbackOnWsDisconnect cbOnWsDisconnect = NULL;
 static CallbackOnSocketBinary cbOnSocketBinary = NULL;
 static CallbackOnSocketText cbOnSocketText = NULL;
+static CallbackOnWsStream cbOnWsStream = NULL;
 
 static String errLast = ""; 
 
@@ -87,6 +132,13 @@ static void srv_processTask(void* pvParameters);
 static void srv_handleNotFound(AsyncWebServerRequest *request);
 static void srv_handleWsEvents(AsyncWebSocket * server, AsyncWebSocketClient * client, AwsEventType type, void * arg, uint8_t *payload, size_t len);
 static void srv_onReboot(TimerHandle_t xTimer);
+static void srv_sendWsBinary(ws_binary_t * buf);
+static void srv_drainWsBinary(void);
+static void srv_drainWsText(void);
+static void srv_drainWsStream(void);
+static AsyncWebSocketSharedBuffer * srv_findFreeStreamBlock(void);
+static void srv_wakeProcessTask(void);
+static void srv_printStatus(cli_cmd_t command);
 
 #ifdef HTTP_UPDATE_ENABLE
 static void srv_setupHttpUpdate(void);
@@ -95,7 +147,7 @@ static void srv_printUpdateProgress(size_t progress, size_t size);
 
 /******************************************************************************
 * Function Name: SRV_initTask
-* Description  : WebT[o^XN
+* Description  : Webサーバタスク初期化
 * Arguments    : none
 * Return Value : true  -> initialization succeeded, 
                  false -> initialization failed
@@ -112,16 +164,31 @@ bool SRV_initTask(String hostName)
 	}
 
 	// send binary data to the client via WebSocket
-	xQueBinToClient = xQueueCreate(10, sizeof(que_ws_binary_t));
-	if (NULL == xQueBinToClient) {
+	// (the queues carry pointers to the buffers in the pool)
+	xQueBinToClient = xQueueCreate(SRV_QUE_BINARY_LEN, sizeof(ws_binary_t *));
+	xQueBinFree = xQueueCreate(SRV_QUE_BINARY_LEN, sizeof(ws_binary_t *));
+	if ((NULL == xQueBinToClient) || (NULL == xQueBinFree)) {
 		Serial.println(" [failure] Failed to create binary WebSocket queue.");
 		return false;
 	}
+	for (uint8_t i = 0; i < SRV_QUE_BINARY_LEN; i++) {
+		ws_binary_t * pBinary = &poolBinary[i];
+		xQueueSend(xQueBinFree, &pBinary, 0);
+	}
+
+	// stream blocks to the subscribers
+	for (uint8_t i = 0; i < SRV_STREAM_POOL_LEN; i++) {
+		if (NULL == poolStream[i]) {
+			poolStream[i] = std::make_shared<std::vector<uint8_t>>();
+			poolStream[i]->reserve(WS_LEN_STREAM_MAX);
+			stStats.shared_alloc++;
+		}
+	}
 
 	// send text data to the client via WebSocket
-	xQueTxtToClient = xQueueCreate(10, sizeof(que_ws_text_t));
-	if (NULL == xQueTxtToClient) {
-		Serial.println(" [failure] Failed to create text WebSocket queue.");
+	xMutexTxt = xSemaphoreCreateMutex();
+	if (NULL == xMutexTxt) {
+		Serial.println(" [failure] Failed to create text WebSocket mutex.");
 		return false;
 	}
 
@@ -144,6 +211,8 @@ bool SRV_initTask(String hostName)
 	server.addHandler(&events);
 
 	server.onNotFound(srv_handleNotFound);
+	ASSET_initCache();
+	CLI_addCommand("SRV", srv_printStatus);
 	//server.serveStatic("/", LittleFS, "/").setDefaultFile("index.html");
 
 #ifdef HTTP_UPDATE_ENABLE
@@ -178,136 +247,239 @@ bool SRV_initTask(String hostName)
 
 /******************************************************************************
 * Function Name: srv_processTask
-* Description  : WebT[o[^XN
+* Description  : Webサーバータスク
 * Arguments    : none
 * Return Value : none
 ******************************************************************************/
 void srv_processTask(void* pvParameters)
 {
-	que_ws_binary_t queBinary;
-	que_ws_text_t queText;
 	TickType_t tickSendPre = xTaskGetTickCount();
 
 	while(true) {
+		// block until a message is queued (or the cleanup interval elapses)
+		ulTaskNotifyTake(pdTRUE, SRV_CLEANUP_INTERVAL);
+
 		// send binary data to the client via WebSocket
-		if (pdPASS == xQueueReceive(xQueBinToClient, &queBinary, 0)) {
-			if (queBinary.len) {
-				if (queBinary.id) {
-					webSocket.binary(queBinary.id, &queBinary.data[0], queBinary.len);
-				} else {
-					webSocket.binaryAll(&queBinary.data[0], queBinary.len);
+		srv_drainWsBinary();
+
+		// send text data to the client via WebSocket
+		srv_drainWsText();
+
+		// send stream blocks to the subscribers
+		srv_drainWsStream();
+
+		if (SRV_CLEANUP_INTERVAL < (xTaskGetTickCount() - tickSendPre)) {
+			tickSendPre = xTaskGetTickCount();
+			webSocket.cleanupClients();
+		}
+	}
+}
+
+/******************************************************************************
+* Function Name: srv_drainWsBinary
+* Description  : キューにあるバイナリデータをすべて送信する
+* Arguments    : none
+* Return Value : none
+******************************************************************************/
+void srv_drainWsBinary(void)
+{
+	ws_binary_t * batch[SRV_QUE_BINARY_LEN];
+	uint8_t count = 0;
+
+	while ((SRV_QUE_BINARY_LEN > count) && (pdPASS == xQueueReceive(xQueBinToClient, &batch[count], 0))) {
+		count++;
+	}
+
+	if (stStats.binary_que_max < count) {
+		stStats.binary_que_max = count;
+	}
+
+	for (uint8_t i = 0; i < count; i++) {
+		bool superseded = false;
+
+		// only the newest message with the same tag is sent
+		if (batch[i]->tag) {
+			for (uint8_t j = i + 1; j < count; j++) {
+				if ((batch[j]->tag == batch[i]->tag) && (batch[j]->id == batch[i]->id)) {
+					superseded = true;
+					break;
 				}
 			}
 		}
 
-		// send text data to the client via WebSocket
-		if (pdPASS == xQueueReceive(xQueTxtToClient, &queText, 0)) {
-			if (queText.data.length()) {
-				if (queText.id) {
-					webSocket.text(queText.id, queText.data.c_str());
-				} else {
-					webSocket.textAll(queText.data.c_str());
-				}
+		if (superseded) {
+			stStats.binary_coalesced++;
+		} else {
+			srv_sendWsBinary(batch[i]);
+		}
+		SRV_releaseWsBinary(batch[i]);
+	}
+}
+
+/******************************************************************************
+* Function Name: srv_drainWsText
+* Description  : キューにあるテキストデータをすべて送信する
+* Arguments    : none
+* Return Value : none
+******************************************************************************/
+void srv_drainWsText(void)
+{
+	uint32_t tail = ringTextTail.load(std::memory_order_relaxed);
+
+	while (ringTextHead.load(std::memory_order_acquire) != tail) {
+		ws_text_header_t * header = (ws_text_header_t *)&ringText[tail];
+
+		if ((SRV_TEXT_RING_SIZE - tail < sizeof(ws_text_header_t)) || (SRV_TEXT_WRAP == header->len)) {
+			// the record continues at the top of the ring
+			tail = 0;
+		} else {
+			// the library copies the text into its own buffer
+			const char * text = (const char *)(header + 1);
+			if (header->id) {
+				webSocket.text(header->id, text, header->len);
+			} else {
+				webSocket.textAll(text, header->len);
+			}
+			stStats.text_sent++;
+
+			tail += SRV_TEXT_RECORD_SIZE(header->len);
+			if (SRV_TEXT_RING_SIZE <= tail) {
+				tail = 0;
 			}
 		}
+		ringTextTail.store(tail, std::memory_order_release);
+	}
+}
 
-		if (SRV_CLEANUP_INTERVAL < (xTaskGetTickCount() - tickSendPre)) {
-			tickSendPre = xTaskGetTickCount();
-			webSocket.cleanupClients();
+/******************************************************************************
+* Function Name: srv_drainWsStream
+* Description  : 準備できたストリームのブロックを購読中のクライアントへ送信する
+* Arguments    : none
+* Return Value : none
+******************************************************************************/
+void srv_drainWsStream(void)
+{
+	size_t len;
+
+	if ((NULL == cbOnWsStream) || (0 == numStreamClient.load(std::memory_order_relaxed))) {
+		return;
+	}
+
+	while (true) {
+		// a single block of the pool is shared by all subscribers
+		AsyncWebSocketSharedBuffer * buffer = srv_findFreeStreamBlock();
+		if (NULL == buffer) {
+			// every block is still queued, the rest is sent once the clients catch up
+			stStats.stream_no_block++;
+			break;
+		}
+		std::vector<uint8_t> & block = **buffer;
+		block.resize(WS_LEN_STREAM_MAX);	// within the reserved capacity
+		len = cbOnWsStream(block.data(), block.size());
+		if (0 == len) {
+			break;
+		}
+		block.resize(len);
+		stStats.stream_packed++;
+
+		for (uint8_t i = 0; i < SRV_STREAM_CLIENT_MAX; i++) {
+			srv_stream_client_t * sub = &stStreamClient[i];
+			uint32_t id = sub->id.load(std::memory_order_relaxed);
+			AsyncWebSocketClient * client;
+
+			if (0 == id) {
+				continue;
+			}
+			client = webSocket.client(id);
+			if (NULL == client) {
+				SRV_subscribeWsStream(id, false);
+				continue;
+			}
+
+			// a slow client skips blocks instead of delaying the status frames
+			if (SRV_STREAM_QUEUE_MAX <= client->queueLen()) {
+				sub->dropped++;
+				stStats.stream_dropped++;
+			} else if (webSocket.binary(id, *buffer)) {
+				sub->sent++;
+				stStats.stream_sent++;
+			}
+		}
+	}
+}
+
+/******************************************************************************
+* Function Name: srv_findFreeStreamBlock
+* Description  : どのクライアントの送信キューからも参照されていないストリームのブロックを探す
+* Arguments    : none
+* Return Value : block of the pool,
+*              : NULL (every block is still queued)
+******************************************************************************/
+AsyncWebSocketSharedBuffer * srv_findFreeStreamBlock(void)
+{
+	for (uint8_t i = 0; i < SRV_STREAM_POOL_LEN; i++) {
+		if ((NULL != poolStream[i]) && (1 == poolStream[i].use_count())) {
+			// the last reference was released by the async_tcp task
+			std::atomic_thread_fence(std::memory_order_acquire);
+			return &poolStream[i];
 		}
+	}
+	return NULL;
+}
 
-		vTaskDelay(1);
+/******************************************************************************
+* Function Name: srv_wakeProcessTask
+* Description  : 送信データの追加をWebサーバタスクへ通知する
+* Arguments    : none
+* Return Value : none
+******************************************************************************/
+void srv_wakeProcessTask(void)
+{
+	if (NULL != hTaskServer) {
+		xTaskNotifyGive(hTaskServer);
 	}
 }
+/******************************************************************************
+* Function Name: srv_sendWsBinary
+* Description  : WebSocketのバイナリデータを送信する
+* Arguments    : buf - binary message buffer
+* Return Value : none
+******************************************************************************/
+void srv_sendWsBinary(ws_binary_t * buf)
+{
+	if ((0 == buf->len) || (0 == webSocket.count())) {
+		return;
+	}
+
+	// a single reference counted buffer is shared by all clients
+	AsyncWebSocketMessageBuffer * buffer = webSocket.makeBuffer(&buf->data[0], buf->len);
+	if (NULL == buffer) {
+		return;
+	}
+	stStats.shared_alloc++;
+	stStats.binary_sent++;
+
+	if (buf->id) {
+		webSocket.binary(buf->id, buffer);
+	} else {
+		webSocket.binaryAll(buffer);
+	}
+}
+
 /******************************************************************************
 * Function Name: srv_handleNotFound
-* Description  : WebSocketCxg
+* Description  : 静的ファイルの要求を処理する
 * Arguments    : request
 * Return Value : none
 ******************************************************************************/
 void srv_handleNotFound(AsyncWebServerRequest *request)
 {
-	String dataType = "text/plain";
 	String path = request->url();
 	if (path.endsWith("/")) {
 		path += "index.html";
 	}
 
-	if (path.endsWith(".src")) {
-		path = path.substring(0, path.lastIndexOf("."));
-	} else if (path.endsWith(".html")) {
-		dataType = "text/html";
-	} else if (path.endsWith(".css")) {
-		dataType = "text/css";
-	} else if (path.endsWith(".js")) {
-		dataType = "text/javascript";
-		//dataType = "application/javascript";
-	} else if (path.endsWith(".ttf")) {
-		dataType = "font/ttf";
-	} else if (path.endsWith(".woff")) {
-		dataType = "font/woff";
-	} else if (path.endsWith(".woff2")) {
-		dataType = "font/woff2";
-	} else if (path.endsWith(".png")) {
-		dataType = "image/png";
-	} else if (path.endsWith(".gif")) {
-		dataType = "image/gif";
-	} else if (path.endsWith(".jpg")) {
-		dataType = "image/jpeg";
-	} else if (path.endsWith(".ico")) {
-		dataType = "image/x-icon";
-	} else if (path.endsWith(".xml")) {
-		dataType = "text/xml";
-	} else if (path.endsWith(".pdf")) {
-		dataType = "application/pdf";
-	} else if (path.endsWith(".zip")) {
-		dataType = "application/zip";
-	} else if (path.endsWith(".gz")) {
-		dataType = "text/javascript";
-	}
-
-	if (request->hasArg("download")) {
-		dataType = "application/octet-stream";
-	}
-
-	if (LittleFS.exists(path)) {// || LittleFS.exists(pathWithGz)) {
-#if defined(TARGET_RP2040) || defined(TARGET_RP2350)
-		//bool gzipped = false;
-		//if (LittleFS.exists(pathWithGz)) {
-		//	gzipped = true;
-		//	path += ".gz";
-		//}
-		
-		//Serial.println(String("[WEBSERVER] opening file: ") + path);
-		File file = LittleFS.open(path, "r");
-		//String etag = String(file.size());
-		AsyncWebServerResponse *response = request->beginChunkedResponse(
-			dataType.c_str(), 
-			[file](uint8_t *buffer, size_t maxLen, size_t index) -> size_t {
-				maxLen = 1024;
-				auto localHandle = file;
-				//Serial.printf("[HTTP]  [%6d] INDEX [%6d] BUFFER_MAX [%6d] NAME [%s]\n", index, localHandle.size(), maxLen, localHandle.name());
-				size_t len = localHandle.read(buffer, maxLen);
-				//Serial.printf(">> Succcessful read of %d\n", len);
-				if (len == 0)
-				{
-					//Serial.printf("Closing [%d]\n", file);
-					localHandle.close();
-				}
-				return len;
-			}
-		);
-
-		//if (gzipped) {
-		//	response->addHeader(F("Content-Encoding"), F("gzip"));
-		//}
-		//response->addHeader(asyncsrv::T_ETag, etag);
-		request->send(response);
-#else
-		request->send(LittleFS, path, dataType);
-#endif
-
-	} else {
+	if (false == ASSET_sendFile(request, path)) {
 		String message = "File Not Detected\n\n";
 		message += "URI: ";
 		message += request->url();
@@ -328,7 +500,7 @@ void srv_handleNotFound(AsyncWebServerRequest *request)
 
 /******************************************************************************
 * Function Name: srv_handleWsEvents
-* Description  : WebSocketCxg
+* Description  : WebSocketイベント
 * Arguments    : none
 * Return Value : none
 ******************************************************************************/
@@ -347,6 +519,7 @@ void srv_handleWsEvents(AsyncWebSocket * server, AsyncWebSocketClient * client,
 		break;
 
 	case WS_EVT_DISCONNECT:
+		SRV_subscribeWsStream(client->id(), false);
 		if (NULL != cbOnWsDisconnect) {
 			cbOnWsDisconnect(client->id(), webSocket.count());
 		}
@@ -383,6 +556,7 @@ void srv_handleWsEvents(AsyncWebSocket * server, AsyncWebSocketClient * client,
 					}
 				}
 			} else if (info->opcode == WS_BINARY) {
+				SYS_LATENCY_START(SYS_LAT_WS_TO_DUTY);
 				if (NULL != cbOnSocketBinary) {
 					cbOnSocketBinary(&payload[0], info->len, client->id());
 				}
@@ -413,7 +587,7 @@ void srv_handleWsEvents(AsyncWebSocket * server, AsyncWebSocketClient * client,
 
 /******************************************************************************
 * Function Name: srv_onReboot
-* Description  : ^C}CxgɂċN
+* Description  : タイマイベントによる再起動処理
 * Arguments    : none
 * Return Value : none
 ******************************************************************************/
@@ -429,59 +603,273 @@ void srv_onReboot(TimerHandle_t xTimer)
 
 /******************************************************************************
 * Function Name: SRV_pushWsBinaryToQueue
-* Description  : WebSocket̃oCif[^𑗐ML[ɒǉ
+* Description  : WebSocketのバイナリデータを送信キューに追加する
 * Arguments    : data - bainary data,
                  len - data bytes (with checksum)
 * Return Value : none
 ******************************************************************************/
 void SRV_pushWsBinaryToQueue(uint8_t * data, uint8_t len, uint32_t id)
 {
-	que_ws_binary_t queBinary;
-
-	if (NULL == xQueBinToClient){
-		return;
-	}
-
 	if (0 < len) {
+		ws_binary_t * buf = SRV_allocWsBinary();
+		if (NULL == buf) {
+			return;
+		}
+
 		if (WS_LEN_BINARY_MAX < len) {
 			len = WS_LEN_BINARY_MAX;
 		}
-		queBinary.len = len;
-		queBinary.id = id;
+		buf->len = len;
+		buf->id = id;
+		memcpy(&buf->data[0], data, len);
 
-		for (uint8_t i = 0; i < len; i++) {
-			queBinary.data[i] = *(data + i);
-		}
-		xQueueSend(xQueBinToClient, &queBinary, SERVER_QUE_SEND_WAIT);
+		SRV_pushWsBinary(buf);
+	}
+}
+
+/******************************************************************************
+* Function Name: SRV_allocWsBinary
+* Description  : WebSocketのバイナリデータ用バッファを確保する
+* Arguments    : none
+* Return Value : binary message buffer, NULL -> no buffer is available
+******************************************************************************/
+ws_binary_t * SRV_allocWsBinary(void)
+{
+	ws_binary_t * buf = NULL;
+
+	if (NULL == xQueBinFree) {
+		return NULL;
+	}
+
+	if (pdPASS != xQueueReceive(xQueBinFree, &buf, 0)) {
+		stStats.binary_dropped++;
+		return NULL;
 	}
+
+	buf->id = 0;
+	buf->tag = 0;
+	buf->len = 0;
+	return buf;
+}
+
+/******************************************************************************
+* Function Name: SRV_releaseWsBinary
+* Description  : WebSocketのバイナリデータ用バッファを解放する
+* Arguments    : buf - binary message buffer
+* Return Value : none
+******************************************************************************/
+void SRV_releaseWsBinary(ws_binary_t * buf)
+{
+	if (NULL != buf) {
+		xQueueSend(xQueBinFree, &buf, 0);
+	}
+}
+
+/******************************************************************************
+* Function Name: SRV_pushWsBinary
+* Description  : 確保したバッファのバイナリデータを送信キューに追加する
+* Arguments    : buf - binary message buffer (len and id are set by the caller)
+* Return Value : none
+******************************************************************************/
+void SRV_pushWsBinary(ws_binary_t * buf)
+{
+	if (NULL == buf) {
+		return;
+	}
+
+	// the queue has room for every buffer in the pool
+	xQueueSend(xQueBinToClient, &buf, 0);
+	srv_wakeProcessTask();
 }
 
 /******************************************************************************
 * Function Name: SRV_pushWsTextToQueue
-* Description  : WebSocket̃oCif[^𑗐ML[ɒǉ
-* Arguments    : data - bainary data,
-                 len - data bytes (with checksum)
+* Description  : WebSocketのテキストデータを送信キューに追加する
+* Arguments    : data - text data
 * Return Value : none
 ******************************************************************************/
-void SRV_pushWsTextToQueue(String data, uint32_t id)
+void SRV_pushWsTextToQueue(const String & data, uint32_t id)
 {
-	que_ws_text_t queText;
+	SRV_pushWsTextToQueue(data.c_str(), data.length(), id);
+}
 
-	if (NULL == xQueTxtToClient){
+/******************************************************************************
+* Function Name: SRV_pushWsTextToQueue
+* Description  : WebSocketのテキストデータを送信リングバッファに追加する
+* Arguments    : data - text data, len - text length
+* Return Value : none
+******************************************************************************/
+void SRV_pushWsTextToQueue(const char * data, size_t len, uint32_t id)
+{
+	uint32_t size = SRV_TEXT_RECORD_SIZE(len);
+	uint32_t head, tail, pos;
+	bool stored = false;
+
+	if ((NULL == xMutexTxt) || (0 == len)) {
+		return;
+	}
+
+	// a record must not take more than half of the ring
+	if ((SRV_TEXT_RING_SIZE / 2) < size) {
+		stStats.text_dropped++;
+		return;
+	}
+
+	if (pdTRUE != xSemaphoreTake(xMutexTxt, SERVER_QUE_SEND_WAIT)) {
+		stStats.text_dropped++;
 		return;
 	}
 
-	if (0 < data.length()) {
-		queText.id = id;
-		queText.data = data;
+	head = ringTextHead.load(std::memory_order_relaxed);
+	tail = ringTextTail.load(std::memory_order_acquire);
+	pos = head;
+
+	// the write position must never catch up with the read position
+	if (head >= tail) {
+		if ((SRV_TEXT_RING_SIZE - head > size) || ((SRV_TEXT_RING_SIZE - head == size) && (0 != tail))) {
+			stored = true;
+		} else if (size < tail) {
+			// not enough room at the end, continue at the top of the ring
+			if (SRV_TEXT_RING_SIZE - head >= sizeof(ws_text_header_t)) {
+				((ws_text_header_t *)&ringText[head])->len = SRV_TEXT_WRAP;
+			}
+			pos = 0;
+			stored = true;
+		}
+	} else if (tail - head > size) {
+		stored = true;
+	}
+
+	if (stored) {
+		ws_text_header_t * header = (ws_text_header_t *)&ringText[pos];
+		header->id = id;
+		header->len = (uint16_t)len;
+		memcpy(header + 1, data, len);
 
-		xQueueSend(xQueTxtToClient, &queText, SERVER_QUE_SEND_WAIT);
+		pos += size;
+		if (SRV_TEXT_RING_SIZE <= pos) {
+			pos = 0;
+		}
+		ringTextHead.store(pos, std::memory_order_release);
+	} else {
+		stStats.text_dropped++;
+	}
+
+	xSemaphoreGive(xMutexTxt);
+
+	if (stored) {
+		srv_wakeProcessTask();
+	}
+}
+
+/******************************************************************************
+* Function Name: srv_printStatus
+* Description  : Webサーバ状態をコンソールに出力する
+* Arguments    : none
+* Return Value : none
+******************************************************************************/
+void srv_printStatus(cli_cmd_t command)
+{
+	srv_stats_t stats;
+	SRV_getStats(&stats);
+
+	command.out->printf("- WebSocket Clients : %u\n", webSocket.count());
+	command.out->printf("- Binary Buffers    : free %u / %u\n", uxQueueMessagesWaiting(xQueBinFree), SRV_QUE_BINARY_LEN);
+	command.out->printf("- Binary Messages   : sent %u, dropped %u, coalesced %u, max batch %u\n",
+		stats.binary_sent, stats.binary_dropped, stats.binary_coalesced, stats.binary_que_max);
+	command.out->printf("- Text Messages     : sent %u, dropped %u\n", stats.text_sent, stats.text_dropped);
+	command.out->printf("- Shared Allocation : %u\n", stats.shared_alloc);
+	command.out->printf("- Stream Blocks     : packed %u, sent %u, dropped %u, no block %u\n", stats.stream_packed, stats.stream_sent, stats.stream_dropped, stats.stream_no_block);
+	for (uint8_t i = 0; i < SRV_STREAM_CLIENT_MAX; i++) {
+		uint32_t id = stStreamClient[i].id.load(std::memory_order_relaxed);
+		if (id) {
+			command.out->printf("- Stream Client %u   : sent %u, dropped %u\n", id, stStreamClient[i].sent, stStreamClient[i].dropped);
+		}
+	}
+}
+
+/******************************************************************************
+* Function Name: SRV_subscribeWsStream
+* Description  : クライアントのストリーム購読を開始／終了する
+* Arguments    : id - websocket client id, enable - true -> subscribe
+* Return Value : true -> subscribed (enable), unsubscribed (!enable)
+******************************************************************************/
+bool SRV_subscribeWsStream(uint32_t id, bool enable)
+{
+	uint32_t expected;
+
+	if (0 == id) {
+		return false;
+	}
+
+	for (uint8_t i = 0; i < SRV_STREAM_CLIENT_MAX; i++) {
+		if (id == stStreamClient[i].id.load()) {
+			if (enable) {
+				return true;
+			}
+			expected = id;
+			if (stStreamClient[i].id.compare_exchange_strong(expected, 0)) {
+				numStreamClient.fetch_sub(1);
+			}
+			return true;
+		}
+	}
+
+	if (false == enable) {
+		return false;
+	}
+
+	for (uint8_t i = 0; i < SRV_STREAM_CLIENT_MAX; i++) {
+		expected = 0;
+		if (stStreamClient[i].id.compare_exchange_strong(expected, id)) {
+			stStreamClient[i].sent = 0;
+			stStreamClient[i].dropped = 0;
+			numStreamClient.fetch_add(1);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/******************************************************************************
+* Function Name: SRV_countWsStreamClients
+* Description  : ストリームを購読中のクライアント数を取得する
+* Arguments    : none
+* Return Value : number of subscribers
+******************************************************************************/
+size_t SRV_countWsStreamClients(void)
+{
+	return numStreamClient.load(std::memory_order_relaxed);
+}
+
+/******************************************************************************
+* Function Name: SRV_wakeWsStream
+* Description  : ストリームのブロックが準備できたことを通知する
+* Arguments    : none
+* Return Value : none
+******************************************************************************/
+void SRV_wakeWsStream(void)
+{
+	srv_wakeProcessTask();
+}
+
+/******************************************************************************
+* Function Name: SRV_getStats
+* Description  : WebSocket送信の統計情報を取得する
+* Arguments    : stats - destination of the counters
+* Return Value : none
+******************************************************************************/
+void SRV_getStats(srv_stats_t * stats)
+{
+	if (NULL != stats) {
+		*stats = stStats;
 	}
 }
 
 /******************************************************************************
 * Function Name: SRV_attachWsConnectListener
-* Description  : WebSocket̃NCAgڑꂽ̃R[obN֐ݒ
+* Description  : WebSocketのクライアントが接続された時のコールバック関数を設定
 * Arguments    : callback - function pointer
 * Return Value : none
 ******************************************************************************/
@@ -492,7 +880,7 @@ void SRV_attachWsConnectListener(CallbackOnWsConnect callback)
 
 /******************************************************************************
 * Function Name: SRV_attachWsDisconnectListener
-* Description  : WebSocket̃NCAgؒfꂽ̃R[obN֐ݒ
+* Description  : WebSocketのクライアントが切断された時のコールバック関数を設定
 * Arguments    : callback - function pointer
 * Return Value : none
 ******************************************************************************/
@@ -503,7 +891,7 @@ void SRV_attachWsDisconnectListener(CallbackOnWsDisconnect callback)
 
 /******************************************************************************
 * Function Name: SRV_attachWsBinaryListener
-* Description  : WebSocketioCif[^jM̃R[obN֐ݒ
+* Description  : WebSocket（バイナリデータ）受信時のコールバック関数を設定
 * Arguments    : callback - function pointer
 * Return Value : none
 ******************************************************************************/
@@ -514,7 +902,7 @@ void SRV_attachWsBinaryListener(CallbackOnSocketBinary callback)
 
 /******************************************************************************
 * Function Name: SRV_attachWsTextListener
-* Description  : WebSocketieLXgf[^jM̃R[obN֐ݒ
+* Description  : WebSocket（テキストデータ）受信時のコールバック関数を設定
 * Arguments    : callback - function pointer
 * Return Value : none
 ******************************************************************************/
@@ -523,10 +911,22 @@ void SRV_attachWsTextListener(CallbackOnSocketText callback)
 	cbOnSocketText = callback;
 }
 
+/******************************************************************************
+* Function Name: SRV_attachWsStreamSource
+* Description  : ストリームのブロックを作成するコールバック関数を設定
+*                (Webサーバタスクから呼び出される)
+* Arguments    : callback - function pointer
+* Return Value : none
+******************************************************************************/
+void SRV_attachWsStreamSource(CallbackOnWsStream callback)
+{
+	cbOnWsStream = callback;
+}
+
 #ifdef HTTP_UPDATE_ENABLE
 /******************************************************************************
 * Function Name: srv_setupHttpUpdate
-* Description  : HTTPiWebuEUjAbvf[g̏
+* Description  : HTTP（Webブラウザ）アップデートの初期化
 * Arguments    : none
 * Return Value : none
 ******************************************************************************/
@@ -588,6 +988,7 @@ void srv_setupHttpUpdate(void)
 #if defined(ESP32)
 			if (fileType == "filesystem") {
 				Serial.printf("update filesystem : %s\n", filename.c_str());
+				ASSET_clearCache();
 				update_size = LittleFS.totalBytes();
 				update_cmd = U_SPIFFS;
 			} else if (fileType == "firmware") {
@@ -644,7 +1045,7 @@ void srv_setupHttpUpdate(void)
 
 /******************************************************************************
 * Function Name: srv_printUpdateProgress
-* Description  : vOX\
+* Description  : プログレス表示
 * Arguments    : none
 * Return Value : none
 ******************************************************************************/
@@ -5,27 +5,62 @@
 // https://opensource.org/license/GPL-3.0
 // --------------------------------------------------------
 
-#ifndef __TASK_SERVER_H__	/* d`h~ */
+#ifndef __TASK_SERVER_H__	/* 二重定義防止 */
 
 #include <Arduino.h>
 
 #define WS_LEN_BINARY_MAX 64
+// maximum length of a stream block
+#define WS_LEN_STREAM_MAX 1024
+// maximum number of stream subscribers
+#define SRV_STREAM_CLIENT_MAX 4
+
+typedef struct {
+	uint32_t id;	// client id (0 -> all clients)
+	uint8_t tag;	// coalescing tag (0 -> never coalesced)
+	uint8_t len;	// data length
+	uint8_t data[WS_LEN_BINARY_MAX];	// binary data
+} ws_binary_t;
+
+typedef struct {
+	uint32_t binary_sent;		// binary messages sent
+	uint32_t binary_dropped;	// binary messages dropped (no buffer available)
+	uint32_t binary_coalesced;	// binary messages replaced by a newer one
+	uint32_t binary_que_max;	// maximum binary messages drained at once
+	uint32_t text_sent;			// text messages sent
+	uint32_t text_dropped;		// text messages dropped (queue full)
+	uint32_t shared_alloc;		// shared message buffers allocated
+	uint32_t stream_packed;		// stream blocks packed
+	uint32_t stream_sent;		// stream blocks sent (counted per client)
+	uint32_t stream_dropped;	// stream blocks skipped (client queue backed up)
+	uint32_t stream_no_block;	// stream blocks delayed (every pooled block still queued)
+} srv_stats_t;
 
 typedef void (*CallbackOnWsConnect)(uint32_t, size_t);
 typedef void (*CallbackOnWsDisconnect)(uint32_t, size_t);
 typedef void (*CallbackOnSocketBinary)(uint8_t *, size_t, uint32_t);
 typedef void (*CallbackOnSocketText)(String, uint32_t);
+typedef size_t (*CallbackOnWsStream)(uint8_t *, size_t);
 
 bool SRV_initTask(String hostName = "");
 
 void SRV_pushWsBinaryToQueue(uint8_t * data, uint8_t len, uint32_t id = 0);
-void SRV_pushWsTextToQueue(String data, uint32_t id = 0);
+ws_binary_t * SRV_allocWsBinary(void);
+void SRV_releaseWsBinary(ws_binary_t * buf);
+void SRV_pushWsBinary(ws_binary_t * buf);
+void SRV_getStats(srv_stats_t * stats);
+void SRV_pushWsTextToQueue(const String & data, uint32_t id = 0);
+void SRV_pushWsTextToQueue(const char * data, size_t len, uint32_t id = 0);
+bool SRV_subscribeWsStream(uint32_t id, bool enable);
+size_t SRV_countWsStreamClients(void);
+void SRV_wakeWsStream(void);
 
 void SRV_attachWsConnectListener(CallbackOnWsConnect callback);
 void SRV_attachWsDisconnectListener(CallbackOnWsDisconnect callback);
 void SRV_attachWsBinaryListener(CallbackOnSocketBinary callback);
 void SRV_attachWsTextListener(CallbackOnSocketText callback);
+void SRV_attachWsStreamSource(CallbackOnWsStream callback);
 
-#endif /* __TASK_SERVER_H__*/	/* d`h~ */
-#define __TASK_SERVER_H__	/* d`h~ */
+#endif /* __TASK_SERVER_H__*/	/* 二重定義防止 */
+#define __TASK_SERVER_H__	/* 二重定義防止 */
 
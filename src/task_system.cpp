@@ -6,6 +6,7 @@
 // --------------------------------------------------------
 
 #include "task_system.h"
+#include "srv_asset.h"
 
 #if defined(TARGET_RP2040) || defined(TARGET_RP2350)
 #include <FreeRTOS.h>
@@ -27,6 +28,8 @@
 #define WIFI_STA_SETUP_INTERVAL 500 // [msec]
 #define WIFI_STA_SETUP_TIMEOUT 20000 // [msec]
 #define WIFI_STA_TIMEOUT_COUNT (WIFI_STA_SETUP_TIMEOUT / WIFI_STA_SETUP_INTERVAL)
+#define SYS_PROCESS_INTERVAL 1 // [msec]
+static_assert(0 < pdMS_TO_TICKS(SYS_PROCESS_INTERVAL), "SYS_PROCESS_INTERVAL must be one tick at least");
 
 static system_config_t cfgSystem = {
 	WIFI_STA,					// Wi-Fi mode
@@ -49,7 +52,7 @@ static void sys_onWiFiEvent(SYS_WIFI_EVENT_PARAM param);
 
 /******************************************************************************
 * Function Name: SYS_initTask
-* Description  : VXeɊւ鏈̏
+* Description  : システムに関する処理の初期化
 * Arguments    : cfg - system configration
 * Return Value : true  -> initialization succeeded, 
                  false -> initialization failed
@@ -61,8 +64,13 @@ bool SYS_initTask(system_config_t* cfg)
 	// ----- Fili System initialize -----
 	Serial.println(" File System starting ...");
 	if (false == LittleFS.begin()) {
+#ifdef SRV_EMBEDDED_ASSETS
+		// the web UI is served from the firmware image
+		Serial.println("  [warning] Failed to initialize file system.");
+#else
 		Serial.println("  [failure] Failed to initialize file system.");
 		return false;
+#endif
 	}
 
 	// ----- Wi-Fi initialize -----
@@ -95,7 +103,7 @@ bool SYS_initTask(system_config_t* cfg)
 		if (WL_CONNECTED == WiFi.status()) {
 			Serial.println("  disconect");
 			WiFi.disconnect(true);
-			vTaskDelay(100);
+			vTaskDelay(pdMS_TO_TICKS(100));
 		}
 
 		WiFi.mode(WIFI_STA);
@@ -117,7 +125,7 @@ bool SYS_initTask(system_config_t* cfg)
 			Serial.printf("   ssid = %s, password = %s\n", cfgSystem.wifiSsid, cfgSystem.wifiPass);
 			while (WiFi.status() != WL_CONNECTED) {
 				Serial.println("  [info] Please update the Wi-Fi credential.");
-				vTaskDelay(10000);
+				vTaskDelay(pdMS_TO_TICKS(10000));
 			}
 			return false;
 		}
@@ -130,7 +138,7 @@ bool SYS_initTask(system_config_t* cfg)
 				return false;
 			}
 
-			vTaskDelay(WIFI_STA_SETUP_INTERVAL);
+			vTaskDelay(pdMS_TO_TICKS(WIFI_STA_SETUP_INTERVAL));
 			sys_updateWifiStatus();
 			timeout_cnt++;
 		}
@@ -166,7 +174,7 @@ bool SYS_initTask(system_config_t* cfg)
 			return false;
 		}
 
-		vTaskDelay(100);
+		vTaskDelay(pdMS_TO_TICKS(100));
 		if (false == WiFi.softAPConfig(cfgSystem.ipLocal, cfgSystem.ipGateway, cfgSystem.ipSubnet)) {
 			Serial.println(" [failure] AP failed to configure. Please check the TCP/IP configuration.");
 			sys_updateWifiStatus();
@@ -188,6 +196,7 @@ bool SYS_initTask(system_config_t* cfg)
 			}
 
 			// NOTE: if updating file system this would be the place to unmount file system using end()
+			ASSET_clearCache();
 			LittleFS.end();
 
 			Serial.println("Start updating " + type);
@@ -229,7 +238,7 @@ bool SYS_initTask(system_config_t* cfg)
 
 /******************************************************************************
 * Function Name: sys_processTask
-* Description  : VXeɊւ鏈
+* Description  : システムに関する処理
 * Arguments    : none
 * Return Value : none
 ******************************************************************************/
@@ -242,13 +251,13 @@ void sys_processTask(void* pvParameters)
 
 		sys_updateWifiStatus();
 
-		vTaskDelay(1);
+		vTaskDelay(pdMS_TO_TICKS(SYS_PROCESS_INTERVAL));
 	}
 }
 
 /******************************************************************************
 * Function Name: sys_updateWifiStatus
-* Description  : Wi-FĩCxg
+* Description  : Wi-Fiのイベント処理
 * Arguments    : none
 * Return Value : none
 ******************************************************************************/
@@ -269,7 +278,7 @@ void sys_updateWifiStatus(void)
 
 /******************************************************************************
 * Function Name: sys_onWiFiEvent
-* Description  : Wi-FĩCxg
+* Description  : Wi-Fiのイベント処理
 * Arguments    : event
 * Return Value : none
 ******************************************************************************/
@@ -382,7 +391,7 @@ void sys_onWiFiEvent(SYS_WIFI_EVENT_PARAM param)
 
 /******************************************************************************
 * Function Name: SYS_attachWiFiEventListener
-* Description  : WebSocketioCif[^jM̃R[obN֐ݒ
+* Description  : WebSocket（バイナリデータ）受信時のコールバック関数を設定
 * Arguments    : callback - function pointer
 * Return Value : none
 ******************************************************************************/
@@ -393,7 +402,7 @@ void SYS_attachWiFiEventListener(CallbackWifiEvent callback)
 
 /******************************************************************************
 * Function Name: SYS_isWiFiAvailable
-* Description  : WebSocketioCif[^jM̃R[obN֐ݒ
+* Description  : WebSocket（バイナリデータ）受信時のコールバック関数を設定
 * Arguments    : callback - function pointer
 * Return Value : none
 ******************************************************************************/
@@ -5,7 +5,7 @@
 // https://opensource.org/license/GPL-3.0
 // --------------------------------------------------------
 
-#ifndef __TASK_SYSTEM_H__	/* d`h~ */
+#ifndef __TASK_SYSTEM_H__	/* 二重定義防止 */
 
 #include <Arduino.h>
 #include <WiFi.h>
@@ -31,6 +31,6 @@ bool SYS_initTask(system_config_t* cfg = nullptr);
 void SYS_attachWiFiEventListener(CallbackWifiEvent callback);
 bool SYS_isWiFiAvailable(void);
 
-#endif /* __TASK_SYSTEM_H__*/	/* d`h~ */
-#define __TASK_SYSTEM_H__	/* d`h~ */
+#endif /* __TASK_SYSTEM_H__*/	/* 二重定義防止 */
+#define __TASK_SYSTEM_H__	/* 二重定義防止 */
 
@@ -0,0 +1,188 @@
+// --------------------------------------------------------
+// Copyright (c) 2025 rapid4mifu 
+//
+// These codes are licensed under GPL v3.0
+// https://opensource.org/license/GPL-3.0
+// --------------------------------------------------------
+
+// This software module is related to the benchmark harness of the host build
+
+#include "bench.h"
+
+#include <algorithm>
+#include <deque>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <sim.h>
+
+// number of operations of a run is limited to this
+#define BENCH_MAX_ITERATIONS (1000000000ULL)
+
+typedef struct {
+	uint64_t real;			// [ns]
+	uint64_t cpu;			// [ns] (thread of the caller)
+	uint64_t allocs;
+} bench_clock_t;
+
+static std::deque<bench_result_t> results;
+
+// the clock of the current run (stopped while paused)
+static bench_clock_t clockStart;
+static bench_clock_t clockTotal;
+static bool clockRunning = false;
+
+static void bench_readClock(bench_clock_t * clock);
+static void bench_writeString(FILE * file, const std::string & text);
+
+void bench_readClock(bench_clock_t * clock)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	clock->real = (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+	clock->cpu = (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+	clock->allocs = SIM_getAllocCount();
+}
+
+void bench_writeString(FILE * file, const std::string & text)
+{
+	fputc('"', file);
+	for (char c : text) {
+		if (('"' == c) || ('\\' == c)) {
+			fputc('\\', file);
+		}
+		fputc(c, file);
+	}
+	fputc('"', file);
+}
+
+bench_result_t * BENCH_run(const char * name, std::function<void(uint64_t)> body)
+{
+	uint64_t iterations = 1;
+
+	// the operations grow tenfold until the run is long enough
+	while (true) {
+		clockTotal = {};
+		clockRunning = false;
+		BENCH_resumeTiming();
+		body(iterations);
+		BENCH_pauseTiming();
+
+		if ((BENCH_MIN_TIME <= clockTotal.real) || (BENCH_MAX_ITERATIONS <= iterations)) {
+			break;
+		}
+		iterations = (0 == clockTotal.real) ? (iterations * 10)
+			: iterations * std::min<uint64_t>(10, 1 + BENCH_MIN_TIME * 14 / 10 / clockTotal.real);
+	}
+
+	results.push_back({ name, iterations, (double)clockTotal.real / iterations, (double)clockTotal.cpu / iterations,
+		(double)clockTotal.allocs / iterations, {} });
+	return &results.back();
+}
+
+bench_result_t * BENCH_record(const char * name, uint64_t iterations, uint64_t ns, uint64_t allocs)
+{
+	if (0 == iterations) {
+		iterations = 1;
+	}
+	results.push_back({ name, iterations, (double)ns / iterations, (double)ns / iterations,
+		(double)allocs / iterations, {} });
+	return &results.back();
+}
+
+void BENCH_pauseTiming(void)
+{
+	bench_clock_t now;
+
+	if (!clockRunning) {
+		return;
+	}
+	bench_readClock(&now);
+	clockTotal.real += now.real - clockStart.real;
+	clockTotal.cpu += now.cpu - clockStart.cpu;
+	clockTotal.allocs += now.allocs - clockStart.allocs;
+	clockRunning = false;
+}
+
+void BENCH_resumeTiming(void)
+{
+	if (clockRunning) {
+		return;
+	}
+	bench_readClock(&clockStart);
+	clockRunning = true;
+}
+
+void BENCH_setCounter(bench_result_t * result, const char * name, double value)
+{
+	for (auto & counter : result->counters) {
+		if (counter.first == name) {
+			counter.second = value;
+			return;
+		}
+	}
+	result->counters.push_back({ name, value });
+}
+
+// one line per benchmark as the console reporter of Google Benchmark
+void BENCH_print(const bench_result_t * result)
+{
+	printf("%-44s %12.1f ns %12.1f ns %12llu  allocs/op=%.2f", result->name.c_str(), result->real_time,
+		result->cpu_time, (unsigned long long)result->iterations, result->allocs);
+	for (const auto & counter : result->counters) {
+		printf(" %s=%.6g", counter.first.c_str(), counter.second);
+	}
+	printf("\n");
+}
+
+bool BENCH_writeJson(void)
+{
+	const char * path = getenv("BENCH_OUT");
+	char date[32];
+	time_t now = time(NULL);
+	FILE * file;
+
+	if (NULL == path) {
+		path = BENCH_OUT_FILE;
+	}
+	file = fopen(path, "w");
+	if (NULL == file) {
+		return false;
+	}
+	strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S%z", localtime(&now));
+
+	fprintf(file, "{\n  \"context\": {\n");
+	fprintf(file, "    \"date\": \"%s\",\n", date);
+	fprintf(file, "    \"executable\": \"test_bench\",\n");
+	fprintf(file, "    \"num_cpus\": %ld,\n", sysconf(_SC_NPROCESSORS_ONLN));
+	fprintf(file, "    \"library_build_type\": \"release\"\n");
+	fprintf(file, "  },\n  \"benchmarks\": [\n");
+	for (size_t i = 0; i < results.size(); i++) {
+		const bench_result_t & result = results[i];
+
+		fprintf(file, "    {\n      \"name\": ");
+		bench_writeString(file, result.name);
+		fprintf(file, ",\n      \"run_name\": ");
+		bench_writeString(file, result.name);
+		fprintf(file, ",\n      \"run_type\": \"iteration\",\n");
+		fprintf(file, "      \"repetitions\": 1,\n      \"repetition_index\": 0,\n      \"threads\": 1,\n");
+		fprintf(file, "      \"iterations\": %llu,\n", (unsigned long long)result.iterations);
+		fprintf(file, "      \"real_time\": %.3f,\n", result.real_time);
+		fprintf(file, "      \"cpu_time\": %.3f,\n", result.cpu_time);
+		fprintf(file, "      \"time_unit\": \"ns\",\n");
+		fprintf(file, "      \"allocs_per_op\": %.3f", result.allocs);
+		for (const auto & counter : result.counters) {
+			fprintf(file, ",\n      ");
+			bench_writeString(file, counter.first);
+			fprintf(file, ": %.6g", counter.second);
+		}
+		fprintf(file, "\n    }%s\n", (i + 1 < results.size()) ? "," : "");
+	}
+	fprintf(file, "  ]\n}\n");
+
+	return 0 == fclose(file);
+}
@@ -0,0 +1,57 @@
+// --------------------------------------------------------
+// Copyright (c) 2025 rapid4mifu 
+//
+// These codes are licensed under GPL v3.0
+// https://opensource.org/license/GPL-3.0
+// --------------------------------------------------------
+
+// This header file is related to the benchmark harness of the host build
+//
+// the results are written in the JSON format of Google Benchmark
+// (compare.py and the other tools read it), one entry per benchmark with
+// the time per operation [ns] and the heap allocations per operation
+// (allocs_per_op), the extra figures of an entry are user counters
+//
+// - BENCH_run : calls the body with a growing number of operations until
+//               it runs for BENCH_MIN_TIME, the body may stop the clock
+//               while it prepares or drains (BENCH_pauseTiming / BENCH_resumeTiming)
+// - BENCH_record : adds a measurement made by the caller
+//                  (the host time of a task of the simulation, see sim.h)
+
+#ifndef __BENCH_H__	/* 二重定義防止 */
+
+#include <stdint.h>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+// minimum measuring time of BENCH_run [ns]
+#ifndef BENCH_MIN_TIME
+#define BENCH_MIN_TIME (100000000ULL)
+#endif
+
+// file of the results (overridden by the environment variable BENCH_OUT)
+#ifndef BENCH_OUT_FILE
+#define BENCH_OUT_FILE "test_bench.json"
+#endif
+
+typedef struct {
+	std::string name;
+	uint64_t iterations;
+	double real_time;		// per operation [ns]
+	double cpu_time;		// per operation [ns]
+	double allocs;			// heap allocations per operation
+	std::vector<std::pair<std::string, double>> counters;
+} bench_result_t;
+
+bench_result_t * BENCH_run(const char * name, std::function<void(uint64_t)> body);
+bench_result_t * BENCH_record(const char * name, uint64_t iterations, uint64_t ns, uint64_t allocs);
+void BENCH_pauseTiming(void);
+void BENCH_resumeTiming(void);
+void BENCH_setCounter(bench_result_t * result, const char * name, double value);
+void BENCH_print(const bench_result_t * result);
+bool BENCH_writeJson(void);
+
+#endif /* __BENCH_H__*/	/* 二重定義防止 */
+#define __BENCH_H__	/* 二重定義防止 */
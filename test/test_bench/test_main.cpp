@@ -0,0 +1,1127 @@
+// --------------------------------------------------------
+// Copyright (c) 2025 rapid4mifu 
+//
+// These codes are licensed under GPL v3.0
+// https://opensource.org/license/GPL-3.0
+// --------------------------------------------------------
+
+// Benchmarks of the hot paths on the host (the figures are printed, not checked)
+//  pio test -e native -f test_bench -v
+//
+// the results are written to test_bench.json in the format of Google
+// Benchmark (see bench.h), the time and the heap allocations per operation
+//
+// the firmware is started on the host shim as main.cpp does, the functions
+// with a public entry are called here, the private ones (the parse of an
+// output command, the status frame, the button judge, the LED evaluation)
+// are measured as the host time of their task per operation on the
+// virtual clock (see test_tasks), the delivery of the shim is included
+
+#include <unity.h>
+#include <stdio.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+#include <sim.h>
+
+#include "bench.h"
+#include "board.h"
+#include "rmpp_alive.h"
+#include "rmpp_cmd.h"
+#include "rmpp_ramp.h"
+#include "rmpp_speed.h"
+#include "srv_asset.h"
+#include "srv_embedded.h"
+#include "sys_latency.h"
+#include "sys_perf.h"
+#include "task_adc.h"
+#include "task_cfg.h"
+#include "task_cli.h"
+#include "task_input.h"
+#include "task_led.h"
+#include "task_rmpp.h"
+#include "task_server.h"
+#include "task_system.h"
+
+#define BENCH_MS (1000ULL)			// [us]
+
+// number of simulated faults
+#define BENCH_FAULTS (200)
+
+// priority of the RMPP task when it polled the fault input every tick
+#define BENCH_PRIORITY_POLL 2
+
+// virtual time of a measurement of a task
+#define BENCH_TASK_TIME (10000 * BENCH_MS)
+
+// priority of the test (loopTask) and above the tasks of the firmware
+#define BENCH_PRIORITY_LOOP 1
+#define BENCH_PRIORITY_HIGH (configMAX_PRIORITIES - 1)
+
+// size of the binary message pool of the server (see task_server.cpp)
+#define BENCH_WS_BINARY_POOL 10
+
+typedef struct {
+	uint64_t ns;			// host time of the task [ns]
+	uint32_t wakeups;
+	uint64_t allocs;		// allocations of the program
+} bench_task_t;
+
+// commands per frame of the batched output commands
+#define BENCH_BATCH 8
+
+// lines of the reply of the console burst
+#define BENCH_BURST_LINES 100
+
+// full duty of the output (as the RMPP task)
+#define BENCH_DUTY_FULL (1 << PWM_RES)
+
+static uint32_t idClient;
+static cli_cmd_t cmdBench;
+static uint32_t cntBench;
+static uint32_t cntWalk;
+static std::vector<uint64_t> pollFound;
+
+static bool bench_boot(void);
+static void bench_sendOutput(uint32_t id, uint16_t duty, uint8_t dir);
+static uint64_t bench_getPercentile(std::vector<uint64_t> & samples, uint32_t percent);
+static void bench_readTask(const char * name, bench_task_t * task);
+static void bench_runTask(const char * name, uint64_t time, bench_task_t * task);
+static void bench_handleCommand(cli_cmd_t command);
+static void bench_handleWalk(uint8_t * cmd, uint8_t len, uint32_t id);
+static void bench_handleBurst(cli_cmd_t command);
+static size_t bench_makeOutputFrame(uint8_t * frame, uint32_t count, uint16_t duty);
+static void bench_sendStream(uint32_t id, bool enable);
+static void bench_pollFault(void * pvParameters);
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+/******************************************************************************
+* Function Name: bench_boot
+* Description  : main.cpp の setup と同じ順序でタスクを起動する
+* Arguments    : none
+* Return Value : true -> every module started
+******************************************************************************/
+bool bench_boot(void)
+{
+	RMPP_resetOutput();
+	Serial.begin(115200);
+
+	if ((false == CLI_initTask()) || (false == SYS_initPerf()) || (false == SYS_initLatency())
+	 || (false == RMPP_initTask()) || (false == ADC_initTask()) || (false == INP_initTask())
+	 || (false == LED_initTask(PIN_LED, LED_TYPE_RGB_SERIAL)) || (false == CFG_initTask())) {
+		return false;
+	}
+
+	system_config_t cfgSys;
+	cfgSys.wifiMode = WIFI_STA;
+	cfgSys.wifiSsid = "rmpp";
+	cfgSys.wifiPass = "password";
+	cfgSys.ipLocal = IPAddress(192, 168, 0, 10);
+	cfgSys.ipGateway = IPAddress(192, 168, 0, 1);
+	cfgSys.ipSubnet = IPAddress(255, 255, 255, 0);
+	SIM_setWiFiStatus(true);
+	if (false == SYS_initTask(&cfgSys)) {
+		return false;
+	}
+
+	return SYS_isWiFiAvailable() && SRV_initTask(CFG_getHostName());
+}
+
+/******************************************************************************
+* Function Name: bench_sendOutput
+* Description  : WR_OUTPUT コマンドを WebSocket で送信する
+* Arguments    : id - client id, duty - output duty, dir - 0x40 forward, 0x80 reverse, 0 stop
+* Return Value : none
+******************************************************************************/
+void bench_sendOutput(uint32_t id, uint16_t duty, uint8_t dir)
+{
+	uint8_t buf[RMPP_PACKET_LEN_MAX];
+	uint8_t * cmd = RMPP_PACKET_CMD(buf);
+
+	cmd[0] = RMPP_CMDID_WR_OUTPUT;
+	cmd[1] = duty & 0xFF;
+	cmd[2] = dir | ((duty >> 8) & 0x3F);
+	SIM_receiveWsBinary(id, buf, RMPP_encodePacket(buf, RMPP_CMD_LEN_WR_OUTPUT));
+}
+
+/******************************************************************************
+* Function Name: bench_getPercentile
+* Description  : 測定値のパーセンタイルを求める
+* Arguments    : samples - samples (sorted here), percent - 0 to 100
+* Return Value : percentile, 0 -> no samples
+******************************************************************************/
+uint64_t bench_getPercentile(std::vector<uint64_t> & samples, uint32_t percent)
+{
+	if (samples.empty()) {
+		return 0;
+	}
+	std::sort(samples.begin(), samples.end());
+	return samples[(samples.size() - 1) * percent / 100];
+}
+
+/******************************************************************************
+* Function Name: bench_readTask
+* Description  : タスクの実行時間と起床回数、プログラムのヒープ確保回数を読み出す
+* Arguments    : name - task name, task - figures
+* Return Value : none
+******************************************************************************/
+void bench_readTask(const char * name, bench_task_t * task)
+{
+	sim_task_stats_t stats = {};
+
+	SIM_getTaskStats(name, &stats);
+	task->ns = stats.run_ns;
+	task->wakeups = stats.wakeups;
+	task->allocs = SIM_getAllocCount();
+}
+
+/******************************************************************************
+* Function Name: bench_runTask
+* Description  : 指定時間シミュレーションを進め、その間のタスクの実行時間等を求める
+* Arguments    : name - task name, time - virtual time to run until [us],
+                 task - figures of the run
+* Return Value : none
+******************************************************************************/
+void bench_runTask(const char * name, uint64_t time, bench_task_t * task)
+{
+	bench_task_t begin;
+	bench_task_t end;
+
+	bench_readTask(name, &begin);
+	SIM_runUntil(time);
+	bench_readTask(name, &end);
+	task->ns = end.ns - begin.ns;
+	task->wakeups = end.wakeups - begin.wakeups;
+	task->allocs = end.allocs - begin.allocs;
+}
+
+/******************************************************************************
+* Function Name: bench_handleCommand
+* Description  : ベンチマーク用のコンソールコマンド（引数を保存する）
+* Arguments    : command
+* Return Value : none
+******************************************************************************/
+void bench_handleCommand(cli_cmd_t command)
+{
+	cmdBench = command;
+	cntBench++;
+}
+
+/******************************************************************************
+* Function Name: bench_handleWalk
+* Description  : フレーム分割のベンチマーク用のコマンド処理（数えるのみ）
+* Arguments    : cmd - command, len - command length, id - websocket client id
+* Return Value : none
+******************************************************************************/
+void bench_handleWalk(uint8_t * cmd, uint8_t len, uint32_t id)
+{
+	cntWalk += len;
+}
+
+/******************************************************************************
+* Function Name: bench_handleBurst
+* Description  : 長い応答のベンチマーク用のコンソールコマンド
+* Arguments    : command
+* Return Value : none
+******************************************************************************/
+void bench_handleBurst(cli_cmd_t command)
+{
+	for (uint32_t i = 0; i < BENCH_BURST_LINES; i++) {
+		command.out->printf("- Line %3u : %s\n", i, "0123456789abcdef0123456789");
+	}
+}
+
+/******************************************************************************
+* Function Name: bench_makeOutputFrame
+* Description  : WR_OUTPUT コマンドを指定数詰めたフレームを作成する
+* Arguments    : frame - frame (output), count - number of commands, duty - output duty
+* Return Value : frame length
+******************************************************************************/
+size_t bench_makeOutputFrame(uint8_t * frame, uint32_t count, uint16_t duty)
+{
+	size_t len = 0;
+
+	for (uint32_t i = 0; i < count; i++) {
+		uint8_t * cmd = RMPP_PACKET_CMD(&frame[len]);
+
+		cmd[0] = RMPP_CMDID_WR_OUTPUT;
+		cmd[1] = (duty + i) & 0xFF;
+		cmd[2] = 0x40 | (((duty + i) >> 8) & 0x3F);
+		len += RMPP_encodePacket(&frame[len], RMPP_CMD_LEN_WR_OUTPUT);
+	}
+	return len;
+}
+
+/******************************************************************************
+* Function Name: bench_sendStream
+* Description  : WR_STREAM コマンドを WebSocket で送信する
+* Arguments    : id - client id, enable - true -> subscribe
+* Return Value : none
+******************************************************************************/
+void bench_sendStream(uint32_t id, bool enable)
+{
+	uint8_t buf[RMPP_PACKET_LEN_MAX];
+	uint8_t * cmd = RMPP_PACKET_CMD(buf);
+
+	cmd[0] = RMPP_CMDID_WR_STREAM;
+	cmd[1] = 0;
+	cmd[2] = enable ? 1 : 0;
+	SIM_receiveWsBinary(id, buf, RMPP_encodePacket(buf, RMPP_GET_CMD_LEN(RMPP_CMDID_WR_STREAM)));
+}
+
+/******************************************************************************
+* Function Name: bench_pollFault
+* Description  : 毎ティック故障入力を読むタスク（イベント駆動前の RMPP タスクと同じ）
+*                (故障を見つけた時刻を記録する)
+* Arguments    : none
+* Return Value : none
+******************************************************************************/
+void bench_pollFault(void * pvParameters)
+{
+	bool during = false;
+
+	while (true) {
+		bool now = (FAULT_DURING == digitalRead(PIN_FAULT));
+
+		if (now && !during && (pollFound.size() < pollFound.capacity())) {
+			pollFound.push_back(SIM_getTime());
+		}
+		during = now;
+		vTaskDelay(1);
+	}
+}
+
+// the firmware starts as on the target (station mode)
+static void test_boot(void)
+{
+	TEST_ASSERT_TRUE(bench_boot());
+	CLI_addCommand("BENCH", bench_handleCommand);
+	CLI_addCommand("BURST", bench_handleBurst);
+	idClient = SIM_connectWs();
+	SIM_runFor(100 * BENCH_MS);
+}
+
+/* srv_embedded, srv_asset */
+
+// every embedded path is found in its own slot, an unknown one is not found
+static void test_bench_asset_lookup(void)
+{
+	static const char * path[64];
+	static size_t count = 0;
+	bench_result_t * result;
+
+	for (size_t i = 0; i < ASSET_getEmbeddedSize(); i++) {
+		const asset_embedded_t * asset = ASSET_getEmbedded(i);
+		if (NULL != asset) {
+			TEST_ASSERT_TRUE(asset == ASSET_findEmbedded(asset->path));
+			if (sizeof(path) / sizeof(path[0]) > count) {
+				path[count++] = asset->path;
+			}
+		}
+	}
+	TEST_ASSERT_TRUE(0 < count);
+	TEST_ASSERT_TRUE(NULL == ASSET_findEmbedded("/no/such/file.html"));
+
+	result = BENCH_run("ASSET_findEmbedded", [](uint64_t n) {
+		size_t found = 0;
+		for (uint64_t i = 0; i < n; i++) {
+			found += (NULL != ASSET_findEmbedded(path[i % count]));
+		}
+		TEST_ASSERT_EQUAL_UINT32(n, found);
+	});
+	BENCH_setCounter(result, "paths", count);
+	BENCH_setCounter(result, "slots", ASSET_getEmbeddedSize());
+	BENCH_print(result);
+}
+
+// the content type of the paths the web server serves, an unknown type is text
+static void test_bench_mime_type(void)
+{
+	static const String path[] = {
+		"/index.html", "/css/style.css", "/js/main.js", "/img/logo.png", "/favicon.ico",
+		"/img/icon.svg", "/manifest.json", "/data/readme.txt", "/no/extension"
+	};
+	const size_t count = sizeof(path) / sizeof(path[0]);
+
+	TEST_ASSERT_EQUAL_STRING("text/html", ASSET_getMimeType(path[0]));
+	TEST_ASSERT_EQUAL_STRING("text/css", ASSET_getMimeType(path[1]));
+
+	BENCH_print(BENCH_run("ASSET_getMimeType", [count](uint64_t n) {
+		size_t len = 0;
+		for (uint64_t i = 0; i < n; i++) {
+			len += strlen(ASSET_getMimeType(path[i % count]));
+		}
+		TEST_ASSERT_TRUE(0 < len);
+	}));
+}
+
+/* sys_latency */
+
+// the cost of an empty probe scope and of a start / stop pair,
+// every span is counted in the histogram
+static void test_bench_latency_probe(void)
+{
+	BENCH_print(BENCH_run("SYS_LATENCY_SCOPE", [](uint64_t n) {
+		sys_latency_stats_t stats;
+
+		// (the probes were initialised on the boot)
+		BENCH_pauseTiming();
+		SYS_clearLatency();
+		BENCH_resumeTiming();
+		for (uint64_t i = 0; i < n; i++) {
+			SYS_LATENCY_SCOPE(SYS_LAT_WS_TO_DUTY);
+		}
+		BENCH_pauseTiming();
+		SYS_getLatencyStats(SYS_LAT_WS_TO_DUTY, &stats);
+		TEST_ASSERT_EQUAL_UINT32(n, stats.count);
+	}));
+
+	BENCH_print(BENCH_run("SYS_LATENCY_START_STOP", [](uint64_t n) {
+		sys_latency_stats_t stats;
+
+		BENCH_pauseTiming();
+		SYS_clearLatency();
+		BENCH_resumeTiming();
+		for (uint64_t i = 0; i < n; i++) {
+			SYS_LATENCY_START(SYS_LAT_FAULT_TO_TASK);
+			SYS_LATENCY_STOP(SYS_LAT_FAULT_TO_TASK);
+		}
+		BENCH_pauseTiming();
+		SYS_getLatencyStats(SYS_LAT_FAULT_TO_TASK, &stats);
+		TEST_ASSERT_EQUAL_UINT32(n, stats.count + stats.expired);
+	}));
+	SYS_clearLatency();
+}
+
+/* task_cli */
+
+// a command line is split into its words and handed to the handler
+// (the reply ">" is written to the serial port, it is taken while paused)
+static void test_bench_cli_parse(void)
+{
+	static const String line("BENCH 12 speed on");
+
+	cntBench = 0;
+	CLI_processCommand(line, 0);
+	TEST_ASSERT_EQUAL_UINT32(1, cntBench);
+	TEST_ASSERT_EQUAL_STRING("12", cmdBench.command2);
+	TEST_ASSERT_EQUAL_STRING("speed", cmdBench.command3);
+	TEST_ASSERT_EQUAL_STRING("on", cmdBench.command4);
+
+	BENCH_print(BENCH_run("cli_parseCommand", [](uint64_t n) {
+		cntBench = 0;
+		for (uint64_t i = 0; i < n; i++) {
+			CLI_processCommand(line, 0);
+			if (0 == (i & 0xFFF)) {
+				BENCH_pauseTiming();
+				SIM_readSerial();
+				BENCH_resumeTiming();
+			}
+		}
+		BENCH_pauseTiming();
+		SIM_readSerial();
+		TEST_ASSERT_EQUAL_UINT32(n, cntBench);
+	}));
+}
+
+/* task_server */
+
+// a status packet is copied into a message of the pool and queued,
+// the server task sends the messages while the clock is paused
+// (the test runs over the server task while it pushes)
+static void test_bench_ws_push_binary(void)
+{
+	BENCH_print(BENCH_run("SRV_pushWsBinaryToQueue", [](uint64_t n) {
+		uint8_t packet[8] = { 0x02, 0x21, 0x12, 0x34, 0x56, 0x78, 0x9A, 0x00 };
+
+		for (uint64_t i = 0; i < n; i += BENCH_WS_BINARY_POOL) {
+			BENCH_pauseTiming();
+			vTaskPrioritySet(NULL, BENCH_PRIORITY_HIGH);
+			BENCH_resumeTiming();
+			for (uint64_t j = i; (j < n) && (j < i + BENCH_WS_BINARY_POOL); j++) {
+				SRV_pushWsBinaryToQueue(packet, sizeof(packet), idClient);
+			}
+			BENCH_pauseTiming();
+			vTaskPrioritySet(NULL, BENCH_PRIORITY_LOOP);
+			SIM_runFor(BENCH_MS);
+			BENCH_resumeTiming();
+		}
+	}));
+}
+
+// a text line is copied into the ring and the server task is woken
+static void test_bench_ws_push_text(void)
+{
+	BENCH_print(BENCH_run("SRV_pushWsTextToQueue", [](uint64_t n) {
+		static const char text[] = "[info] output 0 on !";
+
+		for (uint64_t i = 0; i < n; i += 16) {
+			BENCH_pauseTiming();
+			vTaskPrioritySet(NULL, BENCH_PRIORITY_HIGH);
+			BENCH_resumeTiming();
+			for (uint64_t j = i; (j < n) && (j < i + 16); j++) {
+				SRV_pushWsTextToQueue(text, sizeof(text) - 1, idClient);
+			}
+			BENCH_pauseTiming();
+			vTaskPrioritySet(NULL, BENCH_PRIORITY_LOOP);
+			SIM_runFor(BENCH_MS);
+			BENCH_resumeTiming();
+		}
+	}));
+}
+
+// a message for all clients is wrapped once in a shared buffer whatever
+// the number of clients, the allocations per broadcast are those of the
+// program while the server task drains (the status frames of the RMPP
+// task are broadcasts as well and counted with them), against a socket of
+// the test that copies the message for each client (binaryAll of a
+// pointer, as the server task sent before)
+static void test_bench_ws_broadcast(void)
+{
+	static const uint32_t clients[] = { 1, 4, 16 };
+	uint8_t packet[8] = { 0x02, 0x21, 0x12, 0x34, 0x56, 0x78, 0x9A, 0x00 };
+	std::vector<uint32_t> ids;
+	AsyncWebSocket socketCopy("/bench");
+	size_t numCopy = 0;
+	double allocsFirst = 0;
+
+	for (uint32_t num : clients) {
+		char name[48];
+		bench_result_t * result;
+		srv_stats_t begin;
+		srv_stats_t end;
+		bench_task_t taskBegin;
+		bench_task_t taskEnd;
+		uint32_t sent;
+		uint64_t allocs;
+		uint64_t allocsCopy;
+
+		while (ids.size() + 1 < num) {
+			ids.push_back(SIM_connectWs());
+		}
+		SIM_runFor(10 * BENCH_MS);
+
+		while (numCopy < num) {
+			socketCopy.connect(8);
+			numCopy++;
+		}
+		allocsCopy = SIM_getAllocCount();
+		socketCopy.binaryAll(packet, sizeof(packet));
+		allocsCopy = SIM_getAllocCount() - allocsCopy;
+
+		SRV_getStats(&begin);
+		bench_readTask("srv_task", &taskBegin);
+		for (uint32_t i = 0; i < 100; i++) {
+			vTaskPrioritySet(NULL, BENCH_PRIORITY_HIGH);
+			for (uint32_t j = 0; j < BENCH_WS_BINARY_POOL - 2; j++) {
+				SRV_pushWsBinaryToQueue(packet, sizeof(packet));
+			}
+			vTaskPrioritySet(NULL, BENCH_PRIORITY_LOOP);
+			SIM_runFor(BENCH_MS);
+		}
+		bench_readTask("srv_task", &taskEnd);
+		SRV_getStats(&end);
+
+		sent = end.binary_sent - begin.binary_sent;
+		allocs = taskEnd.allocs - taskBegin.allocs;
+		TEST_ASSERT_TRUE(100 * (BENCH_WS_BINARY_POOL - 2) <= sent);
+		TEST_ASSERT_EQUAL_UINT32(0, end.binary_dropped - begin.binary_dropped);
+		// one shared buffer per message, not one per client
+		TEST_ASSERT_EQUAL_UINT32(sent, end.shared_alloc - begin.shared_alloc);
+
+		snprintf(name, sizeof(name), "srv_sendWsBinary/clients:%u", num);
+		result = BENCH_record(name, sent, taskEnd.ns - taskBegin.ns, allocs);
+		BENCH_setCounter(result, "shared_buffers_per_op", (double)(end.shared_alloc - begin.shared_alloc) / sent);
+		BENCH_setCounter(result, "copy_allocs_per_op", (double)allocsCopy);
+		BENCH_print(result);
+		TEST_ASSERT_EQUAL_UINT32(2 * num, allocsCopy);
+
+		if (1 == num) {
+			allocsFirst = result->allocs;
+		}
+		TEST_ASSERT_TRUE(allocsFirst + 0.05 > result->allocs);
+	}
+
+	for (uint32_t id : ids) {
+		SIM_disconnectWs(id);
+	}
+	SIM_runFor(10 * BENCH_MS);
+}
+
+// a console command of a client answers 100 lines, each one is queued in
+// the text ring and drained by the server task, the time is from the
+// command to the last line sent, the host time is the one of the console
+// and the server tasks
+static void test_bench_ws_cli_burst(void)
+{
+	uint64_t t0 = SIM_getTime();
+	std::vector<sim_tl_event_t> timeline;
+	bench_task_t cliBegin;
+	bench_task_t cliEnd;
+	bench_task_t srvBegin;
+	bench_task_t srvEnd;
+	srv_stats_t begin;
+	srv_stats_t end;
+	bench_result_t * result;
+	uint64_t tLast = 0;
+	uint32_t lines = 0;
+
+	SRV_getStats(&begin);
+	bench_readTask("cli_task", &cliBegin);
+	bench_readTask("srv_task", &srvBegin);
+	SIM_recordTimeline(true);
+	SIM_receiveWsText(idClient, "BURST");
+	SIM_runUntil(t0 + 100 * BENCH_MS);
+	timeline = SIM_takeTimeline();
+	SIM_recordTimeline(false);
+	bench_readTask("cli_task", &cliEnd);
+	bench_readTask("srv_task", &srvEnd);
+	SRV_getStats(&end);
+
+	for (const sim_tl_event_t & event : timeline) {
+		if ((SIM_TL_WS_TX == event.kind) && (0 == event.value) && (idClient == event.source)) {
+			lines++;
+			tLast = event.time;
+		}
+	}
+	// the lines and the prompt
+	TEST_ASSERT_EQUAL_UINT32(BENCH_BURST_LINES + 1, lines);
+	TEST_ASSERT_EQUAL_UINT32(BENCH_BURST_LINES + 1, end.text_sent - begin.text_sent);
+	TEST_ASSERT_EQUAL_UINT32(0, end.text_dropped - begin.text_dropped);
+
+	result = BENCH_record("CLI_processCommand/ws_burst", lines,
+		(cliEnd.ns - cliBegin.ns) + (srvEnd.ns - srvBegin.ns), cliEnd.allocs - cliBegin.allocs);
+	BENCH_setCounter(result, "virtual_drain_us", (double)(tLast - t0));
+	BENCH_setCounter(result, "srv_wakeups", srvEnd.wakeups - srvBegin.wakeups);
+	BENCH_setCounter(result, "srv_ns_per_line", (double)(srvEnd.ns - srvBegin.ns) / lines);
+	BENCH_print(result);
+	TEST_ASSERT_TRUE(2 * 1000000 / configTICK_RATE_HZ >= tLast - t0);
+}
+
+/* task_input */
+
+// the button is sampled at INPUT_SAMPLE_PERIOD and judged on each sample,
+// short presses with bounces are scripted (each one stops the output)
+static void test_bench_input_judge(void)
+{
+	uint64_t t0 = SIM_getTime();
+	bench_task_t task;
+	bench_result_t * result;
+
+	for (uint64_t t = 500 * BENCH_MS; t < BENCH_TASK_TIME; t += 1000 * BENCH_MS) {
+		SIM_pressPin(t0 + t, PIN_SW, SW_PRESS, 100 * BENCH_MS, 3);
+	}
+	bench_runTask("btn_task", t0 + BENCH_TASK_TIME, &task);
+	TEST_ASSERT_TRUE(0 < task.wakeups);
+
+	// (the switch judge is not called on this board, the DIP switch is not read)
+	result = BENCH_record("inp_judgeButton/sample", task.wakeups, task.ns, task.allocs);
+	BENCH_setCounter(result, "samples_per_s", (double)task.wakeups * 1000000 / BENCH_TASK_TIME);
+	BENCH_print(result);
+	SIM_runFor(2000 * BENCH_MS);
+}
+
+/* task_led */
+
+// the pattern of the LED is evaluated every control period,
+// the pattern and the colour are changed on the way
+static void test_bench_led_evaluate(void)
+{
+	uint64_t t0 = SIM_getTime();
+	bench_task_t task;
+	bench_result_t * result;
+
+	for (uint64_t t = 0; t < BENCH_TASK_TIME; t += 500 * BENCH_MS) {
+		SIM_at(t0 + t, [t] {
+			LED_setLightPattern((0 == t % (1000 * BENCH_MS)) ? LED_PT_BLINK_FAST : LED_PT_BLINK_SLOW);
+			LED_setColor((0 == t % (1000 * BENCH_MS)) ? LED_COL_GREEN : LED_COL_BLUE);
+		});
+	}
+	bench_runTask("led_task", t0 + BENCH_TASK_TIME, &task);
+	TEST_ASSERT_TRUE(0 < task.wakeups);
+
+	result = BENCH_record("led_evaluate/period", task.wakeups, task.ns, task.allocs);
+	BENCH_setCounter(result, "periods_per_s", (double)task.wakeups * 1000000 / BENCH_TASK_TIME);
+	BENCH_print(result);
+	LED_setLightPattern(LED_PT_ON);
+}
+
+/* rmpp_cmd */
+
+// a received frame is split into its packets and decoded in place,
+// the frame is copied back before each walk (as the receive buffer is)
+static void test_bench_walk_frame(void)
+{
+	static const uint8_t cmds[][RMPP_CMD_LEN_MAX] = {
+		{ RMPP_CMDID_WR_OUTPUT, 0x00, 0x48 },
+		{ RMPP_CMDID_WR_OUTPUT_CH, 0x01, 0x00, 0x08 },
+		{ RMPP_CMDID_WR_STREAM, 0x00, 0x01 },
+	};
+	static uint8_t frame[WS_LEN_BINARY_MAX];
+	static size_t len = 0;
+	static uint32_t count = 0;
+	bench_result_t * result;
+
+	// a frame of the web page filled with mixed commands
+	while (true) {
+		uint8_t buf[RMPP_PACKET_LEN_MAX];
+		const uint8_t * cmd = cmds[count % (sizeof(cmds) / sizeof(cmds[0]))];
+		uint8_t packet;
+
+		memcpy(RMPP_PACKET_CMD(buf), cmd, RMPP_GET_CMD_LEN(cmd[0]));
+		packet = RMPP_encodePacket(buf, RMPP_GET_CMD_LEN(cmd[0]));
+		if (len + packet > sizeof(frame)) {
+			break;
+		}
+		memcpy(&frame[len], buf, packet);
+		len += packet;
+		count++;
+	}
+
+	result = BENCH_run("RMPP_walkFrame/mixed", [](uint64_t n) {
+		uint8_t work[WS_LEN_BINARY_MAX];
+		size_t handed = 0;
+		for (uint64_t i = 0; i < n; i++) {
+			memcpy(work, frame, len);
+			handed += RMPP_walkFrame(work, len, idClient, bench_handleWalk);
+		}
+		TEST_ASSERT_EQUAL_UINT32(n * count, handed);
+	});
+	BENCH_setCounter(result, "cmds_per_frame", count);
+	BENCH_setCounter(result, "frames_per_s", 1e9 / result->real_time);
+	BENCH_setCounter(result, "bytes_per_s", len * 1e9 / result->real_time);
+	BENCH_print(result);
+}
+
+// output commands sent one per frame against BENCH_BATCH per frame
+static void test_bench_walk_batch(void)
+{
+	static const uint32_t batch[] = { 1, BENCH_BATCH };
+
+	for (uint32_t cmds : batch) {
+		static uint8_t frame[WS_LEN_BINARY_MAX];
+		static size_t len;
+		static uint32_t count;
+		bench_result_t * result;
+
+		count = cmds;
+		len = bench_makeOutputFrame(frame, count, 0x100);
+		result = BENCH_run((1 == cmds) ? "RMPP_walkFrame/single" : "RMPP_walkFrame/batch8", [](uint64_t n) {
+			uint8_t work[WS_LEN_BINARY_MAX];
+			size_t handed = 0;
+			for (uint64_t i = 0; i < n; i++) {
+				memcpy(work, frame, len);
+				handed += RMPP_walkFrame(work, len, idClient, bench_handleWalk);
+			}
+			TEST_ASSERT_EQUAL_UINT32(n * count, handed);
+		});
+		BENCH_setCounter(result, "cmds_per_frame", count);
+		BENCH_setCounter(result, "ns_per_cmd", result->real_time / count);
+		BENCH_print(result);
+	}
+}
+
+/* rmpp_ramp, rmpp_speed */
+
+// the cost of one update of the ramp (RMPP_RAMP_RATE per channel) for each
+// curve over a full swing, and of the speed controller (RMPP_SPEED_RATE)
+static void test_bench_ramp_update(void)
+{
+	static const char * const name[] = {
+		"RMPP_updateRamp/linear", "RMPP_updateRamp/scurve", "RMPP_updateRamp/table" };
+	static const uint8_t curves[] = { RMPP_RAMP_LINEAR, RMPP_RAMP_SCURVE, RMPP_RAMP_TABLE };
+
+	for (uint8_t i = 0; i < sizeof(curves) / sizeof(curves[0]); i++) {
+		static rmpp_ramp_profile_t profile;
+		uint8_t curve = curves[i];
+
+		RMPP_makeRampProfile(&profile, curve, 1000, BENCH_DUTY_FULL);
+		BENCH_print(BENCH_run(name[i], [](uint64_t n) {
+			static rmpp_ramp_t ramp;
+			RMPP_resetRamp(&ramp, 0);
+			RMPP_setRampTarget(&ramp, BENCH_DUTY_FULL);
+			for (uint64_t j = 0; j < n; j++) {
+				// up and down again once the target is reached
+				if (!RMPP_updateRamp(&ramp, &profile, &profile)) {
+					RMPP_setRampTarget(&ramp, (0 == RMPP_getRampDuty(&ramp)) ? BENCH_DUTY_FULL : 0);
+				}
+				asm volatile("" : : "r"(&ramp) : "memory");
+			}
+		}));
+	}
+
+	BENCH_print(BENCH_run("RMPP_updateSpeedPi/update", [](uint64_t n) {
+		static rmpp_speed_pi_t pi;
+		rmpp_speed_gain_t gain = { RMPP_SPEED_KP, RMPP_SPEED_KI };
+		uint32_t sum = 0;
+		RMPP_resetSpeedPi(&pi);
+		for (uint64_t j = 0; j < n; j++) {
+			sum += RMPP_updateSpeedPi(&pi, &gain, 6000, 5800 + (int32_t)(j & 0x1FF), 2048, BENCH_DUTY_FULL);
+			asm volatile("" : : "r"(&pi) : "memory");
+		}
+		TEST_ASSERT_TRUE(sum <= n * BENCH_DUTY_FULL);
+	}));
+}
+
+/* rmpp_alive */
+
+// the cost of the alive monitoring per accepted command (the tick is
+// stored, no timer is restarted) and per check at the status period
+static void test_bench_alive(void)
+{
+	BENCH_print(BENCH_run("RMPP_feedAlive/command", [](uint64_t n) {
+		static rmpp_alive_t alive;
+		for (uint64_t i = 0; i < n; i++) {
+			RMPP_feedAlive(&alive, (uint32_t)i);
+			asm volatile("" : : "r"(&alive) : "memory");
+		}
+	}));
+	BENCH_print(BENCH_run("RMPP_isAliveExpired/check", [](uint64_t n) {
+		static rmpp_alive_t alive = { 0xFFFFF000UL };
+		uint32_t expired = 0;
+		for (uint64_t i = 0; i < n; i++) {
+			expired += RMPP_isAliveExpired(&alive, (uint32_t)i, 3000);
+			asm volatile("" : : "r"(&alive) : "memory");
+		}
+		TEST_ASSERT_TRUE(expired <= n);
+	}));
+}
+
+/* task_rmpp */
+
+// an output command of the slider is parsed and posted in the server
+// context (async_tcp), the process task applies it (rmpp_task),
+// a command every 25 ms (within RMPP_SESSION_RATE_MAX)
+static void test_bench_output_command(void)
+{
+	uint64_t t0 = SIM_getTime();
+	uint32_t frames = BENCH_TASK_TIME / (25 * BENCH_MS);
+	bench_task_t parse;
+	bench_task_t apply;
+	bench_result_t * result;
+
+	for (uint32_t i = 0; i < frames; i++) {
+		uint16_t duty = (i % 80 < 40) ? (i % 80) * 100 : (80 - i % 80) * 100;
+		SIM_at(t0 + i * 25 * BENCH_MS, [duty] { bench_sendOutput(idClient, duty, 0x40); });
+	}
+	SIM_at(t0 + BENCH_TASK_TIME - 10 * BENCH_MS, [] { bench_sendOutput(idClient, 0, 0); });
+
+	bench_readTask("rmpp_task", &apply);
+	bench_runTask("async_tcp", t0 + BENCH_TASK_TIME, &parse);
+	{
+		bench_task_t end;
+		bench_readTask("rmpp_task", &end);
+		apply.ns = end.ns - apply.ns;
+		apply.wakeups = end.wakeups - apply.wakeups;
+	}
+	TEST_ASSERT_TRUE(frames <= parse.wakeups);
+
+	result = BENCH_record("rmpp_parseOutputCommand/ws_frame", frames + 1, parse.ns, parse.allocs);
+	BENCH_setCounter(result, "apply_ns_per_frame", (double)apply.ns / (frames + 1));
+	BENCH_print(result);
+}
+
+// the same output commands through the firmware one per frame and
+// BENCH_BATCH per frame (40 commands per second, within the rate limit),
+// the time of the server context and of the process task per command
+static void test_bench_output_batch(void)
+{
+	static const uint32_t batch[] = { 1, BENCH_BATCH };
+
+	for (uint32_t cmds : batch) {
+		uint64_t t0 = SIM_getTime();
+		uint64_t period = 25 * BENCH_MS * cmds;
+		uint32_t frames = BENCH_TASK_TIME / period;
+		bench_task_t parse;
+		bench_task_t apply;
+		bench_task_t end;
+		bench_result_t * result;
+
+		for (uint32_t i = 0; i < frames; i++) {
+			SIM_at(t0 + i * period, [cmds, i] {
+				uint8_t frame[WS_LEN_BINARY_MAX];
+				size_t len = bench_makeOutputFrame(frame, cmds, 0x100 + (i % 64) * 32);
+				SIM_receiveWsBinary(idClient, frame, len);
+			});
+		}
+		bench_readTask("rmpp_task", &apply);
+		bench_runTask("async_tcp", t0 + BENCH_TASK_TIME, &parse);
+		bench_readTask("rmpp_task", &end);
+		bench_sendOutput(idClient, 0, 0);
+		SIM_runFor(100 * BENCH_MS);
+
+		result = BENCH_record((1 == cmds) ? "rmpp_handleWsBinaryData/single" : "rmpp_handleWsBinaryData/batch8",
+			frames * cmds, parse.ns, parse.allocs);
+		BENCH_setCounter(result, "cmds_per_frame", cmds);
+		BENCH_setCounter(result, "apply_ns_per_cmd", (double)(end.ns - apply.ns) / (frames * cmds));
+		BENCH_print(result);
+	}
+}
+
+// the status of the channels is sampled and sent every RMPP_STATUS_INTERVAL
+// (full status as the keep-alive, differences on a change), the output is off
+static void test_bench_status_frame(void)
+{
+	uint64_t t0 = SIM_getTime();
+	bench_task_t task;
+	std::vector<sim_tl_event_t> timeline;
+	uint32_t frames = 0;
+	bench_result_t * result;
+
+	SIM_recordTimeline(true);
+	bench_runTask("rmpp_task", t0 + BENCH_TASK_TIME, &task);
+	timeline = SIM_takeTimeline();
+	SIM_recordTimeline(false);
+	for (const sim_tl_event_t & event : timeline) {
+		frames += (SIM_TL_WS_TX == event.kind) && event.value;
+	}
+	TEST_ASSERT_TRUE(0 < task.wakeups);
+
+	result = BENCH_record("rmpp_publishStatus/period", task.wakeups, task.ns, task.allocs);
+	BENCH_setCounter(result, "periods_per_s", (double)task.wakeups * 1000000 / BENCH_TASK_TIME);
+	BENCH_setCounter(result, "frames_per_s", (double)frames * 1000000 / BENCH_TASK_TIME);
+	BENCH_print(result);
+}
+
+// a telemetry block is packed once into a block of the pool and sent to
+// every subscriber, the allocations per block are those of the program
+// less the ones of the status frames (measured by a run without subscribers)
+static void test_bench_ws_stream(void)
+{
+	static const uint32_t subscribers[] = { 1, 2, SRV_STREAM_CLIENT_MAX };
+	uint32_t ids[SRV_STREAM_CLIENT_MAX] = { idClient };
+	srv_stats_t begin;
+	srv_stats_t end;
+	bench_task_t task;
+	uint64_t allocsBinary;
+
+	for (uint32_t i = 1; i < SRV_STREAM_CLIENT_MAX; i++) {
+		ids[i] = SIM_connectWs();
+	}
+	SIM_runFor(10 * BENCH_MS);
+
+	SRV_getStats(&begin);
+	bench_runTask("srv_task", SIM_getTime() + BENCH_TASK_TIME, &task);
+	SRV_getStats(&end);
+	TEST_ASSERT_TRUE(0 < end.binary_sent - begin.binary_sent);
+	TEST_ASSERT_EQUAL_UINT32(0, task.allocs % (end.binary_sent - begin.binary_sent));
+	allocsBinary = task.allocs / (end.binary_sent - begin.binary_sent);
+
+	for (uint32_t num : subscribers) {
+		char name[48];
+		bench_result_t * result;
+		uint32_t blocks;
+		uint64_t allocs;
+
+		for (uint32_t i = 0; i < num; i++) {
+			bench_sendStream(ids[i], true);
+		}
+		SIM_runFor(100 * BENCH_MS);
+
+		SRV_getStats(&begin);
+		bench_runTask("srv_task", SIM_getTime() + BENCH_TASK_TIME, &task);
+		SRV_getStats(&end);
+		for (uint32_t i = 0; i < num; i++) {
+			bench_sendStream(ids[i], false);
+		}
+		SIM_runFor(100 * BENCH_MS);
+
+		blocks = end.stream_packed - begin.stream_packed;
+		allocs = task.allocs - (end.binary_sent - begin.binary_sent) * allocsBinary;
+		TEST_ASSERT_TRUE(0 < blocks);
+		TEST_ASSERT_EQUAL_UINT32(blocks * num, end.stream_sent - begin.stream_sent);
+		TEST_ASSERT_EQUAL_UINT32(0, allocs);
+
+		snprintf(name, sizeof(name), "srv_drainWsStream/subscribers:%u", num);
+		result = BENCH_record(name, blocks, task.ns, allocs);
+		BENCH_setCounter(result, "blocks_per_s", (double)blocks * 1000000 / BENCH_TASK_TIME);
+		BENCH_print(result);
+	}
+
+	for (uint32_t i = 1; i < SRV_STREAM_CLIENT_MAX; i++) {
+		SIM_disconnectWs(ids[i]);
+	}
+	SIM_runFor(10 * BENCH_MS);
+}
+
+// latency from the fault edge to the cut of the output pins and to the
+// protection of the task, on the virtual clock (the time of the target
+// scheduler) and in host time of the probes, over repeated faults
+static void test_bench_fault_latency(void)
+{
+	std::vector<uint64_t> cut;
+	std::vector<uint64_t> report;
+	std::vector<sim_tl_event_t> timeline;
+	sys_latency_stats_t off;
+	sys_latency_stats_t task;
+	bench_result_t * result;
+	uint64_t t0 = SIM_getTime();
+
+	// output on, fault, fault cleared, stop (clears the latched fault)
+	for (uint32_t i = 0; i < BENCH_FAULTS; i++) {
+		uint64_t t = t0 + i * 100 * BENCH_MS;
+
+		SIM_at(t + 10 * BENCH_MS, [] { bench_sendOutput(idClient, 0x800, 0x40); });
+		SIM_at(t + 50 * BENCH_MS + i % 7 * 100, [] { SIM_setPin(PIN_FAULT, FAULT_DURING); });
+		SIM_at(t + 60 * BENCH_MS, [] { SIM_setPin(PIN_FAULT, FAULT_CLEAR); });
+		SIM_at(t + 70 * BENCH_MS, [] { bench_sendOutput(idClient, 0, 0); });
+	}
+
+	SYS_clearLatency();
+	SIM_recordTimeline(true);
+	SIM_runUntil(t0 + BENCH_FAULTS * 100 * BENCH_MS);
+	timeline = SIM_takeTimeline();
+	SIM_recordTimeline(false);
+
+	// the fault edge is at the same time of every cycle, the first duty
+	// change and the first status frame after it are the cut and the report
+	for (uint32_t i = 0; i < BENCH_FAULTS; i++) {
+		uint64_t tFault = t0 + i * 100 * BENCH_MS + 50 * BENCH_MS + i % 7 * 100;
+		uint64_t tCut = UINT64_MAX;
+		uint64_t tReport = UINT64_MAX;
+
+		for (const sim_tl_event_t & event : timeline) {
+			if (tFault > event.time) {
+				continue;
+			}
+			if ((UINT64_MAX == tCut) && (SIM_TL_DUTY == event.kind)
+			 && ((PIN_PWM1 == event.source) || (PIN_PWM2 == event.source)) && (0 == event.value)) {
+				tCut = event.time;
+			}
+			if ((UINT64_MAX == tReport) && (SIM_TL_WS_TX == event.kind)) {
+				tReport = event.time;
+			}
+			if ((UINT64_MAX != tCut) && (UINT64_MAX != tReport)) {
+				break;
+			}
+		}
+		TEST_ASSERT_TRUE(UINT64_MAX != tCut);
+		TEST_ASSERT_TRUE(UINT64_MAX != tReport);
+		cut.push_back(tCut - tFault);
+		report.push_back(tReport - tFault);
+	}
+
+	SYS_getLatencyStats(SYS_LAT_FAULT_TO_OFF, &off);
+	SYS_getLatencyStats(SYS_LAT_FAULT_TO_TASK, &task);
+	TEST_ASSERT_EQUAL_UINT32(BENCH_FAULTS, off.count);
+	TEST_ASSERT_EQUAL_UINT32(BENCH_FAULTS, task.count + task.expired);
+	TEST_ASSERT_EQUAL_UINT32(0, bench_getPercentile(cut, 100));
+
+	// the time per operation is the host time of the cut in the interrupt
+	result = BENCH_record("fault_to_cut", BENCH_FAULTS, (uint64_t)off.p50 * 1000 / SYS_getLatencyRate() * BENCH_FAULTS, 0);
+	BENCH_setCounter(result, "virtual_p50_us", bench_getPercentile(cut, 50));
+	BENCH_setCounter(result, "virtual_p99_us", bench_getPercentile(cut, 99));
+	BENCH_setCounter(result, "host_p99_ns", (double)off.p99 * 1000 / SYS_getLatencyRate());
+	BENCH_print(result);
+
+	// the time per operation is the host time to the protection of the task
+	result = BENCH_record("fault_to_report", BENCH_FAULTS, (uint64_t)task.p50 * 1000 / SYS_getLatencyRate() * BENCH_FAULTS, 0);
+	BENCH_setCounter(result, "virtual_p50_us", bench_getPercentile(report, 50));
+	BENCH_setCounter(result, "virtual_p99_us", bench_getPercentile(report, 99));
+	BENCH_setCounter(result, "host_p99_ns", (double)task.p99 * 1000 / SYS_getLatencyRate());
+	BENCH_print(result);
+}
+
+// wakeups of the RMPP task while the output is off, against a task that
+// polls the fault input every tick as the RMPP task did before it blocked
+// on the fault interrupt and the status timer, and the time the polling
+// takes to find a fault edge (the interrupt cuts the output at the edge,
+// see test_bench_fault_latency)
+static void test_bench_rmpp_wakeups(void)
+{
+	TaskHandle_t hTaskPoll = NULL;
+	bench_task_t rmpp;
+	bench_task_t poll;
+	bench_task_t begin;
+	std::vector<uint64_t> detect;
+	bench_result_t * result;
+	uint64_t t0;
+
+	pollFound.reserve(BENCH_FAULTS);
+	TEST_ASSERT_EQUAL(pdPASS, xTaskCreate(bench_pollFault, "poll_ref", 2048, NULL, BENCH_PRIORITY_POLL, &hTaskPoll));
+	SIM_runFor(10 * BENCH_MS);
+
+	// idle
+	t0 = SIM_getTime();
+	bench_readTask("poll_ref", &begin);
+	bench_runTask("rmpp_task", t0 + BENCH_TASK_TIME, &rmpp);
+	bench_readTask("poll_ref", &poll);
+	poll.ns -= begin.ns;
+	poll.wakeups -= begin.wakeups;
+	poll.allocs -= begin.allocs;
+	TEST_ASSERT_TRUE(rmpp.wakeups * 10 < poll.wakeups);
+
+	result = BENCH_record("rmpp_task/idle", rmpp.wakeups, rmpp.ns, rmpp.allocs);
+	BENCH_setCounter(result, "wakeups_per_s", (double)rmpp.wakeups * 1000000 / BENCH_TASK_TIME);
+	BENCH_print(result);
+	result = BENCH_record("poll_ref/idle", poll.wakeups, poll.ns, 0);
+	BENCH_setCounter(result, "wakeups_per_s", (double)poll.wakeups * 1000000 / BENCH_TASK_TIME);
+	BENCH_print(result);
+
+	// faults at any phase of the tick, cleared by a stop
+	t0 = SIM_getTime();
+	for (uint32_t i = 0; i < BENCH_FAULTS; i++) {
+		uint64_t t = t0 + i * 100 * BENCH_MS;
+
+		SIM_at(t + 50 * BENCH_MS + i % 10 * 100, [] { SIM_setPin(PIN_FAULT, FAULT_DURING); });
+		SIM_at(t + 60 * BENCH_MS, [] { SIM_setPin(PIN_FAULT, FAULT_CLEAR); });
+		SIM_at(t + 70 * BENCH_MS, [] { bench_sendOutput(idClient, 0, 0); });
+	}
+	SIM_runUntil(t0 + BENCH_FAULTS * 100 * BENCH_MS);
+	vTaskDelete(hTaskPoll);
+
+	TEST_ASSERT_EQUAL_UINT32(BENCH_FAULTS, pollFound.size());
+	for (uint32_t i = 0; i < BENCH_FAULTS; i++) {
+		detect.push_back(pollFound[i] - (t0 + i * 100 * BENCH_MS + 50 * BENCH_MS + i % 10 * 100));
+	}
+	result = BENCH_record("fault_to_detect/polling", BENCH_FAULTS, 0, 0);
+	BENCH_setCounter(result, "virtual_p50_us", bench_getPercentile(detect, 50));
+	BENCH_setCounter(result, "virtual_p99_us", bench_getPercentile(detect, 99));
+	BENCH_print(result);
+	TEST_ASSERT_TRUE(0 < bench_getPercentile(detect, 50));
+	SIM_runFor(10 * BENCH_MS);
+}
+
+// the results are written for the tools of Google Benchmark
+static void test_bench_write(void)
+{
+	TEST_ASSERT_TRUE(BENCH_writeJson());
+}
+
+int main(void)
+{
+	UNITY_BEGIN();
+	RUN_TEST(test_boot);
+	RUN_TEST(test_bench_asset_lookup);
+	RUN_TEST(test_bench_mime_type);
+	RUN_TEST(test_bench_latency_probe);
+	RUN_TEST(test_bench_cli_parse);
+	RUN_TEST(test_bench_ws_push_binary);
+	RUN_TEST(test_bench_ws_push_text);
+	RUN_TEST(test_bench_ws_broadcast);
+	RUN_TEST(test_bench_ws_cli_burst);
+	RUN_TEST(test_bench_input_judge);
+	RUN_TEST(test_bench_led_evaluate);
+	RUN_TEST(test_bench_walk_frame);
+	RUN_TEST(test_bench_walk_batch);
+	RUN_TEST(test_bench_ramp_update);
+	RUN_TEST(test_bench_alive);
+	RUN_TEST(test_bench_output_command);
+	RUN_TEST(test_bench_output_batch);
+	RUN_TEST(test_bench_status_frame);
+	RUN_TEST(test_bench_ws_stream);
+	RUN_TEST(test_bench_fault_latency);
+	RUN_TEST(test_bench_rmpp_wakeups);
+	RUN_TEST(test_bench_write);
+	return UNITY_END();
+}
@@ -0,0 +1,733 @@
+// --------------------------------------------------------
+// Copyright (c) 2025 rapid4mifu 
+//
+// These codes are licensed under GPL v3.0
+// https://opensource.org/license/GPL-3.0
+// --------------------------------------------------------
+
+// Unit tests of the hardware independent RMPP modules (host build)
+//  pio test -e native -f test_rmpp
+
+#include <unity.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "adc_filter.h"
+#include "board.h"
+#include "rmpp_alive.h"
+#include "rmpp_cmd.h"
+#include "rmpp_ramp.h"
+#include "rmpp_speed.h"
+#include "rmpp_stream.h"
+#include "sys_latency.h"
+
+#define DUTY_FULL ((1U << PWM_RES) - 1)
+
+// number of frames of the fuzz test
+#define FUZZ_FRAMES 20000
+// frame size of the fuzz test (a WebSocket message of the web page)
+#define FUZZ_FRAME_LEN 64
+
+// alive monitoring of the process task (1 tick = 1 ms)
+#define ALIVE_TIMEOUT 3000
+#define ALIVE_CHECK_PERIOD 200
+
+static char simMessage[128];
+
+/* commands handed over by RMPP_walkFrame */
+static const uint8_t * walkBegin;
+static const uint8_t * walkEnd;
+static uint8_t walkCmd[64][RMPP_CMD_LEN_MAX];
+static uint32_t walkCount;
+static uint32_t walkBad;
+static uint8_t simFrame[FUZZ_FRAME_LEN];
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+/* rmpp_cmd */
+
+// the command survives the encode / decode round trip, zero bytes included
+static void test_cmd_round_trip(void)
+{
+	const uint8_t cmd[] = { 0x33, 0x00, 0x00, 0x08 };	// WR_OUTPUT_CH : channel 0, duty 0, forward
+	uint8_t buf[RMPP_PACKET_LEN_MAX];
+	uint8_t len = sizeof(cmd) + RMPP_BYTES_CHECKSUM;
+	uint8_t packet;
+
+	memcpy(RMPP_PACKET_CMD(buf), cmd, sizeof(cmd));
+	packet = RMPP_encodePacket(buf, len);
+	TEST_ASSERT_EQUAL_UINT8(len + RMPP_BYTES_COBS, packet);
+
+	// no zero byte but the delimiter
+	for (uint8_t i = 0; i < packet - RMPP_BYTES_DELIMITER; i++) {
+		TEST_ASSERT_NOT_EQUAL(0, buf[i]);
+	}
+	TEST_ASSERT_EQUAL_UINT8(0, buf[packet - 1]);
+
+	TEST_ASSERT_EQUAL_UINT8(len, RMPP_decodePacket(buf, packet));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(cmd, RMPP_PACKET_CMD(buf), sizeof(cmd));
+	TEST_ASSERT_EQUAL_UINT8(0, RMPP_calcChecksum(RMPP_PACKET_CMD(buf), len));
+}
+
+// a flipped bit, a wrong length or a stray delimiter is rejected
+static void test_cmd_reject(void)
+{
+	const uint8_t cmd[] = { 0x12, 0x34, 0x08 };	// WR_OUTPUT
+	uint8_t buf[RMPP_PACKET_LEN_MAX];
+	uint8_t len = sizeof(cmd) + RMPP_BYTES_CHECKSUM;
+	uint8_t work[RMPP_PACKET_LEN_MAX];
+	uint8_t packet;
+
+	memcpy(RMPP_PACKET_CMD(buf), cmd, sizeof(cmd));
+	packet = RMPP_encodePacket(buf, len);
+
+	memcpy(work, buf, packet);
+	work[2] ^= 0x01;
+	TEST_ASSERT_EQUAL_UINT8(0, RMPP_decodePacket(work, packet));
+
+	memcpy(work, buf, packet);
+	TEST_ASSERT_EQUAL_UINT8(0, RMPP_decodePacket(work, packet - 2));
+
+	memcpy(work, buf, packet);
+	work[1] = 0;
+	TEST_ASSERT_EQUAL_UINT8(0, RMPP_decodePacket(work, packet));
+
+	TEST_ASSERT_EQUAL_UINT8(0, RMPP_encodePacket(buf, RMPP_CMD_LEN_MAX + 1));
+}
+
+/* rmpp_ramp */
+
+// the linear ramp reaches the target in the given time and stays there
+static void test_ramp_linear(void)
+{
+	rmpp_ramp_profile_t profile;
+	rmpp_ramp_t ramp;
+	uint32_t updates = 0;
+
+	RMPP_makeRampProfile(&profile, RMPP_RAMP_LINEAR, 1000, DUTY_FULL);
+	RMPP_resetRamp(&ramp, 0);
+	RMPP_setRampTarget(&ramp, DUTY_FULL);
+
+	while (RMPP_updateRamp(&ramp, &profile, &profile)) {
+		updates++;
+		TEST_ASSERT_TRUE(updates <= RMPP_RAMP_RATE + 1);
+	}
+	TEST_ASSERT_EQUAL_UINT16(DUTY_FULL, RMPP_getRampDuty(&ramp));
+	TEST_ASSERT_UINT32_WITHIN(1, RMPP_RAMP_RATE, updates);
+	TEST_ASSERT_FALSE(RMPP_updateRamp(&ramp, &profile, &profile));
+}
+
+// the S-curve rises monotonically and lands on the target
+static void test_ramp_scurve(void)
+{
+	rmpp_ramp_profile_t profile;
+	rmpp_ramp_t ramp;
+	uint16_t prev = 0;
+
+	RMPP_makeRampProfile(&profile, RMPP_RAMP_SCURVE, 500, DUTY_FULL);
+	RMPP_resetRamp(&ramp, 0);
+	RMPP_setRampTarget(&ramp, DUTY_FULL / 2);
+
+	for (uint32_t i = 0; RMPP_updateRamp(&ramp, &profile, &profile); i++) {
+		TEST_ASSERT_TRUE(i < 10 * RMPP_RAMP_RATE);
+		TEST_ASSERT_TRUE(RMPP_getRampDuty(&ramp) >= prev);
+		prev = RMPP_getRampDuty(&ramp);
+	}
+	TEST_ASSERT_EQUAL_UINT16(DUTY_FULL / 2, RMPP_getRampDuty(&ramp));
+}
+
+// duty against time at the ramp rate, from the shortest to the longest time
+// accepted by the console : the duty never falls back, the full duty is
+// reached in the given time (plus the bends of the S-curve and the rounding
+// of the step), the linear ramp is on the straight line on the way and the
+// S-curve behind it
+static void test_ramp_profile_time(void)
+{
+	static const uint8_t curves[] = { RMPP_RAMP_LINEAR, RMPP_RAMP_SCURVE };
+	static const uint32_t times[] = { 200, 1000, 5000, RMPP_RAMP_TIME_MAX };
+
+	for (uint8_t curve : curves) {
+		for (uint32_t time : times) {
+			rmpp_ramp_profile_t profile;
+			rmpp_ramp_t ramp;
+			uint32_t updates = 0;
+			uint16_t quarter = 0;
+			uint16_t half = 0;
+			uint16_t prev = 0;
+
+			TEST_ASSERT_TRUE(RMPP_makeRampProfile(&profile, curve, time, DUTY_FULL));
+			RMPP_resetRamp(&ramp, 0);
+			RMPP_setRampTarget(&ramp, DUTY_FULL);
+
+			while (RMPP_updateRamp(&ramp, &profile, &profile)) {
+				uint16_t duty = RMPP_getRampDuty(&ramp);
+
+				updates++;
+				TEST_ASSERT_TRUE(duty >= prev);
+				TEST_ASSERT_TRUE(updates <= time * 13 / 10);
+				if (time / 4 == updates) {
+					quarter = duty;
+				} else if (time / 2 == updates) {
+					half = duty;
+				}
+				prev = duty;
+			}
+			TEST_ASSERT_EQUAL_UINT16(DUTY_FULL, RMPP_getRampDuty(&ramp));
+			TEST_ASSERT_TRUE(updates >= time);
+
+			if (RMPP_RAMP_LINEAR == curve) {
+				TEST_ASSERT_UINT32_WITHIN(DUTY_FULL * 3 / 100, DUTY_FULL / 4, quarter);
+				TEST_ASSERT_UINT32_WITHIN(DUTY_FULL * 3 / 100, DUTY_FULL / 2, half);
+			} else {
+				TEST_ASSERT_TRUE(DUTY_FULL / 4 > quarter);
+				TEST_ASSERT_TRUE(DUTY_FULL / 2 > half);
+			}
+		}
+	}
+}
+
+// a curve or a time out of range leaves the profile as it was
+static void test_ramp_profile_range(void)
+{
+	rmpp_ramp_profile_t profile;
+	rmpp_ramp_profile_t before;
+
+	TEST_ASSERT_TRUE(RMPP_makeRampProfile(&profile, RMPP_RAMP_LINEAR, 1000, DUTY_FULL));
+	before = profile;
+	TEST_ASSERT_FALSE(RMPP_makeRampProfile(&profile, RMPP_RAMP_TABLE + 1, 1000, DUTY_FULL));
+	TEST_ASSERT_FALSE(RMPP_makeRampProfile(&profile, RMPP_RAMP_SCURVE, RMPP_RAMP_TIME_MAX + 1, DUTY_FULL));
+	TEST_ASSERT_FALSE(RMPP_makeRampProfile(&profile, RMPP_RAMP_SCURVE, UINT32_MAX, DUTY_FULL));
+	TEST_ASSERT_EQUAL_UINT8(before.curve, profile.curve);
+	TEST_ASSERT_EQUAL_UINT32(before.step, profile.step);
+	TEST_ASSERT_EQUAL_UINT32(before.jerk, profile.jerk);
+}
+
+// braking from the full duty takes the step of the last table entry
+static void test_ramp_table_full_duty(void)
+{
+	static const uint32_t table[RMPP_RAMP_TABLE_LEN] = {
+		1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16,
+	};
+	rmpp_ramp_profile_t profile;
+	rmpp_ramp_t ramp;
+
+	RMPP_makeRampProfile(&profile, RMPP_RAMP_TABLE, 1000, DUTY_FULL);
+	profile.table = table;
+	RMPP_resetRamp(&ramp, DUTY_FULL);
+	RMPP_setRampTarget(&ramp, 0);
+
+	TEST_ASSERT_TRUE(RMPP_updateRamp(&ramp, &profile, &profile));
+	TEST_ASSERT_EQUAL_UINT32(((uint32_t)DUTY_FULL << RMPP_RAMP_FRAC) - table[RMPP_RAMP_TABLE_LEN - 1], ramp.duty);
+}
+
+// handler of the commands of RMPP_walkFrame, the command must lie in the
+// frame and be complete with a zero checksum
+static void walk_handleCommand(uint8_t * cmd, uint8_t len, uint32_t id)
+{
+	if ((cmd < walkBegin) || (cmd + len > walkEnd) || (len != RMPP_GET_CMD_LEN(cmd[0]))
+	 || (0 != RMPP_calcChecksum(cmd, len)) || (7 != id)) {
+		walkBad++;
+	}
+	if (sizeof(walkCmd) / sizeof(walkCmd[0]) > walkCount) {
+		memcpy(walkCmd[walkCount], cmd, len);
+	}
+	walkCount++;
+}
+
+// builds a frame of valid packets of random commands
+static size_t walk_makeFrame(uint8_t * frame, size_t size, uint32_t * seed, uint8_t cmds[][RMPP_CMD_LEN_MAX], uint32_t * count)
+{
+	size_t len = 0;
+
+	*count = 0;
+	while (true) {
+		uint8_t buf[RMPP_PACKET_LEN_MAX];
+		uint8_t * cmd = RMPP_PACKET_CMD(buf);
+		uint8_t bytes;
+		uint8_t packet;
+
+		*seed = *seed * 1103515245 + 12345;
+		bytes = (*seed >> 16) % (RMPP_BYTES_DAT_MAX + 1);
+		cmd[0] = (((*seed >> 8) & 0x07) << 4) | bytes;
+		for (uint8_t i = 0; i < bytes; i++) {
+			*seed = *seed * 1103515245 + 12345;
+			cmd[1 + i] = (0 == (*seed & 0x300)) ? 0 : (uint8_t)(*seed >> 16);
+		}
+		cmd[1 + bytes] = RMPP_calcChecksum(cmd, 1 + bytes);
+		memcpy(cmds[*count], cmd, RMPP_GET_CMD_LEN(cmd[0]));
+		packet = RMPP_encodePacket(buf, RMPP_GET_CMD_LEN(cmd[0]));
+		if (len + packet > size) {
+			return len;
+		}
+		(*count)++;
+		memcpy(&frame[len], buf, packet);
+		len += packet;
+	}
+}
+
+// the packets of a frame are handed over in their order,
+// a corrupted packet is dropped without losing the packets around it
+static void test_cmd_walk_frame(void)
+{
+	uint8_t frame[FUZZ_FRAME_LEN];
+	uint8_t cmds[32][RMPP_CMD_LEN_MAX];
+	uint32_t count;
+	uint32_t seed = 1;
+	size_t len = walk_makeFrame(frame, sizeof(frame), &seed, cmds, &count);
+	size_t second;
+
+	TEST_ASSERT_TRUE(2 < count);
+	walkBegin = frame;
+	walkEnd = frame + len;
+	walkCount = 0;
+	walkBad = 0;
+	TEST_ASSERT_EQUAL_UINT32(count, RMPP_walkFrame(frame, len, 7, walk_handleCommand));
+	TEST_ASSERT_EQUAL_UINT32(count, walkCount);
+	TEST_ASSERT_EQUAL_UINT32(0, walkBad);
+	for (uint32_t i = 0; i < count; i++) {
+		TEST_ASSERT_EQUAL_UINT8_ARRAY(cmds[i], walkCmd[i], RMPP_GET_CMD_LEN(cmds[i][0]));
+	}
+
+	// the second packet is corrupted (a byte of its data)
+	seed = 1;
+	len = walk_makeFrame(frame, sizeof(frame), &seed, cmds, &count);
+	second = (const uint8_t *)memchr(frame, 0, len) - frame + 1;
+	frame[second + 1] ^= 0x01;
+	walkCount = 0;
+	TEST_ASSERT_EQUAL_UINT32(count - 1, RMPP_walkFrame(frame, len, 7, walk_handleCommand));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(cmds[0], walkCmd[0], RMPP_GET_CMD_LEN(cmds[0][0]));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(cmds[2], walkCmd[1], RMPP_GET_CMD_LEN(cmds[2][0]));
+	TEST_ASSERT_EQUAL_UINT32(0, walkBad);
+}
+
+// random and mutated frames (flipped bits, truncation, stray or missing
+// delimiters, random bytes) never hand over a command outside the frame
+// or a command with a wrong length or checksum
+static void test_cmd_walk_fuzz(void)
+{
+	uint8_t cmds[32][RMPP_CMD_LEN_MAX];
+	uint32_t seed = 12345;
+	uint32_t count;
+	uint32_t handed = 0;
+
+	walkBad = 0;
+	for (uint32_t n = 0; n < FUZZ_FRAMES; n++) {
+		// the frame is on the heap at its exact size (out of bounds reads
+		// show up with the address sanitizer)
+		size_t len = walk_makeFrame(simFrame, sizeof(simFrame), &seed, cmds, &count);
+		uint8_t * frame;
+
+		seed = seed * 1103515245 + 12345;
+		switch ((seed >> 16) % 6) {
+			case 0:		// a bit flipped
+				simFrame[(seed >> 4) % len] ^= 1 << ((seed >> 20) & 7);
+				break;
+			case 1:		// truncated
+				len = (seed >> 4) % len;
+				break;
+			case 2:		// a stray delimiter
+				simFrame[(seed >> 4) % len] = 0;
+				break;
+			case 3:		// a delimiter lost
+				simFrame[len - 1] = (uint8_t)(seed >> 8) | 1;
+				break;
+			case 4:		// random bytes
+				for (size_t i = 0; i < len; i++) {
+					seed = seed * 1103515245 + 12345;
+					simFrame[i] = (uint8_t)(seed >> 16);
+				}
+				break;
+			default:	// as it was built
+				break;
+		}
+
+		frame = (uint8_t *)malloc((0 < len) ? len : 1);
+		memcpy(frame, simFrame, len);
+		walkBegin = frame;
+		walkEnd = frame + len;
+		walkCount = 0;
+		count = RMPP_walkFrame(frame, len, 7, walk_handleCommand);
+		TEST_ASSERT_EQUAL_UINT32(count, walkCount);
+		handed += walkCount;
+		free(frame);
+	}
+	TEST_ASSERT_EQUAL_UINT32(0, walkBad);
+	TEST_ASSERT_TRUE(0 < handed);
+	snprintf(simMessage, sizeof(simMessage), "fuzz : %u frames, %u commands handed over", FUZZ_FRAMES, handed);
+	TEST_MESSAGE(simMessage);
+}
+
+/* rmpp_alive */
+
+// the deadline is exact to the tick, also across the wrap of the tick count
+static void test_alive_edges(void)
+{
+	const uint32_t last[] = { 0, 12345, 0xFFFFFFFFUL - ALIVE_TIMEOUT / 2, 0xFFFFFFFFUL };
+	rmpp_alive_t alive;
+
+	for (uint32_t tick : last) {
+		RMPP_feedAlive(&alive, tick);
+		TEST_ASSERT_FALSE(RMPP_isAliveExpired(&alive, tick, ALIVE_TIMEOUT));
+		TEST_ASSERT_FALSE(RMPP_isAliveExpired(&alive, tick + ALIVE_TIMEOUT - 1, ALIVE_TIMEOUT));
+		TEST_ASSERT_TRUE(RMPP_isAliveExpired(&alive, tick + ALIVE_TIMEOUT, ALIVE_TIMEOUT));
+		TEST_ASSERT_TRUE(RMPP_isAliveExpired(&alive, tick + ALIVE_TIMEOUT + ALIVE_CHECK_PERIOD, ALIVE_TIMEOUT));
+	}
+}
+
+// checked at the status period, the stop lands between the timeout and
+// the timeout plus one period after the last command, for every phase of
+// the command against the check and across the wrap, commands at the
+// rate of the slider keep the output alive
+static void test_alive_window(void)
+{
+	const uint32_t start[] = { 0, 0xFFFFFFFFUL - ALIVE_TIMEOUT - 100, 0xFFFFFFFFUL - 50 };
+	rmpp_alive_t alive;
+
+	for (uint32_t base : start) {
+		for (uint32_t phase = 0; phase < ALIVE_CHECK_PERIOD; phase++) {
+			uint32_t last = base;
+			uint32_t tick = base;
+			uint32_t stop;
+
+			// the output starts at the base (the start keeps it alive),
+			// a tick at a time, commands every 50 ms for a second from the
+			// phase, then none, checked every period from the base
+			RMPP_feedAlive(&alive, base);
+			while (true) {
+				uint32_t elapsed = tick - (base + phase);
+
+				if ((0 <= (int32_t)elapsed) && (1000 > elapsed) && (0 == elapsed % 50)) {
+					RMPP_feedAlive(&alive, tick);
+					last = tick;
+				}
+				if ((0 == (tick - base) % ALIVE_CHECK_PERIOD) && RMPP_isAliveExpired(&alive, tick, ALIVE_TIMEOUT)) {
+					TEST_ASSERT_TRUE(1000 <= elapsed);
+					break;
+				}
+				tick++;
+			}
+			stop = tick - last;
+			TEST_ASSERT_GREATER_OR_EQUAL_UINT32(ALIVE_TIMEOUT, stop);
+			TEST_ASSERT_TRUE(ALIVE_TIMEOUT + ALIVE_CHECK_PERIOD > stop);
+		}
+	}
+}
+
+/* rmpp_speed */
+
+// the output stays within the duty range and the integral does not wind up
+static void test_speed_saturation(void)
+{
+	rmpp_speed_gain_t gain = { 256, 48 };
+	rmpp_speed_pi_t pi;
+
+	RMPP_resetSpeedPi(&pi);
+	for (uint8_t i = 0; i < 100; i++) {
+		TEST_ASSERT_EQUAL_UINT16(DUTY_FULL, RMPP_updateSpeedPi(&pi, &gain, 12000, 0, DUTY_FULL, DUTY_FULL));
+	}
+	TEST_ASSERT_EQUAL_INT32(0, pi.integ);
+
+	// the correction takes effect on the first update once the error turns
+	TEST_ASSERT_TRUE(DUTY_FULL > RMPP_updateSpeedPi(&pi, &gain, 6000, 6100, DUTY_FULL, DUTY_FULL));
+	TEST_ASSERT_EQUAL_UINT16(0, RMPP_updateSpeedPi(&pi, &gain, 0, 12000, 0, DUTY_FULL));
+}
+
+// gains out of range are refused, the largest gains saturate the output
+// on the largest error instead of overflowing
+static void test_speed_gain_range(void)
+{
+	rmpp_speed_gain_t gain = { 256, 48 };
+	rmpp_speed_pi_t pi;
+
+	TEST_ASSERT_FALSE(RMPP_setSpeedGain(&gain, -1, 48));
+	TEST_ASSERT_FALSE(RMPP_setSpeedGain(&gain, 256, RMPP_SPEED_GAIN_MAX + 1));
+	TEST_ASSERT_FALSE(RMPP_setSpeedGain(&gain, INT32_MAX, INT32_MAX));
+	TEST_ASSERT_EQUAL_INT32(256, gain.kp);
+	TEST_ASSERT_EQUAL_INT32(48, gain.ki);
+	TEST_ASSERT_TRUE(RMPP_setSpeedGain(&gain, RMPP_SPEED_GAIN_MAX, RMPP_SPEED_GAIN_MAX));
+
+	RMPP_resetSpeedPi(&pi);
+	for (uint8_t i = 0; i < 100; i++) {
+		TEST_ASSERT_EQUAL_UINT16(DUTY_FULL, RMPP_updateSpeedPi(&pi, &gain, UINT16_MAX, 0, 0, DUTY_FULL));
+	}
+	for (uint8_t i = 0; i < 100; i++) {
+		TEST_ASSERT_EQUAL_UINT16(0, RMPP_updateSpeedPi(&pi, &gain, 0, UINT16_MAX, DUTY_FULL, DUTY_FULL));
+	}
+}
+
+// no error gives the feed forward duty
+static void test_speed_feed_forward(void)
+{
+	rmpp_speed_gain_t gain = { 256, 48 };
+	rmpp_speed_pi_t pi;
+
+	RMPP_resetSpeedPi(&pi);
+	TEST_ASSERT_EQUAL_UINT16(1234, RMPP_updateSpeedPi(&pi, &gain, 6000, 6000, 1234, DUTY_FULL));
+}
+
+// a DC motor (first order, time constant SIM_TAU) with a load that drops
+// the armature voltage by SIM_LOAD, closed by the default gains at the
+// speed rate with a 1 ms gate : the speed recovers after a 6x load step
+#define SIM_VIN 12000	// input voltage [mV]
+#define SIM_TARGET 6000	// target back-EMF [mV]
+#define SIM_TAU 100		// mechanical time constant [ms]
+#define SIM_LOAD 300	// voltage drop of the light load [mV]
+#define SIM_GATE 1		// gate (Hi-Z) time per speed period [ms]
+
+static void test_speed_load_step(void)
+{
+	const rmpp_speed_gain_t gain = { RMPP_SPEED_KP, RMPP_SPEED_KI };
+	const uint32_t period = 1000 / RMPP_SPEED_RATE;
+	const int32_t feed = SIM_TARGET * (int32_t)(1 << PWM_RES) / SIM_VIN;
+	rmpp_speed_pi_t pi;
+	double bemf = 0;
+	double load = SIM_LOAD;
+	double errSquare = 0;
+	uint32_t errCount = 0;
+	uint32_t settle = 0;
+	uint16_t duty = 0;
+
+	RMPP_resetSpeedPi(&pi);
+	for (uint32_t ms = 0; ms < 4000; ms++) {
+		if (0 == ms % period) {
+			int32_t err = SIM_TARGET - (int32_t)bemf;
+
+			duty = RMPP_updateSpeedPi(&pi, &gain, SIM_TARGET, (int32_t)bemf, feed, 1 << PWM_RES);
+			if (2000 <= ms) {
+				// after the load step
+				errSquare += (double)err * err;
+				errCount++;
+				if ((SIM_TARGET / 50) < abs(err)) {
+					settle = ms - 2000 + period;
+				}
+			}
+		}
+		if (2000 == ms) {
+			load = 6 * SIM_LOAD;
+		}
+
+		// no drive while the output is gated
+		double drive = ((ms % period) < SIM_GATE) ? bemf : ((double)SIM_VIN * duty / (1 << PWM_RES) - load);
+		bemf += (drive - bemf) / SIM_TAU;
+	}
+
+	snprintf(simMessage, sizeof(simMessage), "load step : RMS error %.0f mV, settled in %u ms",
+		sqrt(errSquare / errCount), (unsigned)settle);
+	TEST_MESSAGE(simMessage);
+	TEST_ASSERT_TRUE(500 > settle);
+	TEST_ASSERT_INT32_WITHIN(SIM_TARGET / 100, SIM_TARGET, (int32_t)bemf);
+}
+
+/* adc_filter */
+
+// level of the input and the noise of a conversion of the noise test [raw]
+#define ADC_TEST_LEVEL (1500)
+#define ADC_TEST_NOISE (50)		// +/- 50 counts (+/- 40 mV)
+#define ADC_TEST_OVERSAMPLE (8)
+#define ADC_TEST_FRAMES (4000)
+
+static uint32_t adcSeed = 1;
+
+// uniform noise of +/- ADC_TEST_NOISE counts (the same sequence on every run)
+static int32_t adc_noise(void)
+{
+	adcSeed = adcSeed * 1103515245 + 12345;
+	return (int32_t)((adcSeed >> 16) % (2 * ADC_TEST_NOISE + 1)) - ADC_TEST_NOISE;
+}
+
+// the oversampling and the filter take the noise of the conversions out
+// without a bias, the filter settles to 63 % of a step in 2^n frames
+static void test_adc_noise(void)
+{
+	double mean = (double)ADC_TEST_LEVEL * ADC_RAW_FULL_MV / ADC_RAW_FULL;
+	double convSquare = 0;
+	double frameSquare = 0;
+	double filterSquare = 0;
+	double filterSum = 0;
+	uint32_t filter = 0;
+	uint32_t count = 0;
+
+	for (uint32_t i = 0; i < ADC_TEST_FRAMES; i++) {
+		uint32_t sum = 0;
+
+		for (uint8_t n = 0; n < ADC_TEST_OVERSAMPLE; n++) {
+			int32_t raw = ADC_TEST_LEVEL + adc_noise();
+			double err = (double)raw * ADC_RAW_FULL_MV / ADC_RAW_FULL - mean;
+
+			convSquare += err * err;
+			sum += raw;
+		}
+		uint16_t mv = ADC_averageRaw(sum, ADC_TEST_OVERSAMPLE);
+
+		filter = (0 == i) ? ADC_startFilter(mv) : ADC_updateFilter(filter, mv);
+		if ((1 << ADC_FILTER_SHIFT) * 4 <= i) {
+			// after the filter settled
+			double out = ADC_getFilterOutput(filter);
+
+			frameSquare += (mv - mean) * (mv - mean);
+			filterSquare += (out - mean) * (out - mean);
+			filterSum += out;
+			count++;
+		}
+	}
+
+	double conv = sqrt(convSquare / (ADC_TEST_FRAMES * ADC_TEST_OVERSAMPLE));
+	double frame = sqrt(frameSquare / count);
+	double out = sqrt(filterSquare / count);
+
+	snprintf(simMessage, sizeof(simMessage), "noise : conversion %.1f mV, frame %.1f mV, filter %.1f mV",
+		conv, frame, out);
+	TEST_MESSAGE(simMessage);
+	// the average of 8 conversions is sqrt(8) times quieter
+	TEST_ASSERT_TRUE((conv / 2) > frame);
+	// the filter takes a quarter out of the rest at least
+	TEST_ASSERT_TRUE((frame / 4) > out);
+	// the truncations lose less than 1 mV
+	TEST_ASSERT_TRUE(1.5 > fabs(filterSum / count - mean));
+
+	// step from 0 mV to 1000 mV
+	filter = ADC_startFilter(0);
+	for (uint8_t i = 0; i < (1 << ADC_FILTER_SHIFT); i++) {
+		filter = ADC_updateFilter(filter, 1000);
+	}
+	TEST_ASSERT_UINT32_WITHIN(30, 640, ADC_getFilterOutput(filter));
+	for (uint16_t i = 0; i < (1 << ADC_FILTER_SHIFT) * 16; i++) {
+		filter = ADC_updateFilter(filter, 1000);
+	}
+	TEST_ASSERT_UINT32_WITHIN(1, 1000, ADC_getFilterOutput(filter));
+}
+
+// the input voltage through the millivolts is the one of the old direct
+// scaling (raw * 360 / 4095 [0.1 V]) within its 1 % and a digit, the old
+// one took the divider as 10.91 (36 V at 3.3 V) in place of VIN_DIV
+static void test_adc_scale_vin(void)
+{
+	uint32_t worst = 0;
+
+	for (uint32_t raw = 0; raw <= ADC_RAW_FULL; raw++) {
+		uint32_t old = raw * 360 / 4095;
+		uint32_t now = ADC_scaleDivider(ADC_averageRaw(raw * ADC_TEST_OVERSAMPLE, ADC_TEST_OVERSAMPLE), VIN_DIV, 100);
+		uint32_t diff = (now > old) ? (now - old) : (old - now);
+
+		TEST_ASSERT_TRUE(old / 100 + 1 >= diff);
+		if (worst < diff) {
+			worst = diff;
+		}
+	}
+	snprintf(simMessage, sizeof(simMessage), "input voltage : %u x 0.1 V from the old scaling at most", (unsigned)worst);
+	TEST_MESSAGE(simMessage);
+
+	// the full scale, [mV] and [10 mV] as the telemetry and the stream
+	TEST_ASSERT_EQUAL_UINT16(ADC_RAW_FULL_MV, ADC_averageRaw(ADC_RAW_FULL * 8, 8));
+	TEST_ASSERT_EQUAL_UINT32(ADC_RAW_FULL_MV * VIN_DIV, ADC_scaleDivider(ADC_RAW_FULL_MV, VIN_DIV, 1));
+	TEST_ASSERT_EQUAL_UINT32(ADC_RAW_FULL_MV * VIN_DIV / 10, ADC_scaleDivider(ADC_RAW_FULL_MV, VIN_DIV, 10));
+	TEST_ASSERT_EQUAL_UINT16(0, ADC_averageRaw(0, 0));
+}
+
+/* rmpp_stream */
+
+// a whole block is packed with the time deltas, a full ring drops samples
+static void test_stream_block(void)
+{
+	uint8_t buf[RMPP_STREAM_BLOCK_LEN];
+	rmpp_stream_sample_t sample = { 1000, 100, 1200, 300 };
+	rmpp_stream_stats_t stats;
+	bool ready = false;
+
+	RMPP_resetStream();
+	RMPP_setStreamChannel(2);
+	TEST_ASSERT_EQUAL(0, RMPP_packStreamBlock(buf, sizeof(buf)));
+
+	for (uint8_t i = 0; i < RMPP_STREAM_BLOCK; i++) {
+		ready = RMPP_pushStreamSample(&sample);
+		sample.time += 1000;
+	}
+	TEST_ASSERT_TRUE(ready);
+	TEST_ASSERT_EQUAL(0, RMPP_packStreamBlock(buf, sizeof(buf) - 1));
+	TEST_ASSERT_EQUAL(RMPP_STREAM_BLOCK_LEN, RMPP_packStreamBlock(buf, sizeof(buf)));
+
+	TEST_ASSERT_EQUAL_UINT8(0x00, buf[0]);
+	TEST_ASSERT_EQUAL_UINT8(RMPP_STREAM_MARKER, buf[1]);
+	TEST_ASSERT_EQUAL_UINT8(2, buf[2]);
+	TEST_ASSERT_EQUAL_UINT8(RMPP_STREAM_BLOCK, buf[3]);
+	// the first delta is 0, the others 1000 us
+	TEST_ASSERT_EQUAL_UINT8(0, buf[RMPP_STREAM_HEADER_LEN]);
+	TEST_ASSERT_EQUAL_UINT8(1000 & 0xFF, buf[RMPP_STREAM_HEADER_LEN + RMPP_STREAM_SAMPLE_LEN]);
+	TEST_ASSERT_EQUAL_UINT8(1000 >> 8, buf[RMPP_STREAM_HEADER_LEN + RMPP_STREAM_SAMPLE_LEN + 1]);
+
+	for (uint16_t i = 0; i < RMPP_STREAM_RING_LEN + 1; i++) {
+		RMPP_pushStreamSample(&sample);
+	}
+	RMPP_getStreamStats(&stats);
+	TEST_ASSERT_EQUAL_UINT32(1, stats.dropped);
+	TEST_ASSERT_EQUAL_UINT32(1, stats.blocks);
+}
+
+/* sys_latency */
+
+// the percentiles are the upper bounds of the buckets, limited to the longest span
+static void test_latency_percentile(void)
+{
+	sys_latency_stats_t stats;
+
+	TEST_ASSERT_TRUE(SYS_initLatency());
+	for (uint8_t i = 0; i < 99; i++) {
+		SYS_recordLatency(SYS_LAT_WS_TO_DUTY, 100);
+	}
+	SYS_recordLatency(SYS_LAT_WS_TO_DUTY, 100000);
+
+	SYS_getLatencyStats(SYS_LAT_WS_TO_DUTY, &stats);
+	TEST_ASSERT_EQUAL_UINT32(100, stats.count);
+	TEST_ASSERT_EQUAL_UINT32(127, stats.p50);
+	TEST_ASSERT_EQUAL_UINT32(127, stats.p99);
+	TEST_ASSERT_EQUAL_UINT32(100000, stats.max);
+
+	// spans spread over several buckets
+	SYS_clearLatency();
+	for (uint32_t i = 1; i <= 1000; i++) {
+		SYS_recordLatency(SYS_LAT_WS_TO_DUTY, i * 100);
+	}
+	SYS_getLatencyStats(SYS_LAT_WS_TO_DUTY, &stats);
+	TEST_ASSERT_EQUAL_UINT32(1000, stats.count);
+	TEST_ASSERT_EQUAL_UINT32(65535, stats.p50);
+	TEST_ASSERT_EQUAL_UINT32(100000, stats.p99);
+	TEST_ASSERT_EQUAL_UINT32(100000, stats.max);
+
+	// a stop without a start counts nothing
+	SYS_stopLatency(SYS_LAT_FAULT_TO_TASK);
+	SYS_getLatencyStats(SYS_LAT_FAULT_TO_TASK, &stats);
+	TEST_ASSERT_EQUAL_UINT32(0, stats.count);
+}
+
+int main(void)
+{
+	UNITY_BEGIN();
+	RUN_TEST(test_cmd_round_trip);
+	RUN_TEST(test_cmd_reject);
+	RUN_TEST(test_cmd_walk_frame);
+	RUN_TEST(test_cmd_walk_fuzz);
+	RUN_TEST(test_alive_edges);
+	RUN_TEST(test_alive_window);
+	RUN_TEST(test_ramp_linear);
+	RUN_TEST(test_ramp_scurve);
+	RUN_TEST(test_ramp_profile_time);
+	RUN_TEST(test_ramp_profile_range);
+	RUN_TEST(test_ramp_table_full_duty);
+	RUN_TEST(test_speed_saturation);
+	RUN_TEST(test_speed_gain_range);
+	RUN_TEST(test_speed_feed_forward);
+	RUN_TEST(test_speed_load_step);
+	RUN_TEST(test_adc_noise);
+	RUN_TEST(test_adc_scale_vin);
+	RUN_TEST(test_stream_block);
+	RUN_TEST(test_latency_percentile);
+	return UNITY_END();
+}
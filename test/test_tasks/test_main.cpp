@@ -0,0 +1,668 @@
+// --------------------------------------------------------
+// Copyright (c) 2025 rapid4mifu 
+//
+// These codes are licensed under GPL v3.0
+// https://opensource.org/license/GPL-3.0
+// --------------------------------------------------------
+
+// Tests of the task modules on the host shim (virtual clock)
+//  pio test -e native -f test_tasks
+//
+// the firmware is started once as main.cpp does, then each test drives
+// the console, the web socket and the pins, at once or by a script of
+// steps at their virtual time, and checks the timeline of the outputs
+// (the same script gives the same timeline on every run)
+
+#include <unity.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+#include <Arduino.h>
+#include <sim.h>
+
+#include "board.h"
+#include "rmpp_cmd.h"
+#include "sys_latency.h"
+#include "sys_perf.h"
+#include "task_adc.h"
+#include "task_cfg.h"
+#include "task_cli.h"
+#include "task_input.h"
+#include "task_led.h"
+#include "task_rmpp.h"
+#include "task_server.h"
+#include "task_system.h"
+
+#define TST_MS (1000ULL)			// [us]
+#define TST_TICK (1000000ULL / configTICK_RATE_HZ)
+
+// output modes of the status frame (as the web page reads them)
+#define TST_MODE_NONE 0xFF
+#define TST_MODE_OFF 1
+#define TST_MODE_ON 2
+#define TST_MODE_INHBIT 3
+#define TST_MODE_FAULT 4
+
+// time of the firmware (see task_rmpp.cpp)
+#define TST_INHBIT_TIME (1000 * TST_MS)
+#define TST_ALIVE_TIMEOUT (3000 * TST_MS)
+#define TST_STATUS_INTERVAL (200 * TST_MS)
+#define TST_QUE_REQ_LEN 16
+
+// text messages of the soak of the text ring (sent in bursts, one per millisecond)
+#define TST_SOAK_MESSAGES (2000000)
+#define TST_SOAK_BURST 64
+
+// priority of the test (loopTask) and above the tasks of the firmware
+#define TST_PRIORITY_LOOP 1
+#define TST_PRIORITY_HIGH (configMAX_PRIORITIES - 1)
+
+typedef struct {
+	const char * name;
+	uint32_t wakeups;		// per second (deterministic)
+	uint32_t cpu;			// host time per second [us] (the target takes about ten times as long)
+} tst_budget_t;
+
+static char tstMessage[160];
+static uint32_t idClient;
+
+static bool tst_boot(void);
+static void tst_sendOutput(uint32_t id, uint16_t duty, uint8_t dir);
+static uint8_t tst_getMode(const sim_tl_event_t * event);
+static uint64_t tst_findMode(const std::vector<sim_tl_event_t> & timeline, uint64_t from, uint8_t mode);
+static uint64_t tst_findDuty(const std::vector<sim_tl_event_t> & timeline, uint64_t from, bool on);
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+/******************************************************************************
+* Function Name: tst_boot
+* Description  : main.cpp の setup と同じ順序でタスクを起動する
+* Arguments    : none
+* Return Value : true -> every module started
+******************************************************************************/
+bool tst_boot(void)
+{
+	RMPP_resetOutput();
+	Serial.begin(115200);
+
+	if ((false == CLI_initTask()) || (false == SYS_initPerf()) || (false == SYS_initLatency())
+	 || (false == RMPP_initTask()) || (false == ADC_initTask()) || (false == INP_initTask())
+	 || (false == LED_initTask(PIN_LED, LED_TYPE_RGB_SERIAL)) || (false == CFG_initTask())) {
+		return false;
+	}
+
+	system_config_t cfgSys;
+	cfgSys.wifiMode = WIFI_STA;
+	cfgSys.wifiSsid = "rmpp";
+	cfgSys.wifiPass = "password";
+	cfgSys.ipLocal = IPAddress(192, 168, 0, 10);
+	cfgSys.ipGateway = IPAddress(192, 168, 0, 1);
+	cfgSys.ipSubnet = IPAddress(255, 255, 255, 0);
+	SIM_setWiFiStatus(true);
+	if (false == SYS_initTask(&cfgSys)) {
+		return false;
+	}
+
+	return SYS_isWiFiAvailable() && SRV_initTask(CFG_getHostName());
+}
+
+/******************************************************************************
+* Function Name: tst_sendOutput
+* Description  : WR_OUTPUT コマンドを WebSocket で送信する
+* Arguments    : id - client id, duty - output duty, dir - 0x40 forward, 0x80 reverse, 0 stop
+* Return Value : none
+******************************************************************************/
+void tst_sendOutput(uint32_t id, uint16_t duty, uint8_t dir)
+{
+	uint8_t buf[RMPP_PACKET_LEN_MAX];
+	uint8_t * cmd = RMPP_PACKET_CMD(buf);
+
+	cmd[0] = RMPP_CMDID_WR_OUTPUT;
+	cmd[1] = duty & 0xFF;
+	cmd[2] = dir | ((duty >> 8) & 0x3F);
+	SIM_receiveWsBinary(id, buf, RMPP_encodePacket(buf, RMPP_CMD_LEN_WR_OUTPUT));
+}
+
+/******************************************************************************
+* Function Name: tst_getMode
+* Description  : 状態フレームからチャネル0の出力モードを取り出す
+* Arguments    : event - timeline event
+* Return Value : output mode, TST_MODE_NONE -> no output flags of channel 0
+******************************************************************************/
+uint8_t tst_getMode(const sim_tl_event_t * event)
+{
+	uint8_t mode = TST_MODE_NONE;
+	size_t begin = 0;
+
+	if ((SIM_TL_WS_TX != event->kind) || (0 == event->value)) {
+		return TST_MODE_NONE;
+	}
+
+	// the frame carries packets back to back
+	while (begin < event->data.size()) {
+		size_t end = event->data.find('\0', begin);
+		uint8_t buf[RMPP_PACKET_LEN_MAX];
+		uint8_t * cmd = RMPP_PACKET_CMD(buf);
+
+		if ((std::string::npos == end) || (RMPP_PACKET_LEN_MAX < end + 1 - begin)) {
+			break;
+		}
+		memcpy(buf, event->data.data() + begin, end + 1 - begin);
+		if (0 != RMPP_decodePacket(buf, end + 1 - begin)) {
+			if (RMPP_CMDID_RD_STATUS == cmd[0]) {
+				mode = cmd[1] & 0x0F;
+			} else if ((RMPP_CMDID_RD_STATUS_DIFF(0) == (cmd[0] & 0xF0))
+			 && (0 == RMPP_GET_STATUS_DIFF_CH(cmd[1])) && (cmd[1] & RMPP_STATUS_DIFF_OUTPUT)) {
+				mode = cmd[2] & 0x0F;
+			}
+		}
+		begin = end + 1;
+	}
+	return mode;
+}
+
+/******************************************************************************
+* Function Name: tst_findMode
+* Description  : 指定時刻以降で最初に出力モードを報告した状態フレームを探す
+* Arguments    : timeline - timeline, from - virtual time [us], mode - output mode
+* Return Value : virtual time of the frame [us], UINT64_MAX -> not found
+******************************************************************************/
+uint64_t tst_findMode(const std::vector<sim_tl_event_t> & timeline, uint64_t from, uint8_t mode)
+{
+	for (const sim_tl_event_t & event : timeline) {
+		if ((from <= event.time) && (mode == tst_getMode(&event))) {
+			return event.time;
+		}
+	}
+	return UINT64_MAX;
+}
+
+/******************************************************************************
+* Function Name: tst_findDuty
+* Description  : 指定時刻以降で最初に出力がオン／オフした時刻を探す
+*                (PWM信号はアクティブロー、両方がローで出力はHi-Z、
+*                 記録の開始時に出力はオフ)
+* Arguments    : timeline - timeline, from - virtual time [us], on - true -> output on
+* Return Value : virtual time of the change [us], UINT64_MAX -> not found
+******************************************************************************/
+uint64_t tst_findDuty(const std::vector<sim_tl_event_t> & timeline, uint64_t from, bool on)
+{
+	uint32_t duty[2] = { 0, 0 };
+	bool output = false;
+
+	for (const sim_tl_event_t & event : timeline) {
+		bool previous = output;
+
+		if (SIM_TL_DUTY != event.kind) {
+			continue;
+		}
+		if (PIN_PWM1 == event.source) {
+			duty[0] = event.value;
+		} else if (PIN_PWM2 == event.source) {
+			duty[1] = event.value;
+		} else {
+			continue;
+		}
+		output = (0 != duty[0]) && (0 != duty[1]);
+		if ((from <= event.time) && (output != previous) && (output == on)) {
+			return event.time;
+		}
+	}
+	return UINT64_MAX;
+}
+
+// the firmware starts as on the target (station mode)
+static void test_boot(void)
+{
+	TEST_ASSERT_TRUE(tst_boot());
+}
+
+// the tasks are created and run
+static void test_tasks_started(void)
+{
+	static const char * const names[] = { "cli_task", "rmpp_task", "btn_task", "led_task", "sys_task" };
+	sim_task_stats_t stats;
+
+	SIM_clearTaskStats();
+	SIM_runFor(1000000);
+	for (const char * name : names) {
+		TEST_ASSERT_TRUE_MESSAGE(SIM_getTaskStats(name, &stats), name);
+		TEST_ASSERT_NOT_EQUAL_MESSAGE(0, stats.switches, name);
+	}
+	TEST_ASSERT_FALSE(SIM_isRestarted());
+}
+
+// a console command is answered on the serial port
+static void test_console_round_trip(void)
+{
+	std::string reply;
+
+	SIM_readSerial();
+	SIM_writeSerial("RMPP\n");
+	SIM_runFor(200000);
+	reply = SIM_readSerial();
+	TEST_ASSERT_NOT_EQUAL(std::string::npos, reply.find("- Input Voltage"));
+}
+
+// a change of the ramp or the gains is applied (and printed) by the RMPP
+// task, a value out of range is refused by the console
+static void test_console_ramp_gain(void)
+{
+	uint64_t t0 = SIM_getTime();
+	std::string reply;
+
+	SIM_readSerial();
+	SIM_writeSerial("RAMP BRK LINEAR 99999\n");
+	SIM_writeSerial("SPEED GAIN 99999 48\n");
+	SIM_writeSerial("SPEED GAIN 256 -1\n");
+	SIM_runUntil(t0 + 200 * TST_MS);
+	reply = SIM_readSerial();
+	TEST_ASSERT_NOT_EQUAL(std::string::npos, reply.find("usage : RAMP"));
+	TEST_ASSERT_NOT_EQUAL(std::string::npos, reply.find("usage : SPEED GAIN"));
+	TEST_ASSERT_EQUAL(std::string::npos, reply.find("- Braking"));
+	TEST_ASSERT_EQUAL(std::string::npos, reply.find("- Speed Control"));
+
+	// the full duty 4096 in 500 updates
+	SIM_writeSerial("RAMP BRK LINEAR 500\n");
+	SIM_writeSerial("SPEED GAIN 300 40\n");
+	SIM_runUntil(t0 + 400 * TST_MS);
+	reply = SIM_readSerial();
+	TEST_ASSERT_NOT_EQUAL(std::string::npos, reply.find("- Braking      : LINEAR, step 2097,"));
+	TEST_ASSERT_NOT_EQUAL(std::string::npos, reply.find("kp 300, ki 40"));
+
+	SIM_writeSerial("RAMP BRK LINEAR 800\n");
+	SIM_writeSerial("SPEED GAIN 256 48\n");
+	SIM_runUntil(t0 + 600 * TST_MS);
+	reply = SIM_readSerial();
+	TEST_ASSERT_NOT_EQUAL(std::string::npos, reply.find("- Braking      : LINEAR, step 1310,"));
+	TEST_ASSERT_NOT_EQUAL(std::string::npos, reply.find("kp 256, ki 48"));
+}
+
+// a web socket client drives the output and stops it
+static void test_ws_drive(void)
+{
+	idClient = SIM_connectWs();
+	SIM_runFor(100000);
+
+	tst_sendOutput(idClient, 0x800, 0x40);
+	SIM_runFor(2000000);
+	TEST_ASSERT_NOT_EQUAL(0, SIM_getPinDuty(PIN_PWM1) + SIM_getPinDuty(PIN_PWM2));
+
+	tst_sendOutput(idClient, 0, 0);
+	SIM_runFor(2000000);
+	TEST_ASSERT_EQUAL_UINT32(0, SIM_getPinDuty(PIN_PWM1) + SIM_getPinDuty(PIN_PWM2));
+}
+
+// a console command of a web socket client is answered to that client,
+// a line per text message, nothing is written to the serial port
+static void test_ws_console(void)
+{
+	std::vector<sim_tl_event_t> timeline;
+	std::string reply;
+
+	SIM_readSerial();
+	SIM_recordTimeline(true);
+	SIM_receiveWsText(idClient, "?");
+	SIM_runFor(100 * TST_MS);
+	timeline = SIM_takeTimeline();
+	SIM_recordTimeline(false);
+
+	for (const sim_tl_event_t & event : timeline) {
+		if ((SIM_TL_WS_TX == event.kind) && (0 == event.value)) {
+			TEST_ASSERT_EQUAL_UINT32(idClient, event.source);
+			reply += event.data + "\n";
+		}
+	}
+	TEST_ASSERT_NOT_EQUAL(std::string::npos, reply.find("----- CLI Command List -----\n"));
+	TEST_ASSERT_NOT_EQUAL(std::string::npos, reply.find(" [00] RESET\n"));
+	TEST_ASSERT_EQUAL_STRING(">\n", reply.substr(reply.size() - 2).c_str());
+	TEST_ASSERT_EQUAL(std::string::npos, SIM_readSerial().find("CLI Command List"));
+}
+
+// a fault edge cuts the output in the interrupt, the output stays off
+// until a stop command after the fault has cleared
+static void test_sim_fault_cut(void)
+{
+	uint64_t t0 = SIM_getTime();
+	std::vector<sim_tl_event_t> timeline;
+	uint64_t tOn;
+	uint64_t tCut;
+
+	SIM_recordTimeline(true);
+	SIM_at(t0 + 10 * TST_MS, [] { tst_sendOutput(idClient, 0x800, 0x40); });
+	SIM_at(t0 + 500 * TST_MS, [] { SIM_setPin(PIN_FAULT, FAULT_DURING); });
+	SIM_at(t0 + 600 * TST_MS, [] { SIM_setPin(PIN_FAULT, FAULT_CLEAR); });
+	SIM_at(t0 + 700 * TST_MS, [] { tst_sendOutput(idClient, 0x800, 0x40); });	// latched
+	SIM_at(t0 + 800 * TST_MS, [] { tst_sendOutput(idClient, 0, 0); });			// clears the fault
+	SIM_at(t0 + 900 * TST_MS, [] { tst_sendOutput(idClient, 0x800, 0x40); });
+	SIM_at(t0 + 1000 * TST_MS, [] { tst_sendOutput(idClient, 0, 0); });
+	SIM_runUntil(t0 + 1100 * TST_MS);
+	timeline = SIM_takeTimeline();
+	SIM_recordTimeline(false);
+
+	tOn = tst_findDuty(timeline, t0, true);
+	TEST_ASSERT_TRUE(t0 + 500 * TST_MS > tOn);
+	tCut = tst_findDuty(timeline, tOn, false);
+	TEST_ASSERT_EQUAL_UINT32(500 * TST_MS, tCut - t0);
+	TEST_ASSERT_LESS_OR_EQUAL_UINT32(2 * TST_TICK, tst_findMode(timeline, tCut, TST_MODE_FAULT) - tCut);
+	TEST_ASSERT_TRUE(t0 + 900 * TST_MS <= tst_findDuty(timeline, tCut, true));
+	TEST_ASSERT_TRUE(t0 + 900 * TST_MS > tst_findMode(timeline, tCut, TST_MODE_OFF));
+}
+
+#if (RMPP_PIN_NONE != PIN_ISENSE)
+// an over current cuts the output in the ADC task, the trip stays latched
+// (no command turns the output on) until a stop clears it in the RMPP task
+static void test_sim_trip_latch(void)
+{
+	uint64_t t0 = SIM_getTime();
+	std::vector<sim_tl_event_t> timeline;
+	std::string reply;
+	uint64_t tOn;
+	uint64_t tCut;
+
+	// 1 A trips, the sense gives ISENSE_MV_PER_A [mV/A]
+	SIM_writeSerial("TRIP 1000 800\n");
+	SIM_runUntil(t0 + 10 * TST_MS);
+
+	SIM_recordTimeline(true);
+	SIM_at(t0 + 20 * TST_MS, [] { tst_sendOutput(idClient, 0x800, 0x40); });
+	SIM_at(t0 + 300 * TST_MS, [] { SIM_setAnalog(PIN_ISENSE, ISENSE_MV_PER_A * 3 / 2); });
+	SIM_at(t0 + 400 * TST_MS, [] { SIM_setAnalog(PIN_ISENSE, 0); });
+	SIM_at(t0 + 500 * TST_MS, [] { tst_sendOutput(idClient, 0x800, 0x40); });	// latched
+	SIM_at(t0 + 600 * TST_MS, [] { tst_sendOutput(idClient, 0, 0); });			// clears the trip
+	SIM_at(t0 + 700 * TST_MS, [] { tst_sendOutput(idClient, 0x800, 0x40); });
+	SIM_at(t0 + 800 * TST_MS, [] { tst_sendOutput(idClient, 0, 0); });
+	SIM_runUntil(t0 + 900 * TST_MS);
+	timeline = SIM_takeTimeline();
+	SIM_recordTimeline(false);
+
+	SIM_readSerial();
+	SIM_writeSerial("TRIP 3000 2000\n");
+	SIM_runUntil(t0 + 1000 * TST_MS);
+	reply = SIM_readSerial();
+
+	tOn = tst_findDuty(timeline, t0, true);
+	TEST_ASSERT_TRUE(t0 + 300 * TST_MS > tOn);
+	tCut = tst_findDuty(timeline, tOn, false);
+	TEST_ASSERT_TRUE(t0 + 300 * TST_MS <= tCut);
+	TEST_ASSERT_TRUE(t0 + 300 * TST_MS + 2 * TST_TICK >= tCut);
+	TEST_ASSERT_LESS_OR_EQUAL_UINT32(2 * TST_TICK, tst_findMode(timeline, tCut, TST_MODE_FAULT) - tCut);
+	TEST_ASSERT_TRUE(t0 + 700 * TST_MS <= tst_findDuty(timeline, tCut, true));
+	TEST_ASSERT_TRUE(t0 + 700 * TST_MS > tst_findMode(timeline, tCut, TST_MODE_OFF));
+	TEST_ASSERT_NOT_EQUAL(std::string::npos, reply.find("tripped 1 times"));
+}
+#endif
+
+// a stop that does not fit in the request queue wins over the older
+// requests in the queue, the requests after the stop are applied
+static void test_sim_stop_overflow(void)
+{
+	uint64_t t0 = SIM_getTime();
+	std::vector<sim_tl_event_t> timeline;
+	uint64_t tOn;
+
+	SIM_recordTimeline(true);
+	SIM_runUntil(t0 + 10 * TST_MS);
+	// the queue fills before the task runs (the test runs over the task)
+	vTaskPrioritySet(NULL, TST_PRIORITY_HIGH);
+	RMPP_startOutput(0, RMPP_DIR_FWD);
+	for (uint32_t i = 0; i < TST_QUE_REQ_LEN; i++) {
+		RMPP_setOutputDuty(0, 0x800);
+	}
+	RMPP_stopAllOutputs(false);
+	vTaskPrioritySet(NULL, TST_PRIORITY_LOOP);
+	SIM_runUntil(t0 + 200 * TST_MS);
+	RMPP_startOutput(0, RMPP_DIR_FWD);
+	RMPP_setOutputDuty(0, 0x800);
+	SIM_runUntil(t0 + 400 * TST_MS);
+	RMPP_stopAllOutputs(false);
+	SIM_runUntil(t0 + 500 * TST_MS);
+	timeline = SIM_takeTimeline();
+	SIM_recordTimeline(false);
+
+	tOn = tst_findDuty(timeline, t0, true);
+	TEST_ASSERT_TRUE(t0 + 200 * TST_MS <= tOn);
+	TEST_ASSERT_TRUE(t0 + 200 * TST_MS + 2 * TST_TICK >= tOn);
+	TEST_ASSERT_TRUE(t0 + 400 * TST_MS <= tst_findDuty(timeline, tOn, false));
+	TEST_ASSERT_EQUAL_UINT32(0, SIM_getPinDuty(PIN_PWM1) + SIM_getPinDuty(PIN_PWM2));
+}
+
+// a press of the button stops the output for the inhbit time,
+// the commands in the time are not accepted
+static void test_sim_inhibit(void)
+{
+	uint64_t t0 = SIM_getTime();
+	std::vector<sim_tl_event_t> timeline;
+	uint64_t tStop;
+	uint64_t tInhbit;
+	uint64_t tOff;
+
+	SIM_recordTimeline(true);
+	SIM_at(t0 + 10 * TST_MS, [] { tst_sendOutput(idClient, 0x800, 0x40); });
+	SIM_pressPin(t0 + 300 * TST_MS, PIN_SW, SW_PRESS, 100 * TST_MS, 3);
+	SIM_at(t0 + 800 * TST_MS, [] { tst_sendOutput(idClient, 0x800, 0x40); });	// in the inhbit time
+	SIM_at(t0 + 2000 * TST_MS, [] { tst_sendOutput(idClient, 0x800, 0x40); });
+	SIM_at(t0 + 2100 * TST_MS, [] { tst_sendOutput(idClient, 0, 0); });
+	SIM_runUntil(t0 + 2200 * TST_MS);
+	timeline = SIM_takeTimeline();
+	SIM_recordTimeline(false);
+
+	// the press is judged on the settled release (3 bounces of 2 ms)
+	tStop = tst_findDuty(timeline, t0 + 20 * TST_MS, false);
+	TEST_ASSERT_TRUE(t0 + 406 * TST_MS <= tStop);
+	TEST_ASSERT_TRUE(t0 + 406 * TST_MS + 3 * 25 * TST_MS >= tStop);
+
+	tInhbit = tst_findMode(timeline, tStop, TST_MODE_INHBIT);
+	tOff = tst_findMode(timeline, tInhbit, TST_MODE_OFF);
+	snprintf(tstMessage, sizeof(tstMessage), "inhbit : %llu us", (unsigned long long)(tOff - tInhbit));
+	TEST_MESSAGE(tstMessage);
+	TEST_ASSERT_TRUE(TST_INHBIT_TIME <= tOff - tInhbit);
+	TEST_ASSERT_TRUE(TST_INHBIT_TIME + 2 * TST_TICK >= tOff - tInhbit);
+
+	TEST_ASSERT_EQUAL_UINT32(2000 * TST_MS, tst_findDuty(timeline, tStop, true) - t0);
+}
+
+// a bounce shorter than the press time is not a press,
+// a press with many bounces is judged on its settled release
+static void test_sim_debounce(void)
+{
+	uint64_t t0 = SIM_getTime();
+	std::vector<sim_tl_event_t> timeline;
+	uint64_t tStop;
+
+	SIM_recordTimeline(true);
+	SIM_at(t0 + 10 * TST_MS, [] { tst_sendOutput(idClient, 0x800, 0x40); });
+	SIM_pressPin(t0 + 300 * TST_MS, PIN_SW, SW_PRESS, 20 * TST_MS, 2);
+	SIM_pressPin(t0 + 1000 * TST_MS, PIN_SW, SW_PRESS, 60 * TST_MS, 10);
+	SIM_runUntil(t0 + 2500 * TST_MS);
+	timeline = SIM_takeTimeline();
+	SIM_recordTimeline(false);
+
+	// 10 bounces of 2 ms on the press and on the release
+	tStop = tst_findDuty(timeline, t0 + 20 * TST_MS, false);
+	TEST_ASSERT_TRUE(t0 + 1100 * TST_MS <= tStop);
+	TEST_ASSERT_TRUE(t0 + 1100 * TST_MS + 20 * TST_MS + 3 * 25 * TST_MS >= tStop);
+	TEST_ASSERT_TRUE(tStop <= tst_findMode(timeline, tStop, TST_MODE_INHBIT));
+}
+
+// the output stops when the client sends nothing for the alive timeout
+// (checked at the status interval)
+static void test_sim_alive_timeout(void)
+{
+	uint64_t t0 = SIM_getTime();
+	std::vector<sim_tl_event_t> timeline;
+	uint64_t tCmd = t0 + 10 * TST_MS;
+	uint64_t tStop;
+
+	SIM_recordTimeline(true);
+	SIM_at(tCmd, [] { tst_sendOutput(idClient, 0x800, 0x40); });
+	SIM_runUntil(t0 + 4000 * TST_MS);
+	timeline = SIM_takeTimeline();
+	SIM_recordTimeline(false);
+
+	tStop = tst_findDuty(timeline, tst_findDuty(timeline, t0, true), false);
+	snprintf(tstMessage, sizeof(tstMessage), "alive timeout : %llu us", (unsigned long long)(tStop - tCmd));
+	TEST_MESSAGE(tstMessage);
+	TEST_ASSERT_TRUE(TST_ALIVE_TIMEOUT <= tStop - tCmd);
+	TEST_ASSERT_TRUE(TST_ALIVE_TIMEOUT + TST_STATUS_INTERVAL >= tStop - tCmd);
+	TEST_ASSERT_TRUE(tStop <= tst_findMode(timeline, tStop, TST_MODE_OFF));
+}
+
+// the loss of the access point and the reconnection are followed
+static void test_sim_wifi_events(void)
+{
+	static bool available[2];
+	uint64_t t0 = SIM_getTime();
+
+	SIM_at(t0 + 100 * TST_MS, [] { SIM_setWiFiStatus(false); });
+	SIM_at(t0 + 300 * TST_MS, [] { available[0] = SYS_isWiFiAvailable(); });
+	SIM_at(t0 + 1000 * TST_MS, [] { SIM_setWiFiStatus(true); });
+	SIM_at(t0 + 1200 * TST_MS, [] { available[1] = SYS_isWiFiAvailable(); });
+	SIM_runUntil(t0 + 1500 * TST_MS);
+
+	TEST_ASSERT_FALSE(available[0]);
+	TEST_ASSERT_TRUE(available[1]);
+}
+
+// the profile is taken every window while it is on, the copy holds every
+// task of the firmware, nothing is sampled while it is off
+static void test_sim_perf_profile(void)
+{
+	static sys_perf_t perf;
+	uint64_t t0 = SIM_getTime();
+	uint32_t seq;
+	bool found = false;
+
+	SYS_enablePerf(true);
+	SIM_runUntil(t0 + 3 * SYS_PERF_WINDOW * TST_MS);
+	TEST_ASSERT_TRUE(SYS_getPerf(&perf));
+	TEST_ASSERT_TRUE(2 <= perf.seq);
+	TEST_ASSERT_TRUE(0 < perf.count);
+	TEST_ASSERT_NOT_EQUAL(SYS_PERF_CPU_NONE, perf.load);
+	for (uint8_t i = 0; i < perf.count; i++) {
+		found |= (0 == strcmp("rmpp_task", perf.task[i].name));
+	}
+	TEST_ASSERT_TRUE(found);
+
+	SYS_enablePerf(false);
+	seq = perf.seq;
+	SIM_runUntil(t0 + 6 * SYS_PERF_WINDOW * TST_MS);
+	TEST_ASSERT_TRUE(SYS_getPerf(&perf));
+	TEST_ASSERT_EQUAL_UINT32(seq, perf.seq);
+}
+
+// millions of text messages through the ring of the server, the producers
+// allocate nothing and the heap in use stays flat (the messages of the
+// other tasks come and go meanwhile)
+static void test_sim_text_soak(void)
+{
+	static const char text[] = "[info] output 0 on !";
+	uint64_t t0 = SIM_getTime();
+	srv_stats_t begin;
+	srv_stats_t end;
+	size_t heapFirst = SIM_getAllocBytes();
+	size_t heapMin = heapFirst;
+	size_t heapMax = heapFirst;
+	uint64_t allocs = 0;
+
+	SRV_getStats(&begin);
+	for (uint32_t i = 0; i < TST_SOAK_MESSAGES; i += TST_SOAK_BURST) {
+		uint64_t count;
+		size_t heap;
+
+		vTaskPrioritySet(NULL, TST_PRIORITY_HIGH);
+		count = SIM_getAllocCount();
+		for (uint32_t j = 0; j < TST_SOAK_BURST; j++) {
+			SRV_pushWsTextToQueue(text, sizeof(text) - 1, idClient);
+		}
+		allocs += SIM_getAllocCount() - count;
+		vTaskPrioritySet(NULL, TST_PRIORITY_LOOP);
+		SIM_runFor(TST_MS);
+
+		heap = SIM_getAllocBytes();
+		heapMin = (heap < heapMin) ? heap : heapMin;
+		heapMax = (heap > heapMax) ? heap : heapMax;
+	}
+	SRV_getStats(&end);
+
+	snprintf(tstMessage, sizeof(tstMessage), "%u messages, heap in use %u - %u bytes (first %u), %llu allocations by the producers",
+		(uint32_t)(end.text_sent - begin.text_sent), (uint32_t)heapMin, (uint32_t)heapMax, (uint32_t)heapFirst,
+		(unsigned long long)allocs);
+	TEST_MESSAGE(tstMessage);
+	TEST_ASSERT_EQUAL_UINT32(TST_SOAK_MESSAGES, end.text_sent - begin.text_sent);
+	TEST_ASSERT_EQUAL_UINT32(0, end.text_dropped - begin.text_dropped);
+	TEST_ASSERT_EQUAL_UINT32(0, allocs);
+	TEST_ASSERT_LESS_OR_EQUAL_UINT32(heapFirst, heapMax);
+	SIM_runUntil(t0 + (TST_SOAK_MESSAGES / TST_SOAK_BURST / 1000 + 1) * 1000 * TST_MS);
+}
+
+// wakeups and host time of each task while a slider drives the output
+static void test_sim_cpu_budget(void)
+{
+	static const tst_budget_t budgets[] = {
+		{ "rmpp_task", 1000, 5000 },	// ramp at RMPP_RAMP_RATE while the duty moves
+		{ "adc_task", 2000, 5000 },		// ADC_FRAME_RATE
+		{ "srv_task", 50, 2000 },
+		{ "async_tcp", 40, 2000 },
+		{ "btn_task", 40, 2000 },		// INPUT_SAMPLE_PERIOD
+		{ "led_task", 40, 2000 },
+		{ "cli_task", 1000, 2000 },		// CLI_POLL_INTERVAL
+		{ "sys_task", 1000, 2000 },		// SYS_PROCESS_INTERVAL
+		{ "Tmr Svc", 5, 2000 },			// RMPP_STATUS_INTERVAL only (no timer is restarted per command)
+	};
+	const uint64_t seconds = 10;
+	uint64_t t0 = SIM_getTime();
+
+	// a command every 50 ms, the duty rises and falls
+	for (uint32_t i = 0; i < seconds * 20; i++) {
+		uint16_t duty = (i % 40 < 20) ? (i % 40) * 200 : (40 - i % 40) * 200;
+		SIM_at(t0 + i * 50 * TST_MS, [duty] { tst_sendOutput(idClient, duty, 0x40); });
+	}
+	SIM_at(t0 + seconds * 1000 * TST_MS, [] { tst_sendOutput(idClient, 0, 0); });
+
+	SIM_clearTaskStats();
+	SIM_runUntil(t0 + seconds * 1000 * TST_MS);
+
+	for (const tst_budget_t & budget : budgets) {
+		sim_task_stats_t stats;
+
+		TEST_ASSERT_TRUE_MESSAGE(SIM_getTaskStats(budget.name, &stats), budget.name);
+		snprintf(tstMessage, sizeof(tstMessage), "%-10s : %u wakeups/s, %llu us/s (budget %u, %u)", budget.name,
+			(uint32_t)(stats.wakeups / seconds), (unsigned long long)(stats.run_ns / 1000 / seconds), budget.wakeups, budget.cpu);
+		TEST_MESSAGE(tstMessage);
+		TEST_ASSERT_LESS_OR_EQUAL_UINT32(budget.wakeups, stats.wakeups / seconds);
+		TEST_ASSERT_LESS_OR_EQUAL_UINT32(budget.cpu, stats.run_ns / 1000 / seconds);
+	}
+	SIM_runFor(100 * TST_MS);
+}
+
+int main(void)
+{
+	UNITY_BEGIN();
+	RUN_TEST(test_boot);
+	RUN_TEST(test_tasks_started);
+	RUN_TEST(test_console_round_trip);
+	RUN_TEST(test_console_ramp_gain);
+	RUN_TEST(test_ws_drive);
+	RUN_TEST(test_ws_console);
+	RUN_TEST(test_sim_fault_cut);
+#if (RMPP_PIN_NONE != PIN_ISENSE)
+	RUN_TEST(test_sim_trip_latch);
+#endif
+	RUN_TEST(test_sim_stop_overflow);
+	RUN_TEST(test_sim_inhibit);
+	RUN_TEST(test_sim_debounce);
+	RUN_TEST(test_sim_alive_timeout);
+	RUN_TEST(test_sim_wifi_events);
+	RUN_TEST(test_sim_perf_profile);
+	RUN_TEST(test_sim_text_soak);
+	RUN_TEST(test_sim_cpu_budget);
+	return UNITY_END();
+}